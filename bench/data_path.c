@@ -0,0 +1,184 @@
+/*
+ * Lace
+ * Benchmark suite - data path without a screen
+ *
+ * Driver decode of query results into DbValues, the DbValue helpers every
+ * cell goes through afterwards, and WHERE clause building from the filter
+ * panel.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "harness.h"
+#include "../src/core/app_state.h"
+#include "../src/db/connstr.h"
+#include "../src/util/str.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Rows decoded per iteration, and held for the DbValue benchmarks */
+#define DATA_QUERY "SELECT * FROM " BENCH_TABLE " LIMIT 20000"
+
+/* WHERE clauses built per iteration (one build is too quick to time) */
+#define FILTER_BUILDS_PER_ITER 1000
+
+typedef struct {
+  DbConnection *conn;
+  ResultSet *rs; /* DATA_QUERY result for the DbValue benchmarks */
+  TableSchema *schema;
+  TableFilters filters;
+} DataCtx;
+
+static size_t num_cells(const ResultSet *rs) {
+  return rs->num_rows * rs->num_columns;
+}
+
+static bool bench_sqlite_query(void *ctx, BenchIter *it) {
+  DataCtx *c = ctx;
+  char *err = NULL;
+  ResultSet *rs = db_query(c->conn, DATA_QUERY, &err);
+  free(err);
+  if (!rs)
+    return false;
+  it->items = rs->num_rows;
+  it->bytes = c->conn->last_stats.bytes;
+  it->server_us = c->conn->last_stats.server_us;
+  it->decode_us = c->conn->last_stats.decode_us;
+  db_result_free(rs);
+  return true;
+}
+
+static bool bench_value_copy(void *ctx, BenchIter *it) {
+  DataCtx *c = ctx;
+  for (size_t r = 0; r < c->rs->num_rows; r++) {
+    Row *row = &c->rs->rows[r];
+    for (size_t i = 0; i < row->num_cells; i++) {
+      DbValue copy = db_value_copy(&row->cells[i]);
+      db_value_free(&copy);
+    }
+  }
+  it->items = num_cells(c->rs);
+  return true;
+}
+
+static bool bench_value_convert(void *ctx, BenchIter *it) {
+  DataCtx *c = ctx;
+  volatile double sink = 0;
+  for (size_t r = 0; r < c->rs->num_rows; r++) {
+    Row *row = &c->rs->rows[r];
+    for (size_t i = 0; i < row->num_cells; i++) {
+      sink += (double)db_value_to_int(&row->cells[i]);
+      sink += db_value_to_float(&row->cells[i]);
+      sink += db_value_to_bool(&row->cells[i]);
+    }
+  }
+  (void)sink;
+  it->items = num_cells(c->rs);
+  return true;
+}
+
+static bool bench_value_to_string(void *ctx, BenchIter *it) {
+  DataCtx *c = ctx;
+  size_t bytes = 0;
+  for (size_t r = 0; r < c->rs->num_rows; r++) {
+    Row *row = &c->rs->rows[r];
+    for (size_t i = 0; i < row->num_cells; i++) {
+      char *s = db_value_to_string(&row->cells[i]);
+      if (s) {
+        bytes += strlen(s);
+        free(s);
+      }
+    }
+  }
+  it->items = num_cells(c->rs);
+  it->bytes = bytes;
+  return true;
+}
+
+static bool bench_filters_build_where(void *ctx, BenchIter *it) {
+  DataCtx *c = ctx;
+  for (size_t i = 0; i < FILTER_BUILDS_PER_ITER; i++) {
+    char *err = NULL;
+    char *where = filters_build_where(&c->filters, c->schema, "sqlite", &err);
+    free(err);
+    if (!where)
+      return false;
+    free(where);
+  }
+  it->items = FILTER_BUILDS_PER_ITER;
+  return true;
+}
+
+/* Index of the fixture column named name */
+static size_t column_index(const TableSchema *schema, const char *name) {
+  for (size_t i = 0; i < schema->num_columns; i++) {
+    if (str_eq(schema->columns[i].name, name))
+      return i;
+  }
+  return 0;
+}
+
+/* A filter panel as a user would fill it: one filter of each common kind */
+static void add_filters(DataCtx *c) {
+  TableSchema *s = c->schema;
+  filters_init(&c->filters);
+  filters_add(&c->filters, column_index(s, "name"), FILTER_OP_CONTAINS,
+              "bravo");
+  filters_add(&c->filters, column_index(s, "qty"), FILTER_OP_IN,
+              "1, 2, 3, 5, 8, 13, 21, 34, 55, 89, 144, 233, 377, 610");
+  filters_add(&c->filters, column_index(s, "price"), FILTER_OP_BETWEEN,
+              "10.5");
+  snprintf(c->filters.filters[c->filters.num_filters - 1].value2,
+           sizeof(c->filters.filters[0].value2), "%s", "999.99");
+  filters_add(&c->filters, column_index(s, "created"), FILTER_OP_GE,
+              "2023-01-01 00:00:00");
+  filters_add(&c->filters, column_index(s, "note"), FILTER_OP_IS_NOT_NULL,
+              NULL);
+  filters_add(&c->filters, column_index(s, "email"), FILTER_OP_NE,
+              "o'brien@example.com");
+}
+
+void bench_suite_data(const BenchOptions *opts) {
+  char *err = NULL;
+  char *connstr = connstr_from_path(opts->fixture, &err);
+  DataCtx c = {0};
+  c.conn = connstr ? db_connect(connstr, &err) : NULL;
+  free(connstr);
+  if (!c.conn) {
+    bench_skip("data", err ? err : "cannot open fixture");
+    free(err);
+    return;
+  }
+
+  c.conn->measure_queries = true;
+  bench_run(opts, "sqlite_query", "rows", bench_sqlite_query, &c);
+  c.conn->measure_queries = false;
+
+  c.rs = db_query(c.conn, DATA_QUERY, &err);
+  if (c.rs) {
+    bench_run(opts, "db_value_copy", "cells", bench_value_copy, &c);
+    bench_run(opts, "db_value_to_number", "cells", bench_value_convert, &c);
+    bench_run(opts, "db_value_to_string", "cells", bench_value_to_string, &c);
+    db_result_free(c.rs);
+  } else {
+    bench_skip("db_value", err ? err : "query failed");
+    free(err);
+    err = NULL;
+  }
+
+  c.schema = db_get_table_schema(c.conn, BENCH_TABLE, &err);
+  if (c.schema) {
+    add_filters(&c);
+    bench_run(opts, "filters_build_where", "calls", bench_filters_build_where,
+              &c);
+    filters_free(&c.filters);
+    db_schema_free(c.schema);
+  } else {
+    bench_skip("filters_build_where", err ? err : "no schema");
+    free(err);
+  }
+
+  db_disconnect(c.conn);
+}
@@ -0,0 +1,149 @@
+/*
+ * Lace
+ * Benchmark fixture - a generated SQLite table of mixed column types
+ *
+ * Values come from a fixed-seed generator so every run and every machine
+ * reads the same data: integers, reals, short and long text, dates, NULLs
+ * and small blobs, in proportions close to a typical application table.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "harness.h"
+#include "../src/util/str.h"
+#include <sqlite3.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+static const char *const words[] = {
+    "alpha",   "bravo",  "charlie", "delta",  "echo",    "foxtrot",
+    "golf",    "hotel",  "india",   "juliet", "kilo",    "lima",
+    "mike",    "oscar",  "papa",    "quebec", "romeo",   "sierra",
+    "tango",   "victor", "whiskey", "yankee", "zulu",    "amber",
+    "crimson", "indigo", "jade",    "scarlet", "saffron", "teal"};
+#define NUM_WORDS (sizeof(words) / sizeof(words[0]))
+
+/* xorshift64: fixed seed, same sequence everywhere */
+static uint64_t next_rand(uint64_t *state) {
+  uint64_t x = *state;
+  x ^= x << 13;
+  x ^= x >> 7;
+  x ^= x << 17;
+  return *state = x;
+}
+
+/* Words separated by spaces, appended to buf */
+static size_t append_words(char *buf, size_t size, size_t count,
+                           uint64_t *rng) {
+  size_t len = 0;
+  for (size_t i = 0; i < count; i++) {
+    const char *w = words[next_rand(rng) % NUM_WORDS];
+    int n = snprintf(buf + len, size - len, "%s%s", i ? " " : "", w);
+    if (n < 0 || (size_t)n >= size - len)
+      break;
+    len += (size_t)n;
+  }
+  return len;
+}
+
+static bool exec(sqlite3 *db, const char *sql, char **err) {
+  char *msg = NULL;
+  if (sqlite3_exec(db, sql, NULL, NULL, &msg) != SQLITE_OK) {
+    *err = str_dup(msg ? msg : sqlite3_errmsg(db));
+    sqlite3_free(msg);
+    return false;
+  }
+  return true;
+}
+
+bool bench_fixture_create(const char *path, size_t rows, char **err) {
+  remove(path);
+
+  sqlite3 *db = NULL;
+  if (sqlite3_open(path, &db) != SQLITE_OK) {
+    *err = str_printf("Cannot create %s: %s", path,
+                      db ? sqlite3_errmsg(db) : "out of memory");
+    sqlite3_close(db);
+    return false;
+  }
+
+  if (!exec(db,
+            "PRAGMA journal_mode = OFF; PRAGMA synchronous = OFF;"
+            "CREATE TABLE " BENCH_TABLE " ("
+            "  id INTEGER PRIMARY KEY,"
+            "  name TEXT NOT NULL,"
+            "  email TEXT,"
+            "  qty INTEGER,"
+            "  price REAL,"
+            "  created TEXT,"
+            "  note TEXT,"
+            "  payload BLOB);"
+            "BEGIN",
+            err)) {
+    sqlite3_close(db);
+    return false;
+  }
+
+  sqlite3_stmt *stmt = NULL;
+  if (sqlite3_prepare_v2(db,
+                         "INSERT INTO " BENCH_TABLE
+                         " VALUES (?, ?, ?, ?, ?, ?, ?, ?)",
+                         -1, &stmt, NULL) != SQLITE_OK) {
+    *err = str_dup(sqlite3_errmsg(db));
+    sqlite3_close(db);
+    return false;
+  }
+
+  uint64_t rng = 0x9E3779B97F4A7C15ULL;
+  char name[64], email[96], created[32], note[512];
+  uint8_t payload[64];
+  bool ok = true;
+
+  for (size_t i = 1; i <= rows && ok; i++) {
+    append_words(name, sizeof(name), 2, &rng);
+    snprintf(email, sizeof(email), "%s.%zu@example.com",
+             words[next_rand(&rng) % NUM_WORDS], i);
+    snprintf(created, sizeof(created), "20%02u-%02u-%02u %02u:%02u:%02u",
+             (unsigned)(20 + next_rand(&rng) % 6),
+             (unsigned)(1 + next_rand(&rng) % 12),
+             (unsigned)(1 + next_rand(&rng) % 28),
+             (unsigned)(next_rand(&rng) % 24), (unsigned)(next_rand(&rng) % 60),
+             (unsigned)(next_rand(&rng) % 60));
+
+    sqlite3_bind_int64(stmt, 1, (sqlite3_int64)i);
+    sqlite3_bind_text(stmt, 2, name, -1, SQLITE_STATIC);
+    /* One in ten rows misses its email, one in three its note */
+    if (next_rand(&rng) % 10 == 0)
+      sqlite3_bind_null(stmt, 3);
+    else
+      sqlite3_bind_text(stmt, 3, email, -1, SQLITE_STATIC);
+    sqlite3_bind_int64(stmt, 4, (sqlite3_int64)(next_rand(&rng) % 1000));
+    sqlite3_bind_double(stmt, 5, (double)(next_rand(&rng) % 100000) / 100.0);
+    sqlite3_bind_text(stmt, 6, created, -1, SQLITE_STATIC);
+    if (next_rand(&rng) % 3 == 0) {
+      sqlite3_bind_null(stmt, 7);
+    } else {
+      size_t len = append_words(note, sizeof(note),
+                                1 + next_rand(&rng) % 40, &rng);
+      sqlite3_bind_text(stmt, 7, note, (int)len, SQLITE_STATIC);
+    }
+    size_t blob_len = next_rand(&rng) % sizeof(payload);
+    for (size_t b = 0; b < blob_len; b++)
+      payload[b] = (uint8_t)next_rand(&rng);
+    sqlite3_bind_blob(stmt, 8, payload, (int)blob_len, SQLITE_STATIC);
+
+    if (sqlite3_step(stmt) != SQLITE_DONE) {
+      *err = str_dup(sqlite3_errmsg(db));
+      ok = false;
+    }
+    sqlite3_reset(stmt);
+  }
+  sqlite3_finalize(stmt);
+
+  if (ok)
+    ok = exec(db, "COMMIT", err);
+  sqlite3_close(db);
+  return ok;
+}
@@ -0,0 +1,187 @@
+/*
+ * Lace
+ * Benchmark harness - runner, JSON output and lace-bench entry point
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "harness.h"
+#include "../src/core/bench.h"
+#include "../src/platform/thread.h"
+#include "../src/util/mem.h"
+#include "../src/util/str.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+/* Iterations per benchmark: enough for percentiles, bounded for memory */
+#define BENCH_MIN_ITERATIONS 5
+#define BENCH_MAX_ITERATIONS 100000
+
+#define BENCH_DEFAULT_ROWS 100000
+#define BENCH_DEFAULT_MIN_MS 300
+
+/* Results printed so far (for the separating commas) */
+static size_t num_printed = 0;
+
+/* Print s as a JSON string */
+static void json_string(const char *s) {
+  putchar('"');
+  for (const unsigned char *p = (const unsigned char *)s; *p; p++) {
+    if (*p == '"' || *p == '\\')
+      printf("\\%c", *p);
+    else if (*p < 0x20)
+      printf("\\u%04x", *p);
+    else
+      putchar(*p);
+  }
+  putchar('"');
+}
+
+static void result_begin(const char *name) {
+  printf("%s\n    {\"name\": ", num_printed++ ? "," : "");
+  json_string(name);
+}
+
+void bench_skip(const char *name, const char *reason) {
+  result_begin(name);
+  printf(", \"skipped\": ");
+  json_string(reason);
+  printf("}");
+  fflush(stdout);
+  fprintf(stderr, "  %-28s skipped: %s\n", name, reason);
+}
+
+void bench_run(const BenchOptions *opts, const char *name, const char *unit,
+               BenchFn fn, void *ctx) {
+  AsyncBenchRun *samples =
+      safe_calloc(BENCH_MAX_ITERATIONS, sizeof(AsyncBenchRun));
+  size_t n = 0;
+  uint64_t timed_us = 0;
+  uint64_t deadline = lace_time_us() + (uint64_t)opts->min_ms * 1000;
+
+  /* One untimed pass warms caches and the allocator */
+  BenchIter it = {0};
+  bool ok = fn(ctx, &it);
+
+  while (ok && n < BENCH_MAX_ITERATIONS &&
+         (n < BENCH_MIN_ITERATIONS || lace_time_us() < deadline)) {
+    memset(&it, 0, sizeof(it));
+    uint64_t started = lace_time_us();
+    if (!fn(ctx, &it))
+      break;
+    uint64_t elapsed = it.timed_us ? it.timed_us : lace_time_us() - started;
+
+    AsyncBenchRun *s = &samples[n++];
+    s->started_us = started;
+    s->elapsed_us = elapsed;
+    s->rows = it.items;
+    s->stats.bytes = it.bytes;
+    s->stats.server_us = it.server_us;
+    s->stats.decode_us = it.decode_us;
+    timed_us += elapsed;
+  }
+
+  if (n == 0) {
+    bench_skip(name, ok ? "no iterations" : "first iteration failed");
+    free(samples);
+    return;
+  }
+
+  BenchSummary sum;
+  bench_summarize(samples, n, &sum);
+  free(samples);
+
+  /* Rates over the timed work only, not the runner's gaps */
+  double secs = timed_us > 0 ? (double)timed_us / 1e6 : 1e-6;
+  double items_per_sec = (double)sum.rows / secs;
+
+  result_begin(name);
+  printf(", \"unit\": ");
+  json_string(unit);
+  printf(", \"iterations\": %zu, \"%s_per_iter\": %.1f", sum.runs, unit,
+         (double)sum.rows / (double)sum.runs);
+  printf(", \"min_us\": %llu, \"p50_us\": %llu, \"p95_us\": %llu"
+         ", \"p99_us\": %llu, \"max_us\": %llu, \"mean_us\": %llu",
+         (unsigned long long)sum.min_us, (unsigned long long)sum.p50_us,
+         (unsigned long long)sum.p95_us, (unsigned long long)sum.p99_us,
+         (unsigned long long)sum.max_us, (unsigned long long)sum.mean_us);
+  printf(", \"%s_per_sec\": %.0f", unit, items_per_sec);
+  if (sum.bytes > 0)
+    printf(", \"bytes_per_sec\": %.0f", (double)sum.bytes / secs);
+  if (sum.server_us > 0 || sum.decode_us > 0)
+    printf(", \"server_us\": %llu, \"decode_us\": %llu",
+           (unsigned long long)sum.server_us,
+           (unsigned long long)sum.decode_us);
+  printf("}");
+  fflush(stdout);
+
+  fprintf(stderr, "  %-28s p50 %8lluus  %12.0f %s/s\n", name,
+          (unsigned long long)sum.p50_us, items_per_sec, unit);
+}
+
+static void print_usage(const char *prog) {
+  fprintf(stderr,
+          "Usage: %s [options]\n"
+          "  --fixture PATH  SQLite fixture to generate "
+          "(default: lace-bench.db)\n"
+          "  --rows N        Rows in the fixture (default: %d)\n"
+          "  --min-ms N      Minimum time per benchmark (default: %d)\n"
+          "Results are written to stdout as JSON, progress to stderr.\n",
+          prog, BENCH_DEFAULT_ROWS, BENCH_DEFAULT_MIN_MS);
+}
+
+int main(int argc, char **argv) {
+  BenchOptions opts = {"lace-bench.db", BENCH_DEFAULT_ROWS,
+                       BENCH_DEFAULT_MIN_MS};
+
+  for (int i = 1; i < argc; i++) {
+    const char *arg = argv[i];
+    const char *val = i + 1 < argc ? argv[i + 1] : NULL;
+    int64_t num;
+    if (str_eq(arg, "--fixture") && val) {
+      opts.fixture = val;
+      i++;
+    } else if (str_eq(arg, "--rows") && val && str_to_int64(val, &num) &&
+               num > 0) {
+      opts.rows = (size_t)num;
+      i++;
+    } else if (str_eq(arg, "--min-ms") && val && str_to_int64(val, &num) &&
+               num > 0 && num <= 600000) {
+      opts.min_ms = (unsigned)num;
+      i++;
+    } else {
+      print_usage(argv[0]);
+      return 1;
+    }
+  }
+
+  db_init();
+
+  fprintf(stderr, "Generating %s (%zu rows)...\n", opts.fixture, opts.rows);
+  char *err = NULL;
+  if (!bench_fixture_create(opts.fixture, opts.rows, &err)) {
+    fprintf(stderr, "Fixture failed: %s\n", err ? err : "unknown error");
+    free(err);
+    db_cleanup();
+    return 1;
+  }
+
+  char stamp[32];
+  time_t now = time(NULL);
+  strftime(stamp, sizeof(stamp), "%Y-%m-%dT%H:%M:%SZ", gmtime(&now));
+
+  printf("{\n  \"timestamp\": \"%s\",\n  \"fixture\": {\"path\": ", stamp);
+  json_string(opts.fixture);
+  printf(", \"rows\": %zu},\n  \"min_ms\": %u,\n  \"results\": [",
+         opts.rows, opts.min_ms);
+
+  bench_suite_data(&opts);
+  bench_suite_tui(&opts);
+
+  printf("\n  ]\n}\n");
+  db_cleanup();
+  return 0;
+}
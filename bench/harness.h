@@ -0,0 +1,61 @@
+/*
+ * Lace
+ * Benchmark harness - shared runner for the `make bench` suites
+ *
+ * Each benchmark is a function doing one timed iteration of work and
+ * returning how many items (rows, cells, calls) it processed. The runner
+ * repeats it until a minimum time has passed and prints one JSON object
+ * per benchmark; lace-bench wraps them in a single document.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_BENCH_HARNESS_H
+#define LACE_BENCH_HARNESS_H
+
+#include "../src/db/db.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Table every suite reads */
+#define BENCH_TABLE "items"
+
+/* Run options */
+typedef struct {
+  const char *fixture; /* Path of the generated SQLite database */
+  size_t rows;         /* Rows in the fixture table */
+  unsigned min_ms;     /* Time each benchmark runs for, at least */
+} BenchOptions;
+
+/* What one iteration did; bytes and the time split are optional */
+typedef struct {
+  size_t items;
+  size_t bytes;
+  uint64_t server_us; /* From DbQueryStats, when the iteration queried */
+  uint64_t decode_us;
+  uint64_t timed_us; /* Set by iterations that time only part of their work */
+} BenchIter;
+
+/* One iteration. Returns false once the work is exhausted or failed: that
+ * iteration is dropped and the benchmark ends. */
+typedef bool (*BenchFn)(void *ctx, BenchIter *it);
+
+/* Run fn until opts->min_ms passed (and at least a few iterations), then
+ * print its results. unit names what items counts. */
+void bench_run(const BenchOptions *opts, const char *name, const char *unit,
+               BenchFn fn, void *ctx);
+
+/* Print a benchmark that could not run, with the reason */
+void bench_skip(const char *name, const char *reason);
+
+/* Write the fixture: BENCH_TABLE with rows rows of mixed types. Returns
+ * false with *err set on failure. */
+bool bench_fixture_create(const char *path, size_t rows, char **err);
+
+/* Suites */
+void bench_suite_data(const BenchOptions *opts);
+void bench_suite_tui(const BenchOptions *opts);
+
+#endif /* LACE_BENCH_HARNESS_H */
@@ -0,0 +1,160 @@
+/*
+ * Lace
+ * Benchmark suite - table tab on an off-screen terminal
+ *
+ * Opens the fixture in a real table tab drawn into an ncurses screen that
+ * writes to /dev/null, then measures what scrolling costs the TUI: column
+ * width statistics, merging fetched pages into the window and trimming it,
+ * and painting the grid.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "harness.h"
+#include "../src/config/config.h"
+#include "../src/core/history.h"
+#include "../src/db/connstr.h"
+#include "../src/tui/ncurses/tui_internal.h"
+#include "../src/util/str.h"
+#include <stdio.h>
+#include <stdlib.h>
+
+/* Off-screen terminal size */
+#define TUI_BENCH_LINES "50"
+#define TUI_BENCH_COLS "200"
+
+typedef struct {
+  TuiState *state;
+  size_t frame; /* Frames drawn by the scroll benchmark */
+} TuiCtx;
+
+static void set_cursor(TuiState *state, Tab *tab, size_t row) {
+  size_t visible = state->content_rows > 4 ? state->content_rows - 4 : 1;
+  tab->cursor_row = row;
+  tab->scroll_row = row >= visible ? row - visible + 1 : 0;
+  VmTable *vm = tui_vm_table(state);
+  if (vm) {
+    vm_table_set_cursor(vm, tab->cursor_row, tab->cursor_col);
+    vm_table_set_scroll(vm, tab->scroll_row, tab->scroll_col);
+  }
+}
+
+static bool bench_column_widths(void *ctx, BenchIter *it) {
+  TuiCtx *c = ctx;
+  Tab *tab = TUI_TAB(c->state);
+  tui_calculate_column_widths(c->state);
+  it->items = tab->data->num_rows;
+  return true;
+}
+
+/* One forward page: fetched untimed, then merged and trimmed (timed) the
+ * way the main loop finishes a background load */
+static bool bench_page_merge(void *ctx, BenchIter *it) {
+  TuiCtx *c = ctx;
+  TuiState *state = c->state;
+  Tab *tab = TUI_TAB(state);
+
+  /* Start over at the top once the table is scrolled through */
+  if (tab->loaded_offset + tab->loaded_count >= tab->total_rows) {
+    if (!tui_load_rows_at(state, 0))
+      return false;
+  }
+  set_cursor(state, tab, tab->data->num_rows - 1);
+
+  if (!tui_start_background_load(state, true))
+    return false;
+  AsyncOperation *op = tab->bg_load_op;
+  while (async_poll(op) == ASYNC_STATE_RUNNING)
+    async_wait(op, POLL_INTERVAL_MS);
+
+  size_t end = tab->loaded_offset + tab->loaded_count;
+  uint64_t started = lace_time_us();
+  tui_poll_background_load(state);
+  it->timed_us = lace_time_us() - started;
+  if (it->timed_us == 0)
+    it->timed_us = 1;
+  it->items = tab->loaded_offset + tab->loaded_count - end;
+  return it->items > 0;
+}
+
+static bool bench_redraw(void *ctx, BenchIter *it) {
+  TuiCtx *c = ctx;
+  tui_refresh(c->state);
+  it->items = 1;
+  return true;
+}
+
+/* Cursor down one row per frame, repainting only what changed */
+static bool bench_scroll(void *ctx, BenchIter *it) {
+  TuiCtx *c = ctx;
+  Tab *tab = TUI_TAB(c->state);
+  set_cursor(c->state, tab, c->frame++ % tab->data->num_rows);
+  tui_refresh_damaged(c->state);
+  it->items = 1;
+  return true;
+}
+
+/* Defaults, so results don't depend on the user's configuration */
+static void use_default_config(AppState *app) {
+  config_free(app->config);
+  app->config = config_get_defaults();
+  app->config->general.restore_session = false;
+  app->config->general.auto_open_first_table = true;
+  app->config->general.history_mode = HISTORY_MODE_OFF;
+}
+
+void bench_suite_tui(const BenchOptions *opts) {
+  setenv("LINES", TUI_BENCH_LINES, 1);
+  setenv("COLUMNS", TUI_BENCH_COLS, 1);
+  FILE *out = fopen("/dev/null", "w");
+  FILE *in = fopen("/dev/null", "r");
+  const char *term = getenv("TERM");
+  if (!term || !*term || str_eq(term, "dumb"))
+    term = "xterm-256color";
+  SCREEN *screen = out && in ? newterm(term, out, in) : NULL;
+  if (!screen && out && in)
+    screen = newterm("xterm", out, in);
+  if (!screen) {
+    bench_skip("tui", "cannot open an off-screen terminal");
+    if (out)
+      fclose(out);
+    if (in)
+      fclose(in);
+    return;
+  }
+  set_term(screen);
+
+  AppState app;
+  TuiState state;
+  app_state_init(&app);
+  use_default_config(&app);
+
+  char *err = NULL;
+  char *connstr = connstr_from_path(opts->fixture, &err);
+  Tab *tab = NULL;
+  if (tui_init(&state, &app) && connstr && tui_connect(&state, connstr))
+    tab = TUI_TAB(&state);
+  free(connstr);
+  free(err);
+
+  if (tab && tab->data && tab->data->num_rows > 0) {
+    TuiCtx c = {&state, 0};
+    bench_run(opts, "tui_calculate_column_widths", "rows", bench_column_widths,
+              &c);
+    bench_run(opts, "merge_page_result+trim", "rows", bench_page_merge, &c);
+
+    tui_load_rows_at(&state, 0);
+    set_cursor(&state, tab, 0);
+    bench_run(opts, "grid_redraw", "frames", bench_redraw, &c);
+    bench_run(opts, "grid_scroll", "frames", bench_scroll, &c);
+  } else {
+    bench_skip("tui", "fixture table did not open");
+  }
+
+  tui_cleanup(&state);
+  app_state_cleanup(&app);
+  delscreen(screen);
+  fclose(out);
+  fclose(in);
+}
@@ -12,6 +12,43 @@
 #include <stdlib.h>
 #include <string.h>
 
+/* ASYNC_OP_SCRIPT progress: publish it, and stop once cancelled */
+static bool async_script_progress(void *ctx, size_t done) {
+  AsyncOperation *op = ctx;
+  lace_mutex_lock(&op->mutex);
+  op->count = (int64_t)done;
+  bool go = !op->cancel_requested;
+  lace_mutex_unlock(&op->mutex);
+  return go;
+}
+
+/* Open the private connection of ASYNC_OP_QUERY_PRIVATE (or a private
+ * ASYNC_OP_CURSOR_OPEN) and publish it so async_cancel can interrupt what
+ * runs on it */
+static DbConnection *private_connect(AsyncOperation *op, char **err) {
+  DbConnection *own = db_connect(op->connstr, err);
+  if (!own)
+    return NULL;
+
+  lace_mutex_lock(&op->mutex);
+  op->conn = own;
+  if (own->driver && own->driver->prepare_cancel)
+    op->cancel_handle = own->driver->prepare_cancel(own);
+  lace_mutex_unlock(&op->mutex);
+  return own;
+}
+
+/* Withdraw the private connection from cancellation before it is closed
+ * or handed over with the result */
+static void private_detach(AsyncOperation *op, DbConnection *own) {
+  lace_mutex_lock(&op->mutex);
+  if (op->cancel_handle && own->driver && own->driver->free_cancel_handle)
+    own->driver->free_cancel_handle(op->cancel_handle);
+  op->cancel_handle = NULL;
+  op->conn = NULL;
+  lace_mutex_unlock(&op->mutex);
+}
+
 /* Worker thread function */
 static void *async_worker_thread(void *arg) {
   AsyncOperation *op = (AsyncOperation *)arg;
@@ -48,9 +85,9 @@ static void *async_worker_thread(void *arg) {
     break;
 
   case ASYNC_OP_QUERY_PAGE_WHERE:
-    op->result =
-        db_query_page_where(op->conn, op->table_name, op->offset, op->limit,
-                            op->where_clause, op->order_by, op->desc, &err);
+    op->result = db_query_page_where_params(
+        op->conn, op->table_name, op->offset, op->limit, op->where_clause,
+        op->params, op->num_params, op->order_by, op->desc, &err);
     break;
 
   case ASYNC_OP_COUNT_ROWS:
@@ -81,8 +118,9 @@ static void *async_worker_thread(void *arg) {
     break;
 
   case ASYNC_OP_COUNT_ROWS_WHERE:
-    op->count =
-        db_count_rows_where(op->conn, op->table_name, op->where_clause, &err);
+    op->count = db_count_rows_where_params(op->conn, op->table_name,
+                                           op->where_clause, op->params,
+                                           op->num_params, &err);
     op->is_approximate = false; /* WHERE counts are always exact */
     break;
 
@@ -93,6 +131,102 @@ static void *async_worker_thread(void *arg) {
   case ASYNC_OP_EXEC:
     op->count = db_exec(op->conn, op->sql, &err);
     break;
+
+  case ASYNC_OP_EXEC_TRANSACTION: {
+    DbTransaction txn = db_transaction_begin(op->conn, &err);
+    if (!err) {
+      op->count = db_exec(op->conn, op->sql, &err);
+      /* A cancel that lands after the statement finished still rolls back */
+      lace_mutex_lock(&op->mutex);
+      bool cancelled = op->cancel_requested;
+      lace_mutex_unlock(&op->mutex);
+      if (op->count >= 0 && !cancelled)
+        db_transaction_commit(&txn, &err);
+    }
+    db_transaction_end(&txn);
+    break;
+  }
+
+  case ASYNC_OP_QUERY_PRIVATE: {
+    DbConnection *own = private_connect(op, &err);
+    if (!own)
+      break;
+    if (!op->cancel_requested)
+      op->result = db_query(own, op->sql, &err);
+    private_detach(op, own);
+    db_disconnect(own);
+    break;
+  }
+
+  case ASYNC_OP_CURSOR_OPEN: {
+    /* With connstr set the cursor gets a connection of its own */
+    DbConnection *own = NULL;
+    if (op->connstr) {
+      own = private_connect(op, &err);
+      if (!own)
+        break;
+    }
+    DbCursor *cur = NULL;
+    if (!op->cancel_requested)
+      cur = db_cursor_open(op->conn, op->sql, &err);
+    if (cur)
+      op->count = (int64_t)cur->num_rows;
+    if (own) {
+      private_detach(op, own);
+      if (cur)
+        cur->owns_conn = true;
+      else
+        db_disconnect(own);
+    }
+    op->result = cur;
+    break;
+  }
+
+  case ASYNC_OP_CURSOR_FETCH:
+    op->result = db_cursor_fetch(op->cursor, op->offset, op->limit, &err);
+    break;
+
+  case ASYNC_OP_BENCHMARK: {
+    AsyncBenchRun *runs =
+        calloc(op->limit ? op->limit : 1, sizeof(AsyncBenchRun));
+    if (!runs) {
+      err = str_dup("Memory allocation failed");
+      break;
+    }
+    op->result = runs;
+
+    bool was_measuring = op->conn->measure_queries;
+    op->conn->measure_queries = true;
+    size_t total = op->offset + op->limit;
+    for (size_t i = 0; i < total && !op->cancel_requested; i++) {
+      uint64_t run_started = lace_time_us();
+      ResultSet *rs = db_query(op->conn, op->sql, &err);
+      uint64_t run_ended = lace_time_us();
+      if (!rs)
+        break;
+
+      lace_mutex_lock(&op->mutex);
+      if (i >= op->offset) {
+        AsyncBenchRun *run = &runs[i - op->offset];
+        run->started_us = run_started;
+        run->elapsed_us = run_ended - run_started;
+        run->stats = op->conn->last_stats;
+        run->rows = rs->num_rows;
+        op->result_count = i - op->offset + 1;
+      }
+      op->count = (int64_t)i + 1;
+      lace_mutex_unlock(&op->mutex);
+      db_result_free(rs);
+    }
+    op->conn->measure_queries = was_measuring;
+    break;
+  }
+
+  case ASYNC_OP_SCRIPT:
+    op->script->progress = async_script_progress;
+    op->script->progress_ctx = op;
+    db_exec_script(op->conn, op->script, &err);
+    break;
   }
 
   /* Update state and signal completion */
@@ -110,8 +244,10 @@ static void *async_worker_thread(void *arg) {
     if (op->result) {
       switch (op->op_type) {
       case ASYNC_OP_QUERY:
+      case ASYNC_OP_QUERY_PRIVATE:
       case ASYNC_OP_QUERY_PAGE:
       case ASYNC_OP_QUERY_PAGE_WHERE:
+      case ASYNC_OP_CURSOR_FETCH:
         db_result_free(op->result);
         break;
       case ASYNC_OP_GET_SCHEMA:
@@ -130,6 +266,12 @@ static void *async_worker_thread(void *arg) {
           db_disconnect(op->result);
         }
         break;
+      case ASYNC_OP_CURSOR_OPEN:
+        db_cursor_close(op->result);
+        break;
+      case ASYNC_OP_BENCHMARK:
+        free(op->result);
+        break;
       default:
         break;
       }
@@ -165,7 +307,9 @@ bool async_start(AsyncOperation *op) {
     lace_mutex_destroy(&op->mutex);
     return false;
   }
-  op->state = ASYNC_STATE_IDLE;
+  /* Report RUNNING from the start: pollers treat anything else as finished
+   * and would free the operation before the worker thread got to it */
+  op->state = ASYNC_STATE_RUNNING;
   op->cancel_requested = false;
   op->cancel_handle = NULL;
 
@@ -177,6 +321,7 @@ bool async_start(AsyncOperation *op) {
 
   lace_thread_t thread;
   if (!lace_thread_create(&thread, &attr, async_worker_thread, op)) {
+    op->state = ASYNC_STATE_IDLE;
     lace_mutex_destroy(&op->mutex);
     lace_cond_destroy(&op->cond);
     return false;
@@ -256,6 +401,9 @@ void async_free(AsyncOperation *op) {
   free(op->where_clause);
   op->where_clause = NULL;
 
+  FREE_ARRAY(op->params, op->num_params, db_value_free);
+  op->num_params = 0;
+
   free(op->order_by);
   op->order_by = NULL;
 
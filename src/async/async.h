@@ -25,7 +25,24 @@ typedef enum {
   ASYNC_OP_COUNT_ROWS,
   ASYNC_OP_COUNT_ROWS_WHERE,
   ASYNC_OP_QUERY,
-  ASYNC_OP_EXEC
+  ASYNC_OP_EXEC,
+  ASYNC_OP_EXEC_TRANSACTION, /* sql in its own transaction, rolled back on
+                                error or cancel */
+  ASYNC_OP_QUERY_PRIVATE,    /* sql on a connection of its own opened from
+                                connstr, so a long scan does not hold the
+                                shared one */
+  ASYNC_OP_CURSOR_OPEN,      /* Server-side cursor over sql: result is a
+                                DbCursor*, count its row count. With
+                                connstr set instead of conn it runs on a
+                                connection of its own, which the cursor
+                                owns */
+  ASYNC_OP_CURSOR_FETCH,     /* limit rows of cursor from offset */
+  ASYNC_OP_BENCHMARK,        /* sql offset times unmeasured, then limit
+                                times measured: result is limit
+                                AsyncBenchRun, result_count how many of
+                                them are filled, count runs done so far */
+  ASYNC_OP_SCRIPT            /* db_exec_script(script): count statements
+                                finished so far */
 } AsyncOpType;
 
 /* Operation states */
@@ -37,6 +54,14 @@ typedef enum {
   ASYNC_STATE_ERROR
 } AsyncState;
 
+/* One measured run of ASYNC_OP_BENCHMARK */
+typedef struct {
+  uint64_t started_us; /* lace_time_us() when the run started */
+  uint64_t elapsed_us; /* The whole query call */
+  DbQueryStats stats;  /* Its server/decode split and bytes */
+  size_t rows;
+} AsyncBenchRun;
+
 /* Async operation structure */
 typedef struct {
   AsyncOpType op_type;
@@ -48,11 +73,15 @@ typedef struct {
   char *table_name;
   char *sql;
   char *where_clause;
+  DbValue *params;   /* Bound into where_clause's placeholders (owned) */
+  size_t num_params;
   char *order_by;
   size_t offset;
   size_t limit;
   bool desc;
   bool use_approximate;
+  DbCursor *cursor; /* For ASYNC_OP_CURSOR_FETCH (not owned) */
+  DbScript *script; /* For ASYNC_OP_SCRIPT (not owned) */
 
   /* Output results (set by worker thread) */
   void *result;        /* ResultSet*, TableSchema*, DbConnection*, char** */
@@ -48,6 +48,8 @@ static const char *def_page_down[] = {"PGDN"};
 static const char *def_first_row[] = {"g", "a"};
 static const char *def_last_row[] = {"G", "z"};
 static const char *def_goto_row[] = {"CTRL+G", "F5"};
+static const char *def_find[] = {"CTRL+F"};
+static const char *def_find_next[] = {"F8"};
 static const char *def_first_col[] = {"HOME"};
 static const char *def_last_col[] = {"END"};
 
@@ -61,6 +63,8 @@ static const char *def_toggle_filters[] = {"f", "/"};
 static const char *def_toggle_sidebar[] = {"t", "F9"};
 static const char *def_show_schema[] = {"s", "F3"};
 static const char *def_refresh[] = {"r"};
+static const char *def_toggle_watch[] = {"W"};
+static const char *def_live_trigger[] = {"L"};
 static const char *def_cycle_sort[] = {"o"};
 static const char *def_cell_copy[] = {"c", "CTRL+K"};
 static const char *def_cell_paste[] = {"v", "CTRL+U"};
@@ -88,6 +92,9 @@ static const char *def_execute_query[] = {"CTRL+R"};
 static const char *def_execute_all[] = {"CTRL+A"};
 static const char *def_execute_transaction[] = {"CTRL+T"};
 static const char *def_query_switch_focus[] = {"CTRL+W", "ESCAPE"};
+static const char *def_explain_query[] = {"CTRL+P", "F12"};
+static const char *def_benchmark_query[] = {"CTRL+B"};
+static const char *def_cancel_query[] = {"CTRL+O"};
 
 /* Filters Panel */
 static const char *def_add_filter[] = {"+", "=", "INSERT"};
@@ -110,6 +117,7 @@ static const char *def_conn_rename[] = {"r"};
 /* Row Selection */
 static const char *def_toggle_selection[] = {"SPACE"};
 static const char *def_clear_selections[] = {"ESCAPE"};
+static const char *def_select_all[] = {"*"};
 
 /* Row Add */
 static const char *def_row_add[] = {"+", "=", "INSERT"};
@@ -156,6 +164,10 @@ static const ActionMeta action_meta[HOTKEY_COUNT] = {
                          DEF_KEYS(def_last_row)},
     [HOTKEY_GOTO_ROW] = {"goto_row", "Go to row", HOTKEY_CAT_NAVIGATION,
                          DEF_KEYS(def_goto_row)},
+    [HOTKEY_FIND] = {"find", "Find in grid", HOTKEY_CAT_NAVIGATION,
+                     DEF_KEYS(def_find)},
+    [HOTKEY_FIND_NEXT] = {"find_next", "Find next", HOTKEY_CAT_NAVIGATION,
+                          DEF_KEYS(def_find_next)},
     [HOTKEY_FIRST_COL] = {"first_col", "First column", HOTKEY_CAT_NAVIGATION,
                           DEF_KEYS(def_first_col)},
     [HOTKEY_LAST_COL] = {"last_col", "Last column", HOTKEY_CAT_NAVIGATION,
@@ -180,6 +192,10 @@ static const ActionMeta action_meta[HOTKEY_COUNT] = {
                             DEF_KEYS(def_show_schema)},
     [HOTKEY_REFRESH] = {"refresh", "Refresh", HOTKEY_CAT_TABLE,
                         DEF_KEYS(def_refresh)},
+    [HOTKEY_TOGGLE_WATCH] = {"toggle_watch", "Watch for changes",
+                             HOTKEY_CAT_TABLE, DEF_KEYS(def_toggle_watch)},
+    [HOTKEY_LIVE_TRIGGER] = {"live_trigger", "Live update trigger SQL",
+                             HOTKEY_CAT_TABLE, DEF_KEYS(def_live_trigger)},
     [HOTKEY_CYCLE_SORT] = {"cycle_sort", "Cycle sort", HOTKEY_CAT_TABLE,
                            DEF_KEYS(def_cycle_sort)},
     [HOTKEY_CELL_COPY] = {"cell_copy", "Copy cell", HOTKEY_CAT_TABLE,
@@ -234,6 +250,13 @@ static const ActionMeta action_meta[HOTKEY_COUNT] = {
     [HOTKEY_QUERY_SWITCH_FOCUS] = {"query_switch_focus",
                                    "Switch editor/results", HOTKEY_CAT_QUERY,
                                    DEF_KEYS(def_query_switch_focus)},
+    [HOTKEY_EXPLAIN_QUERY] = {"explain_query", "Explain query plan",
+                              HOTKEY_CAT_QUERY, DEF_KEYS(def_explain_query)},
+    [HOTKEY_BENCHMARK_QUERY] = {"benchmark_query", "Benchmark query",
+                                HOTKEY_CAT_QUERY,
+                                DEF_KEYS(def_benchmark_query)},
+    [HOTKEY_CANCEL_QUERY] = {"cancel_query", "Cancel running query",
+                             HOTKEY_CAT_QUERY, DEF_KEYS(def_cancel_query)},
 
     /* Filters Panel */
     [HOTKEY_ADD_FILTER] = {"add_filter", "Add filter", HOTKEY_CAT_FILTERS,
@@ -277,6 +300,8 @@ static const ActionMeta action_meta[HOTKEY_COUNT] = {
     [HOTKEY_CLEAR_SELECTIONS] = {"clear_selections", "Clear selections",
                                  HOTKEY_CAT_TABLE,
                                  DEF_KEYS(def_clear_selections)},
+    [HOTKEY_SELECT_ALL] = {"select_all", "Select all matching rows",
+                           HOTKEY_CAT_TABLE, DEF_KEYS(def_select_all)},
 
     /* Row Add (Table category) */
     [HOTKEY_ROW_ADD] = {"row_add", "Add new row", HOTKEY_CAT_TABLE,
@@ -538,7 +563,12 @@ Config *config_get_defaults(void) {
   config->general.restore_session = true;
   config->general.quit_confirmation = false;
   config->general.delete_confirmation = true; /* Default: ask before delete */
+  config->general.script_stop_on_error = true;
   config->general.max_result_rows = CONFIG_MAX_RESULT_ROWS_DEFAULT;
+  config->general.memory_budget_mb = CONFIG_MEMORY_BUDGET_MB_DEFAULT;
+  config->general.query_cache_mb = CONFIG_QUERY_CACHE_MB_DEFAULT;
+  config->general.watch_interval_sec = CONFIG_WATCH_INTERVAL_SEC_DEFAULT;
+  config->general.live_updates = false;
   config->general.auto_open_first_table = false;
   config->general.close_conn_on_last_tab = false;
   config->general.history_mode =
@@ -748,6 +778,8 @@ Config *config_load(char **error) {
         json_get_bool(general, "quit_confirmation", config->general.quit_confirmation);
     config->general.delete_confirmation =
         json_get_bool(general, "delete_confirmation", config->general.delete_confirmation);
+    config->general.script_stop_on_error =
+        json_get_bool(general, "script_stop_on_error", config->general.script_stop_on_error);
     config->general.auto_open_first_table =
         json_get_bool(general, "auto_open_first_table", config->general.auto_open_first_table);
     config->general.close_conn_on_last_tab =
@@ -766,6 +798,23 @@ Config *config_load(char **error) {
     if (val >= CONFIG_MAX_RESULT_ROWS_MIN && val <= CONFIG_MAX_RESULT_ROWS_MAX)
       config->general.max_result_rows = val;
 
+    val = json_get_int(general, "memory_budget_mb", config->general.memory_budget_mb);
+    if (val >= CONFIG_MEMORY_BUDGET_MB_MIN && val <= CONFIG_MEMORY_BUDGET_MB_MAX)
+      config->general.memory_budget_mb = val;
+
+    val = json_get_int(general, "query_cache_mb", config->general.query_cache_mb);
+    if (val >= CONFIG_QUERY_CACHE_MB_MIN && val <= CONFIG_QUERY_CACHE_MB_MAX)
+      config->general.query_cache_mb = val;
+
+    val = json_get_int(general, "watch_interval_sec",
+                       config->general.watch_interval_sec);
+    if (val >= CONFIG_WATCH_INTERVAL_SEC_MIN &&
+        val <= CONFIG_WATCH_INTERVAL_SEC_MAX)
+      config->general.watch_interval_sec = val;
+
+    config->general.live_updates =
+        json_get_bool(general, "live_updates", config->general.live_updates);
+
     val = json_get_int(general, "history_mode", config->general.history_mode);
     if (val >= HISTORY_MODE_OFF && val <= HISTORY_MODE_PERSISTENT)
       config->general.history_mode = val;
@@ -834,7 +883,13 @@ bool config_save(const Config *config, char **error) {
   JSON_ADD_BOOL(general, "restore_session", config->general.restore_session);
   JSON_ADD_BOOL(general, "quit_confirmation", config->general.quit_confirmation);
   JSON_ADD_BOOL(general, "delete_confirmation", config->general.delete_confirmation);
+  JSON_ADD_BOOL(general, "script_stop_on_error", config->general.script_stop_on_error);
   JSON_ADD_INT(general, "max_result_rows", config->general.max_result_rows);
+  JSON_ADD_INT(general, "memory_budget_mb", config->general.memory_budget_mb);
+  JSON_ADD_INT(general, "query_cache_mb", config->general.query_cache_mb);
+  JSON_ADD_INT(general, "watch_interval_sec",
+               config->general.watch_interval_sec);
+  JSON_ADD_BOOL(general, "live_updates", config->general.live_updates);
   JSON_ADD_BOOL(general, "auto_open_first_table", config->general.auto_open_first_table);
   JSON_ADD_BOOL(general, "close_conn_on_last_tab", config->general.close_conn_on_last_tab);
   JSON_ADD_INT(general, "history_mode", config->general.history_mode);
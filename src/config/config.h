@@ -52,6 +52,8 @@ typedef enum {
   HOTKEY_FIRST_ROW,
   HOTKEY_LAST_ROW,
   HOTKEY_GOTO_ROW,
+  HOTKEY_FIND,
+  HOTKEY_FIND_NEXT,
   HOTKEY_FIRST_COL,
   HOTKEY_LAST_COL,
 
@@ -65,6 +67,8 @@ typedef enum {
   HOTKEY_TOGGLE_SIDEBAR,
   HOTKEY_SHOW_SCHEMA,
   HOTKEY_REFRESH,
+  HOTKEY_TOGGLE_WATCH,
+  HOTKEY_LIVE_TRIGGER,
   HOTKEY_CYCLE_SORT,
   HOTKEY_CELL_COPY,
   HOTKEY_CELL_PASTE,
@@ -92,6 +96,9 @@ typedef enum {
   HOTKEY_EXECUTE_ALL,
   HOTKEY_EXECUTE_TRANSACTION,
   HOTKEY_QUERY_SWITCH_FOCUS,
+  HOTKEY_EXPLAIN_QUERY,
+  HOTKEY_BENCHMARK_QUERY,
+  HOTKEY_CANCEL_QUERY,
 
   /* Filters Panel (HOTKEY_CAT_FILTERS) */
   HOTKEY_ADD_FILTER,
@@ -115,6 +122,7 @@ typedef enum {
   /* Row Selection (HOTKEY_CAT_TABLE) */
   HOTKEY_TOGGLE_SELECTION,
   HOTKEY_CLEAR_SELECTIONS,
+  HOTKEY_SELECT_ALL,
 
   /* Row Add (HOTKEY_CAT_TABLE) */
   HOTKEY_ROW_ADD,
@@ -154,7 +162,12 @@ typedef struct {
   bool restore_cursor_position; /* Restore cursor/scroll on session load */
   bool quit_confirmation;
   bool delete_confirmation;    /* Ask for confirmation before deleting rows */
+  bool script_stop_on_error;   /* Execute all: skip the rest after a failure */
   int max_result_rows;         /* Maximum rows returned by raw SQL queries */
+  int memory_budget_mb;        /* Loaded rows across all tabs (0=unlimited) */
+  int query_cache_mb;          /* Cached query results per connection (0=off) */
+  int watch_interval_sec;      /* Seconds between watch mode probes */
+  bool live_updates;           /* Refresh tabs on other sessions' writes */
   bool auto_open_first_table;  /* Open first table instead of connection tab */
   bool close_conn_on_last_tab; /* Close connection when last tab closes */
   int history_mode;            /* 0=off, 1=session, 2=persistent */
@@ -61,54 +61,13 @@ static size_t json_to_size_t(cJSON *num) {
 /* Note: History recording is now handled automatically by the database layer
  * via the history callback set up in app_add_connection(). */
 
-/* Column width constants (from tui_internal.h) */
-#define SESSION_MIN_COL_WIDTH 4
-#define SESSION_MAX_COL_WIDTH 40
-
 /* Calculate column widths for a Tab based on its data */
 static void calculate_tab_column_widths(Tab *tab) {
   if (!tab || !tab->data)
     return;
 
-  ResultSet *data = tab->data;
-  if (!data->columns || data->num_columns == 0)
-    return;
-
-  free(tab->col_widths);
-  tab->num_col_widths = data->num_columns;
-  tab->col_widths = safe_calloc(tab->num_col_widths, sizeof(int));
-
-  /* Start with column name widths */
-  for (size_t i = 0; i < data->num_columns; i++) {
-    const char *name = data->columns[i].name;
-    int len = name ? (int)strlen(name) : 0;
-    tab->col_widths[i] =
-        len < SESSION_MIN_COL_WIDTH ? SESSION_MIN_COL_WIDTH : len;
-  }
-
-  /* Check data widths (first 100 rows) */
-  for (size_t row = 0; row < data->num_rows && row < 100; row++) {
-    Row *r = &data->rows[row];
-    if (!r->cells)
-      continue;
-    for (size_t col = 0; col < data->num_columns && col < r->num_cells; col++) {
-      char *str = db_value_to_string(&r->cells[col]);
-      if (str) {
-        int len = (int)strlen(str);
-        if (len > tab->col_widths[col]) {
-          tab->col_widths[col] = len;
-        }
-        free(str);
-      }
-    }
-  }
-
-  /* Apply max width */
-  for (size_t i = 0; i < tab->num_col_widths; i++) {
-    if (tab->col_widths[i] > SESSION_MAX_COL_WIDTH) {
-      tab->col_widths[i] = SESSION_MAX_COL_WIDTH;
-    }
-  }
+  col_widths_rebuild(tab->data, &tab->col_stats, &tab->col_widths,
+                     &tab->num_col_widths);
 }
 
 char *session_get_path(void) {
@@ -144,55 +103,6 @@ static const char *find_connection_id_by_connstr(ConnectionManager *mgr,
   return NULL;
 }
 
-/* Build ORDER BY clause from tab's sort entries (caller must free) */
-static char *build_tab_order_clause(Tab *tab, TableSchema *schema,
-                                    const char *driver_name) {
-  if (!tab || tab->num_sort_entries == 0 || !schema || !driver_name)
-    return NULL;
-
-  /* Determine quote character based on driver */
-  bool use_backtick = (strcmp(driver_name, "mysql") == 0 ||
-                       strcmp(driver_name, "mariadb") == 0);
-
-  /* Build ORDER BY clause */
-  StringBuilder *sb = sb_new(128);
-  if (!sb)
-    return NULL;
-
-  bool first_added = false;
-  for (size_t i = 0; i < tab->num_sort_entries; i++) {
-    SortEntry *entry = &tab->sort_entries[i];
-    if (entry->column >= schema->num_columns)
-      continue;
-
-    const char *col_name = schema->columns[entry->column].name;
-    if (!col_name)
-      continue;
-
-    /* Escape column name */
-    char *escaped = use_backtick ? str_escape_identifier_backtick(col_name)
-                                 : str_escape_identifier_dquote(col_name);
-    if (!escaped) {
-      sb_free(sb);
-      return NULL;
-    }
-
-    /* Add separator if not first valid entry */
-    if (first_added) {
-      sb_append(sb, ", ");
-    }
-    first_added = true;
-
-    /* Add column with direction */
-    sb_printf(sb, "%s %s", escaped,
-              entry->direction == SORT_ASC ? "ASC" : "DESC");
-    free(escaped);
-  }
-
-  char *result = sb_to_string(sb);
-  return result;
-}
-
 /* ============================================================================
  * Session Free
  * ============================================================================
@@ -266,7 +176,7 @@ static cJSON *serialize_filter(const ColumnFilter *f,
 
   JSON_ADD_STR(json, "column", col_name);
   JSON_ADD_INT(json, "op", (int)f->op);
-  JSON_ADD_STR(json, "value", f->value);
+  JSON_ADD_STR(json, "value", filter_value(f));
 
   return json;
 }
@@ -1210,11 +1120,10 @@ static bool restore_tab(TuiState *state, SessionTab *stab, size_t conn_idx,
       }
     }
 
-    /* Build ORDER BY clause from restored sort entries */
+    /* Build ORDER BY clause from restored sort entries and the primary key */
     char *order_by = NULL;
     if (tab->schema && conn->conn->driver) {
-      order_by =
-          build_tab_order_clause(tab, tab->schema, conn->conn->driver->name);
+      order_by = tab_build_order_clause(tab, conn->conn->driver->name);
     }
 
     /* Load data at the calculated offset (near saved cursor position) */
@@ -1238,10 +1147,10 @@ static bool restore_tab(TuiState *state, SessionTab *stab, size_t conn_idx,
     if (err) {
       free(err);
     }
-
     if (tab->data) {
       tab->loaded_offset = load_offset;
       tab->loaded_count = tab->data->num_rows;
+      tab_record_data_filters(tab); /* Rows were fetched with these */
 
       /* Calculate column widths based on loaded data */
       calculate_tab_column_widths(tab);
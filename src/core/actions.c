@@ -204,6 +204,14 @@ static ChangeFlags handle_rows_clear_select(AppState *app,
   return CHANGED_DATA;
 }
 
+static ChangeFlags handle_rows_select_all(AppState *app,
+                                          const UICallbacks *ui) {
+  VALIDATE_TABLE_EDIT(app, ui);
+
+  tab_select_all(tab);
+  return CHANGED_DATA | CHANGED_STATUS;
+}
+
 /* ============================================================================
  * Tab Actions (switch tabs within current workspace)
  * ============================================================================
@@ -509,6 +517,8 @@ ChangeFlags app_dispatch(AppState *app, const Action *action,
     return handle_row_toggle_select(app, ui);
   case ACTION_ROWS_CLEAR_SELECT:
     return handle_rows_clear_select(app, ui);
+  case ACTION_ROWS_SELECT_ALL:
+    return handle_rows_select_all(app, ui);
 
   /* Tabs - switch within current workspace */
   case ACTION_TAB_NEXT:
@@ -87,6 +87,7 @@ typedef enum {
   ACTION_ROW_DELETE,        /* Delete current row */
   ACTION_ROW_TOGGLE_SELECT, /* Toggle selection of current row */
   ACTION_ROWS_CLEAR_SELECT, /* Clear all row selections */
+  ACTION_ROWS_SELECT_ALL,   /* Select all rows matching current filters */
 
   /* Tab Management (within current workspace) */
   ACTION_TAB_NEXT,         /* Switch to next tab */
@@ -455,6 +456,10 @@ static inline Action action_rows_clear_select(void) {
   return (Action){.type = ACTION_ROWS_CLEAR_SELECT};
 }
 
+static inline Action action_rows_select_all(void) {
+  return (Action){.type = ACTION_ROWS_SELECT_ALL};
+}
+
 /* Tabs (within workspace) */
 static inline Action action_tab_next(void) {
   return (Action){.type = ACTION_TAB_NEXT};
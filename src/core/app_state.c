@@ -9,6 +9,7 @@
 #include "app_state.h"
 #include "../async/async.h"
 #include "../db/db.h"
+#include "../db/sql_lexer.h"
 #include "../util/mem.h"
 #include "../util/str.h"
 #include "history.h"
@@ -32,7 +33,18 @@ typedef struct {
 /* Callback function invoked by db_query/db_exec after successful queries */
 static void history_callback(void *context, const char *sql, int type) {
   HistoryCallbackContext *ctx = (HistoryCallbackContext *)context;
-  if (!ctx || !ctx->conn || !ctx->conn->history || !sql || !sql[0])
+  if (!ctx || !ctx->conn || !sql || !sql[0])
+    return;
+
+  /* A write through this connection may change any cached result; the
+   * data version probe doesn't see a connection's own writes on SQLite */
+  if (!result_cache_sql_is_read(sql))
+    result_cache_clear(ctx->conn->result_cache);
+
+  if (sql_changes_session(sql))
+    ctx->conn->session_bound = true;
+
+  if (!ctx->conn->history)
     return;
 
   /* Use auto-detect if type is DB_HISTORY_AUTO */
@@ -85,6 +97,14 @@ static bool app_ensure_connection_capacity(AppState *app) {
   memset(&app->connections[app->connection_capacity], 0,
          (new_capacity - app->connection_capacity) * sizeof(Connection));
 
+  /* History callbacks hold their connection's address: follow the move */
+  for (size_t i = 0; i < app->num_connections; i++) {
+    DbConnection *db_conn = app->connections[i].conn;
+    if (db_conn && db_conn->history_callback == history_callback)
+      ((HistoryCallbackContext *)db_conn->history_context)->conn =
+          &app->connections[i];
+  }
+
   app->connection_capacity = new_capacity;
   return true;
 }
@@ -120,6 +140,14 @@ void tab_init(Tab *tab) {
     return;
   memset(tab, 0, sizeof(Tab));
   filters_init(&tab->filters);
+  filters_init(&tab->data_filters);
+}
+
+void tab_record_data_filters(Tab *tab) {
+  if (!tab)
+    return;
+  filters_copy(&tab->data_filters, &tab->filters);
+  tab->data_filters_known = true;
 }
 
 void tab_free_data(Tab *tab) {
@@ -152,6 +180,9 @@ void tab_free_data(Tab *tab) {
     free(op);
     tab->bg_load_op = NULL;
   }
+  tab_cancel_query_op(tab);
+  landmark_index_free(&tab->landmarks);
+  row_watch_stop(&tab->watch);
 
   /* Free table data */
   FREE_NULL(tab->table_name);
@@ -161,8 +192,11 @@ void tab_free_data(Tab *tab) {
   db_schema_free(tab->schema);
   tab->schema = NULL;
   FREE_NULL(tab->col_widths);
+  FREE_NULL(tab->col_stats);
   tab->num_col_widths = 0;
   filters_free(&tab->filters);
+  filters_free(&tab->data_filters);
+  tab->data_filters_known = false;
 
   /* Free query data */
   FREE_NULL(tab->query_text);
@@ -170,17 +204,48 @@ void tab_free_data(Tab *tab) {
   tab->query_results = NULL;
   FREE_NULL(tab->query_error);
   FREE_NULL(tab->query_result_col_widths);
+  FREE_NULL(tab->query_result_col_stats);
 
   /* Note: query_result_edit_buf is now in UITabState (TUI layer) */
   FREE_NULL(tab->query_source_table);
   db_schema_free(tab->query_source_schema);
   tab->query_source_schema = NULL;
   FREE_NULL(tab->query_base_sql);
+  db_cursor_close(tab->query_server_cursor);
+  tab->query_server_cursor = NULL;
 
   /* Free row selections */
-  FREE_NULL(tab->selected_rows);
-  tab->num_selected = 0;
-  tab->selected_capacity = 0;
+  row_set_free(&tab->selection);
+}
+
+void tab_cancel_query_op(Tab *tab) {
+  if (!tab || !tab->query_op)
+    return;
+
+  /* It runs on a connection of its own: nothing else waits on it, but
+   * the tab can't go away under it */
+  AsyncOperation *op = (AsyncOperation *)tab->query_op;
+  async_cancel(op);
+  async_wait(op, 500);
+  while (async_poll(op) == ASYNC_STATE_RUNNING) {
+    struct timespec ts = {0, 10000000L}; /* 10ms */
+    nanosleep(&ts, NULL);
+  }
+
+  lace_mutex_lock(&op->mutex);
+  if (op->result) {
+    if (op->op_type == ASYNC_OP_CURSOR_OPEN)
+      db_cursor_close((DbCursor *)op->result);
+    else
+      db_result_free((ResultSet *)op->result);
+    op->result = NULL;
+  }
+  lace_mutex_unlock(&op->mutex);
+
+  async_free(op);
+  free(op);
+  tab->query_op = NULL;
+  FREE_NULL(tab->query_op_sql);
 }
 
 Tab *workspace_current_tab(Workspace *ws) {
@@ -460,6 +525,10 @@ void connection_free_data(Connection *conn) {
   history_free(conn->history);
   conn->history = NULL;
 
+  /* Stop the live feed before its connection string goes */
+  live_feed_stop(conn->live);
+  conn->live = NULL;
+
   /* Free history callback context and disconnect database */
   if (conn->conn) {
     /* Disable callback FIRST to prevent calls with freed context */
@@ -472,6 +541,11 @@ void connection_free_data(Connection *conn) {
     conn->conn = NULL;
   }
 
+  result_cache_free(conn->result_cache);
+  conn->result_cache = NULL;
+  page_cache_free(conn->page_cache);
+  conn->page_cache = NULL;
+
   conn->active = false;
 }
 
@@ -491,18 +565,22 @@ Connection *app_add_connection(AppState *app, DbConnection *db_conn,
   conn->conn = db_conn;
   conn->connstr = str_dup(connstr);
 
-  /* Create history object and set up callback if history tracking is enabled */
-  if (app->config && app->config->general.history_mode != HISTORY_MODE_OFF) {
+  conn->result_cache = result_cache_create();
+  conn->page_cache = page_cache_create();
+
+  /* Create history object if history tracking is enabled */
+  if (app->config && app->config->general.history_mode != HISTORY_MODE_OFF)
     conn->history = history_create(NULL); /* ID set later when known */
 
-    /* Set up history callback in the database connection */
-    if (conn->history && db_conn) {
-      HistoryCallbackContext *ctx = safe_malloc(sizeof(HistoryCallbackContext));
-      ctx->conn = conn;
-      ctx->max_size = app->config->general.history_max_size;
-      db_conn->history_callback = history_callback;
-      db_conn->history_context = ctx;
-    }
+  /* Set up history callback in the database connection. It also runs with
+   * history off: writes it reports invalidate the result cache. */
+  if (db_conn) {
+    HistoryCallbackContext *ctx = safe_malloc(sizeof(HistoryCallbackContext));
+    ctx->conn = conn;
+    ctx->max_size = app->config ? app->config->general.history_max_size
+                                : HISTORY_SIZE_DEFAULT;
+    db_conn->history_callback = history_callback;
+    db_conn->history_context = ctx;
   }
 
   app->num_connections++;
@@ -634,6 +712,15 @@ void app_state_cleanup(AppState *app) {
     app->config = NULL;
   }
 
+  /* Free all workspaces first: tabs close their cursors and stop their
+   * background loads on connections that are still open */
+  if (app->workspaces) {
+    for (size_t i = 0; i < app->num_workspaces; i++) {
+      workspace_free_data(&app->workspaces[i]);
+    }
+    free(app->workspaces);
+  }
+
   /* Close all connections */
   if (app->connections) {
     for (size_t i = 0; i < app->num_connections; i++) {
@@ -642,14 +729,6 @@ void app_state_cleanup(AppState *app) {
     free(app->connections);
   }
 
-  /* Free all workspaces */
-  if (app->workspaces) {
-    for (size_t i = 0; i < app->num_workspaces; i++) {
-      workspace_free_data(&app->workspaces[i]);
-    }
-    free(app->workspaces);
-  }
-
   memset(app, 0, sizeof(AppState));
 }
 
@@ -679,73 +758,134 @@ Connection *app_current_tab_connection(AppState *app) {
 }
 
 /* ============================================================================
- * Row Selection Operations
+ * Sort Order
  * ============================================================================
  */
 
-/* Toggle selection of a row by global index */
-bool tab_toggle_selection(Tab *tab, size_t global_row) {
-  if (!tab)
+static void sort_key_add(SortKey *key, size_t col, bool desc) {
+  for (size_t i = 0; i < key->num_cols; i++) {
+    if (key->cols[i] == col)
+      return;
+  }
+  if (key->num_cols >= MAX_KEY_COLUMNS)
+    return;
+  key->cols[key->num_cols] = col;
+  key->desc[key->num_cols] = desc;
+  key->num_cols++;
+}
+
+bool tab_sort_key(const Tab *tab, SortKey *key) {
+  if (!key)
+    return false;
+  memset(key, 0, sizeof(SortKey));
+  if (!tab || !tab->schema)
     return false;
 
-  /* Check if already selected - if so, remove */
-  if (!tab->selected_rows && tab->num_selected > 0)
-    return false; /* Invalid state */
-  for (size_t i = 0; i < tab->num_selected; i++) {
-    if (tab->selected_rows[i] == global_row) {
-      /* Remove by shifting remaining elements */
-      for (size_t j = i; j < tab->num_selected - 1; j++) {
-        tab->selected_rows[j] = tab->selected_rows[j + 1];
-      }
-      tab->num_selected--;
-      return true;
-    }
+  const TableSchema *schema = tab->schema;
+  for (size_t i = 0; i < tab->num_sort_entries; i++) {
+    const SortEntry *entry = &tab->sort_entries[i];
+    if (entry->column < schema->num_columns &&
+        schema->columns[entry->column].name)
+      sort_key_add(key, entry->column, entry->direction != SORT_ASC);
   }
 
-  /* Not selected - add it */
-  /* Ensure capacity (also handle NULL selected_rows) */
-  if (tab->num_selected >= tab->selected_capacity || !tab->selected_rows) {
-    size_t new_cap = tab->selected_capacity == 0 ? INITIAL_SELECTION_CAPACITY
-                                                 : tab->selected_capacity * 2;
-    tab->selected_rows =
-        safe_reallocarray(tab->selected_rows, new_cap, sizeof(size_t));
-    tab->selected_capacity = new_cap;
+  /* Primary key tie-breakers make the order total, so OFFSET pages and
+   * keyset seeks agree on every row's position */
+  size_t pk_cols = 0;
+  for (size_t c = 0; c < schema->num_columns; c++) {
+    if (!schema->columns[c].primary_key || !schema->columns[c].name)
+      continue;
+    pk_cols++;
+    sort_key_add(key, c, false);
+  }
+
+  size_t pk_in_key = 0;
+  for (size_t i = 0; i < key->num_cols; i++) {
+    if (schema->columns[key->cols[i]].primary_key)
+      pk_in_key++;
   }
+  key->unique = pk_cols > 0 && pk_in_key == pk_cols;
+  return key->num_cols > 0;
+}
+
+char *tab_build_order_clause(const Tab *tab, const char *driver_name) {
+  SortKey key;
+  if (!driver_name || !tab_sort_key(tab, &key))
+    return NULL;
 
-  tab->selected_rows[tab->num_selected++] = global_row;
+  /* Determine quote character based on driver */
+  bool use_backtick = (strcmp(driver_name, "mysql") == 0 ||
+                       strcmp(driver_name, "mariadb") == 0);
+
+  StringBuilder *sb = sb_new(128);
+  if (!sb)
+    return NULL;
+
+  for (size_t i = 0; i < key.num_cols; i++) {
+    const char *col_name = tab->schema->columns[key.cols[i]].name;
+    char *escaped = use_backtick ? str_escape_identifier_backtick(col_name)
+                                 : str_escape_identifier_dquote(col_name);
+    if (!escaped) {
+      sb_free(sb);
+      return NULL;
+    }
+    sb_printf(sb, "%s%s %s", i > 0 ? ", " : "", escaped,
+              key.desc[i] ? "DESC" : "ASC");
+    free(escaped);
+  }
+  return sb_to_string(sb);
+}
+
+/* ============================================================================
+ * Row Selection Operations
+ * ============================================================================
+ */
+
+/* Toggle selection of a row by global index */
+bool tab_toggle_selection(Tab *tab, size_t global_row) {
+  if (!tab)
+    return false;
+
+  row_set_toggle(&tab->selection, global_row);
   return true;
 }
 
 /* Check if a row is selected */
 bool tab_is_row_selected(Tab *tab, size_t global_row) {
-  if (!tab || !tab->selected_rows)
+  if (!tab)
     return false;
+  return row_set_contains(&tab->selection, global_row);
+}
 
-  for (size_t i = 0; i < tab->num_selected; i++) {
-    if (tab->selected_rows[i] == global_row)
-      return true;
-  }
-  return false;
+/* Select every row in [first, last] */
+void tab_select_range(Tab *tab, size_t first, size_t last) {
+  if (!tab)
+    return;
+  row_set_add_range(&tab->selection, first, last);
+}
+
+/* Select all rows matching the current filters */
+void tab_select_all(Tab *tab) {
+  if (!tab)
+    return;
+  size_t universe = tab->type == TAB_TYPE_QUERY
+                        ? (tab->query_paginated ? tab->query_total_rows
+                                                : tab->query_loaded_count)
+                        : tab->total_rows;
+  row_set_select_all(&tab->selection, universe);
 }
 
 /* Clear all selections */
 void tab_clear_selections(Tab *tab) {
   if (!tab)
     return;
-  tab->num_selected = 0;
-  /* Keep the array allocated for reuse */
+  /* Keep the range array allocated for reuse */
+  row_set_clear(&tab->selection);
 }
 
-/* Get selected row indices */
-const size_t *tab_get_selections(Tab *tab, size_t *count) {
-  if (!tab) {
-    if (count)
-      *count = 0;
-    return NULL;
-  }
-  if (count)
-    *count = tab->num_selected;
-  return tab->selected_rows;
+/* Number of selected rows */
+size_t tab_selection_count(const Tab *tab) {
+  return tab ? row_set_count(&tab->selection) : 0;
 }
 
 /* ============================================================================
@@ -753,11 +893,25 @@ const size_t *tab_get_selections(Tab *tab, size_t *count) {
  * ============================================================================
  */
 
-/* Mark all tabs with the same table as needing refresh (except current tab) */
-void app_mark_table_tabs_dirty(AppState *app, size_t connection_index,
-                               const char *table_name, Tab *exclude_tab) {
-  if (!app || !table_name)
-    return;
+/* Whether tab shows table_name of the connection (any table if NULL) */
+static bool tab_shows_table(const Tab *tab, size_t connection_index,
+                            const char *table_name) {
+  if (tab->connection_index != connection_index)
+    return false;
+  const char *shown = tab->type == TAB_TYPE_QUERY ? tab->query_source_table
+                                                  : tab->table_name;
+  if (!shown || (tab->type != TAB_TYPE_TABLE && tab->type != TAB_TYPE_QUERY))
+    return false;
+  return !table_name || strcmp(shown, table_name) == 0;
+}
+
+static void mark_tabs_dirty(AppState *app, size_t connection_index,
+                            const char *table_name, Tab *exclude_tab) {
+  Connection *conn = app_get_connection(app, connection_index);
+  if (conn) {
+    result_cache_clear(conn->result_cache);
+    page_cache_forget(conn->page_cache, table_name);
+  }
 
   /* Iterate through all workspaces and tabs */
   for (size_t ws_idx = 0; ws_idx < app->num_workspaces; ws_idx++) {
@@ -767,22 +921,35 @@ void app_mark_table_tabs_dirty(AppState *app, size_t connection_index,
 
     for (size_t tab_idx = 0; tab_idx < ws->num_tabs; tab_idx++) {
       Tab *tab = &ws->tabs[tab_idx];
-      if (!tab->active || tab == exclude_tab)
+      if (!tab->active)
         continue;
 
-      /* Check if this is a table tab for the same table */
-      if (tab->type == TAB_TYPE_TABLE && tab->table_name &&
-          tab->connection_index == connection_index &&
-          strcmp(tab->table_name, table_name) == 0) {
-        tab->needs_refresh = true;
-      }
+      /* Row positions moved, including in the tab that made the change */
+      if (tab->connection_index == connection_index && tab->table_name &&
+          (!table_name || strcmp(tab->table_name, table_name) == 0))
+        landmark_invalidate(&tab->landmarks);
 
-      /* Also check query tabs that have results from this table */
-      if (tab->type == TAB_TYPE_QUERY && tab->query_source_table &&
-          tab->connection_index == connection_index &&
-          strcmp(tab->query_source_table, table_name) == 0) {
+      if (tab == exclude_tab)
+        continue;
+
+      /* Table tabs of the table, and query tabs with results from it */
+      if (tab_shows_table(tab, connection_index, table_name))
         tab->needs_refresh = true;
-      }
     }
   }
 }
+
+/* Mark all tabs with the same table as needing refresh (except current tab) */
+void app_mark_table_tabs_dirty(AppState *app, size_t connection_index,
+                               const char *table_name, Tab *exclude_tab) {
+  if (!app || !table_name)
+    return;
+  mark_tabs_dirty(app, connection_index, table_name, exclude_tab);
+}
+
+/* Mark every table and query tab of a connection as needing refresh */
+void app_mark_connection_tabs_dirty(AppState *app, size_t connection_index) {
+  if (!app)
+    return;
+  mark_tabs_dirty(app, connection_index, NULL, NULL);
+}
@@ -14,9 +14,18 @@
 
 #include "../config/config.h"
 #include "../db/db.h"
+#include "col_stats.h"
+#include "landmark.h"
+#include "live_feed.h"
+#include "page_cache.h"
+#include "prefetch.h"
+#include "result_cache.h"
+#include "row_set.h"
+#include "row_watch.h"
 #include "constants.h"
 #include <stdbool.h>
 #include <stddef.h>
+#include <stdint.h>
 
 /* Forward declaration for query history */
 typedef struct QueryHistory QueryHistory;
@@ -46,10 +55,13 @@ typedef enum {
   FILTER_OP_IS_NOT_EMPTY, /* <> '' */
   FILTER_OP_IS_NULL,      /* IS NULL */
   FILTER_OP_IS_NOT_NULL,  /* IS NOT NULL */
+  FILTER_OP_STARTS_WITH,  /* GLOB 'value*' on SQLite, LIKE 'value%' elsewhere:
+                             case-sensitive but for MySQL's _ci collations */
+  FILTER_OP_ICONTAINS,    /* ILIKE '%value%' (LIKE elsewhere) */
   FILTER_OP_RAW,          /* Raw SQL condition */
 } FilterOperator;
 
-#define FILTER_OP_COUNT 15
+#define FILTER_OP_COUNT 17
 
 /* Single column filter */
 typedef struct {
@@ -57,6 +69,8 @@ typedef struct {
   FilterOperator op;   /* Operator type */
   char value[256];     /* Filter value (for ops that need it) */
   char value2[256];    /* Second value (for BETWEEN) */
+  char *long_value;    /* Value too long for value[], which then holds a
+                          preview for display (owned), or NULL */
 } ColumnFilter;
 
 /* Table filters collection */
@@ -103,6 +117,23 @@ typedef struct {
 
   /* Query history for this connection */
   QueryHistory *history;
+
+  /* Measured page load latency (drives adaptive prefetch) */
+  PrefetchLink link;
+
+  /* Recent query results, used when general.query_cache_mb is set */
+  ResultCache *result_cache;
+
+  /* Table pages its tabs hold, shared with tabs asking for the same rows */
+  PageCache *page_cache;
+
+  /* Set once a statement left session state on conn (SET, USE, temporary
+   * tables, a transaction): queries then keep to conn instead of running
+   * in the background on a connection of their own */
+  bool session_bound;
+
+  /* Writes by other sessions, when general.live_updates is on */
+  LiveFeed *live;
 } Connection;
 
 /* ============================================================================
@@ -155,9 +186,12 @@ typedef struct {
   /* Column widths - DEPRECATED: Migrating to TableWidget */
   int *col_widths;      /* DEPRECATED: Use TableWidget.col_widths */
   size_t num_col_widths;  /* DEPRECATED: Use TableWidget.num_col_widths */
+  ColumnWidthStats *col_stats; /* Width histograms of loaded rows (per column) */
 
   /* Filters (per-table) */
   TableFilters filters;
+  TableFilters data_filters; /* Filters the loaded rows were fetched with */
+  bool data_filters_known;   /* data_filters describes data */
 
   /* Sort state (per-table) - multi-column sorting */
   SortEntry sort_entries[MAX_SORT_COLUMNS]; /* Sort columns in priority order */
@@ -176,6 +210,7 @@ typedef struct {
   size_t query_scroll_line;   /* DEPRECATED: Use QueryWidget.base.state.scroll_row */
   size_t query_scroll_col;    /* DEPRECATED: Use QueryWidget.base.state.scroll_col */
   ResultSet *query_results;   /* Query results (model - stays) */
+  bool query_results_cached;  /* query_results came from the result cache */
   int64_t query_affected;     /* Affected rows (model - stays) */
   bool query_exec_success;    /* True if last exec (non-SELECT) succeeded */
   char *query_error;          /* Error message (model - stays) */
@@ -185,6 +220,7 @@ typedef struct {
   size_t query_result_scroll_col;   /* DEPRECATED: Use QueryWidget results */
   int *query_result_col_widths;     /* DEPRECATED: Use QueryWidget results */
   size_t query_result_num_cols;     /* DEPRECATED: Use QueryWidget results */
+  ColumnWidthStats *query_result_col_stats; /* Width histograms of results */
 
   /* Query results editing - source table tracking */
   char *query_source_table;
@@ -192,6 +228,8 @@ typedef struct {
 
   /* Query results pagination */
   char *query_base_sql;
+  DbCursor *query_server_cursor; /* Over query_base_sql's result (NULL =
+                                    pages re-run it with LIMIT/OFFSET) */
   size_t query_total_rows;
   size_t query_loaded_offset;
   size_t query_loaded_count;
@@ -201,14 +239,31 @@ typedef struct {
   void *bg_load_op;             /* AsyncOperation* - current background load */
   bool bg_load_forward;         /* Direction: true=forward, false=backward */
   size_t bg_load_target_offset; /* Target offset being loaded */
+  uint64_t bg_load_started;     /* lace_time_ms() when the load started */
+  PrefetchMotion motion;        /* Cursor speed for prefetch sizing */
+
+  /* Query tab statement running in the background */
+  void *query_op;               /* AsyncOperation* - NULL when idle */
+  char *query_op_sql;           /* Statement it runs */
+  int64_t query_op_version;     /* Data version it reads (-1 = no caching) */
+  uint64_t query_op_started;    /* lace_time_ms() when it started */
+
+  /* Sampled sort keys for seeking deep into the table (see landmark.h) */
+  LandmarkIndex landmarks;
+
+  /* Watch mode: periodic refresh of the rows in view (see row_watch.h) */
+  RowWatch watch;
 
   /* Row selection (for bulk operations) */
-  size_t *selected_rows;    /* Array of selected global row indices */
-  size_t num_selected;      /* Number of selected rows */
-  size_t selected_capacity; /* Capacity of selected_rows array */
+  RowSet selection; /* Selected global row indices */
 
   /* Data change tracking */
   bool needs_refresh; /* True if data was modified in another tab */
+
+  /* Global memory budget accounting (see mem_budget.h) */
+  size_t mem_bytes;   /* Bytes held by loaded rows at last accounting */
+  uint64_t last_used; /* LRU stamp from AppState.use_clock */
+  bool rows_evicted;  /* Rows dropped under memory pressure, refetch on use */
 } Tab;
 
 /* ============================================================================
@@ -248,6 +303,9 @@ typedef struct {
   /* Page size for data loading */
   size_t page_size;
 
+  /* Monotonic clock for Tab.last_used (memory budget LRU) */
+  uint64_t use_clock;
+
   /* Connection pool (dynamic array) */
   Connection *connections;
   size_t num_connections;
@@ -289,6 +347,9 @@ Workspace *app_switch_workspace(AppState *app, size_t index);
 /* Tab management */
 void tab_init(Tab *tab);
 void tab_free_data(Tab *tab);
+/* Note that data was just fetched with the current filters */
+void tab_record_data_filters(Tab *tab);
+void tab_cancel_query_op(Tab *tab); /* Cancel and wait for query_op */
 Tab *workspace_current_tab(Workspace *ws);
 Tab *workspace_create_table_tab(Workspace *ws, size_t connection_index,
                                 size_t table_index, const char *table_name);
@@ -323,6 +384,17 @@ void filters_clear(TableFilters *f);
 bool filters_add(TableFilters *f, size_t col_idx, FilterOperator op,
                  const char *value);
 void filters_remove(TableFilters *f, size_t index);
+void filters_copy(TableFilters *dst, const TableFilters *src);
+
+/* A filter's full value: long_value if set, else value */
+const char *filter_value(const ColumnFilter *cf);
+
+/* Set a filter's value. One too long for value[] (a pasted IN list) is kept
+ * in long_value, with a preview of it in value[]. */
+void filter_set_value(ColumnFilter *cf, const char *value);
+
+bool filter_is_active(const ColumnFilter *cf);
+bool filter_equal(const ColumnFilter *a, const ColumnFilter *b);
 const char *filter_op_name(FilterOperator op);
 const char *filter_op_sql(FilterOperator op);
 bool filter_op_needs_value(FilterOperator op);
@@ -330,6 +402,53 @@ char *filters_parse_in_values(const char *input, char **err);
 char *filters_build_where(TableFilters *f, TableSchema *schema,
                           const char *driver_name, char **err);
 
+/* WHERE clause for the active filters with their values as placeholders
+ * (? or $n, as driver_name's database expects), and *params set to the
+ * values typed after their columns (caller frees each and the array). With
+ * params NULL the values are written into the SQL as literals, numbers for
+ * numeric columns: filters_build_where. RAW filters are copied as they are.
+ * NULL if no filter is active. */
+char *filters_compile_where(TableFilters *f, TableSchema *schema,
+                            const char *driver_name, DbValue **params,
+                            size_t *num_params, char **err);
+
+/* Whether an index on a filter's column can serve it */
+typedef enum {
+  FILTER_INDEX_NONE, /* Not a column filter (RAW or inactive) */
+  FILTER_INDEX_USED, /* An index on the column serves the operator */
+  FILTER_INDEX_SCAN, /* None does: every row is read and tested */
+} FilterIndexUse;
+
+/* Index advice from schema->indexes: B-tree (and SQLite's rowid) keys serve
+ * comparisons, ranges and prefix matches on their leading column, hash keys
+ * equality, and PostgreSQL GIN/GiST indexes (taken to be pg_trgm's)
+ * substring and regex matches on any of theirs. */
+bool filter_op_uses_index(FilterOperator op, size_t col_idx,
+                          const TableSchema *schema, const char *driver_name);
+FilterIndexUse filter_index_use(const ColumnFilter *cf,
+                                const TableSchema *schema,
+                                const char *driver_name);
+
+/* An operator close to a scanning filter's that an index on its column
+ * serves (a prefix match for a substring one, a range on a timestamp), or
+ * cf->op if there is none */
+FilterOperator filter_index_suggestion(const ColumnFilter *cf,
+                                       const TableSchema *schema,
+                                       const char *driver_name);
+
+/* ============================================================================
+ * Sort Order
+ * ============================================================================
+ */
+
+/* Total row order of a table tab (sort entries, then primary key columns).
+ * Returns false if there is nothing to order by. */
+bool tab_sort_key(const Tab *tab, SortKey *key);
+
+/* ORDER BY clause (without the keywords) for tab_sort_key, NULL if there is
+ * nothing to order by. Caller must free. */
+char *tab_build_order_clause(const Tab *tab, const char *driver_name);
+
 /* ============================================================================
  * Row Selection Operations
  * ============================================================================
@@ -341,19 +460,30 @@ bool tab_toggle_selection(Tab *tab, size_t global_row);
 /* Check if a row is selected */
 bool tab_is_row_selected(Tab *tab, size_t global_row);
 
+/* Select every row in [first, last] (global indices, inclusive) */
+void tab_select_range(Tab *tab, size_t first, size_t last);
+
+/* Select all rows matching the current filters (symbolic, O(1)) */
+void tab_select_all(Tab *tab);
+
 /* Clear all selections */
 void tab_clear_selections(Tab *tab);
 
-/* Get selected row indices (returns array, caller should not free) */
-const size_t *tab_get_selections(Tab *tab, size_t *count);
+/* Number of selected rows */
+size_t tab_selection_count(const Tab *tab);
 
 /* ============================================================================
  * Data Change Tracking
  * ============================================================================
  */
 
-/* Mark all tabs with the same table as needing refresh (except current tab) */
+/* Mark all tabs with the same table as needing refresh (except current tab)
+ * and drop the connection's cached query results */
 void app_mark_table_tabs_dirty(AppState *app, size_t connection_index,
                                const char *table_name, Tab *exclude_tab);
 
+/* Mark every table and query tab of a connection as needing refresh, for a
+ * change that names no table */
+void app_mark_connection_tabs_dirty(AppState *app, size_t connection_index);
+
 #endif /* LACE_APP_STATE_H */
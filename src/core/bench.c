@@ -0,0 +1,73 @@
+/*
+ * Lace
+ * Query benchmark - summary statistics over repeated runs of a statement
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "bench.h"
+#include "../util/mem.h"
+#include <stdlib.h>
+#include <string.h>
+
+static int cmp_u64(const void *a, const void *b) {
+  uint64_t x = *(const uint64_t *)a;
+  uint64_t y = *(const uint64_t *)b;
+  return (x > y) - (x < y);
+}
+
+/* Nearest-rank percentile of sorted values */
+static uint64_t percentile(const uint64_t *sorted, size_t n, unsigned pct) {
+  size_t rank = (n * pct + 99) / 100;
+  return sorted[rank > 0 ? rank - 1 : 0];
+}
+
+void bench_summarize(const AsyncBenchRun *runs, size_t num_runs,
+                     BenchSummary *out) {
+  memset(out, 0, sizeof(*out));
+  if (!runs || num_runs == 0)
+    return;
+
+  uint64_t *latencies = safe_malloc(num_runs * sizeof(uint64_t));
+  uint64_t first = runs[0].started_us;
+  uint64_t last = runs[0].started_us + runs[0].elapsed_us;
+  uint64_t total_us = 0, server_us = 0, decode_us = 0;
+
+  for (size_t i = 0; i < num_runs; i++) {
+    const AsyncBenchRun *run = &runs[i];
+    latencies[i] = run->elapsed_us;
+    total_us += run->elapsed_us;
+    server_us += run->stats.server_us;
+    decode_us += run->stats.decode_us;
+    out->rows += run->rows;
+    out->bytes += run->stats.bytes;
+    if (run->started_us < first)
+      first = run->started_us;
+    if (run->started_us + run->elapsed_us > last)
+      last = run->started_us + run->elapsed_us;
+  }
+  qsort(latencies, num_runs, sizeof(uint64_t), cmp_u64);
+
+  out->runs = num_runs;
+  out->wall_us = last - first;
+  out->min_us = latencies[0];
+  out->p50_us = percentile(latencies, num_runs, 50);
+  out->p95_us = percentile(latencies, num_runs, 95);
+  out->p99_us = percentile(latencies, num_runs, 99);
+  out->max_us = latencies[num_runs - 1];
+  out->mean_us = total_us / num_runs;
+  out->server_us = server_us / num_runs;
+  out->decode_us = decode_us / num_runs;
+  out->other_us = out->mean_us > out->server_us + out->decode_us
+                      ? out->mean_us - out->server_us - out->decode_us
+                      : 0;
+
+  if (out->wall_us > 0) {
+    double secs = (double)out->wall_us / 1e6;
+    out->runs_per_sec = (double)num_runs / secs;
+    out->rows_per_sec = (double)out->rows / secs;
+    out->bytes_per_sec = (double)out->bytes / secs;
+  }
+  free(latencies);
+}
@@ -0,0 +1,49 @@
+/*
+ * Lace
+ * Query benchmark - summary statistics over repeated runs of a statement
+ *
+ * The runs themselves are ASYNC_OP_BENCHMARK operations, one per
+ * connection; this turns their measurements into the latency percentiles,
+ * throughput and time split the benchmark report shows.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_BENCH_H
+#define LACE_BENCH_H
+
+#include "../async/async.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Summary of a benchmark */
+typedef struct {
+  size_t runs;
+  uint64_t wall_us; /* First run's start to last run's end */
+
+  /* Latency of one run */
+  uint64_t min_us;
+  uint64_t p50_us;
+  uint64_t p95_us;
+  uint64_t p99_us;
+  uint64_t max_us;
+  uint64_t mean_us;
+
+  /* Mean per run: waiting for the database, decoding rows, the rest */
+  uint64_t server_us;
+  uint64_t decode_us;
+  uint64_t other_us;
+
+  size_t rows;  /* Over all runs */
+  size_t bytes; /* Over all runs */
+  double runs_per_sec;
+  double rows_per_sec;
+  double bytes_per_sec;
+} BenchSummary;
+
+/* Summarize num_runs measured runs (from any number of connections) */
+void bench_summarize(const AsyncBenchRun *runs, size_t num_runs,
+                     BenchSummary *out);
+
+#endif /* LACE_BENCH_H */
@@ -0,0 +1,207 @@
+/*
+ * Lace
+ * Column width statistics - incremental display-width tracking for grids
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "col_stats.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Value widths
+ * ============================================================================
+ */
+
+int col_stats_value_width(const DbValue *val) {
+  if (!val || val->is_null || val->type == DB_TYPE_NULL)
+    return 4; /* "NULL" */
+
+  switch (val->type) {
+  case DB_TYPE_INT: {
+    /* Count digits without formatting */
+    long long v = (long long)val->int_val;
+    unsigned long long u = v < 0 ? 0ULL - (unsigned long long)v
+                                 : (unsigned long long)v;
+    int w = v < 0 ? 2 : 1;
+    while (u >= 10) {
+      u /= 10;
+      w++;
+    }
+    return w;
+  }
+
+  case DB_TYPE_TEXT:
+    if (!val->text.data)
+      return 0;
+    return (int)str_display_width(val->text.data,
+                                  strnlen(val->text.data, val->text.len));
+
+  default: {
+    /* Rare types: measure their formatted form */
+    char *str = db_value_to_string(val);
+    int w = str ? (int)str_display_width(str, strlen(str)) : 0;
+    free(str);
+    return w;
+  }
+  }
+}
+
+static inline size_t width_bucket(int width) {
+  if (width < 0)
+    return 0;
+  return width >= MAX_COL_WIDTH ? MAX_COL_WIDTH : (size_t)width;
+}
+
+/* ============================================================================
+ * Incremental updates
+ * ============================================================================
+ */
+
+void col_stats_add_rows(ColumnWidthStats *stats, size_t num_cols,
+                        const Row *rows, size_t num_rows) {
+  if (!stats || !rows)
+    return;
+
+  for (size_t r = 0; r < num_rows; r++) {
+    const Row *row = &rows[r];
+    if (!row->cells)
+      continue;
+    size_t n = row->num_cells < num_cols ? row->num_cells : num_cols;
+    for (size_t c = 0; c < n; c++) {
+      stats[c].hist[width_bucket(col_stats_value_width(&row->cells[c]))]++;
+      stats[c].count++;
+    }
+  }
+}
+
+void col_stats_remove_rows(ColumnWidthStats *stats, size_t num_cols,
+                           const Row *rows, size_t num_rows) {
+  if (!stats || !rows)
+    return;
+
+  for (size_t r = 0; r < num_rows; r++) {
+    const Row *row = &rows[r];
+    if (!row->cells)
+      continue;
+    size_t n = row->num_cells < num_cols ? row->num_cells : num_cols;
+    for (size_t c = 0; c < n; c++) {
+      size_t b = width_bucket(col_stats_value_width(&row->cells[c]));
+      if (stats[c].hist[b] > 0 && stats[c].count > 0) {
+        stats[c].hist[b]--;
+        stats[c].count--;
+      }
+    }
+  }
+}
+
+void col_stats_replace_value(ColumnWidthStats *stats, const DbValue *old_val,
+                             const DbValue *new_val) {
+  if (!stats)
+    return;
+
+  size_t b = width_bucket(col_stats_value_width(old_val));
+  if (stats->hist[b] > 0) {
+    stats->hist[b]--;
+    stats->hist[width_bucket(col_stats_value_width(new_val))]++;
+  }
+}
+
+/* ============================================================================
+ * Queries
+ * ============================================================================
+ */
+
+int col_stats_max(const ColumnWidthStats *stats) {
+  if (!stats || stats->count == 0)
+    return 0;
+  for (size_t b = COL_STATS_BUCKETS; b > 0; b--) {
+    if (stats->hist[b - 1] > 0)
+      return (int)(b - 1);
+  }
+  return 0;
+}
+
+int col_stats_percentile(const ColumnWidthStats *stats, unsigned pct) {
+  if (!stats || stats->count == 0)
+    return 0;
+  if (pct > 100)
+    pct = 100;
+
+  /* Rank of the pct-th percentile value (1-based, rounded up) */
+  size_t rank = (stats->count * pct + 99) / 100;
+  if (rank == 0)
+    rank = 1;
+
+  size_t seen = 0;
+  for (size_t b = 0; b < COL_STATS_BUCKETS; b++) {
+    seen += stats->hist[b];
+    if (seen >= rank)
+      return (int)b;
+  }
+  return MAX_COL_WIDTH;
+}
+
+int col_stats_width(const ColumnWidthStats *stats, const char *header) {
+  int width = header ? (int)str_display_width(header, strlen(header)) : 0;
+
+  int max = col_stats_max(stats);
+  int p95 = col_stats_percentile(stats, 95);
+  int data = (max - p95 <= COL_STATS_OUTLIER_SLACK) ? max : p95;
+  if (data > width)
+    width = data;
+
+  if (width < MIN_COL_WIDTH)
+    width = MIN_COL_WIDTH;
+  if (width > MAX_COL_WIDTH)
+    width = MAX_COL_WIDTH;
+  return width;
+}
+
+/* ============================================================================
+ * Width arrays
+ * ============================================================================
+ */
+
+void col_widths_rebuild(const ResultSet *data, ColumnWidthStats **stats,
+                        int **widths, size_t *num_cols) {
+  if (!stats || !widths || !num_cols)
+    return;
+
+  free(*stats);
+  free(*widths);
+  *stats = NULL;
+  *widths = NULL;
+  *num_cols = 0;
+
+  if (!data || !data->columns || data->num_columns == 0)
+    return;
+
+  size_t n = data->num_columns;
+  *stats = safe_calloc(n, sizeof(ColumnWidthStats));
+  *widths = safe_calloc(n, sizeof(int));
+  *num_cols = n;
+
+  col_stats_add_rows(*stats, n, data->rows, data->num_rows);
+  for (size_t c = 0; c < n; c++) {
+    (*widths)[c] = col_stats_width(&(*stats)[c], data->columns[c].name);
+  }
+}
+
+void col_widths_grow(const ColumnWidthStats *stats, const ResultSet *data,
+                     int *widths, size_t num_cols) {
+  if (!stats || !widths || !data || !data->columns)
+    return;
+
+  size_t n = num_cols < data->num_columns ? num_cols : data->num_columns;
+  for (size_t c = 0; c < n; c++) {
+    int w = col_stats_width(&stats[c], data->columns[c].name);
+    if (w > widths[c])
+      widths[c] = w;
+  }
+}
@@ -0,0 +1,68 @@
+/*
+ * Lace
+ * Column width statistics - incremental display-width tracking for grids
+ *
+ * Each column keeps a histogram of cell display widths (clamped to
+ * MAX_COL_WIDTH). Rows are folded in as pages merge and folded out as
+ * pages are trimmed, so max/p95 are always exact for the loaded window
+ * without rescanning it.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_COL_STATS_H
+#define LACE_COL_STATS_H
+
+#include "../db/db_types.h"
+#include "constants.h"
+#include <stddef.h>
+#include <stdint.h>
+
+/* Buckets 0..MAX_COL_WIDTH-1 hold exact widths, the last one everything
+ * at or beyond MAX_COL_WIDTH */
+#define COL_STATS_BUCKETS (MAX_COL_WIDTH + 1)
+
+/* Values up to this many columns wider than p95 still widen the column;
+ * rarer, wider outliers are truncated instead */
+#define COL_STATS_OUTLIER_SLACK 4
+
+typedef struct {
+  size_t count;                     /* Cells accounted for */
+  uint32_t hist[COL_STATS_BUCKETS]; /* Display width histogram */
+} ColumnWidthStats;
+
+/* Display width of a cell as drawn in the grid (NULL renders as "NULL") */
+int col_stats_value_width(const DbValue *val);
+
+/* Fold rows into / out of per-column statistics (stats has num_cols items) */
+void col_stats_add_rows(ColumnWidthStats *stats, size_t num_cols,
+                        const Row *rows, size_t num_rows);
+void col_stats_remove_rows(ColumnWidthStats *stats, size_t num_cols,
+                           const Row *rows, size_t num_rows);
+
+/* Account for a cell value changing in place (e.g. after an edit) */
+void col_stats_replace_value(ColumnWidthStats *stats, const DbValue *old_val,
+                             const DbValue *new_val);
+
+/* Widest value (clamped to MAX_COL_WIDTH), 0 if empty */
+int col_stats_max(const ColumnWidthStats *stats);
+
+/* Smallest width w such that pct% of values are <= w, 0 if empty */
+int col_stats_percentile(const ColumnWidthStats *stats, unsigned pct);
+
+/* Layout width for a column: header width, widened to the data width
+ * (max, or p95 when max is an outlier), clamped to MIN/MAX_COL_WIDTH */
+int col_stats_width(const ColumnWidthStats *stats, const char *header);
+
+/* Rebuild statistics and widths from every row of data. Replaces *stats and
+ * *widths (freeing the old arrays) and sets *num_cols. */
+void col_widths_rebuild(const ResultSet *data, ColumnWidthStats **stats,
+                        int **widths, size_t *num_cols);
+
+/* Recompute widths from current statistics, only ever growing them so the
+ * layout stays stable while scrolling */
+void col_widths_grow(const ColumnWidthStats *stats, const ResultSet *data,
+                     int *widths, size_t num_cols);
+
+#endif /* LACE_COL_STATS_H */
@@ -39,7 +39,7 @@
  * Pagination
  * ========================================================================== */
 
-/* Page size for data loading */
+/* Page size for query result loading (tables use general.page_size) */
 #define PAGE_SIZE 1000
 
 /* Config validation bounds for user-configurable page size */
@@ -47,8 +47,7 @@
 #define CONFIG_PAGE_SIZE_MAX 10000
 #define CONFIG_PAGE_SIZE_DEFAULT 500
 
-/* Number of pages to prefetch */
-#define PREFETCH_PAGES 2
+/* Number of pages to prefetch (minimum for adaptive prefetch) */
 #define CONFIG_PREFETCH_PAGES_MIN 1
 #define CONFIG_PREFETCH_PAGES_MAX 10
 #define CONFIG_PREFETCH_PAGES_DEFAULT 2
@@ -56,20 +55,54 @@
 /* Load more data when within this many rows of edge */
 #define LOAD_THRESHOLD 50
 
-/* Start prefetch when within 1 page of edge */
-#define PREFETCH_THRESHOLD PAGE_SIZE
+/* Adaptive prefetch: cursor idle time that resets the measured velocity */
+#define PREFETCH_IDLE_MS 500
 
-/* Maximum pages to keep in memory (~5000 rows at default page size) */
+/* Adaptive prefetch: cover this many round trips of predicted scrolling */
+#define PREFETCH_SAFETY 2.0
+
+/* Adaptive prefetch: upper bound on the bytes fetched by one request */
+#define PREFETCH_MAX_BYTES (16 * 1024 * 1024)
+
+/* Maximum pages to keep in memory (table windows grow to fit prefetch) */
 #define MAX_LOADED_PAGES 5
 
 /* Trim data farther than this many pages from cursor */
 #define TRIM_DISTANCE_PAGES 2
 
+/* Landmark index: tables smaller than this page fine with plain OFFSET */
+#define LANDMARK_MIN_ROWS 100000
+
+/* Landmark index: at most this many sampled keys per index */
+#define LANDMARK_MAX_MARKS 16384
+
+/* Landmark index: at least this many rows between sampled keys */
+#define LANDMARK_MIN_STRIDE 1000
+
+/* Filters no index serves are checked with EXPLAIN before running on
+ * tables about this large */
+#define FILTER_SCAN_PROBE_BYTES (1024.0 * 1024 * 1024)
+
 /* Maximum result rows for config validation */
 #define CONFIG_MAX_RESULT_ROWS_MIN 1000
 #define CONFIG_MAX_RESULT_ROWS_MAX (10 * 1024 * 1024) /* 10M rows */
 #define CONFIG_MAX_RESULT_ROWS_DEFAULT (1024 * 1024)  /* 1M rows */
 
+/* Global memory budget for loaded rows across all tabs (MB, 0 = unlimited) */
+#define CONFIG_MEMORY_BUDGET_MB_MIN 0
+#define CONFIG_MEMORY_BUDGET_MB_MAX (64 * 1024)
+#define CONFIG_MEMORY_BUDGET_MB_DEFAULT 512
+
+/* Per-connection query result cache (MB, 0 = off) */
+#define CONFIG_QUERY_CACHE_MB_MIN 0
+#define CONFIG_QUERY_CACHE_MB_MAX 4096
+#define CONFIG_QUERY_CACHE_MB_DEFAULT 0
+
+/* Watch mode: seconds between probes of the rows in view */
+#define CONFIG_WATCH_INTERVAL_SEC_MIN 1
+#define CONFIG_WATCH_INTERVAL_SEC_MAX 3600
+#define CONFIG_WATCH_INTERVAL_SEC_DEFAULT 2
+
 /* ==========================================================================
  * Column Display
  * ========================================================================== */
@@ -122,6 +155,13 @@
 #define DEFAULT_PORT_POSTGRES 5432
 #define DEFAULT_PORT_MYSQL 3306
 
+/* Query benchmark: measured runs, warmup runs per connection, connections */
+#define BENCH_RUNS_DEFAULT 20
+#define BENCH_RUNS_MAX 100000
+#define BENCH_WARMUP_DEFAULT 2
+#define BENCH_WARMUP_MAX 1000
+#define BENCH_CONCURRENCY_MAX 16
+
 /* ==========================================================================
  * History
  * ========================================================================== */
@@ -152,8 +192,11 @@
 /* Maximum columns for multi-column sort */
 #define MAX_SORT_COLUMNS 8
 
-/* Maximum values in IN() filter clause */
-#define MAX_IN_VALUES 1000
+/* Maximum columns of a table's total row order (sort plus primary key) */
+#define MAX_KEY_COLUMNS (MAX_SORT_COLUMNS + MAX_PK_COLUMNS)
+
+/* IN filters with more values bind them as one array parameter */
+#define IN_ARRAY_MIN_VALUES 100
 
 /* Maximum folder nesting depth for saved connections */
 #define MAX_FOLDER_DEPTH 100
@@ -13,6 +13,8 @@
 #include "../util/str.h"
 #include "app_state.h"
 #include <ctype.h>
+#include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -42,6 +44,8 @@ static const FilterOpDef FILTER_OPS[] = {
     [FILTER_OP_IS_NOT_EMPTY] = {"is not empty", NULL, false},
     [FILTER_OP_IS_NULL] = {"is null", NULL, false},
     [FILTER_OP_IS_NOT_NULL] = {"is not null", NULL, false},
+    [FILTER_OP_STARTS_WITH] = {"prefix (Aa)", NULL, true},
+    [FILTER_OP_ICONTAINS] = {"icontains", NULL, true},
     [FILTER_OP_RAW] = {"RAW", NULL, true},
 };
 
@@ -59,6 +63,7 @@ void filters_init(TableFilters *f) {
 void filters_free(TableFilters *f) {
   if (!f)
     return;
+  filters_clear(f);
   FREE_NULL(f->filters);
   f->num_filters = 0;
   f->filters_cap = 0;
@@ -67,6 +72,8 @@ void filters_free(TableFilters *f) {
 void filters_clear(TableFilters *f) {
   if (!f)
     return;
+  for (size_t i = 0; i < f->num_filters; i++)
+    FREE_NULL(f->filters[i].long_value);
   f->num_filters = 0;
 }
 
@@ -85,26 +92,39 @@ bool filters_add(TableFilters *f, size_t col_idx, FilterOperator op,
   ColumnFilter *cf = &f->filters[f->num_filters];
   cf->column_index = col_idx;
   cf->op = op;
-  if (value) {
-    size_t len = strlen(value);
-    if (len >= sizeof(cf->value)) {
-      /* Value too long - reject instead of silent truncation */
-      return false;
-    }
-    memcpy(cf->value, value, len + 1);
-  } else {
-    cf->value[0] = '\0';
-  }
+  cf->long_value = NULL;
+  filter_set_value(cf, value);
   cf->value2[0] = '\0'; /* Initialize second value for BETWEEN */
 
   f->num_filters++;
   return true;
 }
 
+void filters_copy(TableFilters *dst, const TableFilters *src) {
+  if (!dst)
+    return;
+  filters_clear(dst);
+  if (!src || src->num_filters == 0)
+    return;
+
+  if (dst->filters_cap < src->num_filters) {
+    dst->filters =
+        safe_reallocarray(dst->filters, src->num_filters, sizeof(ColumnFilter));
+    dst->filters_cap = src->num_filters;
+  }
+  memcpy(dst->filters, src->filters, src->num_filters * sizeof(ColumnFilter));
+  for (size_t i = 0; i < src->num_filters; i++) {
+    if (src->filters[i].long_value)
+      dst->filters[i].long_value = str_dup(src->filters[i].long_value);
+  }
+  dst->num_filters = src->num_filters;
+}
+
 void filters_remove(TableFilters *f, size_t index) {
   if (!f || index >= f->num_filters)
     return;
 
+  free(f->filters[index].long_value);
   /* Shift remaining filters down */
   for (size_t i = index; i < f->num_filters - 1; i++) {
     f->filters[i] = f->filters[i + 1];
@@ -135,6 +155,29 @@ bool filter_op_needs_value(FilterOperator op) {
   return FILTER_OPS[op].needs_value;
 }
 
+bool filter_is_active(const ColumnFilter *cf) {
+  if (!cf)
+    return false;
+  /* Filters missing a required value are skipped, as are RAW filters
+   * (virtual column) without an expression and half-filled BETWEENs */
+  bool is_raw = (cf->column_index == SIZE_MAX);
+  if (cf->value[0] == '\0' && (is_raw || filter_op_needs_value(cf->op)))
+    return false;
+  if (cf->op == FILTER_OP_BETWEEN && cf->value2[0] == '\0')
+    return false;
+  return true;
+}
+
+bool filter_equal(const ColumnFilter *a, const ColumnFilter *b) {
+  if (!a || !b)
+    return false;
+  if (a->column_index != b->column_index || a->op != b->op)
+    return false;
+  if (strcmp(filter_value(a), filter_value(b)) != 0)
+    return false;
+  return a->op != FILTER_OP_BETWEEN || strcmp(a->value2, b->value2) == 0;
+}
+
 /* ============================================================================
  * SQL Building Helpers
  * ============================================================================
@@ -173,20 +216,28 @@ static char *escape_sql_value(const char *value) {
   return sb_to_string(sb);
 }
 
-char *filters_parse_in_values(const char *input, char **err) {
+/* One value of an IN list */
+typedef struct {
+  char *text;
+  bool quoted;
+} InValue;
+
+static void in_values_free(InValue *vals, size_t count) {
+  for (size_t i = 0; i < count; i++)
+    free(vals[i].text);
+  free(vals);
+}
+
+/* Split an IN list ("1, 2, 'three'", optionally in parentheses) into its
+ * values. Returns NULL with *err set if it is empty. */
+static InValue *in_values_split(const char *input, size_t *count, char **err) {
+  *count = 0;
   if (!input || !*input) {
     if (err)
       *err = str_dup("Empty value list");
     return NULL;
   }
 
-  StringBuilder *sb = sb_new(strlen(input) * 2);
-  if (!sb) {
-    if (err)
-      *err = str_dup("Out of memory");
-    return NULL;
-  }
-
   const char *p = input;
 
   /* Skip leading whitespace and optional ( */
@@ -195,87 +246,50 @@ char *filters_parse_in_values(const char *input, char **err) {
   if (*p == '(')
     p++;
 
-/* Limit number of values to prevent DoS (MAX_IN_VALUES from constants.h) */
-  size_t value_count = 0;
-
-  bool first = true;
-  bool ok = true; /* Track StringBuilder operation success */
-  while (*p && ok) {
+  InValue *vals = NULL;
+  size_t cap = 0;
+  while (*p) {
     /* Skip whitespace */
     while (*p && isspace((unsigned char)*p))
       p++;
     if (!*p || *p == ')')
       break;
 
-    /* Check value limit */
-    if (value_count >= MAX_IN_VALUES) {
-      sb_free(sb);
-      if (err)
-        *err = str_dup("Too many values in IN clause (max 1000)");
-      return NULL;
-    }
-    value_count++;
-
-    if (!first)
-      ok = sb_append(sb, ", ");
-    first = false;
-
-    if (*p == '\'' || *p == '"') {
+    const char *start;
+    const char *end;
+    bool quoted = *p == '\'' || *p == '"';
+    if (quoted) {
       /* Quoted value - find closing quote */
       char quote = *p;
       p++;
-      const char *start = p;
+      start = p;
       while (*p && *p != quote) {
         if (*p == '\\' && *(p + 1))
           p++; /* Skip escaped chars */
         p++;
       }
-      ok = ok && sb_append_char(sb, '\'');
-      /* Copy and escape single quotes */
-      for (const char *c = start; c < p && ok; c++) {
-        if (*c == '\'')
-          ok = sb_append(sb, "''");
-        else
-          ok = sb_append_char(sb, *c);
-      }
-      ok = ok && sb_append_char(sb, '\'');
+      end = p;
       if (*p == quote)
         p++;
     } else {
       /* Unquoted value - read until comma or end */
-      const char *start = p;
+      start = p;
       while (*p && *p != ',' && *p != ')')
         p++;
       /* Trim trailing whitespace */
-      const char *end = p;
+      end = p;
       while (end > start && isspace((unsigned char)*(end - 1)))
         end--;
+    }
 
-      if (end > start) {
-        /* Check if numeric */
-        bool is_numeric = true;
-        for (const char *c = start; c < end; c++) {
-          if (!isdigit((unsigned char)*c) && *c != '.' && *c != '-' &&
-              *c != '+') {
-            is_numeric = false;
-            break;
-          }
-        }
-
-        if (is_numeric) {
-          ok = sb_append_len(sb, start, (size_t)(end - start));
-        } else {
-          ok = sb_append_char(sb, '\'');
-          /* Escape single quotes in value */
-          for (const char *c = start; c < end && ok; c++) {
-            if (*c == '\'')
-              ok = sb_append(sb, "''");
-            else
-              ok = sb_append_char(sb, *c);
-          }
-          ok = ok && sb_append_char(sb, '\'');
-        }
+    if (quoted || end > start) {
+      if (*count == cap) {
+        cap = cap ? cap * 2 : 16;
+        vals = safe_reallocarray(vals, cap, sizeof(InValue));
       }
+      vals[*count].text = str_ndup(start, (size_t)(end - start));
+      vals[*count].quoted = quoted;
+      (*count)++;
     }
 
     /* Skip comma */
@@ -285,6 +299,250 @@ char *filters_parse_in_values(const char *input, char **err) {
       p++;
   }
 
+  if (*count == 0) {
+    free(vals);
+    if (err)
+      *err = str_dup("Empty value list");
+    return NULL;
+  }
+  return vals;
+}
+
+/* Whether text is a plain decimal number: [+-]digits, and unless integer,
+ * an optional fraction and exponent. Nothing the database could read as
+ * anything else (hex, inf, nan) passes. */
+static bool is_plain_number(const char *text, bool integer) {
+  const char *p = text;
+  if (*p == '+' || *p == '-')
+    p++;
+  size_t digits = 0;
+  while (isdigit((unsigned char)*p)) {
+    p++;
+    digits++;
+  }
+  if (integer)
+    return digits > 0 && *p == '\0';
+
+  if (*p == '.') {
+    p++;
+    while (isdigit((unsigned char)*p)) {
+      p++;
+      digits++;
+    }
+  }
+  if (digits == 0)
+    return false;
+  if (*p == 'e' || *p == 'E') {
+    p++;
+    if (*p == '+' || *p == '-')
+      p++;
+    if (!isdigit((unsigned char)*p))
+      return false;
+    while (isdigit((unsigned char)*p))
+      p++;
+  }
+  return *p == '\0';
+}
+
+/* A filter value typed after its column: integers for integer columns,
+ * numbers for numeric ones, text otherwise (the server converts text
+ * compared with a date, time or the like itself). *numeric is set when the
+ * value is a number to write without quotes. */
+static DbValue typed_value(const char *text, DbValueType type, bool *numeric) {
+  *numeric = false;
+  if (type != DB_TYPE_INT && type != DB_TYPE_FLOAT)
+    return db_value_text(text);
+
+  if (type == DB_TYPE_INT && is_plain_number(text, true)) {
+    errno = 0;
+    long long v = strtoll(text, NULL, 10);
+    if (errno != ERANGE) {
+      *numeric = true;
+      return db_value_int((int64_t)v);
+    }
+  }
+  /* Fractions against integer columns compare as numbers too */
+  if (is_plain_number(text, false)) {
+    errno = 0;
+    double v = strtod(text, NULL);
+    if (errno != ERANGE) {
+      *numeric = true;
+      return db_value_float(v);
+    }
+  }
+  return db_value_text(text);
+}
+
+/* ============================================================================
+ * WHERE Clause Building
+ * ============================================================================
+ */
+
+/* WHERE clause being compiled. Values go to params behind placeholders
+ * when binding, or into the SQL as literals otherwise. */
+typedef struct {
+  StringBuilder *sb;
+  bool bind;
+  bool dollar; /* $n placeholders (PostgreSQL) rather than ? */
+  DbValue *params;
+  size_t num_params;
+  size_t params_cap;
+} WhereBuilder;
+
+/* Append a value: a placeholder bound to val, or val's text as a literal
+ * (bare if numeric). Takes ownership of val. */
+static bool where_value(WhereBuilder *wb, DbValue val, const char *text,
+                        bool numeric) {
+  if (!wb->bind) {
+    db_value_free(&val);
+    if (numeric)
+      return sb_append(wb->sb, text);
+    char *escaped = escape_sql_value(text);
+    bool ok = escaped && sb_printf(wb->sb, "'%s'", escaped);
+    free(escaped);
+    return ok;
+  }
+
+  if (wb->num_params == wb->params_cap) {
+    wb->params_cap = wb->params_cap ? wb->params_cap * 2 : 8;
+    wb->params =
+        safe_reallocarray(wb->params, wb->params_cap, sizeof(DbValue));
+  }
+  wb->params[wb->num_params++] = val;
+  if (wb->dollar)
+    return sb_printf(wb->sb, "$%zu", wb->num_params);
+  return sb_append_char(wb->sb, '?');
+}
+
+/* Append a filter value typed after its column */
+static bool where_typed(WhereBuilder *wb, const char *text, DbValueType type) {
+  bool numeric;
+  DbValue val = typed_value(text, type, &numeric);
+  return where_value(wb, val, text, numeric);
+}
+
+/* Append a text value wrapped in prefix and suffix (LIKE/GLOB patterns) */
+static bool where_pattern(WhereBuilder *wb, const char *prefix,
+                          const char *text, const char *suffix) {
+  char *pattern = str_printf("%s%s%s", prefix, text, suffix);
+  if (!pattern)
+    return false;
+  bool ok = where_value(wb, db_value_text(pattern), pattern, false);
+  free(pattern);
+  return ok;
+}
+
+/* text with its pattern metacharacters made literal: for GLOB each in a
+ * one-character class ([*]), for LIKE behind the '!' ESCAPE character */
+static char *pattern_literal(const char *text, bool glob) {
+  StringBuilder *sb = sb_new(strlen(text) * 3 + 1);
+  bool ok = sb != NULL;
+  for (const char *p = text; *p && ok; p++) {
+    if (glob && strchr("*?[]", *p))
+      ok = sb_printf(sb, "[%c]", *p);
+    else if (!glob && strchr("%_!", *p))
+      ok = sb_append_char(sb, '!') && sb_append_char(sb, *p);
+    else
+      ok = sb_append_char(sb, *p);
+  }
+  if (!ok) {
+    sb_free(sb);
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+/* Append text as a double-quoted element: a JSON string, or an element of
+ * a PostgreSQL array literal, which escapes the same two characters */
+static bool append_quoted_element(StringBuilder *sb, const char *text,
+                                  bool json) {
+  bool ok = sb_append_char(sb, '"');
+  for (const unsigned char *p = (const unsigned char *)text; *p && ok; p++) {
+    if (*p == '"' || *p == '\\')
+      ok = sb_append_char(sb, '\\') && sb_append_char(sb, (char)*p);
+    else if (json && *p < 0x20)
+      ok = sb_printf(sb, "\\u%04x", *p);
+    else
+      ok = sb_append_char(sb, (char)*p);
+  }
+  return ok && sb_append_char(sb, '"');
+}
+
+/* Append a long IN list as a test against one array value, so the
+ * statement is the same whatever the list holds: = ANY($n) on PostgreSQL,
+ * which types the array after the column, and a json_each() subquery on
+ * SQLite, with numbers for numeric columns */
+static bool where_in_array(WhereBuilder *wb, const char *col,
+                           const InValue *vals, size_t count,
+                           DbValueType type, bool postgres) {
+  StringBuilder *arr = sb_new(count * 8 + 2);
+  if (!arr)
+    return false;
+  bool ok = sb_append_char(arr, postgres ? '{' : '[');
+  for (size_t i = 0; i < count && ok; i++) {
+    if (i > 0)
+      ok = sb_append_char(arr, ',');
+    bool numeric;
+    DbValue val = typed_value(vals[i].text, type, &numeric);
+    if (!postgres && val.type == DB_TYPE_INT) {
+      ok = ok && sb_printf(arr, "%lld", (long long)val.int_val);
+    } else if (!postgres && val.type == DB_TYPE_FLOAT) {
+      char *num = str_from_double(val.float_val);
+      ok = ok && num && sb_append(arr, num);
+      free(num);
+    } else {
+      ok = ok && append_quoted_element(arr, vals[i].text, !postgres);
+    }
+    db_value_free(&val);
+  }
+  ok = ok && sb_append_char(arr, postgres ? '}' : ']');
+  if (!ok) {
+    sb_free(arr);
+    return false;
+  }
+  char *text = sb_to_string(arr);
+  if (!text)
+    return false;
+
+  if (postgres)
+    ok = sb_printf(wb->sb, "%s = ANY(", col);
+  else
+    ok = sb_printf(wb->sb, "%s IN (SELECT value FROM json_each(", col);
+  ok = ok && where_value(wb, db_value_text(text), text, false);
+  ok = ok && sb_append(wb->sb, postgres ? ")" : "))");
+  free(text);
+  return ok;
+}
+
+char *filters_parse_in_values(const char *input, char **err) {
+  size_t count = 0;
+  InValue *vals = in_values_split(input, &count, err);
+  if (!vals)
+    return NULL;
+
+  StringBuilder *sb = sb_new(strlen(input) * 2);
+  if (!sb) {
+    in_values_free(vals, count);
+    if (err)
+      *err = str_dup("Out of memory");
+    return NULL;
+  }
+
+  /* Quoted and non-numeric values become string literals */
+  bool ok = true; /* Track StringBuilder operation success */
+  for (size_t i = 0; i < count && ok; i++) {
+    if (i > 0)
+      ok = sb_append(sb, ", ");
+    if (ok && !vals[i].quoted && is_plain_number(vals[i].text, false)) {
+      ok = sb_append(sb, vals[i].text);
+    } else if (ok) {
+      char *escaped = escape_sql_value(vals[i].text);
+      ok = escaped && sb_printf(sb, "'%s'", escaped);
+      free(escaped);
+    }
+  }
+  in_values_free(vals, count);
+
   if (!ok) {
     sb_free(sb);
     if (err)
@@ -296,12 +554,44 @@ char *filters_parse_in_values(const char *input, char **err) {
 }
 
 /* ============================================================================
- * WHERE Clause Building
+ * Long Values
  * ============================================================================
  */
 
-char *filters_build_where(TableFilters *f, TableSchema *schema,
-                          const char *driver_name, char **err) {
+const char *filter_value(const ColumnFilter *cf) {
+  return cf->long_value ? cf->long_value : cf->value;
+}
+
+void filter_set_value(ColumnFilter *cf, const char *value) {
+  FREE_NULL(cf->long_value);
+  if (!value)
+    value = "";
+  size_t len = strlen(value);
+  if (len < sizeof(cf->value)) {
+    memcpy(cf->value, value, len + 1);
+    return;
+  }
+  cf->long_value = str_dup(value);
+
+  /* Preview: how many values the list holds, then as much of it as fits */
+  size_t count = 0;
+  InValue *vals = in_values_split(value, &count, NULL);
+  in_values_free(vals, count);
+  int head = snprintf(cf->value, sizeof(cf->value), "(%zu values) ", count);
+  size_t room = sizeof(cf->value) - (size_t)head - sizeof("...");
+  while (room > 0 && ((unsigned char)value[room] & 0xC0) == 0x80)
+    room--; /* Don't split a UTF-8 sequence */
+  memcpy(cf->value + head, value, room);
+  memcpy(cf->value + head + room, "...", sizeof("..."));
+}
+
+char *filters_compile_where(TableFilters *f, TableSchema *schema,
+                            const char *driver_name, DbValue **params,
+                            size_t *num_params, char **err) {
+  if (params)
+    *params = NULL;
+  if (num_params)
+    *num_params = 0;
   if (!f || !schema)
     return NULL;
 
@@ -309,17 +599,22 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
   if (f->num_filters == 0)
     return NULL;
 
-  StringBuilder *sb = sb_new(256);
-  if (!sb) {
+  WhereBuilder wb = {0};
+  wb.sb = sb_new(256);
+  if (!wb.sb) {
     if (err)
       *err = str_dup("Out of memory");
     return NULL;
   }
+  wb.bind = params && num_params;
+  bool pg = db_driver_is_postgres(driver_name);
+  wb.dollar = pg;
 
   bool first = true;
   bool ok = true; /* Track StringBuilder operation success */
   bool use_backticks =
       str_eq(driver_name, "mysql") || str_eq(driver_name, "mariadb");
+  StringBuilder *sb = wb.sb;
 
   /* Process each column filter */
   if (!f->filters && f->num_filters > 0) {
@@ -335,13 +630,15 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
      * Operators like IS NULL, IS NOT NULL, IS EMPTY, IS NOT EMPTY don't need
      * values. RAW filters also need a value (the SQL expression).
      * BETWEEN requires both values to be non-empty. */
-    bool is_raw = (cf->column_index == SIZE_MAX);
-    if (cf->value[0] == '\0' && (is_raw || filter_op_needs_value(cf->op))) {
+    if (!filter_is_active(cf)) {
       continue;
     }
-    if (cf->op == FILTER_OP_BETWEEN && cf->value2[0] == '\0') {
+    const char *value = filter_value(cf);
+
+    /* Validate column index (RAW filters are a virtual column) */
+    if (cf->column_index != SIZE_MAX &&
+        cf->column_index >= schema->num_columns)
       continue;
-    }
 
     if (!first)
       ok = sb_append(sb, " AND ");
@@ -350,15 +647,12 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
     /* Handle RAW filters (virtual column) - advanced feature for SQL-savvy
      * users */
     if (cf->column_index == SIZE_MAX) {
-      ok = ok && sb_printf(sb, "(%s)", cf->value);
+      ok = ok && sb_printf(sb, "(%s)", value);
       continue;
     }
 
-    /* Validate column index */
-    if (cf->column_index >= schema->num_columns)
-      continue;
-
     const char *col_name = schema->columns[cf->column_index].name;
+    DbValueType col_type = schema->columns[cf->column_index].type;
 
     /* Escape column name */
     char *escaped_col;
@@ -367,8 +661,10 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
     } else {
       escaped_col = str_escape_identifier_dquote(col_name);
     }
-    if (!escaped_col)
-      continue;
+    if (!escaped_col) {
+      ok = false;
+      break;
+    }
 
     switch (cf->op) {
     case FILTER_OP_EQ:
@@ -376,67 +672,83 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
     case FILTER_OP_GT:
     case FILTER_OP_GE:
     case FILTER_OP_LT:
-    case FILTER_OP_LE: {
-      char *escaped_val = escape_sql_value(cf->value);
-      ok = sb_printf(sb, "%s %s '%s'", escaped_col, filter_op_sql(cf->op),
-                     escaped_val ? escaped_val : "");
-      free(escaped_val);
+    case FILTER_OP_LE:
+      ok = ok && sb_printf(sb, "%s %s ", escaped_col, filter_op_sql(cf->op));
+      ok = ok && where_typed(&wb, value, col_type);
       break;
-    }
 
     case FILTER_OP_IN: {
-      char *in_err = NULL;
-      char *in_list = filters_parse_in_values(cf->value, &in_err);
-      if (in_list) {
-        ok = sb_printf(sb, "%s IN (%s)", escaped_col, in_list);
-        free(in_list);
-      } else {
+      size_t count = 0;
+      InValue *vals = in_values_split(value, &count, NULL);
+      /* MySQL's values are sent inline, where an array gains nothing */
+      bool sqlite = str_eq(driver_name, "sqlite");
+      if (count > IN_ARRAY_MIN_VALUES && (pg || sqlite)) {
+        ok = ok && where_in_array(&wb, escaped_col, vals, count, col_type, pg);
+        in_values_free(vals, count);
+        break;
+      }
+      ok = ok && sb_printf(sb, "%s IN (", escaped_col);
+      if (!vals) {
         /* Fall back to empty IN */
-        ok = sb_printf(sb, "%s IN (NULL)", escaped_col);
-        free(in_err);
+        ok = ok && sb_append(sb, "NULL");
+      }
+      for (size_t v = 0; v < count && ok; v++) {
+        if (v > 0)
+          ok = sb_append(sb, ", ");
+        ok = ok && where_typed(&wb, vals[v].text, col_type);
       }
+      ok = ok && sb_append_char(sb, ')');
+      in_values_free(vals, count);
       break;
     }
 
-    case FILTER_OP_CONTAINS: {
-      char *escaped_val = escape_sql_value(cf->value);
+    case FILTER_OP_CONTAINS:
       /* Escape LIKE wildcards */
-      ok = sb_printf(sb, "%s LIKE '%%%s%%'", escaped_col,
-                     escaped_val ? escaped_val : "");
-      free(escaped_val);
+      ok = ok && sb_printf(sb, "%s LIKE ", escaped_col);
+      ok = ok && where_pattern(&wb, "%", value, "%");
+      break;
+
+    case FILTER_OP_STARTS_WITH: {
+      /* SQLite's LIKE ignores case, so only GLOB can use an index; the
+       * prefix matches as typed, wildcards included */
+      bool glob = str_eq(driver_name, "sqlite");
+      char *literal = pattern_literal(value, glob);
+      ok = ok && literal;
+      ok = ok && sb_printf(sb, "%s %s ", escaped_col, glob ? "GLOB" : "LIKE");
+      ok = ok && where_pattern(&wb, "", literal, glob ? "*" : "%");
+      if (!glob)
+        ok = ok && sb_append(sb, " ESCAPE '!'");
+      free(literal);
       break;
     }
 
-    case FILTER_OP_REGEX: {
-      char *escaped_val = escape_sql_value(cf->value);
+    case FILTER_OP_ICONTAINS:
+      /* LIKE already ignores case on SQLite and MySQL's _ci collations */
+      ok = ok && sb_printf(sb, "%s %s ", escaped_col, pg ? "ILIKE" : "LIKE");
+      ok = ok && where_pattern(&wb, "%", value, "%");
+      break;
+
+    case FILTER_OP_REGEX:
       /* Driver-specific regex */
       if (str_eq(driver_name, "mysql") || str_eq(driver_name, "mariadb")) {
-        ok = sb_printf(sb, "%s REGEXP '%s'", escaped_col,
-                       escaped_val ? escaped_val : "");
-      } else if (str_eq(driver_name, "postgres") ||
-                 str_eq(driver_name, "postgresql") ||
-                 str_eq(driver_name, "pg")) {
-        ok = sb_printf(sb, "%s ~ '%s'", escaped_col,
-                       escaped_val ? escaped_val : "");
+        ok = ok && sb_printf(sb, "%s REGEXP ", escaped_col);
+        ok = ok && where_pattern(&wb, "", value, "");
+      } else if (pg) {
+        ok = ok && sb_printf(sb, "%s ~ ", escaped_col);
+        ok = ok && where_pattern(&wb, "", value, "");
       } else {
         /* SQLite - use GLOB as fallback (not true regex) */
-        ok = sb_printf(sb, "%s GLOB '*%s*'", escaped_col,
-                       escaped_val ? escaped_val : "");
+        ok = ok && sb_printf(sb, "%s GLOB ", escaped_col);
+        ok = ok && where_pattern(&wb, "*", value, "*");
       }
-      free(escaped_val);
       break;
-    }
 
-    case FILTER_OP_BETWEEN: {
-      char *escaped_val1 = escape_sql_value(cf->value);
-      char *escaped_val2 = escape_sql_value(cf->value2);
-      ok = sb_printf(sb, "%s BETWEEN '%s' AND '%s'", escaped_col,
-                     escaped_val1 ? escaped_val1 : "",
-                     escaped_val2 ? escaped_val2 : "");
-      free(escaped_val1);
-      free(escaped_val2);
+    case FILTER_OP_BETWEEN:
+      ok = ok && sb_printf(sb, "%s BETWEEN ", escaped_col);
+      ok = ok && where_typed(&wb, value, col_type);
+      ok = ok && sb_append(sb, " AND ");
+      ok = ok && where_typed(&wb, cf->value2, col_type);
       break;
-    }
 
     case FILTER_OP_IS_EMPTY:
       ok = sb_printf(sb, "%s = ''", escaped_col);
@@ -456,7 +768,7 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
 
     case FILTER_OP_RAW:
       /* This case shouldn't occur - RAW is now a virtual column */
-      ok = sb_printf(sb, "(%s)", cf->value);
+      ok = sb_printf(sb, "(%s)", value);
       break;
 
     default:
@@ -466,19 +778,144 @@ char *filters_build_where(TableFilters *f, TableSchema *schema,
     free(escaped_col);
   }
 
-  /* Check for allocation failure */
-  if (!ok) {
+  /* Check for allocation failure; if all filters were skipped, there is no
+   * WHERE clause */
+  if (!ok || first) {
     sb_free(sb);
-    if (err)
+    FREE_ARRAY(wb.params, wb.num_params, db_value_free);
+    if (!ok && err)
       *err = str_dup("Out of memory");
     return NULL;
   }
 
-  /* If all filters were skipped, return NULL */
-  if (first) {
-    sb_free(sb);
-    return NULL;
+  if (wb.bind) {
+    *params = wb.params;
+    *num_params = wb.num_params;
   }
-
   return sb_to_string(sb);
 }
+
+char *filters_build_where(TableFilters *f, TableSchema *schema,
+                          const char *driver_name, char **err) {
+  return filters_compile_where(f, schema, driver_name, NULL, NULL, err);
+}
+
+/* ============================================================================
+ * Index Advice
+ * ============================================================================
+ */
+
+/* What an index can look up */
+typedef enum {
+  INDEX_SERVES_ORDER,   /* Sorted keys: B-tree, SQLite */
+  INDEX_SERVES_EQUAL,   /* Hashed keys */
+  INDEX_SERVES_RANGE,   /* Block ranges: BRIN */
+  INDEX_SERVES_PATTERN, /* Trigrams: GIN/GiST */
+  INDEX_SERVES_NONE,    /* FULLTEXT, SPATIAL, ... */
+} IndexServes;
+
+static IndexServes index_serves(const IndexDef *idx, const char *driver_name) {
+  const char *type = idx->type;
+  if (!type || !*type || str_eq_nocase(type, "btree"))
+    return INDEX_SERVES_ORDER;
+  if (str_eq_nocase(type, "hash"))
+    return INDEX_SERVES_EQUAL;
+  if (str_eq_nocase(type, "brin"))
+    return INDEX_SERVES_RANGE;
+  if (db_driver_is_postgres(driver_name) &&
+      (str_eq_nocase(type, "gin") || str_eq_nocase(type, "gist")))
+    return INDEX_SERVES_PATTERN;
+  return INDEX_SERVES_NONE;
+}
+
+static bool serves_op(IndexServes serves, FilterOperator op) {
+  switch (op) {
+  case FILTER_OP_EQ:
+  case FILTER_OP_IN:
+    return serves == INDEX_SERVES_ORDER || serves == INDEX_SERVES_EQUAL ||
+           serves == INDEX_SERVES_RANGE;
+  case FILTER_OP_GT:
+  case FILTER_OP_GE:
+  case FILTER_OP_LT:
+  case FILTER_OP_LE:
+  case FILTER_OP_BETWEEN:
+    return serves == INDEX_SERVES_ORDER || serves == INDEX_SERVES_RANGE;
+  case FILTER_OP_IS_EMPTY:
+  case FILTER_OP_IS_NULL:
+    return serves == INDEX_SERVES_ORDER;
+  case FILTER_OP_STARTS_WITH:
+    return serves == INDEX_SERVES_ORDER || serves == INDEX_SERVES_PATTERN;
+  case FILTER_OP_CONTAINS:
+  case FILTER_OP_ICONTAINS:
+  case FILTER_OP_REGEX:
+    return serves == INDEX_SERVES_PATTERN;
+  default:
+    return false; /* <>, IS NOT NULL, ... match most of the table */
+  }
+}
+
+bool filter_op_uses_index(FilterOperator op, size_t col_idx,
+                          const TableSchema *schema, const char *driver_name) {
+  if (!schema || col_idx >= schema->num_columns)
+    return false;
+  const char *col = schema->columns[col_idx].name;
+
+  /* SQLite's INTEGER PRIMARY KEY is the rowid, listed under no index */
+  size_t num_pk = 0;
+  for (size_t i = 0; i < schema->num_columns; i++)
+    num_pk += schema->columns[i].primary_key;
+  if (num_pk == 1 && schema->columns[col_idx].primary_key &&
+      serves_op(INDEX_SERVES_ORDER, op))
+    return true;
+
+  for (size_t i = 0; i < schema->num_indexes; i++) {
+    const IndexDef *idx = &schema->indexes[i];
+    IndexServes serves = index_serves(idx, driver_name);
+    if (!serves_op(serves, op))
+      continue;
+    /* Trigram indexes look up each column; the others only their first */
+    size_t usable = serves == INDEX_SERVES_PATTERN ? idx->num_columns : 1;
+    for (size_t c = 0; c < usable && c < idx->num_columns; c++) {
+      if (str_eq(idx->columns[c], col))
+        return true;
+    }
+  }
+  return false;
+}
+
+FilterIndexUse filter_index_use(const ColumnFilter *cf,
+                                const TableSchema *schema,
+                                const char *driver_name) {
+  if (!cf || !schema || cf->column_index >= schema->num_columns ||
+      !filter_is_active(cf))
+    return FILTER_INDEX_NONE;
+  return filter_op_uses_index(cf->op, cf->column_index, schema, driver_name)
+             ? FILTER_INDEX_USED
+             : FILTER_INDEX_SCAN;
+}
+
+FilterOperator filter_index_suggestion(const ColumnFilter *cf,
+                                       const TableSchema *schema,
+                                       const char *driver_name) {
+  if (filter_index_use(cf, schema, driver_name) != FILTER_INDEX_SCAN)
+    return cf ? cf->op : FILTER_OP_EQ;
+
+  /* Only pattern matches have a near variant; nothing narrows <> */
+  if (cf->op != FILTER_OP_CONTAINS && cf->op != FILTER_OP_ICONTAINS &&
+      cf->op != FILTER_OP_REGEX)
+    return cf->op;
+
+  DbValueType type = schema->columns[cf->column_index].type;
+  bool temporal = type == DB_TYPE_TIMESTAMP || type == DB_TYPE_DATE;
+  const FilterOperator candidates[] = {
+      temporal ? FILTER_OP_BETWEEN : FILTER_OP_STARTS_WITH,
+      FILTER_OP_STARTS_WITH,
+      FILTER_OP_ICONTAINS,
+  };
+  for (size_t i = 0; i < sizeof(candidates) / sizeof(candidates[0]); i++) {
+    if (filter_op_uses_index(candidates[i], cf->column_index, schema,
+                             driver_name))
+      return candidates[i];
+  }
+  return cf->op;
+}
@@ -0,0 +1,184 @@
+/*
+ * Lace
+ * Landmark index - sampled sort keys for random access into large tables
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "landmark.h"
+#include "../async/async.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <stdlib.h>
+#include <string.h>
+#include <time.h>
+
+bool landmark_key_usable(const SortKey *key, const TableSchema *schema) {
+  if (!key || !schema || !key->unique || key->num_cols == 0)
+    return false;
+
+  for (size_t i = 0; i < key->num_cols; i++) {
+    if (key->cols[i] >= schema->num_columns)
+      return false;
+    const ColumnDef *col = &schema->columns[key->cols[i]];
+    /* NULLs sort differently per database and never compare equal */
+    if (!col->name || col->type == DB_TYPE_BLOB ||
+        (col->nullable && !col->primary_key))
+      return false;
+  }
+  return true;
+}
+
+bool landmark_matches(const LandmarkIndex *lm, const char *table,
+                      const char *where, const char *order) {
+  return lm && lm->table && str_eq(lm->table, table) &&
+         str_eq(lm->where, where) && str_eq(lm->order, order);
+}
+
+static void clear_keys(LandmarkIndex *lm) {
+  if (lm->keys) {
+    for (size_t i = 0; i < lm->num_marks * lm->key.num_cols; i++)
+      db_value_free(&lm->keys[i]);
+    free(lm->keys);
+  }
+  lm->keys = NULL;
+  lm->num_marks = 0;
+  lm->ready = false;
+}
+
+static void clear_target(LandmarkIndex *lm) {
+  FREE_NULL(lm->table);
+  FREE_NULL(lm->where);
+  FREE_NULL(lm->order);
+  lm->failed = false;
+}
+
+bool landmark_build_start(LandmarkIndex *lm, DbConnection *conn,
+                          const TableSchema *schema, const char *table,
+                          const char *where, const char *order,
+                          const SortKey *key, size_t total_rows) {
+  if (!lm || lm->build_op || !conn || !conn->connstr || !table ||
+      !landmark_key_usable(key, schema))
+    return false;
+
+  size_t stride = (total_rows + LANDMARK_MAX_MARKS - 1) / LANDMARK_MAX_MARKS;
+  if (stride < LANDMARK_MIN_STRIDE)
+    stride = LANDMARK_MIN_STRIDE;
+
+  const char *names[MAX_KEY_COLUMNS];
+  for (size_t i = 0; i < key->num_cols; i++)
+    names[i] = schema->columns[key->cols[i]].name;
+
+  clear_keys(lm);
+  clear_target(lm);
+  lm->table = str_dup(table);
+  lm->where = where ? str_dup(where) : NULL;
+  lm->order = order ? str_dup(order) : NULL;
+  lm->key = *key;
+  lm->stride = stride;
+
+  char *err = NULL;
+  char *sql = db_build_landmark_sql(conn, table, names, key->num_cols, where,
+                                    order, stride, &err);
+  free(err);
+  if (!sql) {
+    lm->failed = true;
+    return false;
+  }
+
+  AsyncOperation *op = safe_malloc(sizeof(AsyncOperation));
+  async_init(op);
+  op->op_type = ASYNC_OP_QUERY_PRIVATE;
+  op->connstr = str_dup(conn->connstr);
+  op->sql = sql; /* ownership transferred */
+
+  if (!async_start(op)) {
+    async_free(op);
+    free(op);
+    lm->failed = true;
+    return false;
+  }
+  lm->build_op = op;
+  return true;
+}
+
+bool landmark_build_poll(LandmarkIndex *lm) {
+  if (!lm || !lm->build_op)
+    return false;
+
+  AsyncOperation *op = (AsyncOperation *)lm->build_op;
+  if (async_poll(op) == ASYNC_STATE_RUNNING)
+    return false;
+
+  ResultSet *rs = (ResultSet *)op->result;
+  op->result = NULL;
+
+  /* An invalidated build finishes with no target; its sample is stale */
+  if (lm->table) {
+    if (op->state == ASYNC_STATE_COMPLETED && rs && rs->num_rows > 0 &&
+        rs->num_columns == lm->key.num_cols) {
+      size_t n = lm->key.num_cols;
+      lm->keys = safe_calloc(rs->num_rows * n, sizeof(DbValue));
+      for (size_t r = 0; r < rs->num_rows; r++) {
+        for (size_t c = 0; c < n && c < rs->rows[r].num_cells; c++)
+          lm->keys[r * n + c] = db_value_copy(&rs->rows[r].cells[c]);
+      }
+      lm->num_marks = rs->num_rows;
+      lm->ready = true;
+    } else {
+      lm->failed = true;
+    }
+  }
+
+  db_result_free(rs);
+  async_free(op);
+  free(op);
+  lm->build_op = NULL;
+  return true;
+}
+
+const DbValue *landmark_seek(const LandmarkIndex *lm, size_t row,
+                             size_t *mark_row) {
+  if (!lm || !lm->ready || lm->num_marks == 0 || lm->stride == 0)
+    return NULL;
+
+  size_t mark = row / lm->stride;
+  if (mark >= lm->num_marks)
+    mark = lm->num_marks - 1;
+  if (mark_row)
+    *mark_row = mark * lm->stride;
+  return &lm->keys[mark * lm->key.num_cols];
+}
+
+void landmark_invalidate(LandmarkIndex *lm) {
+  if (!lm)
+    return;
+
+  /* The build is reaped by landmark_build_poll once it stops */
+  if (lm->build_op)
+    async_cancel((AsyncOperation *)lm->build_op);
+  clear_keys(lm);
+  clear_target(lm);
+}
+
+void landmark_index_free(LandmarkIndex *lm) {
+  if (!lm)
+    return;
+
+  if (lm->build_op) {
+    AsyncOperation *op = (AsyncOperation *)lm->build_op;
+    async_cancel(op);
+    async_wait(op, 500);
+    while (async_poll(op) == ASYNC_STATE_RUNNING) {
+      struct timespec ts = {0, 10000000L}; /* 10ms */
+      nanosleep(&ts, NULL);
+    }
+    db_result_free((ResultSet *)op->result);
+    async_free(op);
+    free(op);
+    lm->build_op = NULL;
+  }
+  clear_keys(lm);
+  clear_target(lm);
+}
@@ -0,0 +1,79 @@
+/*
+ * Lace
+ * Landmark index - sampled sort keys for random access into large tables
+ *
+ * OFFSET n makes the database step over n rows, so a jump deep into a big
+ * table (End, go to row) gets slower the farther it goes. A landmark index
+ * holds the sort key of every stride-th row of one table under one filter
+ * and sort order. A jump to row r then seeks to the nearest landmark by key
+ * - an index range scan - and only skips the r % stride rows after it.
+ *
+ * The sample is built by a background query on a connection of its own
+ * and is dropped when the table's data changes.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_LANDMARK_H
+#define LACE_LANDMARK_H
+
+#include "../db/db.h"
+#include "constants.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Total row order of a table tab: its sort columns, then the primary key
+ * columns not sorted on, ascending, as tie-breakers */
+typedef struct {
+  size_t cols[MAX_KEY_COLUMNS]; /* Schema column indexes */
+  bool desc[MAX_KEY_COLUMNS];   /* Descending per column */
+  size_t num_cols;
+  bool unique; /* Contains the whole primary key */
+} SortKey;
+
+/* Sampled keys of one table, filter and order */
+typedef struct {
+  char *table; /* What the positions hold for */
+  char *where; /* Filter predicate (NULL = none) */
+  char *order; /* ORDER BY clause */
+  SortKey key;
+  size_t stride;    /* Rows between landmarks */
+  DbValue *keys;    /* num_marks * key.num_cols values, mark i is row
+                       i * stride */
+  size_t num_marks;
+  bool ready;     /* keys are built and current */
+  bool failed;    /* Could not be built for this table/where/order */
+  void *build_op; /* AsyncOperation while the sample query runs */
+} LandmarkIndex;
+
+/* Whether a sort key can drive keyset seeks: unique, no NULLs, no blobs */
+bool landmark_key_usable(const SortKey *key, const TableSchema *schema);
+
+/* Whether the index was built (or is building, or failed) for this table,
+ * filter and order */
+bool landmark_matches(const LandmarkIndex *lm, const char *table,
+                      const char *where, const char *order);
+
+/* Start sampling total_rows rows of table in the background on a private
+ * connection opened from conn's connection string */
+bool landmark_build_start(LandmarkIndex *lm, DbConnection *conn,
+                          const TableSchema *schema, const char *table,
+                          const char *where, const char *order,
+                          const SortKey *key, size_t total_rows);
+
+/* Collect a finished build. Returns true once when the build ends. */
+bool landmark_build_poll(LandmarkIndex *lm);
+
+/* Keys of the nearest landmark at or before row, with its row in
+ * *mark_row. NULL if the index is not ready. */
+const DbValue *landmark_seek(const LandmarkIndex *lm, size_t row,
+                             size_t *mark_row);
+
+/* Drop the sample (data changed); a running build is cancelled */
+void landmark_invalidate(LandmarkIndex *lm);
+
+/* Free everything, waiting for a running build to stop */
+void landmark_index_free(LandmarkIndex *lm);
+
+#endif /* LACE_LANDMARK_H */
@@ -0,0 +1,305 @@
+/*
+ * Lace
+ * Live feed - notices of writes made by other sessions
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "live_feed.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* How the feed learns about writes */
+typedef enum {
+  LIVE_SOURCE_NOTIFY,       /* PostgreSQL LISTEN */
+  LIVE_SOURCE_UPDATE_TIME,  /* MySQL information_schema */
+  LIVE_SOURCE_DATA_VERSION, /* SQLite PRAGMA data_version */
+} LiveSource;
+
+/* Last UPDATE_TIME seen for a MySQL table */
+typedef struct {
+  char *table;
+  char *updated;
+} TableStamp;
+
+/* What the thread remembers between looks */
+typedef struct {
+  LiveSource source;
+  bool primed; /* A baseline was taken */
+  int64_t version;
+  TableStamp *stamps;
+  size_t num_stamps;
+} LiveProbe;
+
+static bool is_mysql(const DbConnection *conn) {
+  return str_eq(conn->driver->name, "mysql") ||
+         str_eq(conn->driver->name, "mariadb");
+}
+
+bool live_feed_supported(DbConnection *conn) {
+  if (!conn || !conn->driver || !conn->connstr)
+    return false;
+  if (str_eq(conn->driver->name, "postgres") || is_mysql(conn))
+    return true;
+  /* Another connection to an in-memory database opens a different one */
+  return conn->driver->data_version && conn->database &&
+         !strstr(conn->database, ":memory:");
+}
+
+static void stamps_free(TableStamp *stamps, size_t count) {
+  for (size_t i = 0; i < count; i++) {
+    free(stamps[i].table);
+    free(stamps[i].updated);
+  }
+  free(stamps);
+}
+
+/* Record a written table for the owner, once per take */
+static void feed_add_table(LiveFeed *feed, const char *table) {
+  if (!table || !*table)
+    return;
+  lace_mutex_lock(&feed->mutex);
+  bool seen = false;
+  for (size_t i = 0; i < feed->num_tables && !seen; i++)
+    seen = str_eq(feed->tables[i], table);
+  if (!seen) {
+    feed->tables = safe_reallocarray(feed->tables, feed->num_tables + 1,
+                                     sizeof(char *));
+    feed->tables[feed->num_tables++] = str_dup(table);
+  }
+  lace_mutex_unlock(&feed->mutex);
+}
+
+static void feed_add_all(LiveFeed *feed) {
+  lace_mutex_lock(&feed->mutex);
+  feed->all_tables = true;
+  lace_mutex_unlock(&feed->mutex);
+}
+
+/* Prepare conn for probing */
+static bool probe_setup(LiveProbe *probe, DbConnection *conn, char **err) {
+  memset(probe, 0, sizeof(LiveProbe));
+  if (str_eq(conn->driver->name, "postgres")) {
+    probe->source = LIVE_SOURCE_NOTIFY;
+    return db_exec(conn, "LISTEN " LIVE_FEED_CHANNEL, err) >= 0;
+  }
+  if (is_mysql(conn)) {
+    probe->source = LIVE_SOURCE_UPDATE_TIME;
+    /* MySQL 8 caches table statistics for a day unless told otherwise;
+     * MariaDB has no such variable */
+    char *ignored = NULL;
+    db_exec(conn, "SET SESSION information_schema_stats_expiry = 0",
+            &ignored);
+    free(ignored);
+    return true;
+  }
+  probe->source = LIVE_SOURCE_DATA_VERSION;
+  return true;
+}
+
+static bool probe_notify(LiveFeed *feed, DbConnection *conn, char **err) {
+  size_t count = 0;
+  char **payloads = db_notifications(conn, &count, err);
+  if (!payloads && err && *err)
+    return false;
+  for (size_t i = 0; i < count; i++) {
+    feed_add_table(feed, payloads[i]);
+    free(payloads[i]);
+  }
+  free(payloads);
+  return true;
+}
+
+static bool probe_update_time(LiveFeed *feed, LiveProbe *probe,
+                              DbConnection *conn, char **err) {
+  ResultSet *rs = db_query(conn,
+                           "SELECT TABLE_NAME, UPDATE_TIME FROM "
+                           "information_schema.TABLES WHERE TABLE_SCHEMA = "
+                           "DATABASE()",
+                           err);
+  if (!rs)
+    return false;
+
+  TableStamp *stamps = safe_calloc(rs->num_rows + 1, sizeof(TableStamp));
+  size_t n = 0;
+  for (size_t r = 0; r < rs->num_rows; r++) {
+    Row *row = &rs->rows[r];
+    if (row->num_cells < 2 || row->cells[0].is_null)
+      continue;
+    stamps[n].table = db_value_to_string(&row->cells[0]);
+    stamps[n].updated = row->cells[1].is_null
+                            ? NULL
+                            : db_value_to_string(&row->cells[1]);
+    if (!stamps[n].table) {
+      free(stamps[n].updated);
+      continue;
+    }
+
+    /* A table never written since the server started has no time yet */
+    const char *was = NULL;
+    bool known = false;
+    for (size_t i = 0; i < probe->num_stamps && !known; i++) {
+      if (str_eq(probe->stamps[i].table, stamps[n].table)) {
+        was = probe->stamps[i].updated;
+        known = true;
+      }
+    }
+    bool changed = known ? !str_eq(was, stamps[n].updated)
+                         : stamps[n].updated != NULL;
+    if (probe->primed && changed)
+      feed_add_table(feed, stamps[n].table);
+    n++;
+  }
+  db_result_free(rs);
+
+  stamps_free(probe->stamps, probe->num_stamps);
+  probe->stamps = stamps;
+  probe->num_stamps = n;
+  probe->primed = true;
+  return true;
+}
+
+static bool probe_data_version(LiveFeed *feed, LiveProbe *probe,
+                               DbConnection *conn, char **err) {
+  int64_t version = db_data_version(conn, err);
+  if (version < 0) {
+    if (err && !*err)
+      *err = str_dup("Data version unavailable");
+    return false;
+  }
+  if (probe->primed && version != probe->version)
+    feed_add_all(feed);
+  probe->version = version;
+  probe->primed = true;
+  return true;
+}
+
+static bool probe_run(LiveFeed *feed, LiveProbe *probe, DbConnection *conn,
+                      char **err) {
+  switch (probe->source) {
+  case LIVE_SOURCE_NOTIFY:
+    return probe_notify(feed, conn, err);
+  case LIVE_SOURCE_UPDATE_TIME:
+    return probe_update_time(feed, probe, conn, err);
+  case LIVE_SOURCE_DATA_VERSION:
+    return probe_data_version(feed, probe, conn, err);
+  }
+  return false;
+}
+
+static void *live_feed_thread(void *arg) {
+  LiveFeed *feed = arg;
+  char *err = NULL;
+  LiveProbe probe = {0};
+
+  DbConnection *conn = db_connect(feed->connstr, &err);
+  bool ok = conn && probe_setup(&probe, conn, &err);
+
+  lace_mutex_lock(&feed->mutex);
+  while (ok && !feed->stop) {
+    lace_mutex_unlock(&feed->mutex);
+    ok = probe_run(feed, &probe, conn, &err);
+    lace_mutex_lock(&feed->mutex);
+    if (ok && !feed->stop)
+      lace_cond_timedwait(&feed->cond, &feed->mutex, feed->interval_ms);
+  }
+  if (!ok && !feed->stop && !feed->error) {
+    feed->error = err ? err : str_dup("Live feed failed");
+    err = NULL;
+  }
+  feed->running = false;
+  lace_mutex_unlock(&feed->mutex);
+
+  free(err);
+  stamps_free(probe.stamps, probe.num_stamps);
+  if (conn)
+    db_disconnect(conn);
+  return NULL;
+}
+
+LiveFeed *live_feed_start(const char *connstr, int interval_ms) {
+  if (!connstr)
+    return NULL;
+
+  LiveFeed *feed = safe_calloc(1, sizeof(LiveFeed));
+  feed->connstr = str_dup(connstr);
+  feed->interval_ms = interval_ms > 0 ? interval_ms : 1000;
+  feed->running = true;
+  if (!lace_mutex_init(&feed->mutex)) {
+    free(feed->connstr);
+    free(feed);
+    return NULL;
+  }
+  if (!lace_cond_init(&feed->cond)) {
+    lace_mutex_destroy(&feed->mutex);
+    free(feed->connstr);
+    free(feed);
+    return NULL;
+  }
+
+  /* Same small stack as the async workers; joined by live_feed_stop */
+  lace_thread_attr_t attr;
+  lace_thread_attr_init(&attr);
+  attr.stack_size = 256 * 1024;
+  if (!lace_thread_create(&feed->thread, &attr, live_feed_thread, feed)) {
+    lace_cond_destroy(&feed->cond);
+    lace_mutex_destroy(&feed->mutex);
+    free(feed->connstr);
+    free(feed);
+    return NULL;
+  }
+  return feed;
+}
+
+char **live_feed_take(LiveFeed *feed, size_t *count, bool *all, char **err) {
+  *count = 0;
+  *all = false;
+  if (!feed)
+    return NULL;
+
+  lace_mutex_lock(&feed->mutex);
+  char **tables = feed->tables;
+  *count = feed->num_tables;
+  *all = feed->all_tables;
+  feed->tables = NULL;
+  feed->num_tables = 0;
+  feed->all_tables = false;
+  if (err && feed->error) {
+    *err = feed->error;
+    feed->error = NULL;
+  }
+  lace_mutex_unlock(&feed->mutex);
+  return tables;
+}
+
+bool live_feed_running(LiveFeed *feed) {
+  if (!feed)
+    return false;
+  lace_mutex_lock(&feed->mutex);
+  bool running = feed->running;
+  lace_mutex_unlock(&feed->mutex);
+  return running;
+}
+
+void live_feed_stop(LiveFeed *feed) {
+  if (!feed)
+    return;
+
+  lace_mutex_lock(&feed->mutex);
+  feed->stop = true;
+  lace_cond_signal(&feed->cond);
+  lace_mutex_unlock(&feed->mutex);
+  lace_thread_join(feed->thread, NULL);
+
+  for (size_t i = 0; i < feed->num_tables; i++)
+    free(feed->tables[i]);
+  free(feed->tables);
+  free(feed->error);
+  free(feed->connstr);
+  lace_cond_destroy(&feed->cond);
+  lace_mutex_destroy(&feed->mutex);
+  free(feed);
+}
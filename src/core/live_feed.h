@@ -0,0 +1,66 @@
+/*
+ * Lace
+ * Live feed - notices of writes made by other sessions
+ *
+ * Edits made in Lace mark the affected tabs themselves; a live feed tells
+ * about everyone else's. It runs on a background thread with a connection
+ * of its own and, every interval, collects the tables written since the
+ * last look:
+ *   - PostgreSQL: NOTIFY payloads on LIVE_FEED_CHANNEL, sent by the helper
+ *     trigger db_build_notify_trigger_sql installs per table
+ *   - MySQL/MariaDB: information_schema.TABLES.UPDATE_TIME of each table
+ *   - SQLite: PRAGMA data_version, which only says that something changed
+ *     (reported as all tables)
+ * The owner drains what was collected with live_feed_take.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_LIVE_FEED_H
+#define LACE_LIVE_FEED_H
+
+#include "../db/db.h"
+#include "../platform/thread.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Channel the helper trigger notifies and the feed listens on */
+#define LIVE_FEED_CHANNEL "lace_changes"
+
+typedef struct LiveFeed {
+  char *connstr;
+  int interval_ms;
+
+  lace_thread_t thread;
+  lace_mutex_t mutex;
+  lace_cond_t cond; /* Signalled to stop */
+  bool stop;
+  bool running; /* False once the thread gave up or was stopped */
+
+  /* Collected since the last live_feed_take (under the lock) */
+  char **tables;
+  size_t num_tables;
+  bool all_tables; /* A write the database could not attribute */
+  char *error;     /* Why the feed stopped, until taken */
+} LiveFeed;
+
+/* Whether conn's database can feed changes */
+bool live_feed_supported(DbConnection *conn);
+
+/* Start a feed on a connection of its own opened from connstr, looking
+ * every interval_ms. NULL if the thread could not start. */
+LiveFeed *live_feed_start(const char *connstr, int interval_ms);
+
+/* Take the tables written since the last call (caller frees each and the
+ * array); *all is set if any table may have been. *err gets the reason the
+ * feed stopped, once. */
+char **live_feed_take(LiveFeed *feed, size_t *count, bool *all, char **err);
+
+/* Whether the feed still looks for changes */
+bool live_feed_running(LiveFeed *feed);
+
+/* Stop the thread, close its connection and free the feed */
+void live_feed_stop(LiveFeed *feed);
+
+#endif /* LACE_LIVE_FEED_H */
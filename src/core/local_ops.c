@@ -0,0 +1,605 @@
+/*
+ * Lace
+ * Local sort and filter - in-memory operations on fully loaded results
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "local_ops.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <ctype.h>
+#include <errno.h>
+#include <math.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+void local_rules_for_driver(const char *driver_name, LocalRules *rules) {
+  if (!rules)
+    return;
+  memset(rules, 0, sizeof(*rules));
+
+  if (str_eq(driver_name, "sqlite")) {
+    /* BINARY collation, NULLs first, case-insensitive ASCII LIKE */
+    rules->nulls_first = true;
+    rules->binary_text = true;
+    rules->exact_text = true;
+    rules->like_nocase = true;
+    rules->loose_types = true;
+  } else if (str_eq(driver_name, "postgres")) {
+    /* Locale collation orders text, but deterministic equality is exact.
+     * NULLs sort last in ascending order. */
+    rules->exact_text = true;
+  } else if (str_eq(driver_name, "mysql") || str_eq(driver_name, "mariadb")) {
+    /* Default collations fold case and trailing spaces: only numbers and
+     * NULL checks are reproducible */
+    rules->nulls_first = true;
+  }
+}
+
+/* ============================================================================
+ * Value helpers
+ * ============================================================================
+ */
+
+static bool is_numeric_type(DbValueType t) {
+  return t == DB_TYPE_INT || t == DB_TYPE_FLOAT;
+}
+
+static bool is_null(const DbValue *v) {
+  return !v || v->is_null || v->type == DB_TYPE_NULL;
+}
+
+static double value_as_double(const DbValue *v) {
+  return v->type == DB_TYPE_INT ? (double)v->int_val : v->float_val;
+}
+
+/* Oversized fields are loaded as "[DATA: N bytes]" stand-ins, not values */
+static bool is_placeholder(const DbValue *v) {
+  if (v->type != DB_TYPE_TEXT || !v->text.data || v->text.len < 9)
+    return false;
+  return v->text.data[0] == '[' &&
+         strcmp(v->text.data + v->text.len - 7, " bytes]") == 0;
+}
+
+static int bytes_cmp(const char *a, size_t alen, const char *b, size_t blen) {
+  size_t n = alen < blen ? alen : blen;
+  int c = n > 0 ? memcmp(a, b, n) : 0;
+  if (c != 0)
+    return c < 0 ? -1 : 1;
+  return alen == blen ? 0 : (alen < blen ? -1 : 1);
+}
+
+static int double_cmp(double a, double b) {
+  /* NaN sorts above every number, as in PostgreSQL */
+  if (isnan(a) || isnan(b))
+    return isnan(a) ? (isnan(b) ? 0 : 1) : -1;
+  return a < b ? -1 : (a > b ? 1 : 0);
+}
+
+/* Parse a filter literal as a number the way the server would coerce it.
+ * Accepts surrounding spaces; rejects words like "inf" and "nan". */
+static bool parse_number(const char *s, bool *is_int, int64_t *ival,
+                         double *dval) {
+  while (isspace((unsigned char)*s))
+    s++;
+  if (!*s || !(isdigit((unsigned char)*s) || *s == '-' || *s == '+' ||
+               *s == '.'))
+    return false;
+
+  char *end;
+  errno = 0;
+  long long ll = strtoll(s, &end, 10);
+  const char *rest = end;
+  while (isspace((unsigned char)*rest))
+    rest++;
+  if (errno == 0 && end != s && *rest == '\0') {
+    *is_int = true;
+    *ival = ll;
+    *dval = (double)ll;
+    return true;
+  }
+
+  errno = 0;
+  double d = strtod(s, &end);
+  rest = end;
+  while (isspace((unsigned char)*rest))
+    rest++;
+  if (errno != 0 || end == s || *rest != '\0' || isnan(d) || isinf(d))
+    return false;
+  *is_int = false;
+  *dval = d;
+  return true;
+}
+
+/* Fixed-width character types compare with pad semantics */
+static bool is_padded_type(const ColumnDef *col) {
+  const char *t = col ? col->type_name : NULL;
+  if (!t)
+    return false;
+  if (strncasecmp(t, "character varying", 17) == 0)
+    return false;
+  return strncasecmp(t, "bpchar", 6) == 0 || strncasecmp(t, "char", 4) == 0 ||
+         strncasecmp(t, "nchar", 5) == 0;
+}
+
+/* ============================================================================
+ * Sorting
+ * ============================================================================
+ */
+
+/* Storage class order for mixed-type columns (SQLite) */
+static int type_rank(const DbValue *v) {
+  if (is_null(v))
+    return 0;
+  switch (v->type) {
+  case DB_TYPE_INT:
+  case DB_TYPE_FLOAT:
+  case DB_TYPE_BOOL:
+    return 1;
+  case DB_TYPE_BLOB:
+    return 3;
+  default:
+    return 2;
+  }
+}
+
+/* Can this column be ordered locally exactly as the server orders it? */
+static bool column_sortable(const ResultSet *rs, size_t col,
+                            const LocalRules *rules) {
+  int rank = -1;
+  for (size_t r = 0; r < rs->num_rows; r++) {
+    const Row *row = &rs->rows[r];
+    if (col >= row->num_cells)
+      return false;
+    const DbValue *v = &row->cells[col];
+    if (is_null(v))
+      continue;
+    if (is_placeholder(v))
+      return false;
+    /* Text-like values follow the collation; bytes only match BINARY */
+    if (type_rank(v) >= 2 && !rules->binary_text)
+      return false;
+    if (!rules->loose_types) {
+      if (rank >= 0 && type_rank(v) != rank)
+        return false;
+      rank = type_rank(v);
+    }
+  }
+  return true;
+}
+
+static int value_cmp(const DbValue *a, const DbValue *b) {
+  int ra = type_rank(a);
+  int rb = type_rank(b);
+  if (ra != rb)
+    return ra < rb ? -1 : 1;
+
+  switch (ra) {
+  case 0:
+    return 0;
+  case 1:
+    if (a->type == DB_TYPE_BOOL || b->type == DB_TYPE_BOOL) {
+      int ia = a->type == DB_TYPE_BOOL ? a->bool_val : (int)value_as_double(a);
+      int ib = b->type == DB_TYPE_BOOL ? b->bool_val : (int)value_as_double(b);
+      return ia < ib ? -1 : (ia > ib ? 1 : 0);
+    }
+    if (a->type == DB_TYPE_INT && b->type == DB_TYPE_INT)
+      return a->int_val < b->int_val ? -1 : (a->int_val > b->int_val ? 1 : 0);
+    return double_cmp(value_as_double(a), value_as_double(b));
+  case 3:
+    return bytes_cmp((const char *)a->blob.data, a->blob.len,
+                     (const char *)b->blob.data, b->blob.len);
+  default:
+    return bytes_cmp(a->text.data ? a->text.data : "", a->text.len,
+                     b->text.data ? b->text.data : "", b->text.len);
+  }
+}
+
+typedef struct {
+  const SortEntry *entries;
+  size_t count;
+  bool nulls_first;
+} SortContext;
+
+static int row_cmp(const Row *a, const Row *b, const SortContext *ctx) {
+  for (size_t i = 0; i < ctx->count; i++) {
+    size_t col = ctx->entries[i].column;
+    const DbValue *va = &a->cells[col];
+    const DbValue *vb = &b->cells[col];
+
+    int c;
+    bool na = is_null(va), nb = is_null(vb);
+    if (na || nb)
+      c = na == nb ? 0 : ((na != ctx->nulls_first) ? 1 : -1);
+    else
+      c = value_cmp(va, vb);
+
+    if (c != 0)
+      return ctx->entries[i].direction == SORT_DESC ? -c : c;
+  }
+  return 0;
+}
+
+/* Bottom-up merge sort: stable, so ties keep their server order */
+static void merge_sort_rows(Row *rows, size_t n, const SortContext *ctx) {
+  if (n < 2)
+    return;
+
+  Row *tmp = safe_malloc(n * sizeof(Row));
+  Row *src = rows, *dst = tmp;
+
+  for (size_t width = 1; width < n; width *= 2) {
+    for (size_t lo = 0; lo < n; lo += 2 * width) {
+      size_t mid = lo + width < n ? lo + width : n;
+      size_t hi = lo + 2 * width < n ? lo + 2 * width : n;
+      size_t i = lo, j = mid, k = lo;
+      while (i < mid && j < hi)
+        dst[k++] = row_cmp(&src[j], &src[i], ctx) < 0 ? src[j++] : src[i++];
+      while (i < mid)
+        dst[k++] = src[i++];
+      while (j < hi)
+        dst[k++] = src[j++];
+    }
+    Row *swap = src;
+    src = dst;
+    dst = swap;
+  }
+
+  if (src != rows)
+    memcpy(rows, src, n * sizeof(Row));
+  free(tmp);
+}
+
+bool local_sort_rows(ResultSet *rs, const SortEntry *entries, size_t count,
+                     const LocalRules *rules) {
+  if (!rs || !entries || count == 0 || !rules)
+    return false;
+
+  for (size_t i = 0; i < count; i++) {
+    if (entries[i].column >= rs->num_columns ||
+        !column_sortable(rs, entries[i].column, rules))
+      return false;
+  }
+
+  SortContext ctx = {entries, count, rules->nulls_first};
+  merge_sort_rows(rs->rows, rs->num_rows, &ctx);
+  return true;
+}
+
+/* ============================================================================
+ * Filtering
+ * ============================================================================
+ */
+
+typedef enum { MATCH_NO, MATCH_YES, MATCH_UNKNOWN } LocalMatch;
+
+/* Compare a non-NULL cell with a filter literal. quoted is false for bare
+ * numeric IN-list items. ordered requests <, > semantics rather than
+ * equality. Returns false if the server's answer can't be reproduced. */
+static bool cmp_literal(const DbValue *cell, const ColumnDef *col,
+                        const char *lit, size_t lit_len, bool quoted,
+                        bool ordered, const LocalRules *rules, int *out) {
+  if (is_numeric_type(cell->type)) {
+    /* Literal is coerced to the column's numeric affinity */
+    if (!col || !is_numeric_type(col->type))
+      return false;
+    char buf[64];
+    if (lit_len >= sizeof(buf))
+      return false;
+    memcpy(buf, lit, lit_len);
+    buf[lit_len] = '\0';
+    bool is_int;
+    int64_t ival;
+    double dval;
+    if (!parse_number(buf, &is_int, &ival, &dval))
+      return false;
+    if (cell->type == DB_TYPE_INT && is_int)
+      *out = cell->int_val < ival ? -1 : (cell->int_val > ival ? 1 : 0);
+    else if (isnan(value_as_double(cell)))
+      return false;
+    else
+      *out = double_cmp(value_as_double(cell), dval);
+    return true;
+  }
+
+  if (cell->type != DB_TYPE_TEXT || is_placeholder(cell))
+    return false;
+  if (!col || col->type != DB_TYPE_TEXT || is_padded_type(col))
+    return false;
+  if (!rules->exact_text || (ordered && !rules->binary_text))
+    return false;
+  if (!quoted) {
+    /* Bare number against text: only SQLite converts, and only the
+     * canonical integer form round-trips */
+    if (!rules->loose_types)
+      return false;
+    const char *p = lit;
+    if (*p == '-')
+      p++;
+    if (*p == '0' && lit_len > (size_t)(p - lit) + 1)
+      return false;
+    for (const char *q = p; q < lit + lit_len; q++) {
+      if (!isdigit((unsigned char)*q))
+        return false;
+    }
+  }
+
+  *out = bytes_cmp(cell->text.data ? cell->text.data : "", cell->text.len, lit,
+                   lit_len);
+  return true;
+}
+
+/* Text form of a cell as LIKE / GLOB see it (SQLite only) */
+static const char *cell_text(const DbValue *cell, char *buf, size_t buflen,
+                             size_t *len) {
+  if (cell->type == DB_TYPE_TEXT && !is_placeholder(cell)) {
+    *len = cell->text.len;
+    return cell->text.data ? cell->text.data : "";
+  }
+  if (cell->type == DB_TYPE_INT) {
+    int n = snprintf(buf, buflen, "%lld", (long long)cell->int_val);
+    *len = n > 0 ? (size_t)n : 0;
+    return buf;
+  }
+  return NULL;
+}
+
+static bool contains(const char *hay, size_t hay_len, const char *needle,
+                     bool nocase) {
+  size_t n = strlen(needle);
+  if (n == 0)
+    return true;
+  for (size_t i = 0; i + n <= hay_len; i++) {
+    size_t k = 0;
+    while (k < n) {
+      unsigned char a = (unsigned char)hay[i + k];
+      unsigned char b = (unsigned char)needle[k];
+      /* LIKE only folds ASCII letters */
+      if (nocase && a < 128 && b < 128) {
+        a = (unsigned char)tolower(a);
+        b = (unsigned char)tolower(b);
+      }
+      if (a != b)
+        break;
+      k++;
+    }
+    if (k == n)
+      return true;
+  }
+  return false;
+}
+
+static LocalMatch from_cmp(bool ok, bool match) {
+  if (!ok)
+    return MATCH_UNKNOWN;
+  return match ? MATCH_YES : MATCH_NO;
+}
+
+/* Match a cell against the SQL list built by filters_parse_in_values:
+ * bare numbers and '...' strings (with '' escapes), comma separated */
+static LocalMatch match_in_list(const DbValue *cell, const ColumnDef *col,
+                                const char *list, const LocalRules *rules) {
+  LocalMatch result = MATCH_NO;
+  char *item = safe_malloc(strlen(list) + 1);
+  const char *p = list;
+
+  while (*p) {
+    while (*p == ' ' || *p == ',')
+      p++;
+    if (!*p)
+      break;
+
+    size_t len = 0;
+    bool quoted = *p == '\'';
+    if (quoted) {
+      p++;
+      while (*p) {
+        if (*p == '\'') {
+          if (p[1] != '\'')
+            break;
+          p++;
+        }
+        item[len++] = *p++;
+      }
+      if (*p == '\'')
+        p++;
+    } else {
+      while (*p && *p != ',')
+        item[len++] = *p++;
+    }
+    item[len] = '\0';
+
+    int c;
+    if (!cmp_literal(cell, col, item, len, quoted, false, rules, &c)) {
+      result = MATCH_UNKNOWN;
+    } else if (c == 0) {
+      result = MATCH_YES;
+      break;
+    }
+  }
+
+  free(item);
+  return result;
+}
+
+bool local_filter_supported(const ColumnFilter *cf, const TableSchema *schema,
+                            const LocalRules *rules) {
+  if (!cf || !schema || !rules || cf->column_index >= schema->num_columns)
+    return false;
+  /* Testing every row against a pasted list costs more than the query */
+  if (cf->long_value)
+    return false;
+
+  switch (cf->op) {
+  case FILTER_OP_EQ:
+  case FILTER_OP_NE:
+  case FILTER_OP_GT:
+  case FILTER_OP_GE:
+  case FILTER_OP_LT:
+  case FILTER_OP_LE:
+  case FILTER_OP_IN:
+  case FILTER_OP_BETWEEN:
+  case FILTER_OP_IS_EMPTY:
+  case FILTER_OP_IS_NOT_EMPTY:
+  case FILTER_OP_IS_NULL:
+  case FILTER_OP_IS_NOT_NULL:
+    return true;
+
+  case FILTER_OP_CONTAINS:
+    /* The value is pasted into LIKE unescaped: wildcards stay live */
+    return rules->exact_text && !strpbrk(cf->value, "%_\\");
+
+  case FILTER_OP_REGEX:
+    /* Only SQLite's GLOB fallback without metacharacters is a substring */
+    return rules->loose_types && !strpbrk(cf->value, "*?[");
+
+  default:
+    return false;
+  }
+}
+
+static LocalMatch match_filter(const ColumnFilter *cf, const ColumnDef *col,
+                               const DbValue *cell, const LocalRules *rules) {
+  bool null = is_null(cell);
+  int c1, c2;
+  bool ok;
+
+  switch (cf->op) {
+  case FILTER_OP_IS_NULL:
+    return null ? MATCH_YES : MATCH_NO;
+  case FILTER_OP_IS_NOT_NULL:
+    return null ? MATCH_NO : MATCH_YES;
+  default:
+    break;
+  }
+
+  /* Every other comparison with NULL is unknown, which filters the row */
+  if (null)
+    return MATCH_NO;
+
+  const char *v = cf->value;
+  size_t vlen = strlen(v);
+
+  switch (cf->op) {
+  case FILTER_OP_EQ:
+    ok = cmp_literal(cell, col, v, vlen, true, false, rules, &c1);
+    return from_cmp(ok, ok && c1 == 0);
+  case FILTER_OP_NE:
+    ok = cmp_literal(cell, col, v, vlen, true, false, rules, &c1);
+    return from_cmp(ok, ok && c1 != 0);
+  case FILTER_OP_GT:
+    ok = cmp_literal(cell, col, v, vlen, true, true, rules, &c1);
+    return from_cmp(ok, ok && c1 > 0);
+  case FILTER_OP_GE:
+    ok = cmp_literal(cell, col, v, vlen, true, true, rules, &c1);
+    return from_cmp(ok, ok && c1 >= 0);
+  case FILTER_OP_LT:
+    ok = cmp_literal(cell, col, v, vlen, true, true, rules, &c1);
+    return from_cmp(ok, ok && c1 < 0);
+  case FILTER_OP_LE:
+    ok = cmp_literal(cell, col, v, vlen, true, true, rules, &c1);
+    return from_cmp(ok, ok && c1 <= 0);
+
+  case FILTER_OP_BETWEEN:
+    ok = cmp_literal(cell, col, v, vlen, true, true, rules, &c1) &&
+         cmp_literal(cell, col, cf->value2, strlen(cf->value2), true, true,
+                     rules, &c2);
+    return from_cmp(ok, ok && c1 >= 0 && c2 <= 0);
+
+  case FILTER_OP_IN: {
+    char *in_err = NULL;
+    char *list = filters_parse_in_values(v, &in_err);
+    free(in_err);
+    if (!list)
+      return MATCH_NO; /* Server falls back to IN (NULL) */
+    LocalMatch m = match_in_list(cell, col, list, rules);
+    free(list);
+    return m;
+  }
+
+  case FILTER_OP_IS_EMPTY:
+  case FILTER_OP_IS_NOT_EMPTY: {
+    bool want_empty = cf->op == FILTER_OP_IS_EMPTY;
+    if (cell->type == DB_TYPE_TEXT && !is_placeholder(cell)) {
+      if (!rules->exact_text || is_padded_type(col))
+        return MATCH_UNKNOWN;
+      return (cell->text.len == 0) == want_empty ? MATCH_YES : MATCH_NO;
+    }
+    /* A number never equals '' in SQLite; other servers reject it */
+    if (is_numeric_type(cell->type) && rules->loose_types)
+      return want_empty ? MATCH_NO : MATCH_YES;
+    return MATCH_UNKNOWN;
+  }
+
+  case FILTER_OP_CONTAINS:
+  case FILTER_OP_REGEX: {
+    char buf[32];
+    size_t len = 0;
+    const char *text = NULL;
+    if (rules->loose_types)
+      text = cell_text(cell, buf, sizeof(buf), &len);
+    else if (cell->type == DB_TYPE_TEXT && !is_placeholder(cell) && col &&
+             col->type == DB_TYPE_TEXT)
+      text = cell_text(cell, buf, sizeof(buf), &len);
+    if (!text)
+      return MATCH_UNKNOWN;
+    /* GLOB is case-sensitive, LIKE per driver */
+    bool nocase = cf->op == FILTER_OP_CONTAINS && rules->like_nocase;
+    return contains(text, len, v, nocase) ? MATCH_YES : MATCH_NO;
+  }
+
+  default:
+    return MATCH_UNKNOWN;
+  }
+}
+
+bool local_filter_rows(ResultSet *rs, const ColumnFilter *filters,
+                       size_t count, const TableSchema *schema,
+                       const LocalRules *rules) {
+  if (!rs || !schema || !rules || (count > 0 && !filters))
+    return false;
+
+  for (size_t f = 0; f < count; f++) {
+    if (!local_filter_supported(&filters[f], schema, rules))
+      return false;
+  }
+
+  /* Decide every row before touching any, so a single undecidable cell
+   * leaves the result intact for the server fallback */
+  bool *keep = safe_malloc((rs->num_rows ? rs->num_rows : 1) * sizeof(bool));
+  for (size_t r = 0; r < rs->num_rows; r++) {
+    const Row *row = &rs->rows[r];
+    keep[r] = true;
+    for (size_t f = 0; f < count && keep[r]; f++) {
+      size_t col = filters[f].column_index;
+      if (col >= row->num_cells) {
+        free(keep);
+        return false;
+      }
+      LocalMatch m = match_filter(&filters[f], &schema->columns[col],
+                                  &row->cells[col], rules);
+      if (m == MATCH_UNKNOWN) {
+        free(keep);
+        return false;
+      }
+      keep[r] = m == MATCH_YES;
+    }
+  }
+
+  size_t out = 0;
+  for (size_t r = 0; r < rs->num_rows; r++) {
+    if (keep[r]) {
+      rs->rows[out++] = rs->rows[r];
+    } else {
+      db_row_free(&rs->rows[r]);
+    }
+  }
+  rs->num_rows = out;
+  rs->total_rows = out;
+  free(keep);
+  return true;
+}
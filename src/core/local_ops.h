@@ -0,0 +1,50 @@
+/*
+ * Lace
+ * Local sort and filter - in-memory operations on fully loaded results
+ *
+ * When every matching row is already loaded, re-sorting or narrowing the
+ * filters can be done on the ResultSet instead of a server round trip.
+ * Both operations follow the driver's SQL semantics (NULL ordering, text
+ * collation, LIKE case folding) and refuse to run whenever the server
+ * could answer differently, so callers fall back to a reload.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_LOCAL_OPS_H
+#define LACE_LOCAL_OPS_H
+
+#include "app_state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Driver-specific comparison rules */
+typedef struct {
+  bool nulls_first;  /* NULL sorts before values in ascending order */
+  bool binary_text;  /* Text orders bytewise (no locale collation) */
+  bool exact_text;   /* Text equality is exact (no case/pad folding) */
+  bool like_nocase;  /* LIKE folds ASCII case */
+  bool loose_types;  /* Values of any type compare (SQLite storage classes) */
+} LocalRules;
+
+/* Fill rules for a driver name ("sqlite", "postgres", "mysql", ...) */
+void local_rules_for_driver(const char *driver_name, LocalRules *rules);
+
+/* Stable sort of rs->rows by the given sort entries. Returns false and
+ * leaves the rows untouched if the server order can't be reproduced. */
+bool local_sort_rows(ResultSet *rs, const SortEntry *entries, size_t count,
+                     const LocalRules *rules);
+
+/* Check whether a filter can be evaluated locally against schema columns */
+bool local_filter_supported(const ColumnFilter *cf, const TableSchema *schema,
+                            const LocalRules *rules);
+
+/* Drop rows not matching every filter (conjunction), compacting rs->rows in
+ * place. Returns false and leaves the rows untouched if any row can't be
+ * decided locally. */
+bool local_filter_rows(ResultSet *rs, const ColumnFilter *filters,
+                       size_t count, const TableSchema *schema,
+                       const LocalRules *rules);
+
+#endif /* LACE_LOCAL_OPS_H */
@@ -0,0 +1,117 @@
+/*
+ * Lace
+ * Memory budget - global byte limit on loaded rows across all tabs
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "mem_budget.h"
+#include "../util/mem.h"
+#include <stdlib.h>
+
+size_t mem_budget_limit(const AppState *app) {
+  if (!app || !app->config || app->config->general.memory_budget_mb <= 0)
+    return 0;
+  return (size_t)app->config->general.memory_budget_mb * 1024 * 1024;
+}
+
+size_t mem_budget_tab_bytes(const Tab *tab) {
+  if (!tab)
+    return 0;
+  return db_result_memory(tab->data) + db_result_memory(tab->query_results);
+}
+
+void mem_budget_touch(AppState *app, Tab *tab) {
+  if (!app || !tab)
+    return;
+  tab->last_used = ++app->use_clock;
+  tab->mem_bytes = mem_budget_tab_bytes(tab);
+}
+
+size_t mem_budget_total(const AppState *app) {
+  if (!app)
+    return 0;
+
+  size_t total = 0;
+  for (size_t w = 0; w < app->num_workspaces; w++) {
+    const Workspace *ws = &app->workspaces[w];
+    for (size_t t = 0; t < ws->num_tabs; t++)
+      total += ws->tabs[t].mem_bytes;
+  }
+  return total;
+}
+
+bool mem_budget_can_evict(const Tab *tab) {
+  if (!tab || tab->bg_load_op || tab->mem_bytes == 0)
+    return false;
+
+  /* Table pages are refetched by offset under the tab's filters and sort */
+  if (tab->type == TAB_TYPE_TABLE)
+    return tab->table_name && tab->data && tab->data->num_rows > 0;
+
+  /* Only paginated SELECTs can be re-run; other results are the only copy */
+  if (tab->type == TAB_TYPE_QUERY)
+    return tab->query_paginated && tab->query_base_sql &&
+           tab->query_results && tab->query_results->num_rows > 0;
+
+  return false;
+}
+
+size_t mem_budget_evict_tab(Tab *tab) {
+  if (!mem_budget_can_evict(tab))
+    return 0;
+
+  /* loaded_offset and the cursor stay as they were, so the rows around the
+   * cursor can be fetched back */
+  if (tab->type == TAB_TYPE_TABLE) {
+    db_result_clear_rows(tab->data);
+    tab->loaded_count = 0;
+  } else {
+    db_result_clear_rows(tab->query_results);
+    tab->query_loaded_count = 0;
+  }
+
+  size_t released = tab->mem_bytes;
+  tab->mem_bytes = 0;
+  tab->rows_evicted = true;
+  return released;
+}
+
+static int tab_lru_cmp(const void *a, const void *b) {
+  const Tab *ta = *(Tab *const *)a;
+  const Tab *tb = *(Tab *const *)b;
+  if (ta->last_used != tb->last_used)
+    return ta->last_used < tb->last_used ? -1 : 1;
+  return 0;
+}
+
+size_t mem_budget_evict_lru(AppState *app, const Tab *keep, size_t limit) {
+  size_t total = mem_budget_total(app);
+  if (!app || limit == 0 || total <= limit)
+    return total;
+
+  size_t num_tabs = 0;
+  for (size_t w = 0; w < app->num_workspaces; w++)
+    num_tabs += app->workspaces[w].num_tabs;
+  if (num_tabs == 0)
+    return total;
+
+  Tab **victims = safe_reallocarray(NULL, num_tabs, sizeof(Tab *));
+  size_t count = 0;
+  for (size_t w = 0; w < app->num_workspaces; w++) {
+    Workspace *ws = &app->workspaces[w];
+    for (size_t t = 0; t < ws->num_tabs; t++) {
+      Tab *tab = &ws->tabs[t];
+      if (tab != keep && mem_budget_can_evict(tab))
+        victims[count++] = tab;
+    }
+  }
+
+  qsort(victims, count, sizeof(Tab *), tab_lru_cmp);
+  for (size_t i = 0; i < count && total > limit; i++)
+    total -= mem_budget_evict_tab(victims[i]);
+
+  free(victims);
+  return total;
+}
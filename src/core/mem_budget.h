@@ -0,0 +1,45 @@
+/*
+ * Lace
+ * Memory budget - global byte limit on loaded rows across all tabs
+ *
+ * Every tab's loaded rows (table pages and paginated query results) are
+ * charged against one byte budget. When the total goes over, whole tabs are
+ * evicted least recently used first; their position is kept and the rows
+ * are refetched when the tab is used again. The active tab is never evicted
+ * here - the UI shrinks its window towards the cursor page instead.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_MEM_BUDGET_H
+#define LACE_MEM_BUDGET_H
+
+#include "app_state.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Budget in bytes from the configuration (0 = unlimited) */
+size_t mem_budget_limit(const AppState *app);
+
+/* Bytes held by a tab's loaded rows */
+size_t mem_budget_tab_bytes(const Tab *tab);
+
+/* Mark a tab most recently used and refresh its cached byte count */
+void mem_budget_touch(AppState *app, Tab *tab);
+
+/* Sum of cached byte counts over all tabs of all workspaces */
+size_t mem_budget_total(const AppState *app);
+
+/* Whether a tab's rows can be dropped and refetched later */
+bool mem_budget_can_evict(const Tab *tab);
+
+/* Drop a tab's loaded rows, keeping its position for the refetch.
+ * Returns the bytes released. */
+size_t mem_budget_evict_tab(Tab *tab);
+
+/* Evict tabs other than keep, least recently used first, until the total
+ * fits in limit. Returns the total afterwards. */
+size_t mem_budget_evict_lru(AppState *app, const Tab *keep, size_t limit);
+
+#endif /* LACE_MEM_BUDGET_H */
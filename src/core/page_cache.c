@@ -0,0 +1,167 @@
+/*
+ * Lace
+ * Page cache - table pages shared between the tabs of one connection
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "page_cache.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <stdlib.h>
+#include <string.h>
+
+static void entry_free(PageCacheEntry *e) {
+  free(e->table);
+  free(e->where);
+  FREE_ARRAY(e->params, e->num_params, db_value_free);
+  free(e->order);
+}
+
+/* Drop entry i, leaving its page unindexed */
+static void cache_remove(PageCache *cache, size_t i) {
+  PageCacheEntry *e = &cache->entries[i];
+  e->page->on_release = NULL;
+  e->page->ctx = NULL;
+  entry_free(e);
+  db_result_free(e->shape);
+  cache->entries[i] = cache->entries[--cache->num_entries];
+}
+
+/* The last row of an indexed page is gone */
+static void cache_on_release(DbRowPage *page, void *ctx) {
+  PageCache *cache = ctx;
+  for (size_t i = 0; i < cache->num_entries; i++) {
+    if (cache->entries[i].page == page) {
+      cache_remove(cache, i);
+      return;
+    }
+  }
+}
+
+PageCache *page_cache_create(void) {
+  return safe_calloc(1, sizeof(PageCache));
+}
+
+void page_cache_free(PageCache *cache) {
+  if (!cache)
+    return;
+  page_cache_forget(cache, NULL);
+  free(cache->entries);
+  free(cache);
+}
+
+void page_cache_put(PageCache *cache, const char *table, const char *where,
+                    const DbValue *params, size_t num_params,
+                    const char *order, size_t offset, size_t limit,
+                    ResultSet *rs) {
+  if (!cache || !table || !rs || limit == 0)
+    return;
+  DbRowPage *page = db_result_share(rs);
+  if (!page)
+    return;
+
+  if (cache->num_entries == cache->capacity) {
+    cache->capacity = cache->capacity ? cache->capacity * 2 : 8;
+    cache->entries = safe_reallocarray(cache->entries, cache->capacity,
+                                       sizeof(PageCacheEntry));
+  }
+  PageCacheEntry *e = &cache->entries[cache->num_entries++];
+  e->table = str_dup(table);
+  e->where = where && *where ? str_dup(where) : NULL;
+  e->params = db_values_copy(params, num_params);
+  e->num_params = e->params ? num_params : 0;
+  e->order = order && *order ? str_dup(order) : NULL;
+  e->offset = offset;
+  e->limit = limit;
+  e->page = page;
+  e->shape = db_row_page_view(page, rs, 0, 0);
+  page->on_release = cache_on_release;
+  page->ctx = cache;
+}
+
+/* NULL and "" both mean no clause */
+static bool clause_eq(const char *a, const char *b) {
+  if (!a || !*a)
+    return !b || !*b;
+  return b && str_eq(a, b);
+}
+
+/* Same values, so the same placeholders select the same rows */
+static bool params_eq(const DbValue *a, size_t na, const DbValue *b,
+                      size_t nb) {
+  if (na != nb)
+    return false;
+  for (size_t i = 0; i < na; i++) {
+    if (a[i].type != b[i].type || a[i].is_null != b[i].is_null)
+      return false;
+    if (a[i].is_null)
+      continue;
+    switch (a[i].type) {
+    case DB_TYPE_INT:
+      if (a[i].int_val != b[i].int_val)
+        return false;
+      break;
+    case DB_TYPE_FLOAT:
+      if (a[i].float_val != b[i].float_val)
+        return false;
+      break;
+    case DB_TYPE_BOOL:
+      if (a[i].bool_val != b[i].bool_val)
+        return false;
+      break;
+    case DB_TYPE_BLOB:
+      if (a[i].blob.len != b[i].blob.len ||
+          (a[i].blob.len &&
+           memcmp(a[i].blob.data, b[i].blob.data, a[i].blob.len) != 0))
+        return false;
+      break;
+    default:
+      if (a[i].text.len != b[i].text.len ||
+          (a[i].text.len &&
+           memcmp(a[i].text.data, b[i].text.data, a[i].text.len) != 0))
+        return false;
+      break;
+    }
+  }
+  return true;
+}
+
+ResultSet *page_cache_get(PageCache *cache, const char *table,
+                          const char *where, const DbValue *params,
+                          size_t num_params, const char *order, size_t offset,
+                          size_t limit) {
+  if (!cache || !table || limit == 0)
+    return NULL;
+
+  for (size_t i = 0; i < cache->num_entries; i++) {
+    PageCacheEntry *e = &cache->entries[i];
+    if (!str_eq(e->table, table) || !clause_eq(e->where, where) ||
+        !params_eq(e->params, e->num_params, params, num_params) ||
+        !clause_eq(e->order, order) || offset < e->offset)
+      continue;
+
+    /* Rows the page holds past offset; a short page ended the data, so
+     * asking past it cannot return more */
+    size_t held = e->page->num_rows;
+    size_t skip = offset - e->offset;
+    bool ended = held < e->limit;
+    if (skip >= held || (!ended && skip + limit > held))
+      continue;
+    return db_row_page_view(e->page, e->shape, skip, limit);
+  }
+  return NULL;
+}
+
+void page_cache_forget(PageCache *cache, const char *table) {
+  if (!cache)
+    return;
+  size_t i = 0;
+  while (i < cache->num_entries) {
+    if (!table || str_eq(cache->entries[i].table, table))
+      cache_remove(cache, i); /* Moves the last entry into i */
+    else
+      i++;
+  }
+}
@@ -0,0 +1,71 @@
+/*
+ * Lace
+ * Page cache - table pages shared between the tabs of one connection
+ *
+ * Tabs on the same table with the same filter and sort ask for the same
+ * pages. Every page a table tab loads is shared (see db_result_share) and
+ * indexed here by what was asked for: table, WHERE with the values bound
+ * into it, ORDER BY and the offset range. A tab asking for rows inside a
+ * page another tab still holds gets references to that page's rows
+ * instead of a fetch, and both tabs hold one copy of the cells; a tab
+ * editing a row takes a copy of that row first (db_row_own).
+ *
+ * The index never keeps a page alive: a page leaves it when the last row
+ * referring to it is freed, or when its table is written to (so no later
+ * tab starts from rows older than a fetch would give). Main thread only.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_PAGE_CACHE_H
+#define LACE_PAGE_CACHE_H
+
+#include "../db/db.h"
+#include <stdbool.h>
+#include <stddef.h>
+
+/* One indexed page */
+typedef struct {
+  char *table;
+  char *where;     /* NULL for none */
+  DbValue *params; /* Bound into where's placeholders */
+  size_t num_params;
+  char *order;     /* NULL for none */
+  size_t offset;
+  size_t limit;     /* Rows asked for; fewer held means the data ended */
+  DbRowPage *page;
+  ResultSet *shape; /* The page's columns, no rows */
+} PageCacheEntry;
+
+typedef struct PageCache {
+  PageCacheEntry *entries;
+  size_t num_entries;
+  size_t capacity;
+} PageCache;
+
+/* Create an empty index */
+PageCache *page_cache_create(void);
+
+/* Forget every page (they stay with the rows referring to them) and free
+ * the index */
+void page_cache_free(PageCache *cache);
+
+/* Share rs, just fetched for the request, and index its page */
+void page_cache_put(PageCache *cache, const char *table, const char *where,
+                    const DbValue *params, size_t num_params,
+                    const char *order, size_t offset, size_t limit,
+                    ResultSet *rs);
+
+/* Rows [offset, offset + limit) of the request from a page that holds all
+ * of them (or all there are), as references to the page's rows. NULL on a
+ * miss. */
+ResultSet *page_cache_get(PageCache *cache, const char *table,
+                          const char *where, const DbValue *params,
+                          size_t num_params, const char *order, size_t offset,
+                          size_t limit);
+
+/* Forget the pages of table (NULL: of every table) after a write */
+void page_cache_forget(PageCache *cache, const char *table);
+
+#endif /* LACE_PAGE_CACHE_H */
@@ -0,0 +1,621 @@
+/*
+ * Lace
+ * Query plans - EXPLAIN output of any driver as one node tree
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "plan.h"
+#include "../util/json_helpers.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <ctype.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Nodes
+ * ============================================================================
+ */
+
+static PlanNode *node_new(const char *label) {
+  PlanNode *n = safe_calloc(1, sizeof(PlanNode));
+  n->label = str_dup(label ? label : "?");
+  n->est_rows = -1;
+  n->act_rows = -1;
+  n->loops = -1;
+  n->cost = -1;
+  n->total_ms = -1;
+  n->self_ms = -1;
+  n->buf_hit = -1;
+  n->buf_read = -1;
+  return n;
+}
+
+static void node_add_child(PlanNode *parent, PlanNode *child) {
+  parent->children = safe_reallocarray(
+      parent->children, parent->num_children + 1, sizeof(PlanNode *));
+  parent->children[parent->num_children++] = child;
+  child->parent = parent;
+}
+
+static void node_free(PlanNode *n) {
+  if (!n)
+    return;
+  for (size_t i = 0; i < n->num_children; i++)
+    node_free(n->children[i]);
+  free(n->children);
+  free(n->label);
+  free(n->detail);
+  free(n);
+}
+
+void plan_free(QueryPlan *plan) {
+  if (!plan)
+    return;
+  node_free(plan->root);
+  free(plan);
+}
+
+static QueryPlan *plan_new(void) {
+  QueryPlan *plan = safe_calloc(1, sizeof(QueryPlan));
+  plan->planning_ms = -1;
+  plan->execution_ms = -1;
+  return plan;
+}
+
+/* Append "name: text" to the node's detail */
+static void node_add_detail(PlanNode *n, const char *name, const char *text) {
+  if (!text || !*text)
+    return;
+  char *part = name ? str_printf("%s: %s", name, text) : str_dup(text);
+  if (!n->detail) {
+    n->detail = part;
+    return;
+  }
+  char *joined = str_printf("%s; %s", n->detail, part);
+  free(n->detail);
+  free(part);
+  n->detail = joined;
+}
+
+/* A synthetic root with a single child is replaced by that child */
+static PlanNode *unwrap_root(PlanNode *root) {
+  if (root && root->num_children == 1 && !root->detail) {
+    PlanNode *only = root->children[0];
+    root->num_children = 0;
+    node_free(root);
+    only->parent = NULL;
+    return only;
+  }
+  return root;
+}
+
+/* Self time from inclusive times: a node's time minus its children's */
+static void compute_self(PlanNode *n) {
+  double children_ms = 0;
+  for (size_t i = 0; i < n->num_children; i++) {
+    compute_self(n->children[i]);
+    if (n->children[i]->total_ms > 0)
+      children_ms += n->children[i]->total_ms;
+  }
+  if (n->total_ms >= 0) {
+    n->self_ms = n->total_ms - children_ms;
+    if (n->self_ms < 0)
+      n->self_ms = 0; /* Parallel workers overlap their parent */
+  }
+}
+
+/* ============================================================================
+ * EXPLAIN statements
+ * ============================================================================
+ */
+
+static bool is_mysql(const DbConnection *conn) {
+  return str_eq(conn->driver->name, "mysql") ||
+         str_eq(conn->driver->name, "mariadb");
+}
+
+char *plan_explain_sql(DbConnection *conn, const char *sql, bool analyze,
+                       int variant) {
+  if (!conn || !conn->driver || !sql)
+    return NULL;
+
+  /* Trailing terminators would end the statement inside EXPLAIN (...) */
+  size_t len = strlen(sql);
+  while (len > 0 &&
+         (sql[len - 1] == ';' || isspace((unsigned char)sql[len - 1])))
+    len--;
+  while (len > 0 && isspace((unsigned char)*sql)) {
+    sql++;
+    len--;
+  }
+  if (len == 0)
+    return NULL;
+
+  const char *prefix = NULL;
+  if (str_eq(conn->driver->name, "postgres")) {
+    if (variant == 0)
+      prefix = analyze ? "EXPLAIN (ANALYZE, BUFFERS, FORMAT JSON)"
+                       : "EXPLAIN (FORMAT JSON)";
+  } else if (is_mysql(conn)) {
+    /* MySQL 8 analyzes only into its text tree; MariaDB has ANALYZE */
+    if (analyze)
+      prefix = variant == 0   ? "EXPLAIN ANALYZE"
+               : variant == 1 ? "ANALYZE FORMAT=JSON"
+                              : NULL;
+    else if (variant == 0)
+      prefix = "EXPLAIN FORMAT=JSON";
+  } else if (variant == 0) {
+    prefix = "EXPLAIN QUERY PLAN";
+  }
+  return prefix ? str_printf("%s %.*s", prefix, (int)len, sql) : NULL;
+}
+
+/* ============================================================================
+ * PostgreSQL (FORMAT JSON)
+ * ============================================================================
+ */
+
+static PlanNode *pg_node(cJSON *obj) {
+  const char *type = json_get_string(obj, "Node Type", "?");
+  const char *join = json_get_string(obj, "Join Type", NULL);
+  const char *index = json_get_string(obj, "Index Name", NULL);
+  const char *rel = json_get_string(obj, "Relation Name", NULL);
+  const char *alias = json_get_string(obj, "Alias", NULL);
+
+  StringBuilder *sb = sb_new(64);
+  sb_append(sb, type);
+  if (join && !str_eq(join, "Inner"))
+    sb_printf(sb, " (%s)", join);
+  if (index)
+    sb_printf(sb, " using %s", index);
+  if (rel) {
+    sb_printf(sb, " on %s", rel);
+    if (alias && !str_eq(alias, rel))
+      sb_printf(sb, " %s", alias);
+  }
+  char *label = sb_finish(sb);
+  PlanNode *n = node_new(label);
+  free(label);
+
+  static const char *const conds[] = {"Index Cond", "Recheck Cond",
+                                      "Hash Cond",  "Merge Cond",
+                                      "Join Filter", "Filter"};
+  for (size_t i = 0; i < sizeof(conds) / sizeof(conds[0]); i++)
+    node_add_detail(n, conds[i], json_get_string(obj, conds[i], NULL));
+  double removed = json_get_double(obj, "Rows Removed by Filter", 0);
+  if (removed > 0) {
+    char buf[32];
+    snprintf(buf, sizeof(buf), "%.0f", removed);
+    node_add_detail(n, "Removed by filter", buf);
+  }
+
+  n->est_rows = json_get_double(obj, "Plan Rows", -1);
+  n->cost = json_get_double(obj, "Total Cost", -1);
+  n->act_rows = json_get_double(obj, "Actual Rows", -1);
+  n->loops = json_get_double(obj, "Actual Loops", -1);
+  double per_loop_ms = json_get_double(obj, "Actual Total Time", -1);
+  if (per_loop_ms >= 0)
+    n->total_ms = per_loop_ms * (n->loops > 0 ? n->loops : 1);
+  n->buf_hit = json_get_int64(obj, "Shared Hit Blocks", -1);
+  n->buf_read = json_get_int64(obj, "Shared Read Blocks", -1);
+
+  cJSON *plans = cJSON_GetObjectItem(obj, "Plans");
+  if (cJSON_IsArray(plans)) {
+    cJSON *child;
+    cJSON_ArrayForEach(child, plans) {
+      if (cJSON_IsObject(child))
+        node_add_child(n, pg_node(child));
+    }
+  }
+  return n;
+}
+
+QueryPlan *plan_parse_pg_json(const char *json, char **err) {
+  cJSON *doc = json ? cJSON_Parse(json) : NULL;
+  cJSON *top = cJSON_IsArray(doc) ? cJSON_GetArrayItem(doc, 0) : doc;
+  cJSON *root = cJSON_IsObject(top) ? cJSON_GetObjectItem(top, "Plan") : NULL;
+  if (!cJSON_IsObject(root)) {
+    cJSON_Delete(doc);
+    err_set(err, "Unrecognized PostgreSQL plan");
+    return NULL;
+  }
+
+  QueryPlan *plan = plan_new();
+  plan->root = pg_node(root);
+  plan->planning_ms = json_get_double(top, "Planning Time", -1);
+  plan->execution_ms = json_get_double(top, "Execution Time", -1);
+  plan->analyzed = plan->root->total_ms >= 0;
+  cJSON_Delete(doc);
+  compute_self(plan->root);
+  return plan;
+}
+
+/* ============================================================================
+ * MySQL / MariaDB (FORMAT=JSON)
+ * ============================================================================
+ * The document nests operations ("query_block", "nested_loop",
+ * "ordering_operation", "table", ...) as object members and arrays. Every
+ * nested object becomes a node named after its key; cost_info is folded
+ * into its owner. MariaDB's ANALYZE adds r_* members with actual values.
+ */
+
+/* Number stored as a JSON number or (MySQL cost_info) a numeric string */
+static double json_number(cJSON *obj, const char *key) {
+  cJSON *item = obj ? cJSON_GetObjectItem(obj, key) : NULL;
+  if (cJSON_IsNumber(item))
+    return item->valuedouble;
+  double d;
+  if (cJSON_IsString(item) && str_to_double(item->valuestring, &d))
+    return d;
+  return -1;
+}
+
+static char *mysql_label(const char *key, cJSON *obj) {
+  const char *table = json_get_string(obj, "table_name", NULL);
+  if (table) {
+    const char *access = json_get_string(obj, "access_type", NULL);
+    const char *index = json_get_string(obj, "key", NULL);
+    StringBuilder *sb = sb_new(64);
+    sb_printf(sb, "%s %s", access ? access : "table", table);
+    if (index)
+      sb_printf(sb, " using %s", index);
+    return sb_finish(sb);
+  }
+
+  char *label = str_dup(key ? key : "plan");
+  for (char *p = label; *p; p++) {
+    if (*p == '_')
+      *p = ' ';
+  }
+  int select_id = json_get_int(obj, "select_id", 0);
+  if (select_id > 0) {
+    char *numbered = str_printf("%s #%d", label, select_id);
+    free(label);
+    label = numbered;
+  }
+  return label;
+}
+
+static void mysql_walk(cJSON *obj, PlanNode *owner);
+
+static PlanNode *mysql_node(const char *key, cJSON *obj) {
+  char *label = mysql_label(key, obj);
+  PlanNode *n = node_new(label);
+  free(label);
+
+  n->est_rows = json_number(obj, "rows_examined_per_scan");
+  if (n->est_rows < 0)
+    n->est_rows = json_number(obj, "rows");
+  n->act_rows = json_number(obj, "r_rows");
+  n->loops = json_number(obj, "r_loops");
+
+  cJSON *cost = cJSON_GetObjectItem(obj, "cost_info");
+  if (cJSON_IsObject(cost)) {
+    /* prefix_cost accumulates over join siblings; a table's own cost is
+     * what it takes to read and evaluate it */
+    double read = json_number(cost, "read_cost");
+    double eval = json_number(cost, "eval_cost");
+    n->cost = read >= 0 ? read + (eval > 0 ? eval : 0)
+                        : json_number(cost, "query_cost");
+  }
+
+  n->total_ms = json_number(obj, "r_total_time_ms");
+  if (n->total_ms < 0) {
+    double table_ms = json_number(obj, "r_table_time_ms");
+    double other_ms = json_number(obj, "r_other_time_ms");
+    if (table_ms >= 0)
+      n->total_ms = table_ms + (other_ms > 0 ? other_ms : 0);
+  }
+
+  node_add_detail(n, "Condition",
+                  json_get_string(obj, "attached_condition", NULL));
+  if (json_get_bool(obj, "using_filesort", false))
+    node_add_detail(n, NULL, "Using filesort");
+  if (json_get_bool(obj, "using_temporary_table", false))
+    node_add_detail(n, NULL, "Using temporary");
+
+  mysql_walk(obj, n);
+  return n;
+}
+
+static void mysql_walk(cJSON *obj, PlanNode *owner) {
+  cJSON *item;
+  cJSON_ArrayForEach(item, obj) {
+    if (cJSON_IsObject(item)) {
+      if (!str_eq(item->string, "cost_info"))
+        node_add_child(owner, mysql_node(item->string, item));
+    } else if (cJSON_IsArray(item)) {
+      /* Arrays of operations; arrays of names (used_columns) are skipped */
+      cJSON *first = cJSON_GetArrayItem(item, 0);
+      if (!cJSON_IsObject(first))
+        continue;
+      char *label = mysql_label(item->string, NULL);
+      PlanNode *list = node_new(label);
+      free(label);
+      cJSON *elem;
+      cJSON_ArrayForEach(elem, item) {
+        if (cJSON_IsObject(elem))
+          mysql_walk(elem, list);
+      }
+      node_add_child(owner, list);
+    }
+  }
+}
+
+QueryPlan *plan_parse_mysql_json(const char *json, char **err) {
+  cJSON *doc = json ? cJSON_Parse(json) : NULL;
+  if (!cJSON_IsObject(doc)) {
+    cJSON_Delete(doc);
+    err_set(err, "Unrecognized MySQL plan");
+    return NULL;
+  }
+
+  PlanNode *root = node_new("plan");
+  mysql_walk(doc, root);
+  cJSON_Delete(doc);
+
+  QueryPlan *plan = plan_new();
+  plan->root = unwrap_root(root);
+  plan->analyzed = plan->root->total_ms >= 0 || plan->root->act_rows >= 0;
+  compute_self(plan->root);
+  return plan;
+}
+
+/* ============================================================================
+ * MySQL (EXPLAIN ANALYZE / FORMAT=TREE)
+ * ============================================================================
+ * One node per "-> " line, nested by four spaces of indent:
+ *   -> Filter: (t.a > 1)  (cost=1.25 rows=3) (actual time=0.04..0.05 rows=2
+ *      loops=1)
+ */
+
+/* Value of "name=" in the text, or -1 */
+static double tree_field(const char *text, const char *name) {
+  const char *p = text ? strstr(text, name) : NULL;
+  return p ? strtod(p + strlen(name), NULL) : -1;
+}
+
+static PlanNode *tree_node(const char *line, size_t len) {
+  char *text = str_ndup(line, len);
+
+  /* Measures follow the label after two spaces */
+  char *cost = strstr(text, "  (cost=");
+  char *actual = strstr(text, "(actual time=");
+  char *never = strstr(text, "(never executed)");
+  char *end = cost ? cost : actual ? actual : never;
+  if (end == text)
+    end = NULL;
+
+  char *label = str_ndup(text, end ? (size_t)(end - text) : len);
+  size_t label_len = strlen(label);
+  while (label_len > 0 && isspace((unsigned char)label[label_len - 1]))
+    label[--label_len] = '\0';
+  PlanNode *n = node_new(label);
+  free(label);
+
+  if (cost) {
+    n->cost = tree_field(cost, "cost=");
+    n->est_rows = tree_field(cost, "rows=");
+  }
+  if (actual) {
+    /* time=first..last is per loop */
+    char *dots = strstr(actual, "..");
+    double last_ms = dots ? strtod(dots + 2, NULL) : -1;
+    n->act_rows = tree_field(actual, " rows=");
+    n->loops = tree_field(actual, "loops=");
+    if (last_ms >= 0)
+      n->total_ms = last_ms * (n->loops > 0 ? n->loops : 1);
+  } else if (never) {
+    n->act_rows = 0;
+    n->loops = 0;
+    n->total_ms = 0;
+  }
+  free(text);
+  return n;
+}
+
+QueryPlan *plan_parse_mysql_tree(const char *text, char **err) {
+  if (!text) {
+    err_set(err, "Unrecognized MySQL plan");
+    return NULL;
+  }
+
+  /* stack[d] is the last node seen at depth d */
+  PlanNode *stack[64];
+  PlanNode *root = node_new("plan");
+  bool any = false;
+
+  for (const char *line = text; *line;) {
+    const char *eol = strchr(line, '\n');
+    size_t line_len = eol ? (size_t)(eol - line) : strlen(line);
+
+    size_t indent = 0;
+    while (indent < line_len && line[indent] == ' ')
+      indent++;
+    if (line_len - indent >= 3 && strncmp(line + indent, "-> ", 3) == 0) {
+      size_t depth = indent / 4;
+      PlanNode *parent = root;
+      if (depth > 0 && any) {
+        if (depth > sizeof(stack) / sizeof(stack[0]) - 1)
+          depth = sizeof(stack) / sizeof(stack[0]) - 1;
+        /* Tolerate skipped levels: attach to the deepest known ancestor */
+        size_t d = depth;
+        while (d > 0 && !stack[d - 1])
+          d--;
+        parent = d > 0 ? stack[d - 1] : root;
+        depth = d;
+      } else {
+        depth = 0;
+      }
+      PlanNode *n = tree_node(line + indent + 3, line_len - indent - 3);
+      node_add_child(parent, n);
+      stack[depth] = n;
+      for (size_t d = depth + 1; d < sizeof(stack) / sizeof(stack[0]); d++)
+        stack[d] = NULL;
+      any = true;
+    }
+    line = eol ? eol + 1 : line + line_len;
+  }
+
+  if (!any) {
+    node_free(root);
+    err_set(err, "Unrecognized MySQL plan");
+    return NULL;
+  }
+
+  QueryPlan *plan = plan_new();
+  plan->root = unwrap_root(root);
+  plan->analyzed = plan->root->total_ms >= 0;
+  compute_self(plan->root);
+  return plan;
+}
+
+/* ============================================================================
+ * SQLite (EXPLAIN QUERY PLAN)
+ * ============================================================================
+ * Rows of (id, parent, notused, detail); parent 0 is the top level and
+ * parents come before their children.
+ */
+
+static int64_t cell_int(const DbValue *v) {
+  if (v->is_null)
+    return -1;
+  if (v->type == DB_TYPE_INT)
+    return v->int_val;
+  int64_t n;
+  char *s = db_value_to_string(v);
+  bool ok = s && str_to_int64(s, &n);
+  free(s);
+  return ok ? n : -1;
+}
+
+QueryPlan *plan_parse_sqlite(const ResultSet *rs, char **err) {
+  if (!rs || rs->num_columns < 4) {
+    err_set(err, "Unrecognized SQLite plan");
+    return NULL;
+  }
+
+  PlanNode *root = node_new("QUERY PLAN");
+  PlanNode **nodes = safe_calloc(rs->num_rows ? rs->num_rows : 1,
+                                 sizeof(PlanNode *));
+  int64_t *ids = safe_calloc(rs->num_rows ? rs->num_rows : 1, sizeof(int64_t));
+
+  for (size_t i = 0; i < rs->num_rows; i++) {
+    const Row *row = &rs->rows[i];
+    if (row->num_cells < 4)
+      continue;
+    char *detail = db_value_to_string(&row->cells[3]);
+    nodes[i] = node_new(detail);
+    free(detail);
+    ids[i] = cell_int(&row->cells[0]);
+
+    int64_t parent_id = cell_int(&row->cells[1]);
+    PlanNode *parent = root;
+    for (size_t j = i; j-- > 0;) {
+      if (nodes[j] && ids[j] == parent_id) {
+        parent = nodes[j];
+        break;
+      }
+    }
+    node_add_child(parent, nodes[i]);
+  }
+  free(nodes);
+  free(ids);
+
+  QueryPlan *plan = plan_new();
+  plan->root = unwrap_root(root);
+  return plan;
+}
+
+/* ============================================================================
+ * Dispatch and hot nodes
+ * ============================================================================
+ */
+
+QueryPlan *plan_parse(DbConnection *conn, const ResultSet *rs, char **err) {
+  if (!conn || !conn->driver || !rs) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+  if (!str_eq(conn->driver->name, "postgres") && !is_mysql(conn))
+    return plan_parse_sqlite(rs, err);
+
+  if (rs->num_rows == 0 || rs->num_columns == 0 ||
+      rs->rows[0].num_cells == 0) {
+    err_set(err, "Empty plan");
+    return NULL;
+  }
+
+  char *text = db_value_to_string(&rs->rows[0].cells[0]);
+  const char *p = text ? text : "";
+  while (isspace((unsigned char)*p))
+    p++;
+
+  QueryPlan *plan;
+  if (*p == '[' || *p == '{') {
+    plan = str_eq(conn->driver->name, "postgres")
+               ? plan_parse_pg_json(p, err)
+               : plan_parse_mysql_json(p, err);
+  } else {
+    plan = plan_parse_mysql_tree(p, err);
+  }
+  free(text);
+  return plan;
+}
+
+/* Own share of the work by the plan's best available measure */
+static double node_score(const QueryPlan *plan, const PlanNode *n) {
+  if (plan->analyzed)
+    return n->self_ms;
+  if (n->cost >= 0) {
+    double own = n->cost;
+    for (size_t i = 0; i < n->num_children; i++) {
+      if (n->children[i]->cost > 0)
+        own -= n->children[i]->cost;
+    }
+    return own;
+  }
+  /* SQLite: "SCAN t" reads the whole table, "SCAN t USING INDEX" doesn't */
+  bool scan = strncmp(n->label, "SCAN ", 5) == 0 && !strstr(n->label, "INDEX");
+  return scan ? 1 : 0;
+}
+
+static void collect_nodes(PlanNode *n, PlanNode ***out, size_t *count,
+                          size_t *cap) {
+  if (*count == *cap) {
+    *cap = *cap ? *cap * 2 : 32;
+    *out = safe_reallocarray(*out, *cap, sizeof(PlanNode *));
+  }
+  (*out)[(*count)++] = n;
+  for (size_t i = 0; i < n->num_children; i++)
+    collect_nodes(n->children[i], out, count, cap);
+}
+
+void plan_mark_hot(QueryPlan *plan) {
+  if (!plan || !plan->root)
+    return;
+
+  PlanNode **all = NULL;
+  size_t count = 0, cap = 0;
+  collect_nodes(plan->root, &all, &count, &cap);
+
+  for (int pick = 0; pick < PLAN_HOT_NODES; pick++) {
+    PlanNode *best = NULL;
+    double best_score = 0;
+    for (size_t i = 0; i < count; i++) {
+      double score = node_score(plan, all[i]);
+      if (!all[i]->hot && score > best_score) {
+        best = all[i];
+        best_score = score;
+      }
+    }
+    if (!best)
+      break;
+    best->hot = true;
+  }
+  free(all);
+}
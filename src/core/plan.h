@@ -0,0 +1,80 @@
+/*
+ * Lace
+ * Query plans - EXPLAIN output of any driver as one node tree
+ *
+ * Each database explains a statement in its own shape: PostgreSQL and MySQL
+ * return a JSON document, MySQL's EXPLAIN ANALYZE an indented text tree,
+ * SQLite's EXPLAIN QUERY PLAN one row per step linked by parent ids. The
+ * parsers here turn all of them into PlanNode trees with the measures the
+ * plan viewer shows. Measures a database doesn't report stay negative.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_PLAN_H
+#define LACE_PLAN_H
+
+#include "../db/db.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Nodes marked hot by plan_mark_hot */
+#define PLAN_HOT_NODES 3
+
+/* One step of a plan */
+typedef struct PlanNode {
+  char *label;  /* "Seq Scan on items", "SEARCH t USING INDEX ..." */
+  char *detail; /* Conditions and the like, or NULL */
+
+  double est_rows; /* Rows the planner expected (per loop) */
+  double act_rows; /* Rows actually produced (per loop) */
+  double loops;    /* Times the node ran */
+  double cost;     /* Planner's total cost, including children */
+  double total_ms; /* Actual time over all loops, including children */
+  double self_ms;  /* total_ms minus the children's */
+  int64_t buf_hit;  /* Shared buffers found in cache */
+  int64_t buf_read; /* Shared buffers read from disk */
+
+  bool hot;       /* Among the most expensive nodes */
+  bool collapsed; /* Viewer state: children hidden */
+
+  struct PlanNode *parent;
+  struct PlanNode **children;
+  size_t num_children;
+} PlanNode;
+
+/* A parsed plan */
+typedef struct {
+  PlanNode *root;
+  bool analyzed;      /* Statement was run: actual rows and times known */
+  double planning_ms; /* Negative if not reported */
+  double execution_ms;
+} QueryPlan;
+
+/* EXPLAIN statement for sql on conn. analyze runs the statement for actual
+ * rows and times. variant picks a fallback syntax when the server rejected
+ * the previous one (MariaDB vs MySQL); NULL once there is none left. */
+char *plan_explain_sql(DbConnection *conn, const char *sql, bool analyze,
+                       int variant);
+
+/* Parse the result of a plan_explain_sql statement. NULL with *err set if
+ * the result isn't a plan. */
+QueryPlan *plan_parse(DbConnection *conn, const ResultSet *rs, char **err);
+
+/* Parsers of each output format (plan_parse picks one) */
+QueryPlan *plan_parse_pg_json(const char *json, char **err);
+QueryPlan *plan_parse_mysql_json(const char *json, char **err);
+QueryPlan *plan_parse_mysql_tree(const char *text, char **err);
+QueryPlan *plan_parse_sqlite(const ResultSet *rs, char **err);
+
+/* Mark up to PLAN_HOT_NODES nodes with the largest own share of the work as
+ * hot: self time when analyzed, otherwise own cost, otherwise (SQLite) full
+ * table scans. */
+void plan_mark_hot(QueryPlan *plan);
+
+/* Free the plan and every node */
+void plan_free(QueryPlan *plan);
+
+#endif /* LACE_PLAN_H */
@@ -0,0 +1,167 @@
+/*
+ * Lace
+ * Adaptive prefetch - sizes background page loads from measured latency
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "prefetch.h"
+#include "constants.h"
+#include <string.h>
+
+/* Weight of the newest sample in the running averages */
+#define LINK_ALPHA 0.3
+#define MOTION_ALPHA 0.5
+
+static double ewma(double avg, double sample, double alpha) {
+  return avg + alpha * (sample - avg);
+}
+
+void prefetch_link_record(PrefetchLink *link, uint64_t elapsed_ms,
+                          size_t rows, size_t bytes) {
+  if (!link || rows == 0)
+    return;
+
+  double n = (double)rows;
+  double t = (double)elapsed_ms;
+  double bpr = (double)bytes / n;
+
+  if (link->samples == 0) {
+    link->n_mean = n;
+    link->t_mean = t;
+    link->nn_mean = n * n;
+    link->nt_mean = n * t;
+    link->bytes_per_row = bpr;
+  } else {
+    link->n_mean = ewma(link->n_mean, n, LINK_ALPHA);
+    link->t_mean = ewma(link->t_mean, t, LINK_ALPHA);
+    link->nn_mean = ewma(link->nn_mean, n * n, LINK_ALPHA);
+    link->nt_mean = ewma(link->nt_mean, n * t, LINK_ALPHA);
+    link->bytes_per_row = ewma(link->bytes_per_row, bpr, LINK_ALPHA);
+  }
+  link->samples++;
+
+  /* Least squares fit of t = rtt + n * ms_per_row over the weighted
+   * samples. Until request sizes vary enough to separate the two terms,
+   * split the average time evenly between them. */
+  double var = link->nn_mean - link->n_mean * link->n_mean;
+  double slope = -1.0;
+  if (var > 0.01 * link->n_mean * link->n_mean)
+    slope = (link->nt_mean - link->n_mean * link->t_mean) / var;
+
+  if (slope >= 0.0 && link->t_mean - slope * link->n_mean >= 0.0) {
+    link->ms_per_row = slope;
+    link->rtt_ms = link->t_mean - slope * link->n_mean;
+  } else {
+    link->rtt_ms = link->t_mean / 2.0;
+    link->ms_per_row = link->t_mean / 2.0 / link->n_mean;
+  }
+}
+
+double prefetch_link_predict(const PrefetchLink *link, size_t rows) {
+  if (!link || link->samples == 0)
+    return 0.0;
+  return link->rtt_ms + (double)rows * link->ms_per_row;
+}
+
+void prefetch_motion_reset(PrefetchMotion *motion) {
+  if (motion)
+    memset(motion, 0, sizeof(*motion));
+}
+
+void prefetch_motion_sample(PrefetchMotion *motion, size_t abs_row,
+                            size_t page_rows, uint64_t now_ms) {
+  if (!motion)
+    return;
+
+  if (!motion->primed) {
+    motion->primed = true;
+    motion->last_ms = now_ms;
+    motion->last_row = abs_row;
+    motion->velocity = 0.0;
+    return;
+  }
+
+  uint64_t dt = now_ms > motion->last_ms ? now_ms - motion->last_ms : 0;
+  size_t delta = abs_row > motion->last_row ? abs_row - motion->last_row
+                                            : motion->last_row - abs_row;
+
+  if (delta == 0) {
+    /* Standing still: the old speed no longer predicts anything */
+    if (dt > PREFETCH_IDLE_MS)
+      motion->velocity = 0.0;
+    return;
+  }
+
+  bool down = abs_row > motion->last_row;
+  motion->last_ms = now_ms;
+  motion->last_row = abs_row;
+
+  if (delta > page_rows || dt > PREFETCH_IDLE_MS) {
+    motion->velocity = 0.0;
+    return;
+  }
+
+  double inst = (double)delta * 1000.0 / (double)(dt > 0 ? dt : 1);
+  if (!down)
+    inst = -inst;
+
+  /* A direction change restarts the average */
+  if ((inst > 0.0) != (motion->velocity > 0.0) || motion->velocity == 0.0)
+    motion->velocity = inst;
+  else
+    motion->velocity = ewma(motion->velocity, inst, MOTION_ALPHA);
+}
+
+int prefetch_motion_direction(const PrefetchMotion *motion) {
+  if (!motion || motion->velocity == 0.0)
+    return 0;
+  return motion->velocity > 0.0 ? 1 : -1;
+}
+
+void prefetch_plan(const PrefetchLink *link, const PrefetchMotion *motion,
+                   size_t page_rows, size_t min_rows, size_t max_rows,
+                   PrefetchPlan *plan) {
+  if (!plan)
+    return;
+  if (max_rows < min_rows)
+    max_rows = min_rows;
+
+  plan->rows = min_rows;
+  plan->lead = page_rows;
+
+  double speed = motion ? motion->velocity / 1000.0 : 0.0; /* rows per ms */
+  if (speed < 0.0)
+    speed = -speed;
+
+  if (link && link->samples > 0 && speed > 0.0) {
+    /* n rows must outlast the scrolling done while they load:
+     *   n >= speed * (rtt + n * ms_per_row) * SAFETY */
+    double need = speed * link->rtt_ms * PREFETCH_SAFETY;
+    double denom = 1.0 - speed * link->ms_per_row * PREFETCH_SAFETY;
+    double rows = denom > 0.0 ? need / denom : (double)max_rows;
+    if (rows > (double)max_rows)
+      rows = (double)max_rows;
+    if (rows > (double)plan->rows)
+      plan->rows = (size_t)rows;
+
+    /* Start while the loaded rows still cover one round trip of scrolling */
+    double lead = speed * prefetch_link_predict(link, plan->rows) *
+                      PREFETCH_SAFETY +
+                  LOAD_THRESHOLD;
+    if (lead > (double)max_rows)
+      lead = (double)max_rows;
+    if (lead > (double)plan->lead)
+      plan->lead = (size_t)lead;
+  }
+
+  /* Keep a single request's payload bounded on wide rows */
+  if (link && link->bytes_per_row > 0.0) {
+    double cap = (double)PREFETCH_MAX_BYTES / link->bytes_per_row;
+    if ((double)plan->rows > cap)
+      plan->rows = (size_t)cap;
+  }
+  if (plan->rows < page_rows)
+    plan->rows = page_rows;
+}
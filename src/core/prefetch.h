@@ -0,0 +1,74 @@
+/*
+ * Lace
+ * Adaptive prefetch - sizes background page loads from measured latency
+ *
+ * Each connection keeps a running estimate of how long a page load takes
+ * (fixed round trip plus per-row transfer) and how large rows are; each
+ * tab tracks how fast and in which direction the cursor moves. A plan
+ * combines both: fetch enough rows to cover the scrolling predicted while
+ * the request is in flight, and start it early enough to land in time.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_PREFETCH_H
+#define LACE_PREFETCH_H
+
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Measured cost of page loads on one connection */
+typedef struct {
+  /* Exponentially weighted moments of (rows, elapsed) samples */
+  double n_mean;
+  double t_mean;
+  double nn_mean;
+  double nt_mean;
+
+  double rtt_ms;        /* Fixed cost of a request (ms) */
+  double ms_per_row;    /* Transfer cost per row (ms) */
+  double bytes_per_row; /* Average loaded row size */
+  size_t samples;
+} PrefetchLink;
+
+/* Cursor motion of one tab */
+typedef struct {
+  uint64_t last_ms; /* Time of the last sample */
+  size_t last_row;  /* Absolute cursor row at the last sample */
+  double velocity;  /* Smoothed rows per second, negative = upwards */
+  bool primed;      /* last_ms/last_row are set */
+} PrefetchMotion;
+
+/* Sizing decision for the next background load */
+typedef struct {
+  size_t rows; /* Rows to request */
+  size_t lead; /* Start loading when the cursor is this close to the edge */
+} PrefetchPlan;
+
+/* Record a completed page load of rows rows totalling bytes */
+void prefetch_link_record(PrefetchLink *link, uint64_t elapsed_ms,
+                          size_t rows, size_t bytes);
+
+/* Predicted time (ms) to load rows rows, 0 if nothing was measured yet */
+double prefetch_link_predict(const PrefetchLink *link, size_t rows);
+
+/* Feed the cursor's absolute row. Moves farther than page_rows at once are
+ * jumps (goto, Home/End) and reset the velocity instead of spiking it. */
+void prefetch_motion_sample(PrefetchMotion *motion, size_t abs_row,
+                            size_t page_rows, uint64_t now_ms);
+
+/* Forget the motion history (new table, reload) */
+void prefetch_motion_reset(PrefetchMotion *motion);
+
+/* Scrolling direction: 1 = down, -1 = up, 0 = idle */
+int prefetch_motion_direction(const PrefetchMotion *motion);
+
+/* Plan the next load. rows stays within [min_rows, max_rows] (and under
+ * PREFETCH_MAX_BYTES, never below page_rows); lead is at least page_rows. */
+void prefetch_plan(const PrefetchLink *link, const PrefetchMotion *motion,
+                   size_t page_rows, size_t min_rows, size_t max_rows,
+                   PrefetchPlan *plan);
+
+#endif /* LACE_PREFETCH_H */
@@ -0,0 +1,287 @@
+/*
+ * Lace
+ * Query result cache - recent read-only results of one connection
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "result_cache.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <ctype.h>
+#include <stdlib.h>
+#include <string.h>
+#include <strings.h>
+
+ResultCache *result_cache_create(void) {
+  ResultCache *cache = safe_calloc(1, sizeof(ResultCache));
+  if (!lace_mutex_init(&cache->mutex)) {
+    free(cache);
+    return NULL;
+  }
+  return cache;
+}
+
+static void entry_free(ResultCacheEntry *e) {
+  free(e->key);
+  db_result_free(e->rs);
+  memset(e, 0, sizeof(*e));
+}
+
+/* Remove entry i, keeping the array dense. Caller holds the lock. */
+static void remove_entry(ResultCache *cache, size_t i) {
+  cache->bytes -= cache->entries[i].bytes;
+  entry_free(&cache->entries[i]);
+  cache->entries[i] = cache->entries[--cache->num_entries];
+}
+
+static void clear_locked(ResultCache *cache) {
+  for (size_t i = 0; i < cache->num_entries; i++)
+    entry_free(&cache->entries[i]);
+  cache->num_entries = 0;
+  cache->bytes = 0;
+}
+
+void result_cache_free(ResultCache *cache) {
+  if (!cache)
+    return;
+  clear_locked(cache);
+  free(cache->entries);
+  lace_mutex_destroy(&cache->mutex);
+  free(cache);
+}
+
+char *result_cache_key(const char *sql) {
+  if (!sql)
+    return NULL;
+
+  size_t len = strlen(sql);
+  char *key = safe_malloc(len + 1);
+  size_t n = 0;
+  bool pending_space = false;
+
+  for (size_t i = 0; i < len;) {
+    char c = sql[i];
+
+    /* Comments read as whitespace */
+    if (c == '-' && sql[i + 1] == '-') {
+      while (i < len && sql[i] != '\n')
+        i++;
+      pending_space = true;
+      continue;
+    }
+    if (c == '/' && sql[i + 1] == '*') {
+      const char *end = strstr(sql + i + 2, "*/");
+      i = end ? (size_t)(end - sql) + 2 : len;
+      pending_space = true;
+      continue;
+    }
+    if (isspace((unsigned char)c)) {
+      pending_space = true;
+      i++;
+      continue;
+    }
+
+    if (pending_space && n > 0)
+      key[n++] = ' ';
+    pending_space = false;
+
+    /* Quoted text and identifiers are kept verbatim */
+    if (c == '\'' || c == '"' || c == '`') {
+      key[n++] = sql[i++];
+      while (i < len) {
+        key[n++] = sql[i];
+        if (sql[i++] == c) {
+          if (sql[i] != c)
+            break;
+          key[n++] = sql[i++]; /* Doubled quote */
+        }
+      }
+      continue;
+    }
+    key[n++] = sql[i++];
+  }
+
+  /* Trailing statement terminators */
+  while (n > 0 && (key[n - 1] == ';' || key[n - 1] == ' '))
+    n--;
+  key[n] = '\0';
+  return key;
+}
+
+/* Index of the entry for key, or num_entries. Caller holds the lock. */
+static size_t find_entry(const ResultCache *cache, const char *key) {
+  size_t i = 0;
+  while (i < cache->num_entries && strcmp(cache->entries[i].key, key) != 0)
+    i++;
+  return i;
+}
+
+ResultSet *result_cache_get(ResultCache *cache, const char *sql,
+                            int64_t version) {
+  if (!cache || !sql)
+    return NULL;
+
+  char *key = result_cache_key(sql);
+  ResultSet *copy = NULL;
+
+  lace_mutex_lock(&cache->mutex);
+  size_t i = find_entry(cache, key);
+  if (i < cache->num_entries) {
+    ResultCacheEntry *e = &cache->entries[i];
+    if (e->version == version) {
+      e->last_used = ++cache->clock;
+      copy = db_result_copy(e->rs);
+    } else {
+      remove_entry(cache, i);
+    }
+  }
+  lace_mutex_unlock(&cache->mutex);
+
+  free(key);
+  return copy;
+}
+
+bool result_cache_put(ResultCache *cache, const char *sql,
+                      const ResultSet *rs, int64_t version, size_t max_bytes) {
+  if (!cache || !sql || !rs || max_bytes == 0)
+    return false;
+
+  /* Column definitions are small; rows are what the bound is about */
+  size_t bytes = db_result_memory(rs) + sizeof(ResultSet) +
+                 rs->num_columns * sizeof(ColumnDef);
+  if (bytes > max_bytes / 4)
+    return false;
+
+  char *key = result_cache_key(sql);
+  ResultSet *copy = db_result_copy(rs);
+
+  lace_mutex_lock(&cache->mutex);
+  size_t i = find_entry(cache, key);
+  if (i < cache->num_entries)
+    remove_entry(cache, i);
+
+  /* Evict least recently used entries until the new one fits */
+  while (cache->num_entries > 0 && cache->bytes + bytes > max_bytes) {
+    size_t lru = 0;
+    for (size_t j = 1; j < cache->num_entries; j++) {
+      if (cache->entries[j].last_used < cache->entries[lru].last_used)
+        lru = j;
+    }
+    remove_entry(cache, lru);
+  }
+
+  if (cache->num_entries == cache->capacity) {
+    cache->capacity = cache->capacity ? cache->capacity * 2 : 8;
+    cache->entries = safe_reallocarray(cache->entries, cache->capacity,
+                                       sizeof(ResultCacheEntry));
+  }
+  ResultCacheEntry *e = &cache->entries[cache->num_entries++];
+  e->key = key;
+  e->rs = copy;
+  e->bytes = bytes;
+  e->version = version;
+  e->last_used = ++cache->clock;
+  cache->bytes += bytes;
+  lace_mutex_unlock(&cache->mutex);
+  return true;
+}
+
+void result_cache_clear(ResultCache *cache) {
+  if (!cache)
+    return;
+  lace_mutex_lock(&cache->mutex);
+  clear_locked(cache);
+  lace_mutex_unlock(&cache->mutex);
+}
+
+/* Whether sql starts with keyword as a whole word */
+static bool starts_with_word(const char *sql, const char *keyword) {
+  size_t len = strlen(keyword);
+  return strncasecmp(sql, keyword, len) == 0 &&
+         !isalnum((unsigned char)sql[len]) && sql[len] != '_';
+}
+
+bool result_cache_sql_is_read(const char *sql) {
+  if (!sql)
+    return false;
+  while (*sql && (isspace((unsigned char)*sql) || *sql == '('))
+    sql++;
+
+  if (starts_with_word(sql, "EXPLAIN")) {
+    /* EXPLAIN ANALYZE runs the statement */
+    const char *p = sql + 7;
+    while (*p && isspace((unsigned char)*p))
+      p++;
+    return !starts_with_word(p, "ANALYZE") && !starts_with_word(p, "ANALYSE");
+  }
+  return starts_with_word(sql, "SELECT") || starts_with_word(sql, "SHOW") ||
+         starts_with_word(sql, "DESCRIBE") || starts_with_word(sql, "DESC") ||
+         starts_with_word(sql, "VALUES");
+}
+
+/* Functions and keywords whose value can differ between two runs with no
+ * write in between (PostgreSQL, SQLite and MySQL spellings) */
+static const char *const VOLATILE_WORDS[] = {
+    "now", "random", "randomblob", "rand", "nextval", "currval", "lastval",
+    "setval", "clock_timestamp", "statement_timestamp",
+    "transaction_timestamp", "timeofday", "current_timestamp",
+    "current_time", "current_date", "localtime", "localtimestamp", "sysdate",
+    "curdate", "curtime", "unix_timestamp", "utc_timestamp", "utc_date",
+    "utc_time", "gen_random_uuid", "uuid_generate_v1", "uuid_generate_v1mc",
+    "uuid_generate_v4", "uuid", "uuid_short", "last_insert_id",
+    "last_insert_rowid", "changes", "total_changes", "txid_current", "sleep",
+    "connection_id", NULL};
+
+/* Prefixes of system catalogs, views and the functions reading them */
+static const char *const SYSTEM_PREFIXES[] = {
+    "pg_", "information_schema", "performance_schema", "sqlite_", NULL};
+
+/* Date input strings that mean "whenever this runs" */
+static const char *const VOLATILE_LITERALS[] = {"now", "today", "tomorrow",
+                                                "yesterday", NULL};
+
+/* Whether word (len bytes, any case) is listed, or starts with a listed
+ * prefix */
+static bool word_listed(const char *word, size_t len,
+                        const char *const *list, bool prefix) {
+  for (size_t i = 0; list[i]; i++) {
+    size_t n = strlen(list[i]);
+    if ((prefix ? len >= n : len == n) && strncasecmp(word, list[i], n) == 0)
+      return true;
+  }
+  return false;
+}
+
+bool result_cache_sql_cacheable(const char *sql) {
+  if (!sql)
+    return false;
+
+  for (const char *p = sql; *p;) {
+    char c = *p;
+    if (c == '\'' || c == '"' || c == '`') {
+      /* Quoted: a string compared as a date input, or an identifier */
+      const char *start = ++p;
+      while (*p && (*p != c || p[1] == c))
+        p += *p == c ? 2 : 1;
+      size_t len = (size_t)(p - start);
+      if (c == '\'' ? word_listed(start, len, VOLATILE_LITERALS, false)
+                    : word_listed(start, len, SYSTEM_PREFIXES, true))
+        return false;
+      if (*p)
+        p++;
+    } else if (isalpha((unsigned char)c) || c == '_') {
+      const char *start = p;
+      while (isalnum((unsigned char)*p) || *p == '_' || *p == '$')
+        p++;
+      size_t len = (size_t)(p - start);
+      if (word_listed(start, len, VOLATILE_WORDS, false) ||
+          word_listed(start, len, SYSTEM_PREFIXES, true))
+        return false;
+    } else {
+      p++;
+    }
+  }
+  return true;
+}
@@ -0,0 +1,88 @@
+/*
+ * Lace
+ * Query result cache - recent read-only results of one connection
+ *
+ * Running the same query again (from history, or the buffer re-executed)
+ * is answered from memory while nothing can have changed its result.
+ * Entries are keyed by the query's normalized text and stamped with the
+ * database's data version when they were read (see db_data_version); an
+ * entry read at another version is stale. Writes made through the
+ * connection itself don't always move the version, so the owner clears the
+ * cache when it sees one. Least recently used entries are dropped first to
+ * stay under the byte bound.
+ *
+ * The version is only as good as the driver's probe: PostgreSQL's is read
+ * from the statistics system, which other sessions flush up to a second
+ * or so after they commit, so their writes can be missed that long.
+ * Queries whose result changes without any write (volatile functions,
+ * system views) are never cached.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_RESULT_CACHE_H
+#define LACE_RESULT_CACHE_H
+
+#include "../db/db.h"
+#include "../platform/thread.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* One cached result */
+typedef struct {
+  char *key;          /* Normalized SQL */
+  ResultSet *rs;      /* Owned copy of the rows */
+  size_t bytes;       /* Charged size of rs */
+  int64_t version;    /* Data version the rows were read at */
+  uint64_t last_used; /* Use stamp, for LRU eviction */
+} ResultCacheEntry;
+
+/* Cache of one connection. Writes may be reported from worker threads, so
+ * every operation takes the lock. */
+typedef struct ResultCache {
+  ResultCacheEntry *entries;
+  size_t num_entries;
+  size_t capacity;
+  size_t bytes;   /* Sum of entry sizes */
+  uint64_t clock; /* Last use stamp handed out */
+  lace_mutex_t mutex;
+} ResultCache;
+
+/* Create an empty cache */
+ResultCache *result_cache_create(void);
+
+/* Free the cache and every entry */
+void result_cache_free(ResultCache *cache);
+
+/* Cache key of sql: comments dropped, whitespace runs outside quotes
+ * collapsed to one space, trailing semicolons removed. Caller frees. */
+char *result_cache_key(const char *sql);
+
+/* Copy of the result cached for sql at version, or NULL (a stale entry is
+ * dropped). Caller frees. */
+ResultSet *result_cache_get(ResultCache *cache, const char *sql,
+                            int64_t version);
+
+/* Cache a copy of rs for sql read at version, evicting least recently used
+ * entries to stay within max_bytes. Results larger than a quarter of
+ * max_bytes are not cached. */
+bool result_cache_put(ResultCache *cache, const char *sql,
+                      const ResultSet *rs, int64_t version, size_t max_bytes);
+
+/* Drop every entry (data changed) */
+void result_cache_clear(ResultCache *cache);
+
+/* Whether sql can't change data: SELECT, SHOW, DESCRIBE, EXPLAIN, VALUES.
+ * Anything else (including PRAGMA and WITH, which may write) counts as a
+ * write. */
+bool result_cache_sql_is_read(const char *sql);
+
+/* Whether a read's result may be cached: it calls no volatile function
+ * (now(), random(), nextval()...) and reads no system catalog or view
+ * (pg_*, information_schema, sqlite_*...), whose results change without
+ * moving the data version. Errs on the side of not caching. */
+bool result_cache_sql_cacheable(const char *sql);
+
+#endif /* LACE_RESULT_CACHE_H */
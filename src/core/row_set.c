@@ -0,0 +1,239 @@
+/*
+ * Lace
+ * Row set - compressed set of global row indices for row selection
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "row_set.h"
+#include "../util/mem.h"
+#include "constants.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * Range storage
+ * ============================================================================
+ */
+
+/* Index of the first range whose end is > row (or >= row if touch) */
+static size_t ranges_lower(const RowSet *set, size_t row, bool touch) {
+  size_t lo = 0, hi = set->num_ranges;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    size_t end = set->ranges[mid].end;
+    if (touch ? end < row : end <= row)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+/* Index of the first range whose start is > row (or >= row if !touch) */
+static size_t ranges_upper(const RowSet *set, size_t row, bool touch) {
+  size_t lo = 0, hi = set->num_ranges;
+  while (lo < hi) {
+    size_t mid = lo + (hi - lo) / 2;
+    size_t start = set->ranges[mid].start;
+    if (touch ? start <= row : start < row)
+      lo = mid + 1;
+    else
+      hi = mid;
+  }
+  return lo;
+}
+
+static bool ranges_contain(const RowSet *set, size_t row) {
+  size_t i = ranges_lower(set, row, false);
+  return i < set->num_ranges && set->ranges[i].start <= row;
+}
+
+/* Replace ranges [i, j) with n new ranges */
+static void ranges_splice(RowSet *set, size_t i, size_t j,
+                          const RowRange *repl, size_t n) {
+  for (size_t k = i; k < j; k++)
+    set->covered -= set->ranges[k].end - set->ranges[k].start;
+
+  size_t new_count = set->num_ranges - (j - i) + n;
+  if (new_count > set->capacity) {
+    size_t new_cap =
+        set->capacity == 0 ? INITIAL_SELECTION_CAPACITY : set->capacity * 2;
+    while (new_cap < new_count)
+      new_cap *= 2;
+    set->ranges = safe_reallocarray(set->ranges, new_cap, sizeof(RowRange));
+    set->capacity = new_cap;
+  }
+
+  memmove(&set->ranges[i + n], &set->ranges[j],
+          (set->num_ranges - j) * sizeof(RowRange));
+  for (size_t k = 0; k < n; k++) {
+    set->ranges[i + k] = repl[k];
+    set->covered += repl[k].end - repl[k].start;
+  }
+  set->num_ranges = new_count;
+}
+
+/* Cover [a, b), merging with overlapping or adjacent ranges */
+static void ranges_insert(RowSet *set, size_t a, size_t b) {
+  if (a >= b)
+    return;
+
+  size_t i = ranges_lower(set, a, true);
+  size_t j = ranges_upper(set, b, true);
+
+  RowRange merged = {a, b};
+  if (i < j) {
+    if (set->ranges[i].start < merged.start)
+      merged.start = set->ranges[i].start;
+    if (set->ranges[j - 1].end > merged.end)
+      merged.end = set->ranges[j - 1].end;
+  }
+  ranges_splice(set, i, j, &merged, 1);
+}
+
+/* Uncover [a, b), splitting a range that straddles it */
+static void ranges_erase(RowSet *set, size_t a, size_t b) {
+  if (a >= b)
+    return;
+
+  size_t i = ranges_lower(set, a, false);
+  size_t j = ranges_upper(set, b, false);
+  if (i >= j)
+    return;
+
+  RowRange keep[2];
+  size_t n = 0;
+  if (set->ranges[i].start < a)
+    keep[n++] = (RowRange){set->ranges[i].start, a};
+  if (set->ranges[j - 1].end > b)
+    keep[n++] = (RowRange){b, set->ranges[j - 1].end};
+  ranges_splice(set, i, j, keep, n);
+}
+
+/* ============================================================================
+ * Public API
+ * ============================================================================
+ */
+
+void row_set_free(RowSet *set) {
+  if (!set)
+    return;
+  free(set->ranges);
+  memset(set, 0, sizeof(*set));
+}
+
+void row_set_clear(RowSet *set) {
+  if (!set)
+    return;
+  set->num_ranges = 0;
+  set->covered = 0;
+  set->inverted = false;
+  set->universe = 0;
+}
+
+bool row_set_contains(const RowSet *set, size_t row) {
+  if (!set)
+    return false;
+  if (set->inverted)
+    return row < set->universe && !ranges_contain(set, row);
+  return ranges_contain(set, row);
+}
+
+bool row_set_add(RowSet *set, size_t row) {
+  if (!set || row_set_contains(set, row))
+    return false;
+  if (set->inverted) {
+    if (row >= set->universe)
+      return false; /* Outside the symbolic selection */
+    ranges_erase(set, row, row + 1);
+  } else {
+    ranges_insert(set, row, row + 1);
+  }
+  return true;
+}
+
+bool row_set_remove(RowSet *set, size_t row) {
+  if (!set || !row_set_contains(set, row))
+    return false;
+  if (set->inverted)
+    ranges_insert(set, row, row + 1);
+  else
+    ranges_erase(set, row, row + 1);
+  return true;
+}
+
+bool row_set_toggle(RowSet *set, size_t row) {
+  if (!set)
+    return false;
+  if (row_set_remove(set, row))
+    return false;
+  return row_set_add(set, row);
+}
+
+void row_set_add_range(RowSet *set, size_t first, size_t last) {
+  if (!set)
+    return;
+  if (first > last) {
+    size_t tmp = first;
+    first = last;
+    last = tmp;
+  }
+  size_t end = last == (size_t)-1 ? last : last + 1;
+
+  if (set->inverted) {
+    if (end > set->universe)
+      end = set->universe;
+    ranges_erase(set, first, end);
+  } else {
+    ranges_insert(set, first, end);
+  }
+}
+
+void row_set_select_all(RowSet *set, size_t universe) {
+  if (!set)
+    return;
+  set->num_ranges = 0;
+  set->covered = 0;
+  set->inverted = true;
+  set->universe = universe;
+}
+
+bool row_set_is_all(const RowSet *set) {
+  return set && set->inverted && set->num_ranges == 0;
+}
+
+size_t row_set_count(const RowSet *set) {
+  if (!set)
+    return 0;
+  if (set->inverted)
+    return set->universe - set->covered;
+  return set->covered;
+}
+
+bool row_set_next(const RowSet *set, size_t from, size_t *row) {
+  if (!set)
+    return false;
+
+  size_t i = ranges_lower(set, from, false);
+  if (!set->inverted) {
+    if (i >= set->num_ranges)
+      return false;
+    size_t start = set->ranges[i].start;
+    if (row)
+      *row = start > from ? start : from;
+    return true;
+  }
+
+  /* Inverted: skip the exclusion range covering from, if any. Ranges are
+   * coalesced, so the row after it is always a member. */
+  size_t candidate = from;
+  if (i < set->num_ranges && set->ranges[i].start <= candidate)
+    candidate = set->ranges[i].end;
+  if (candidate >= set->universe)
+    return false;
+  if (row)
+    *row = candidate;
+  return true;
+}
@@ -0,0 +1,65 @@
+/*
+ * Lace
+ * Row set - compressed set of global row indices for row selection
+ *
+ * Members are kept as sorted, disjoint, non-adjacent half-open ranges, so a
+ * contiguous block of a million rows costs one entry and membership is a
+ * binary search. "All rows" is symbolic: the set is inverted over a universe
+ * of row indices and the ranges hold the exclusions instead.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_ROW_SET_H
+#define LACE_ROW_SET_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+typedef struct {
+  size_t start; /* First row in range */
+  size_t end;   /* One past the last row */
+} RowRange;
+
+typedef struct {
+  RowRange *ranges;   /* Sorted disjoint ranges (exclusions when inverted) */
+  size_t num_ranges;  /* Number of ranges */
+  size_t capacity;    /* Allocated ranges */
+  size_t covered;     /* Rows covered by ranges */
+  bool inverted;      /* Set holds [0, universe) minus ranges */
+  size_t universe;    /* Row count for inverted sets */
+} RowSet;
+
+/* Free range storage and reset to empty */
+void row_set_free(RowSet *set);
+
+/* Remove all members (keeps storage for reuse) */
+void row_set_clear(RowSet *set);
+
+/* O(log n) membership test */
+bool row_set_contains(const RowSet *set, size_t row);
+
+/* Add / remove a single row. Return true if the set changed. */
+bool row_set_add(RowSet *set, size_t row);
+bool row_set_remove(RowSet *set, size_t row);
+
+/* Toggle a row, returns true if it is now a member */
+bool row_set_toggle(RowSet *set, size_t row);
+
+/* Add every row in [first, last] (inclusive, either order) */
+void row_set_add_range(RowSet *set, size_t first, size_t last);
+
+/* Make the set contain every row in [0, universe) in O(1) */
+void row_set_select_all(RowSet *set, size_t universe);
+
+/* True when the set is the symbolic "all rows" selection */
+bool row_set_is_all(const RowSet *set);
+
+/* Number of member rows */
+size_t row_set_count(const RowSet *set);
+
+/* Find the smallest member >= from. Returns false if there is none. */
+bool row_set_next(const RowSet *set, size_t from, size_t *row);
+
+#endif /* LACE_ROW_SET_H */
@@ -0,0 +1,174 @@
+/*
+ * Lace
+ * Row watch - incremental refresh of a table tab's visible rows
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "row_watch.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include "constants.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Column names applications conventionally set on every update */
+static const char *version_column_names[] = {
+    "updated_at", "modified_at", "updated_on", "modified_on",
+    "last_modified", "last_updated", "mtime",
+};
+
+/* Schema index of the table's update timestamp column, SIZE_MAX if none */
+static size_t find_version_column(const TableSchema *schema) {
+  for (size_t n = 0; n < sizeof(version_column_names) / sizeof(char *); n++) {
+    for (size_t c = 0; c < schema->num_columns; c++) {
+      const ColumnDef *col = &schema->columns[c];
+      if (col->name && col->type != DB_TYPE_BLOB &&
+          str_eq_nocase(col->name, version_column_names[n]))
+        return c;
+    }
+  }
+  return SIZE_MAX;
+}
+
+/* Whether kind can version this table's rows */
+static bool kind_usable(RowWatch *w, DbRowVersion kind,
+                        const TableSchema *schema, const char *driver_name) {
+  switch (kind) {
+  case DB_ROW_VERSION_XMIN:
+    return str_eq(driver_name, "postgres");
+  case DB_ROW_VERSION_COLUMN:
+    w->version_col = find_version_column(schema);
+    return w->version_col != SIZE_MAX;
+  case DB_ROW_VERSION_HASH:
+    return true;
+  }
+  return false;
+}
+
+size_t row_watch_key_columns(const TableSchema *schema, size_t *cols) {
+  size_t n = 0;
+  for (size_t c = 0; schema && c < schema->num_columns && n < MAX_PK_COLUMNS;
+       c++) {
+    if (schema->columns[c].primary_key && schema->columns[c].name)
+      cols[n++] = c;
+  }
+  return n;
+}
+
+bool row_watch_start(RowWatch *w, const TableSchema *schema,
+                     const char *driver_name) {
+  size_t cols[MAX_PK_COLUMNS];
+  if (!w || row_watch_key_columns(schema, cols) == 0)
+    return false;
+
+  row_watch_stop(w);
+  w->kind = DB_ROW_VERSION_HASH;
+  for (int k = DB_ROW_VERSION_XMIN; k <= DB_ROW_VERSION_HASH; k++) {
+    if (kind_usable(w, (DbRowVersion)k, schema, driver_name)) {
+      w->kind = (DbRowVersion)k;
+      break;
+    }
+  }
+  w->enabled = true;
+  w->next_tick = 0;
+  return true;
+}
+
+bool row_watch_next_kind(RowWatch *w, const TableSchema *schema) {
+  if (!w)
+    return false;
+  for (int k = (int)w->kind + 1; k <= DB_ROW_VERSION_HASH; k++) {
+    /* xmin comes first, so the driver no longer matters */
+    if (kind_usable(w, (DbRowVersion)k, schema, NULL)) {
+      w->kind = (DbRowVersion)k;
+      return true;
+    }
+  }
+  return false;
+}
+
+void row_watch_stop(RowWatch *w) {
+  if (!w)
+    return;
+  row_watch_set_seen(w, NULL, 0);
+  FREE_NULL(w->changed);
+  memset(w, 0, sizeof(RowWatch));
+}
+
+char *row_watch_key(const DbValue *vals, const size_t *cols, size_t num_cols) {
+  StringBuilder *sb = sb_new(32);
+  bool ok = sb != NULL;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    const DbValue *val = &vals[cols ? cols[i] : i];
+    char *str = val->is_null ? NULL : db_value_to_string(val);
+    /* Unit separator between values; NULL keys never match anything */
+    if (i > 0)
+      ok = sb_append_char(sb, '\x1f');
+    ok = ok && sb_append(sb, str ? str : "\x1e");
+    free(str);
+  }
+  if (!ok) {
+    sb_free(sb);
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+const char *row_watch_version(const RowWatch *w, const char *key) {
+  if (!w || !key)
+    return NULL;
+  for (size_t i = 0; i < w->num_seen; i++) {
+    if (str_eq(w->seen[i].key, key))
+      return w->seen[i].version;
+  }
+  return NULL;
+}
+
+void row_watch_set_seen(RowWatch *w, RowWatchEntry *entries, size_t count) {
+  for (size_t i = 0; i < w->num_seen; i++) {
+    free(w->seen[i].key);
+    free(w->seen[i].version);
+  }
+  free(w->seen);
+  w->seen = entries;
+  w->num_seen = entries ? count : 0;
+}
+
+bool row_watch_reset_changes(RowWatch *w, size_t offset, size_t rows,
+                             size_t cols) {
+  bool had = false;
+  for (size_t i = 0; w->changed && i < w->changed_rows * w->changed_cols;
+       i++) {
+    if (w->changed[i]) {
+      had = true;
+      break;
+    }
+  }
+
+  FREE_NULL(w->changed);
+  w->changed_offset = offset;
+  w->changed_rows = 0;
+  w->changed_cols = 0;
+  if (rows > 0 && cols > 0) {
+    w->changed = safe_calloc(rows * cols, sizeof(bool));
+    w->changed_rows = rows;
+    w->changed_cols = cols;
+  }
+  return had;
+}
+
+void row_watch_flag(RowWatch *w, size_t abs_row, size_t col) {
+  if (!w->changed || abs_row < w->changed_offset ||
+      abs_row - w->changed_offset >= w->changed_rows || col >= w->changed_cols)
+    return;
+  w->changed[(abs_row - w->changed_offset) * w->changed_cols + col] = true;
+}
+
+bool row_watch_changed(const RowWatch *w, size_t abs_row, size_t col) {
+  if (!w || !w->changed || abs_row < w->changed_offset ||
+      abs_row - w->changed_offset >= w->changed_rows || col >= w->changed_cols)
+    return false;
+  return w->changed[(abs_row - w->changed_offset) * w->changed_cols + col];
+}
@@ -0,0 +1,81 @@
+/*
+ * Lace
+ * Row watch - incremental refresh of a table tab's visible rows
+ *
+ * While watching, a table tab periodically asks the server for the key and
+ * a row version (see DbRowVersion) of each row in view, and compares them
+ * with the versions it saw last time. Only the rows that moved or whose
+ * version changed are fetched and patched into the loaded data, so an idle
+ * watch costs a few bytes per row and tick instead of a page reload.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_ROW_WATCH_H
+#define LACE_ROW_WATCH_H
+
+#include "../db/db.h"
+#include <stdbool.h>
+#include <stddef.h>
+#include <stdint.h>
+
+/* Version last seen for one key */
+typedef struct {
+  char *key;     /* row_watch_key() of the row */
+  char *version; /* Row version as text */
+} RowWatchEntry;
+
+typedef struct {
+  bool enabled;
+  uint64_t next_tick;  /* lace_time_ms() of the next probe */
+  DbRowVersion kind;   /* Version the probes compute */
+  size_t version_col;  /* Schema column for DB_ROW_VERSION_COLUMN */
+  RowWatchEntry *seen; /* Keys and versions of the last probed rows */
+  size_t num_seen;
+
+  /* Cells the last tick patched, flagged for highlighting over the
+   * absolute rows [changed_offset, changed_offset + changed_rows) */
+  bool *changed;
+  size_t changed_offset;
+  size_t changed_rows;
+  size_t changed_cols;
+} RowWatch;
+
+/* Start watching rows of schema on a driver: picks the cheapest row
+ * version it offers. False if the table has no primary key. */
+bool row_watch_start(RowWatch *w, const TableSchema *schema,
+                     const char *driver_name);
+
+/* Fall back to the next row version after a probe with the current one
+ * failed. False when none is left. */
+bool row_watch_next_kind(RowWatch *w, const TableSchema *schema);
+
+/* Stop watching and free everything */
+void row_watch_stop(RowWatch *w);
+
+/* Schema indexes of the primary key columns; returns how many */
+size_t row_watch_key_columns(const TableSchema *schema, size_t *cols);
+
+/* Text identifying a row by its key values (cols indexes into vals, or NULL
+ * for vals[0..num_cols)). Caller must free. */
+char *row_watch_key(const DbValue *vals, const size_t *cols, size_t num_cols);
+
+/* Version last seen for key, NULL if none */
+const char *row_watch_version(const RowWatch *w, const char *key);
+
+/* Replace the versions seen with entries (takes ownership) */
+void row_watch_set_seen(RowWatch *w, RowWatchEntry *entries, size_t count);
+
+/* Clear the change flags and cover rows absolute rows starting at offset. Returns
+ * true if any cell was flagged before. */
+bool row_watch_reset_changes(RowWatch *w, size_t offset, size_t rows,
+                             size_t cols);
+
+/* Flag a patched cell */
+void row_watch_flag(RowWatch *w, size_t abs_row, size_t col);
+
+/* Whether the last tick patched the cell */
+bool row_watch_changed(const RowWatch *w, size_t abs_row, size_t col);
+
+#endif /* LACE_ROW_WATCH_H */
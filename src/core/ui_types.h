@@ -36,6 +36,7 @@ typedef enum {
   UI_COLOR_EDIT,
   UI_COLOR_ERROR_TEXT, /* Error message text (distinct from error background) */
   UI_COLOR_PK,         /* Primary key column indicator */
+  UI_COLOR_CHANGED,    /* Cell changed by a watch refresh */
   UI_COLOR_COUNT
 } UiColor;
 
@@ -16,6 +16,47 @@
 /* Forward declaration */
 typedef struct DbConnection DbConnection;
 
+/* Where the time of one query went, recorded by drivers when the
+ * connection's measure_queries is set */
+typedef struct {
+  uint64_t server_us; /* Waiting for the database: execution and transfer */
+  uint64_t decode_us; /* Converting the rows into DbValues */
+  size_t bytes;       /* Value bytes received */
+} DbQueryStats;
+
+/* Outcome of one statement of a script */
+typedef enum {
+  DB_STMT_SKIPPED,     /* Not run (stopped before it, or cancelled) */
+  DB_STMT_OK,          /* Ran and its effects stayed */
+  DB_STMT_ERROR,       /* Failed */
+  DB_STMT_ROLLED_BACK, /* Ran, but undone by a later failure */
+} DbStmtStatus;
+
+typedef struct {
+  DbStmtStatus status;
+  int64_t rows; /* Affected (or returned) rows, -1 if unknown */
+  char *error;  /* Server message for DB_STMT_ERROR */
+} DbStmtResult;
+
+/* Statements sent per round trip by drivers that batch scripts */
+#define DB_SCRIPT_BATCH_STATEMENTS 100
+#define DB_SCRIPT_BATCH_BYTES (1024 * 1024)
+
+/* A script of statements run by db_exec_script */
+typedef struct {
+  const char *const *stmts; /* Statement texts, without terminators */
+  size_t count;
+  bool stop_on_error;    /* Skip what follows a failed statement */
+  bool transaction;      /* All or nothing (implies stop_on_error) */
+  DbStmtResult *results; /* count entries, filled as statements finish */
+  size_t done;           /* Statements finished so far */
+  bool cancelled;        /* progress asked to stop */
+  /* Called (from the running thread) after each statement; return false to
+   * stop before the next one */
+  bool (*progress)(void *ctx, size_t done);
+  void *progress_ctx;
+} DbScript;
+
 /* Database driver interface (vtable) */
 typedef struct DbDriver {
   const char *name;         /* "sqlite", "postgres", "mysql" */
@@ -38,6 +79,10 @@ typedef struct DbDriver {
   ResultSet *(*query)(DbConnection *conn, const char *sql, char **err);
   int64_t (*exec)(DbConnection *conn, const char *sql, char **err);
 
+  /* Run a script with fewer round trips (NULL = one exec per statement).
+   * Fills script->results; false only if the connection itself failed. */
+  bool (*exec_script)(DbConnection *conn, DbScript *script, char **err);
+
   /* Paginated queries */
   ResultSet *(*query_page)(DbConnection *conn, const char *table, size_t offset,
                            size_t limit, const char *order_by, bool desc,
@@ -74,6 +119,31 @@ typedef struct DbDriver {
   int64_t (*estimate_row_count)(DbConnection *conn, const char *table,
                                 char **err);
 
+  /* Server-side result cursors (NULL if unsupported). cursor_open runs sql
+   * once and keeps its result on the server; cursor_fetch reads rows
+   * [offset, offset + limit) of it without running sql again. */
+  void *(*cursor_open)(DbConnection *conn, const char *sql, size_t *num_rows,
+                       char **err);
+  ResultSet *(*cursor_fetch)(DbConnection *conn, void *cursor, size_t offset,
+                             size_t limit, char **err);
+  void (*cursor_close)(DbConnection *conn, void *cursor);
+
+  /* Cheap probe that changes when the database's data may have changed
+   * (NULL if unsupported). Only differences between two calls matter. */
+  int64_t (*data_version)(DbConnection *conn, char **err);
+
+  /* Payloads of the notifications that arrived on channels the connection
+   * LISTENs on since the last call, without waiting (NULL if unsupported).
+   * NULL with *count 0 when none arrived. */
+  char **(*notifications)(DbConnection *conn, size_t *count, char **err);
+
+  /* Run sql with its placeholders ($1, $2... on PostgreSQL, ? elsewhere)
+   * bound to params, keeping the statement prepared so the next call with
+   * the same text skips parsing and planning (NULL if unsupported) */
+  ResultSet *(*query_params)(DbConnection *conn, const char *sql,
+                             const DbValue *params, size_t num_params,
+                             char **err);
+
   /* Library cleanup (called once at program exit) */
   void (*library_cleanup)(void);
 
@@ -103,8 +173,20 @@ struct DbConnection {
    * type values: 0=auto-detect, or HistoryEntryType from history.h */
   void (*history_callback)(void *context, const char *sql, int type);
   void *history_context;
+
+  /* Query timing (benchmarks): when set, query() fills last_stats */
+  bool measure_queries;
+  DbQueryStats last_stats;
 };
 
+/* Server-side cursor over one query's result */
+typedef struct {
+  DbConnection *conn;
+  void *handle;    /* Driver cursor state */
+  size_t num_rows; /* Rows in the result */
+  bool owns_conn;  /* conn was opened for this cursor: closed with it */
+} DbCursor;
+
 /* History type hint for callback (matches HistoryEntryType) */
 #define DB_HISTORY_AUTO 0   /* Auto-detect from SQL */
 #define DB_HISTORY_QUERY 0  /* Manual query */
@@ -114,9 +196,16 @@ struct DbConnection {
 #define DB_HISTORY_INSERT 4 /* Row insert */
 #define DB_HISTORY_DDL 5    /* CREATE/ALTER/DROP */
 
+/* Pass sql to conn's history callback, if it has one. Statements run on
+ * another connection on conn's behalf are recorded with this. */
+void db_record_history(DbConnection *conn, const char *sql, int type);
+
 /* Driver registration */
 void db_register_driver(DbDriver *driver);
 DbDriver *db_get_driver(const char *name);
+
+/* Whether a driver name (or one of its aliases) is PostgreSQL's */
+bool db_driver_is_postgres(const char *name);
 DbDriver **db_get_all_drivers(size_t *count);
 
 /* High-level connection API */
@@ -146,6 +235,41 @@ ResultSet *db_query_page(DbConnection *conn, const char *table, size_t offset,
                          char **err);
 int64_t db_count_rows(DbConnection *conn, const char *table, char **err);
 
+/* Run script's statements in order, batched where the driver supports it.
+ * With script->transaction they run in one transaction that is rolled back
+ * if any of them fails. Per-statement outcomes go to script->results
+ * (allocated here, free with db_script_free_results). Returns true if
+ * every statement succeeded; otherwise *err describes the first failure. */
+bool db_exec_script(DbConnection *conn, DbScript *script, char **err);
+void db_script_free_results(DbScript *script);
+
+/* Record the outcome of statement i and advance script->done. Returns
+ * false if the driver should stop: the statement failed and the script
+ * stops on errors, or progress asked to stop. For drivers. */
+bool db_script_finish_stmt(DbScript *script, size_t i, DbStmtStatus status,
+                           int64_t rows, const char *error);
+
+/* Mark results from..to-1 that ran as rolled back. For drivers. */
+void db_script_mark_rolled_back(DbScript *script, size_t from, size_t to);
+
+/* Server-side cursors - page through a query's result without re-running
+ * the query. db_cursor_open returns NULL if the driver has no cursors or the
+ * query fails; close before disconnecting (unless the cursor owns_conn, then
+ * closing it disconnects). */
+DbCursor *db_cursor_open(DbConnection *conn, const char *sql, char **err);
+ResultSet *db_cursor_fetch(DbCursor *cur, size_t offset, size_t limit,
+                           char **err);
+void db_cursor_close(DbCursor *cur);
+
+/* Data version probe (see DbDriver.data_version). -1 if the driver has none
+ * or the probe failed; not recorded in history. */
+int64_t db_data_version(DbConnection *conn, char **err);
+
+/* Notification payloads received so far (see DbDriver.notifications).
+ * NULL with *count 0 if none arrived or the driver has none. Caller frees
+ * each string and the array. */
+char **db_notifications(DbConnection *conn, size_t *count, char **err);
+
 /* Fast row count (uses approximate estimate if available) */
 int64_t db_count_rows_fast(DbConnection *conn, const char *table,
                            bool allow_approximate, bool *is_approximate,
@@ -159,6 +283,33 @@ ResultSet *db_query_page_where(DbConnection *conn, const char *table,
 int64_t db_count_rows_where(DbConnection *conn, const char *table,
                             const char *where_clause, char **err);
 
+/* Query with placeholders bound to params (see DbDriver.query_params).
+ * Drivers without prepared statements get the values written into the SQL
+ * as literals. History records the SQL with the values in place. */
+ResultSet *db_query_params(DbConnection *conn, const char *sql,
+                           const DbValue *params, size_t num_params,
+                           char **err);
+
+/* The filtered queries with where_clause's placeholders bound to params, as
+ * compiled by filters_compile_where */
+ResultSet *db_query_page_where_params(DbConnection *conn, const char *table,
+                                      size_t offset, size_t limit,
+                                      const char *where_clause,
+                                      const DbValue *params,
+                                      size_t num_params, const char *order_by,
+                                      bool desc, char **err);
+int64_t db_count_rows_where_params(DbConnection *conn, const char *table,
+                                   const char *where_clause,
+                                   const DbValue *params, size_t num_params,
+                                   char **err);
+
+/* Ask the planner (EXPLAIN, nothing is read) whether
+ * SELECT ... WHERE where_clause on table would read every row: *full_scan
+ * is false when an index narrows the read */
+bool db_explain_full_scan(DbConnection *conn, const char *table,
+                          const char *where_clause, bool *full_scan,
+                          char **err);
+
 /* Data manipulation */
 bool db_update_cell(DbConnection *conn, const char *table, const char **pk_cols,
                     const DbValue *pk_vals, size_t num_pk_cols, const char *col,
@@ -168,6 +319,86 @@ bool db_insert_row(DbConnection *conn, const char *table, const ColumnDef *cols,
 bool db_delete_row(DbConnection *conn, const char *table, const char **pk_cols,
                    const DbValue *pk_vals, size_t num_pk_cols, char **err);
 
+/* Rows per statement for db_update_cells */
+#define DB_UPDATE_BATCH_ROWS 500
+
+/* Set col in many rows at once. pk_vals holds num_rows groups of num_pk_cols
+ * key values, new_vals one value per row. Rows are written in batches of
+ * DB_UPDATE_BATCH_ROWS as UPDATE ... SET col = CASE ... END statements.
+ * Call inside a transaction for all-or-nothing semantics.
+ * Returns affected rows, -1 on error. */
+int64_t db_update_cells(DbConnection *conn, const char *table,
+                        const char **pk_cols, size_t num_pk_cols,
+                        const DbValue *pk_vals, const char *col,
+                        const DbValue *new_vals, size_t num_rows,
+                        char **err);
+
+/* Predicate-based bulk statements. where_clause is a filter predicate as
+ * built by filters_build_where (NULL or empty = every row). Return a newly
+ * allocated SQL statement, or NULL with *err set. */
+char *db_build_delete_where(DbConnection *conn, const char *table,
+                            const char *where_clause, char **err);
+char *db_build_update_where(DbConnection *conn, const char *table,
+                            const char *col, const DbValue *new_val,
+                            const char *where_clause, char **err);
+
+/* Find-in-grid continuation. Builds a query returning one row with the
+ * 0-based position (within where_clause and order_by, as paged by
+ * db_query_page_where) of the first row after position `after` (-1 = from
+ * the start) where any of the columns contains needle, ignoring case.
+ * order_by is a pre-built clause or NULL. Returns NULL with *err set. */
+char *db_build_find_row_sql(DbConnection *conn, const char *table,
+                            const char **columns, size_t num_columns,
+                            const char *where_clause, const char *order_by,
+                            const char *needle, int64_t after, char **err);
+
+/* Keyset predicate over a sort key: rows ordered at or after vals (after =
+ * true) or strictly before them (after = false) under ORDER BY cols, each
+ * ascending unless desc[i]. Key columns must not hold NULLs. Returns NULL
+ * with *err set. */
+char *db_build_key_where(DbConnection *conn, const char **cols,
+                         const bool *desc, const DbValue *vals,
+                         size_t num_cols, bool after, char **err);
+
+/* Landmark sample: the key columns of rows 0, stride, 2 * stride, ... under
+ * where_clause and order_by (as paged by db_query_page_where), in order.
+ * Returns NULL with *err set. */
+char *db_build_landmark_sql(DbConnection *conn, const char *table,
+                            const char **cols, size_t num_cols,
+                            const char *where_clause, const char *order_by,
+                            size_t stride, char **err);
+
+/* Row version: a cheap value the server computes per row that changes
+ * whenever the row does */
+typedef enum {
+  DB_ROW_VERSION_XMIN,   /* PostgreSQL xmin (the last writing transaction) */
+  DB_ROW_VERSION_COLUMN, /* A column the application sets on every update */
+  DB_ROW_VERSION_HASH    /* Hash of all columns */
+} DbRowVersion;
+
+/* Version probe: the key columns and, last, the row version of limit rows
+ * from offset under where_clause and order_by (as paged by
+ * db_query_page_where). columns holds the version column for
+ * DB_ROW_VERSION_COLUMN and the columns to hash for DB_ROW_VERSION_HASH.
+ * Returns NULL with *err set. */
+char *db_build_row_version_sql(DbConnection *conn, const char *table,
+                               const char **key_cols, size_t num_key_cols,
+                               DbRowVersion kind, const char **columns,
+                               size_t num_columns, const char *where_clause,
+                               const char *order_by, size_t offset,
+                               size_t limit, char **err);
+
+/* Statements installing a trigger that sends table's name to channel on
+ * every write to it (PostgreSQL only). Returns NULL with *err set. */
+char *db_build_notify_trigger_sql(DbConnection *conn, const char *table,
+                                  const char *channel, char **err);
+
+/* Predicate matching any of num_rows keys over cols; vals holds num_rows *
+ * num_cols values, row by row. Returns NULL with *err set. */
+char *db_build_keys_where(DbConnection *conn, const char **cols,
+                          size_t num_cols, const DbValue *vals,
+                          size_t num_rows, char **err);
+
 /* Transaction support */
 bool db_begin_transaction(DbConnection *conn, char **err);
 bool db_commit(DbConnection *conn, char **err);
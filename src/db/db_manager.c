@@ -7,19 +7,20 @@
  */
 
 #include "../core/constants.h"
+#include "../util/mem.h"
 #include "../util/str.h"
 #include "connstr.h"
 #include "db.h"
+#include <ctype.h>
 #include <errno.h>
+#include <math.h>
 #include <stdarg.h>
 #include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
-/* Helper to invoke history callback if set */
-static inline void db_record_history(DbConnection *conn, const char *sql,
-                                     int type) {
+void db_record_history(DbConnection *conn, const char *sql, int type) {
   if (conn && conn->history_callback && sql) {
     conn->history_callback(conn->history_context, sql, type);
   }
@@ -84,8 +85,16 @@ static char *escape_table_name(DbConnection *conn, const char *table) {
   return escape_identifier(conn, table);
 }
 
-/* Escape a value for SQL (escape single quotes by doubling) */
-static char *escape_sql_value(const char *value) {
+/* Whether the server reads backslash escapes inside string literals, as
+ * MySQL and MariaDB do by default */
+static bool backslash_escapes(const DbConnection *conn) {
+  return str_eq(conn->driver->name, "mysql") ||
+         str_eq(conn->driver->name, "mariadb");
+}
+
+/* Escape a value for SQL (escape single quotes by doubling, and with
+ * backslash set backslashes too) */
+static char *escape_sql_value(const char *value, bool backslash) {
   if (!value)
     return str_dup("NULL");
 
@@ -102,6 +111,8 @@ static char *escape_sql_value(const char *value) {
   for (const char *p = value; *p; p++) {
     if (*p == '\'') {
       sb_append(sb, "''"); /* Escape by doubling */
+    } else if (*p == '\\' && backslash) {
+      sb_append(sb, "\\\\");
     } else {
       sb_append_char(sb, *p);
     }
@@ -157,6 +168,11 @@ void db_register_driver(DbDriver *driver) {
   g_drivers[g_num_drivers++] = driver;
 }
 
+bool db_driver_is_postgres(const char *name) {
+  return str_eq(name, "postgres") || str_eq(name, "postgresql") ||
+         str_eq(name, "pg");
+}
+
 DbDriver *db_get_driver(const char *name) {
   if (!name)
     return NULL;
@@ -166,8 +182,7 @@ DbDriver *db_get_driver(const char *name) {
       return g_drivers[i];
     }
     /* Handle aliases */
-    if ((str_eq(name, "postgresql") || str_eq(name, "pg")) &&
-        str_eq(g_drivers[i]->name, "postgres")) {
+    if (db_driver_is_postgres(name) && str_eq(g_drivers[i]->name, "postgres")) {
       return g_drivers[i];
     }
     if (str_eq(name, "mariadb") && str_eq(g_drivers[i]->name, "mysql")) {
@@ -319,6 +334,172 @@ int64_t db_exec(DbConnection *conn, const char *sql, char **err) {
   return affected;
 }
 
+bool db_script_finish_stmt(DbScript *script, size_t i, DbStmtStatus status,
+                           int64_t rows, const char *error) {
+  DbStmtResult *r = &script->results[i];
+  r->status = status;
+  r->rows = rows;
+  free(r->error);
+  r->error = status == DB_STMT_ERROR
+                 ? str_dup(error && *error ? error : "Statement failed")
+                 : NULL;
+  script->done = i + 1;
+
+  bool go = status != DB_STMT_ERROR ||
+            !(script->stop_on_error || script->transaction);
+  if (script->progress &&
+      !script->progress(script->progress_ctx, script->done)) {
+    script->cancelled = true;
+    go = false;
+  }
+  return go;
+}
+
+void db_script_mark_rolled_back(DbScript *script, size_t from, size_t to) {
+  for (size_t i = from; i < to && i < script->count; i++) {
+    if (script->results[i].status == DB_STMT_OK)
+      script->results[i].status = DB_STMT_ROLLED_BACK;
+  }
+}
+
+void db_script_free_results(DbScript *script) {
+  if (!script || !script->results)
+    return;
+  for (size_t i = 0; i < script->count; i++)
+    free(script->results[i].error);
+  free(script->results);
+  script->results = NULL;
+}
+
+/* One driver exec per statement, for drivers without exec_script */
+static void exec_script_sequential(DbConnection *conn, DbScript *script) {
+  for (size_t i = 0; i < script->count; i++) {
+    char *stmt_err = NULL;
+    int64_t rows = conn->driver->exec(conn, script->stmts[i], &stmt_err);
+    bool go = db_script_finish_stmt(script, i,
+                                    rows >= 0 ? DB_STMT_OK : DB_STMT_ERROR,
+                                    rows, stmt_err);
+    free(stmt_err);
+    if (!go)
+      break;
+  }
+}
+
+bool db_exec_script(DbConnection *conn, DbScript *script, char **err) {
+  if (!conn || !conn->driver || !conn->driver->exec || !script) {
+    err_set(err, "Not supported");
+    return false;
+  }
+
+  script->done = 0;
+  script->cancelled = false;
+  script->results = safe_calloc(script->count ? script->count : 1,
+                                sizeof(DbStmtResult));
+  for (size_t i = 0; i < script->count; i++)
+    script->results[i].rows = -1;
+  if (script->count == 0)
+    return true;
+
+  /* Inside the user's own transaction, leave it to them */
+  bool own_txn = script->transaction && !conn->in_transaction;
+  if (own_txn && !db_begin_transaction(conn, err))
+    return false;
+
+  bool ok;
+  if (conn->driver->exec_script) {
+    ok = conn->driver->exec_script(conn, script, err);
+  } else {
+    exec_script_sequential(conn, script);
+    ok = true;
+  }
+
+  size_t failed = script->count;
+  for (size_t i = 0; i < script->count && failed == script->count; i++) {
+    if (script->results[i].status == DB_STMT_ERROR)
+      failed = i;
+  }
+  bool all_ok = ok && !script->cancelled && failed == script->count &&
+                script->done == script->count;
+
+  if (own_txn) {
+    if (all_ok && !db_commit(conn, err)) {
+      all_ok = false;
+      ok = false; /* err already describes it */
+    }
+    if (!all_ok) {
+      db_rollback(conn, NULL);
+      db_script_mark_rolled_back(script, 0, script->count);
+    }
+  }
+
+  for (size_t i = 0; i < script->count; i++) {
+    if (script->results[i].status == DB_STMT_OK)
+      db_record_history(conn, script->stmts[i], DB_HISTORY_AUTO);
+  }
+
+  if (ok && !all_ok) {
+    if (failed < script->count)
+      err_setf(err, "Statement %zu: %s", failed + 1,
+               script->results[failed].error);
+    else
+      err_set(err, "Cancelled");
+  }
+  return all_ok;
+}
+
+DbCursor *db_cursor_open(DbConnection *conn, const char *sql, char **err) {
+  if (!conn || !conn->driver || !conn->driver->cursor_open || !sql) {
+    err_set(err, "Not supported");
+    return NULL;
+  }
+  size_t num_rows = 0;
+  void *handle = conn->driver->cursor_open(conn, sql, &num_rows, err);
+  if (!handle)
+    return NULL;
+  db_record_history(conn, sql, DB_HISTORY_AUTO);
+
+  DbCursor *cur = safe_calloc(1, sizeof(DbCursor));
+  cur->conn = conn;
+  cur->handle = handle;
+  cur->num_rows = num_rows;
+  return cur;
+}
+
+ResultSet *db_cursor_fetch(DbCursor *cur, size_t offset, size_t limit,
+                           char **err) {
+  if (!cur || !cur->conn || !cur->conn->driver ||
+      !cur->conn->driver->cursor_fetch) {
+    err_set(err, "Not supported");
+    return NULL;
+  }
+  return cur->conn->driver->cursor_fetch(cur->conn, cur->handle, offset, limit,
+                                         err);
+}
+
+void db_cursor_close(DbCursor *cur) {
+  if (!cur)
+    return;
+  if (cur->conn && cur->conn->driver && cur->conn->driver->cursor_close)
+    cur->conn->driver->cursor_close(cur->conn, cur->handle);
+  if (cur->owns_conn)
+    db_disconnect(cur->conn);
+  free(cur);
+}
+
+int64_t db_data_version(DbConnection *conn, char **err) {
+  if (!conn || !conn->driver || !conn->driver->data_version)
+    return -1;
+  return conn->driver->data_version(conn, err);
+}
+
+char **db_notifications(DbConnection *conn, size_t *count, char **err) {
+  if (count)
+    *count = 0;
+  if (!conn || !conn->driver || !conn->driver->notifications || !count)
+    return NULL;
+  return conn->driver->notifications(conn, count, err);
+}
+
 ResultSet *db_query_page(DbConnection *conn, const char *table, size_t offset,
                          size_t limit, const char *order_by, bool desc,
                          char **err) {
@@ -410,6 +591,13 @@ int64_t db_count_rows(DbConnection *conn, const char *table, char **err) {
 
 int64_t db_count_rows_where(DbConnection *conn, const char *table,
                             const char *where_clause, char **err) {
+  return db_count_rows_where_params(conn, table, where_clause, NULL, 0, err);
+}
+
+int64_t db_count_rows_where_params(DbConnection *conn, const char *table,
+                                   const char *where_clause,
+                                   const DbValue *params, size_t num_params,
+                                   char **err) {
   if (!conn || !conn->driver || !table) {
     err_set(err, "Invalid parameters");
     return -1;
@@ -435,7 +623,7 @@ int64_t db_count_rows_where(DbConnection *conn, const char *table,
     return -1;
   }
 
-  ResultSet *rs = db_query(conn, sql, err);
+  ResultSet *rs = db_query_params(conn, sql, params, num_params, err);
   free(sql);
 
   if (!rs)
@@ -446,6 +634,85 @@ int64_t db_count_rows_where(DbConnection *conn, const char *table,
   return count;
 }
 
+/* Index of the column named name, or -1 */
+static int result_column(const ResultSet *rs, const char *name) {
+  for (size_t i = 0; i < rs->num_columns; i++) {
+    if (rs->columns[i].name && str_eq_nocase(rs->columns[i].name, name))
+      return (int)i;
+  }
+  return -1;
+}
+
+/* Text of a plan cell (NULL for none). Caller must free. */
+static char *plan_cell(const ResultSet *rs, size_t row, int col) {
+  if (col < 0 || row >= rs->num_rows ||
+      (size_t)col >= rs->rows[row].num_cells)
+    return NULL;
+  return db_value_to_string(&rs->rows[row].cells[col]);
+}
+
+bool db_explain_full_scan(DbConnection *conn, const char *table,
+                          const char *where_clause, bool *full_scan,
+                          char **err) {
+  if (!conn || !conn->driver || !table || !full_scan) {
+    err_set(err, "Invalid parameters");
+    return false;
+  }
+  *full_scan = false;
+
+  char *escaped_table = escape_table_name(conn, table);
+  if (!escaped_table) {
+    err_set(err, "Out of memory");
+    return false;
+  }
+  bool sqlite = str_eq(conn->driver->name, "sqlite");
+  char *sql = str_printf("%s SELECT 1 FROM %s%s%s",
+                         sqlite ? "EXPLAIN QUERY PLAN" : "EXPLAIN",
+                         escaped_table, where_clause ? " WHERE " : "",
+                         where_clause ? where_clause : "");
+  free(escaped_table);
+  if (!sql) {
+    err_set(err, "Out of memory");
+    return false;
+  }
+  ResultSet *rs = db_query(conn, sql, err);
+  free(sql);
+  if (!rs)
+    return false;
+
+  if (sqlite) {
+    /* One row per step: "SCAN t" reads the table (or a whole index),
+     * "SEARCH t USING INDEX ..." looks rows up */
+    int detail = result_column(rs, "detail");
+    for (size_t r = 0; r < rs->num_rows; r++) {
+      char *step = plan_cell(rs, r, detail);
+      if (step && strncmp(step, "SCAN ", 5) == 0)
+        *full_scan = true;
+      free(step);
+    }
+  } else if (result_column(rs, "type") >= 0) {
+    /* MySQL: one row per table, access type ALL (or index) reads them all */
+    int type = result_column(rs, "type");
+    for (size_t r = 0; r < rs->num_rows; r++) {
+      char *access = plan_cell(rs, r, type);
+      if (access && (str_eq_nocase(access, "ALL") ||
+                     str_eq_nocase(access, "index")))
+        *full_scan = true;
+      free(access);
+    }
+  } else {
+    /* PostgreSQL: plan lines such as "Seq Scan on t  (cost=...)" */
+    for (size_t r = 0; r < rs->num_rows; r++) {
+      char *line = plan_cell(rs, r, 0);
+      if (line && strstr(line, "Seq Scan on "))
+        *full_scan = true;
+      free(line);
+    }
+  }
+  db_result_free(rs);
+  return true;
+}
+
 int64_t db_count_rows_fast(DbConnection *conn, const char *table,
                            bool allow_approximate, bool *is_approximate,
                            char **err) {
@@ -477,6 +744,16 @@ ResultSet *db_query_page_where(DbConnection *conn, const char *table,
                                size_t offset, size_t limit,
                                const char *where_clause, const char *order_by,
                                bool desc, char **err) {
+  return db_query_page_where_params(conn, table, offset, limit, where_clause,
+                                    NULL, 0, order_by, desc, err);
+}
+
+ResultSet *db_query_page_where_params(DbConnection *conn, const char *table,
+                                      size_t offset, size_t limit,
+                                      const char *where_clause,
+                                      const DbValue *params,
+                                      size_t num_params, const char *order_by,
+                                      bool desc, char **err) {
   if (!conn || !conn->driver) {
     err_set(err, "Not connected");
     return NULL;
@@ -536,7 +813,7 @@ ResultSet *db_query_page_where(DbConnection *conn, const char *table,
     return NULL;
   }
 
-  ResultSet *rs = db_query(conn, sql, err);
+  ResultSet *rs = db_query_params(conn, sql, params, num_params, err);
   free(sql);
   return rs;
 }
@@ -561,7 +838,7 @@ bool db_update_cell(DbConnection *conn, const char *table, const char **pk_cols,
       free(escaped_col);
       return success; /* Skip history on allocation failure */
     }
-    char *escaped_val = escape_sql_value(val_str);
+    char *escaped_val = escape_sql_value(val_str, backslash_escapes(conn));
     free(val_str);
 
     char *where_str = NULL;
@@ -569,7 +846,8 @@ bool db_update_cell(DbConnection *conn, const char *table, const char **pk_cols,
     for (size_t i = 0; i < num_pk_cols && alloc_ok; i++) {
       char *pk_val_str = db_value_to_string(&pk_vals[i]);
       char *escaped_pk_col = escape_identifier(conn, pk_cols[i]);
-      char *escaped_pk_val = escape_sql_value(pk_val_str);
+      char *escaped_pk_val =
+          escape_sql_value(pk_val_str, backslash_escapes(conn));
       free(pk_val_str);
 
       if (!escaped_pk_col || !escaped_pk_val) {
@@ -629,7 +907,7 @@ bool db_insert_row(DbConnection *conn, const char *table, const ColumnDef *cols,
     for (size_t i = 0; i < num_cols && alloc_ok; i++) {
       char *escaped_col = escape_identifier(conn, cols[i].name);
       char *val_str = db_value_to_string(&vals[i]);
-      char *escaped_val = escape_sql_value(val_str);
+      char *escaped_val = escape_sql_value(val_str, backslash_escapes(conn));
       free(val_str);
 
       if (!escaped_col || !escaped_val) {
@@ -691,7 +969,8 @@ bool db_delete_row(DbConnection *conn, const char *table, const char **pk_cols,
     for (size_t i = 0; i < num_pk_cols && alloc_ok; i++) {
       char *escaped_pk_col = escape_identifier(conn, pk_cols[i]);
       char *pk_val_str = db_value_to_string(&pk_vals[i]);
-      char *escaped_pk_val = escape_sql_value(pk_val_str);
+      char *escaped_pk_val =
+          escape_sql_value(pk_val_str, backslash_escapes(conn));
       free(pk_val_str);
 
       if (!escaped_pk_col || !escaped_pk_val) {
@@ -729,6 +1008,704 @@ bool db_delete_row(DbConnection *conn, const char *table, const char **pk_cols,
   return success;
 }
 
+/* SQL literal for a value: numbers unquoted, NULL bare, others quoted
+ * (backslashes doubled too with backslash set, see backslash_escapes) */
+static bool append_sql_literal(StringBuilder *sb, const DbValue *val,
+                               bool backslash) {
+  if (!val || val->is_null || val->type == DB_TYPE_NULL)
+    return sb_append(sb, "NULL");
+  if (val->type == DB_TYPE_INT)
+    return sb_printf(sb, "%lld", (long long)val->int_val);
+
+  char *str = db_value_to_string(val);
+  char *escaped = escape_sql_value(str, backslash);
+  free(str);
+  if (!escaped)
+    return false;
+  bool ok = sb_append(sb, escaped);
+  free(escaped);
+  return ok;
+}
+
+/* ============================================================================
+ * Bound parameters
+ * ============================================================================
+ */
+
+/* Skip a quoted run starting at p (on the opening quote); backslashes escape
+ * on MySQL. Returns the position after the closing quote. */
+static const char *skip_quoted(const char *p, char close, bool backslash) {
+  for (p++; *p; p++) {
+    if (backslash && *p == '\\' && p[1]) {
+      p++;
+    } else if (*p == close) {
+      if (p[1] != close || close == ']')
+        return p + 1;
+      p++; /* Doubled quote */
+    }
+  }
+  return p;
+}
+
+/* sql with each placeholder outside literals, quoted identifiers and
+ * comments replaced by its value as a literal */
+static char *inline_params(DbConnection *conn, const char *sql,
+                           const DbValue *params, size_t num_params) {
+  const char *driver = conn->driver->name;
+  bool dollar = db_driver_is_postgres(driver);
+  bool mysql = str_eq(driver, "mysql") || str_eq(driver, "mariadb");
+  bool brackets = str_eq(driver, "sqlite");
+
+  StringBuilder *sb = sb_new(strlen(sql) + num_params * 16);
+  if (!sb)
+    return NULL;
+  bool ok = true;
+  size_t next = 0; /* Next ? */
+  const char *p = sql;
+  while (*p && ok) {
+    const char *from = p;
+    size_t index = SIZE_MAX;
+    if (*p == '\'' || *p == '"' || (*p == '`' && mysql)) {
+      p = skip_quoted(p, *p, mysql);
+    } else if (*p == '[' && brackets) {
+      p = skip_quoted(p, ']', false);
+    } else if (p[0] == '-' && p[1] == '-') {
+      p += strcspn(p, "\n");
+    } else if (p[0] == '/' && p[1] == '*') {
+      const char *end = strstr(p + 2, "*/");
+      p = end ? end + 2 : p + strlen(p);
+    } else if (dollar && *p == '$' && isdigit((unsigned char)p[1])) {
+      char *end;
+      unsigned long n = strtoul(p + 1, &end, 10);
+      if (n >= 1 && n <= num_params)
+        index = n - 1;
+      p = end;
+    } else if (!dollar && *p == '?') {
+      index = next++;
+      p++;
+    } else {
+      p++;
+    }
+
+    if (index == SIZE_MAX || index >= num_params) {
+      ok = sb_append_len(sb, from, (size_t)(p - from));
+    } else if (params[index].type == DB_TYPE_FLOAT && !params[index].is_null &&
+               isfinite(params[index].float_val)) {
+      char *num = str_from_double(params[index].float_val);
+      ok = num && sb_append(sb, num);
+      free(num);
+    } else {
+      ok = append_sql_literal(sb, &params[index], mysql);
+    }
+  }
+  if (!ok) {
+    sb_free(sb);
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+ResultSet *db_query_params(DbConnection *conn, const char *sql,
+                           const DbValue *params, size_t num_params,
+                           char **err) {
+  if (!conn || !conn->driver || !sql) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+  if (num_params == 0)
+    return db_query(conn, sql, err);
+
+  char *inlined = inline_params(conn, sql, params, num_params);
+  if (!inlined) {
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  if (!conn->driver->query_params) {
+    ResultSet *rs = db_query(conn, inlined, err);
+    free(inlined);
+    return rs;
+  }
+
+  ResultSet *rs =
+      conn->driver->query_params(conn, sql, params, num_params, err);
+  if (rs)
+    db_record_history(conn, inlined, DB_HISTORY_AUTO);
+  free(inlined);
+  return rs;
+}
+
+/* Append "pk1 = v1 AND pk2 = v2" for one row */
+static bool append_pk_match(StringBuilder *sb, char **escaped_pks,
+                            size_t num_pk_cols, const DbValue *pk_vals,
+                            bool backslash) {
+  bool ok = true;
+  for (size_t k = 0; k < num_pk_cols && ok; k++) {
+    if (k > 0)
+      ok = sb_append(sb, " AND ");
+    ok = ok && sb_printf(sb, "%s = ", escaped_pks[k]);
+    ok = ok && append_sql_literal(sb, &pk_vals[k], backslash);
+  }
+  return ok;
+}
+
+/* Build one UPDATE ... CASE statement for rows [0, n) */
+static char *build_update_cells_sql(DbConnection *conn,
+                                    const char *escaped_table,
+                                    char **escaped_pks, size_t num_pk_cols,
+                                    const DbValue *pk_vals,
+                                    const char *escaped_col,
+                                    const DbValue *new_vals, size_t n) {
+  StringBuilder *sb = sb_new(64 + n * 32);
+  if (!sb)
+    return NULL;
+
+  bool bs = backslash_escapes(conn);
+
+  bool ok = sb_printf(sb, "UPDATE %s SET %s = CASE", escaped_table,
+                      escaped_col);
+  bool single = num_pk_cols == 1;
+  if (single)
+    ok = ok && sb_printf(sb, " %s", escaped_pks[0]);
+
+  for (size_t i = 0; i < n && ok; i++) {
+    const DbValue *row_pk = &pk_vals[i * num_pk_cols];
+    ok = sb_append(sb, " WHEN ");
+    ok = ok && (single ? append_sql_literal(sb, row_pk, bs)
+                       : append_pk_match(sb, escaped_pks, num_pk_cols, row_pk,
+                                         bs));
+    ok = ok && sb_append(sb, " THEN ");
+    ok = ok && append_sql_literal(sb, &new_vals[i], bs);
+  }
+  /* The WHERE below never reaches the ELSE, but it gives the CASE the
+   * column's own type: PostgreSQL would otherwise type a CASE over quoted
+   * literals as text and refuse to assign it to other columns */
+  ok = ok && sb_printf(sb, " ELSE %s END", escaped_col);
+
+  /* Restrict to the listed rows so the CASE never falls through to NULL */
+  if (single) {
+    ok = ok && sb_printf(sb, " WHERE %s IN (", escaped_pks[0]);
+    for (size_t i = 0; i < n && ok; i++) {
+      if (i > 0)
+        ok = sb_append(sb, ", ");
+      ok = ok && append_sql_literal(sb, &pk_vals[i], bs);
+    }
+    ok = ok && sb_append_char(sb, ')');
+  } else {
+    ok = ok && sb_append(sb, " WHERE ");
+    for (size_t i = 0; i < n && ok; i++) {
+      ok = sb_append(sb, i > 0 ? " OR (" : "(");
+      ok = ok && append_pk_match(sb, escaped_pks, num_pk_cols,
+                                 &pk_vals[i * num_pk_cols], bs);
+      ok = ok && sb_append_char(sb, ')');
+    }
+  }
+
+  if (!ok) {
+    sb_free(sb);
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+int64_t db_update_cells(DbConnection *conn, const char *table,
+                        const char **pk_cols, size_t num_pk_cols,
+                        const DbValue *pk_vals, const char *col,
+                        const DbValue *new_vals, size_t num_rows,
+                        char **err) {
+  if (!conn || !conn->driver || !table || !pk_cols || num_pk_cols == 0 ||
+      !pk_vals || !col || !new_vals) {
+    err_set(err, "Invalid parameters");
+    return -1;
+  }
+  for (size_t i = 0; i < num_rows; i++) {
+    if (new_vals[i].type == DB_TYPE_BLOB && !new_vals[i].is_null) {
+      err_set(err, "Binary values cannot be set in bulk");
+      return -1;
+    }
+  }
+
+  char *escaped_table = escape_table_name(conn, table);
+  char *escaped_col = escape_identifier(conn, col);
+  char **escaped_pks = safe_calloc(num_pk_cols, sizeof(char *));
+  bool ok = escaped_table && escaped_col;
+  for (size_t k = 0; k < num_pk_cols && ok; k++) {
+    escaped_pks[k] = escape_identifier(conn, pk_cols[k]);
+    ok = escaped_pks[k] != NULL;
+  }
+
+  int64_t affected = ok ? 0 : -1;
+  if (!ok)
+    err_set(err, "Out of memory");
+
+  for (size_t start = 0; start < num_rows && affected >= 0;
+       start += DB_UPDATE_BATCH_ROWS) {
+    size_t n = num_rows - start;
+    if (n > DB_UPDATE_BATCH_ROWS)
+      n = DB_UPDATE_BATCH_ROWS;
+
+    char *sql = build_update_cells_sql(
+        conn, escaped_table, escaped_pks, num_pk_cols,
+        &pk_vals[start * num_pk_cols], escaped_col, &new_vals[start], n);
+    if (!sql) {
+      err_set(err, "Out of memory");
+      affected = -1;
+      break;
+    }
+
+    int64_t rows = db_exec(conn, sql, err);
+    free(sql);
+    if (rows < 0) {
+      affected = -1;
+      break;
+    }
+    affected += rows;
+  }
+
+  for (size_t k = 0; k < num_pk_cols; k++)
+    free(escaped_pks[k]);
+  free(escaped_pks);
+  free(escaped_table);
+  free(escaped_col);
+  return affected;
+}
+
+char *db_build_delete_where(DbConnection *conn, const char *table,
+                            const char *where_clause, char **err) {
+  if (!conn || !conn->driver || !table) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  char *escaped_table = escape_table_name(conn, table);
+  if (!escaped_table) {
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+
+  char *sql;
+  if (where_clause && *where_clause) {
+    sql = str_printf("DELETE FROM %s WHERE %s", escaped_table, where_clause);
+  } else {
+    sql = str_printf("DELETE FROM %s", escaped_table);
+  }
+  free(escaped_table);
+
+  if (!sql)
+    err_set(err, "Out of memory");
+  return sql;
+}
+
+char *db_build_update_where(DbConnection *conn, const char *table,
+                            const char *col, const DbValue *new_val,
+                            const char *where_clause, char **err) {
+  if (!conn || !conn->driver || !table || !col || !new_val) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+  if (new_val->type == DB_TYPE_BLOB && !new_val->is_null) {
+    err_set(err, "Binary values cannot be set in bulk");
+    return NULL;
+  }
+
+  char *escaped_table = escape_table_name(conn, table);
+  char *escaped_col = escape_identifier(conn, col);
+  char *val_str = new_val->is_null ? NULL : db_value_to_string(new_val);
+  char *escaped_val = escape_sql_value(val_str, backslash_escapes(conn));
+  free(val_str);
+
+  char *sql = NULL;
+  if (escaped_table && escaped_col && escaped_val) {
+    if (where_clause && *where_clause) {
+      sql = str_printf("UPDATE %s SET %s = %s WHERE %s", escaped_table,
+                       escaped_col, escaped_val, where_clause);
+    } else {
+      sql = str_printf("UPDATE %s SET %s = %s", escaped_table, escaped_col,
+                       escaped_val);
+    }
+  }
+  free(escaped_table);
+  free(escaped_col);
+  free(escaped_val);
+
+  if (!sql)
+    err_set(err, "Out of memory");
+  return sql;
+}
+
+char *db_build_find_row_sql(DbConnection *conn, const char *table,
+                            const char **columns, size_t num_columns,
+                            const char *where_clause, const char *order_by,
+                            const char *needle, int64_t after, char **err) {
+  if (!conn || !conn->driver || !table || !columns || num_columns == 0 ||
+      !needle || !*needle) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  bool is_pg = str_eq(conn->driver->name, "postgres");
+  bool is_mysql = str_eq(conn->driver->name, "mysql") ||
+                  str_eq(conn->driver->name, "mariadb");
+  /* SQLite LIKE and the default MySQL collations already ignore case */
+  const char *like = is_pg ? "ILIKE" : "LIKE";
+  const char *text_type = is_mysql ? "CHAR" : "TEXT";
+
+  /* Pattern: %needle% with LIKE wildcards escaped by '!', which means the
+   * same in every dialect's ESCAPE clause, then quoted as a literal (with
+   * backslashes doubled on MySQL, whose strings read them as escapes) */
+  StringBuilder *pat = sb_new(strlen(needle) * 2 + 4);
+  bool ok = pat && sb_append_char(pat, '%');
+  for (const char *p = needle; *p && ok; p++) {
+    if (*p == '%' || *p == '_' || *p == '!')
+      ok = sb_append_char(pat, '!');
+    ok = ok && sb_append_char(pat, *p);
+  }
+  ok = ok && sb_append_char(pat, '%');
+  char *pattern = ok ? sb_to_string(pat) : NULL;
+  if (!ok)
+    sb_free(pat);
+  char *escaped_pattern = pattern ? escape_sql_value(pattern, is_mysql) : NULL;
+  free(pattern);
+  char *escaped_table = escape_table_name(conn, table);
+
+  StringBuilder *sb = sb_new(512);
+  ok = sb && escaped_pattern && escaped_table;
+  ok = ok && sb_printf(sb, "SELECT rn FROM (SELECT ROW_NUMBER() OVER (");
+  if (ok && order_by && *order_by)
+    ok = sb_printf(sb, "ORDER BY %s", order_by);
+  ok = ok && sb_append(sb, ") - 1 AS rn, CASE WHEN ");
+  for (size_t i = 0; i < num_columns && ok; i++) {
+    char *col = escape_identifier(conn, columns[i]);
+    ok = col && sb_printf(sb, "%sCAST(%s AS %s) %s %s ESCAPE '!'",
+                          i > 0 ? " OR " : "", col, text_type, like,
+                          escaped_pattern);
+    free(col);
+  }
+  ok = ok && sb_printf(sb, " THEN 1 ELSE 0 END AS hit FROM %s", escaped_table);
+  if (ok && where_clause && *where_clause)
+    ok = sb_printf(sb, " WHERE %s", where_clause);
+  ok = ok && sb_printf(sb,
+                       ") find_rows WHERE hit = 1 AND rn > %lld ORDER BY rn "
+                       "LIMIT 1",
+                       (long long)after);
+
+  free(escaped_pattern);
+  free(escaped_table);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+/* Literal for a key value. Floats keep full precision and booleans stay
+ * unquoted, so a seek compares equal to the sampled row. */
+static bool append_key_literal(StringBuilder *sb, const DbValue *val,
+                               bool backslash) {
+  if (val && !val->is_null && val->type == DB_TYPE_FLOAT)
+    return sb_printf(sb, "%.17g", val->float_val);
+  if (val && !val->is_null && val->type == DB_TYPE_BOOL)
+    return sb_append(sb, val->bool_val ? "TRUE" : "FALSE");
+  return append_sql_literal(sb, val, backslash);
+}
+
+char *db_build_key_where(DbConnection *conn, const char **cols,
+                         const bool *desc, const DbValue *vals,
+                         size_t num_cols, bool after, char **err) {
+  if (!conn || !conn->driver || !cols || !desc || !vals || num_cols == 0) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  bool bs = backslash_escapes(conn);
+  char **escaped = safe_calloc(num_cols, sizeof(char *));
+  bool ok = true;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    escaped[i] = escape_identifier(conn, cols[i]);
+    ok = escaped[i] != NULL;
+  }
+
+  /* Lexicographic comparison spelled out, since row value comparisons
+   * cannot mix directions: (a > x) OR (a = x AND b > y) OR ... with the
+   * last column inclusive for "at or after" */
+  StringBuilder *sb = sb_new(128);
+  ok = ok && sb;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    bool greater = after != desc[i];
+    const char *op = greater ? ">" : "<";
+    if (i == num_cols - 1 && after)
+      op = greater ? ">=" : "<=";
+
+    ok = sb_append(sb, i > 0 ? " OR (" : "(");
+    for (size_t k = 0; k < i && ok; k++) {
+      ok = sb_printf(sb, "%s = ", escaped[k]);
+      ok = ok && append_key_literal(sb, &vals[k], bs);
+      ok = ok && sb_append(sb, " AND ");
+    }
+    ok = ok && sb_printf(sb, "%s %s ", escaped[i], op);
+    ok = ok && append_key_literal(sb, &vals[i], bs);
+    ok = ok && sb_append_char(sb, ')');
+  }
+
+  for (size_t i = 0; i < num_cols; i++)
+    free(escaped[i]);
+  free(escaped);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+char *db_build_landmark_sql(DbConnection *conn, const char *table,
+                            const char **cols, size_t num_cols,
+                            const char *where_clause, const char *order_by,
+                            size_t stride, char **err) {
+  if (!conn || !conn->driver || !table || !cols || num_cols == 0 ||
+      stride == 0) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  StringBuilder *list = sb_new(128);
+  bool ok = list != NULL;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    char *col = escape_identifier(conn, cols[i]);
+    ok = col && sb_printf(list, "%s%s", i > 0 ? ", " : "", col);
+    free(col);
+  }
+  char *columns = ok ? sb_to_string(list) : NULL;
+  if (!ok)
+    sb_free(list);
+  char *escaped_table = escape_table_name(conn, table);
+
+  StringBuilder *sb = sb_new(512);
+  ok = sb && columns && escaped_table;
+  ok = ok && sb_printf(sb,
+                       "SELECT %s FROM (SELECT %s, ROW_NUMBER() OVER (",
+                       columns, columns);
+  if (ok && order_by && *order_by)
+    ok = sb_printf(sb, "ORDER BY %s", order_by);
+  ok = ok && sb_printf(sb, ") - 1 AS lm_rn FROM %s", escaped_table);
+  if (ok && where_clause && *where_clause)
+    ok = sb_printf(sb, " WHERE %s", where_clause);
+  ok = ok && sb_printf(sb, ") landmarks WHERE lm_rn %% %zu = 0 ORDER BY lm_rn",
+                       stride);
+
+  free(columns);
+  free(escaped_table);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+/* "a, b, c" with each column escaped, NULL when out of memory */
+static char *join_identifiers(DbConnection *conn, const char **cols,
+                              size_t num_cols) {
+  StringBuilder *sb = sb_new(128);
+  bool ok = sb != NULL;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    char *col = escape_identifier(conn, cols[i]);
+    ok = col && sb_printf(sb, "%s%s", i > 0 ? ", " : "", col);
+    free(col);
+  }
+  if (!ok) {
+    sb_free(sb);
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+/* Expression computing a row's version, NULL with *err set */
+static char *row_version_expr(DbConnection *conn, DbRowVersion kind,
+                              const char **columns, size_t num_columns,
+                              char **err) {
+  const char *driver = conn->driver->name;
+  bool is_pg = str_eq(driver, "postgres");
+  bool is_mysql = str_eq(driver, "mysql") || str_eq(driver, "mariadb");
+
+  if (kind == DB_ROW_VERSION_XMIN) {
+    if (is_pg)
+      return str_dup("xmin::text");
+    err_set(err, "Row versions need PostgreSQL");
+    return NULL;
+  }
+  if (!columns || num_columns == 0) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  char *list = kind == DB_ROW_VERSION_COLUMN
+                   ? escape_identifier(conn, columns[0])
+                   : join_identifiers(conn, columns, num_columns);
+  if (!list) {
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+
+  if (kind == DB_ROW_VERSION_COLUMN)
+    return list;
+
+  char *expr = NULL;
+  if (is_pg) {
+    expr = str_printf("md5(ROW(%s)::text)", list);
+  } else if (is_mysql) {
+    /* JSON_ARRAY keeps NULL apart from '' where CONCAT_WS would not */
+    expr = str_printf("MD5(JSON_ARRAY(%s))", list);
+  } else if (str_eq(driver, "sqlite")) {
+    /* Registered by the SQLite driver */
+    expr = str_printf("lace_row_hash(%s)", list);
+  } else {
+    err_set(err, "Row hashes are not supported by this database");
+  }
+  free(list);
+  return expr;
+}
+
+char *db_build_row_version_sql(DbConnection *conn, const char *table,
+                               const char **key_cols, size_t num_key_cols,
+                               DbRowVersion kind, const char **columns,
+                               size_t num_columns, const char *where_clause,
+                               const char *order_by, size_t offset,
+                               size_t limit, char **err) {
+  if (!conn || !conn->driver || !table || !key_cols || num_key_cols == 0) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  char *version = row_version_expr(conn, kind, columns, num_columns, err);
+  if (!version)
+    return NULL;
+  char *keys = join_identifiers(conn, key_cols, num_key_cols);
+  char *escaped_table = escape_table_name(conn, table);
+
+  StringBuilder *sb = sb_new(256);
+  bool ok = sb && keys && escaped_table;
+  ok = ok && sb_printf(sb, "SELECT %s, %s AS lace_version FROM %s", keys,
+                       version, escaped_table);
+  if (ok && where_clause && *where_clause)
+    ok = sb_printf(sb, " WHERE %s", where_clause);
+  if (ok && order_by && *order_by)
+    ok = sb_printf(sb, " ORDER BY %s", order_by);
+  ok = ok && sb_printf(sb, " LIMIT %zu OFFSET %zu", limit, offset);
+
+  free(version);
+  free(keys);
+  free(escaped_table);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+char *db_build_notify_trigger_sql(DbConnection *conn, const char *table,
+                                  const char *channel, char **err) {
+  if (!conn || !conn->driver || !table || !channel) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+  if (!str_eq(conn->driver->name, "postgres")) {
+    err_set(err, "Change notifications need PostgreSQL");
+    return NULL;
+  }
+
+  char *escaped_table = escape_table_name(conn, table);
+  DbValue name = db_value_text(channel);
+  StringBuilder *sb = sb_new(512);
+  bool ok = sb && escaped_table;
+
+  /* One statement-level trigger per table, all sharing a function that
+   * names the table the way the table list does (schema only outside
+   * public). The channel is the trigger's argument. */
+  ok = ok &&
+       sb_append(sb,
+                 "CREATE OR REPLACE FUNCTION lace_notify_change() "
+                 "RETURNS trigger LANGUAGE plpgsql AS $lace$\n"
+                 "BEGIN\n"
+                 "  PERFORM pg_notify(TG_ARGV[0], CASE WHEN TG_TABLE_SCHEMA = "
+                 "'public' THEN TG_TABLE_NAME ELSE TG_TABLE_SCHEMA || '.' || "
+                 "TG_TABLE_NAME END);\n"
+                 "  RETURN NULL;\n"
+                 "END\n"
+                 "$lace$;\n");
+  ok = ok && sb_printf(sb, "DROP TRIGGER IF EXISTS lace_notify_change ON %s;\n",
+                       escaped_table);
+  ok = ok && sb_printf(sb,
+                       "CREATE TRIGGER lace_notify_change AFTER INSERT OR "
+                       "UPDATE OR DELETE OR TRUNCATE ON %s FOR EACH STATEMENT "
+                       "EXECUTE PROCEDURE lace_notify_change(",
+                       escaped_table);
+  ok = ok && append_sql_literal(sb, &name, false);
+  ok = ok && sb_append(sb, ");\n");
+
+  db_value_free(&name);
+  free(escaped_table);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
+char *db_build_keys_where(DbConnection *conn, const char **cols,
+                          size_t num_cols, const DbValue *vals,
+                          size_t num_rows, char **err) {
+  if (!conn || !conn->driver || !cols || !vals || num_cols == 0 ||
+      num_rows == 0) {
+    err_set(err, "Invalid parameters");
+    return NULL;
+  }
+
+  bool bs = backslash_escapes(conn);
+  char **escaped = safe_calloc(num_cols, sizeof(char *));
+  bool ok = true;
+  for (size_t i = 0; i < num_cols && ok; i++) {
+    escaped[i] = escape_identifier(conn, cols[i]);
+    ok = escaped[i] != NULL;
+  }
+
+  StringBuilder *sb = sb_new(64 + num_rows * 16);
+  ok = ok && sb;
+  if (ok && num_cols == 1) {
+    /* Single column key: one IN list */
+    ok = sb_printf(sb, "%s IN (", escaped[0]);
+    for (size_t r = 0; r < num_rows && ok; r++) {
+      if (r > 0)
+        ok = sb_append(sb, ", ");
+      ok = ok && append_key_literal(sb, &vals[r], bs);
+    }
+    ok = ok && sb_append_char(sb, ')');
+  } else {
+    for (size_t r = 0; r < num_rows && ok; r++) {
+      ok = sb_append(sb, r > 0 ? " OR (" : "(");
+      for (size_t k = 0; k < num_cols && ok; k++) {
+        if (k > 0)
+          ok = sb_append(sb, " AND ");
+        ok = ok && sb_printf(sb, "%s = ", escaped[k]);
+        ok = ok && append_key_literal(sb, &vals[r * num_cols + k], bs);
+      }
+      ok = ok && sb_append_char(sb, ')');
+    }
+  }
+
+  for (size_t i = 0; i < num_cols; i++)
+    free(escaped[i]);
+  free(escaped);
+  if (!ok) {
+    sb_free(sb);
+    err_set(err, "Out of memory");
+    return NULL;
+  }
+  return sb_to_string(sb);
+}
+
 bool db_begin_transaction(DbConnection *conn, char **err) {
   if (!conn || !conn->driver) {
     err_set(err, "Not connected");
@@ -209,6 +209,15 @@ DbValue db_value_copy(const DbValue *src) {
   return v;
 }
 
+DbValue *db_values_copy(const DbValue *src, size_t n) {
+  if (!src || n == 0)
+    return NULL;
+  DbValue *copy = safe_calloc(n, sizeof(DbValue));
+  for (size_t i = 0; i < n; i++)
+    copy[i] = db_value_copy(&src[i]);
+  return copy;
+}
+
 /* Memory management */
 
 void db_value_free(DbValue *val) {
@@ -235,12 +244,30 @@ void db_value_free(DbValue *val) {
   val->is_null = true;
 }
 
+/* Drop one row's reference to page; the last one frees the cells */
+static void row_page_release(DbRowPage *page) {
+  if (--page->refs > 0)
+    return;
+  if (page->on_release)
+    page->on_release(page, page->ctx);
+  for (size_t i = 0; i < page->num_rows; i++)
+    FREE_ARRAY(page->rows[i].cells, page->rows[i].num_cells, db_value_free);
+  free(page->rows);
+  free(page);
+}
+
 void db_row_free(Row *row) {
   if (!row)
     return;
 
-  FREE_ARRAY(row->cells, row->num_cells, db_value_free);
+  /* A row moved elsewhere keeps its page pointer but no cells */
+  if (row->page && row->cells)
+    row_page_release(row->page);
+  else if (!row->page)
+    FREE_ARRAY(row->cells, row->num_cells, db_value_free);
+  row->cells = NULL;
   row->num_cells = 0;
+  row->page = NULL;
 }
 
 void db_column_free(ColumnDef *col) {
@@ -296,14 +323,270 @@ void db_result_free(ResultSet *rs) {
     return;
 
   FREE_ARRAY(rs->columns, rs->num_columns, db_column_free);
-  FREE_ARRAY(rs->rows, rs->num_rows, db_row_free);
+  db_result_clear_rows(rs);
 
   free(rs->error);
   free(rs);
 }
 
+/* Make room for front rows before and back rows after the current ones.
+ * When an end runs out, the rows are recentred in a buffer with at least as
+ * many free slots as rows, so the full copy happens at most once per
+ * num_rows/2 rows added - amortised O(page) per page. */
+static void rows_reserve(ResultSet *rs, size_t front, size_t back) {
+  if (!rs->rows_base) {
+    rs->rows_base = rs->rows;
+    rs->rows_cap = rs->rows ? rs->num_rows : 0;
+  }
+
+  size_t head = rs->rows ? (size_t)(rs->rows - rs->rows_base) : 0;
+  size_t tail = rs->rows_cap - head - rs->num_rows;
+  if (head >= front && tail >= back)
+    return;
+
+  size_t need = rs->num_rows + front + back;
+  size_t cap = need * 2;
+  if (cap < 64)
+    cap = 64;
+  size_t start;
+
+  if (rs->rows_cap >= cap && rs->rows_cap <= cap * 2) {
+    /* Big enough: recentre in place */
+    start = front + (rs->rows_cap - need) / 2;
+    if (rs->num_rows > 0)
+      memmove(rs->rows_base + start, rs->rows, rs->num_rows * sizeof(Row));
+    rs->rows = rs->rows_base + start;
+    return;
+  }
+
+  /* Grow, or shrink a buffer left oversized by an earlier, larger window */
+  Row *base = safe_reallocarray(NULL, cap, sizeof(Row));
+  start = front + (cap - need) / 2;
+  if (rs->num_rows > 0)
+    memcpy(base + start, rs->rows, rs->num_rows * sizeof(Row));
+  free(rs->rows_base);
+  rs->rows_base = base;
+  rs->rows_cap = cap;
+  rs->rows = base + start;
+}
+
+void db_result_append_rows(ResultSet *rs, ResultSet *src) {
+  if (!rs || !src || src->num_rows == 0 || !src->rows)
+    return;
+
+  rows_reserve(rs, 0, src->num_rows);
+  for (size_t i = 0; i < src->num_rows; i++) {
+    rs->rows[rs->num_rows + i] = src->rows[i];
+    /* Clear source so free doesn't deallocate the cells we moved */
+    src->rows[i].cells = NULL;
+    src->rows[i].num_cells = 0;
+  }
+  rs->num_rows += src->num_rows;
+}
+
+void db_result_prepend_rows(ResultSet *rs, ResultSet *src) {
+  if (!rs || !src || src->num_rows == 0 || !src->rows)
+    return;
+
+  rows_reserve(rs, src->num_rows, 0);
+  rs->rows -= src->num_rows;
+  for (size_t i = 0; i < src->num_rows; i++) {
+    rs->rows[i] = src->rows[i];
+    src->rows[i].cells = NULL;
+    src->rows[i].num_cells = 0;
+  }
+  rs->num_rows += src->num_rows;
+}
+
+void db_result_drop_front(ResultSet *rs, size_t count) {
+  if (!rs || !rs->rows)
+    return;
+  if (count > rs->num_rows)
+    count = rs->num_rows;
+
+  if (!rs->rows_base) {
+    rs->rows_base = rs->rows;
+    rs->rows_cap = rs->num_rows;
+  }
+  for (size_t i = 0; i < count; i++)
+    db_row_free(&rs->rows[i]);
+  rs->rows += count;
+  rs->num_rows -= count;
+}
+
+void db_result_drop_back(ResultSet *rs, size_t count) {
+  if (!rs || !rs->rows)
+    return;
+  if (count > rs->num_rows)
+    count = rs->num_rows;
+
+  for (size_t i = rs->num_rows - count; i < rs->num_rows; i++)
+    db_row_free(&rs->rows[i]);
+  rs->num_rows -= count;
+}
+
+void db_result_clear_rows(ResultSet *rs) {
+  if (!rs)
+    return;
+
+  if (rs->rows) {
+    for (size_t i = 0; i < rs->num_rows; i++)
+      db_row_free(&rs->rows[i]);
+  }
+  free(rs->rows_base ? rs->rows_base : rs->rows);
+  rs->rows = NULL;
+  rs->rows_base = NULL;
+  rs->rows_cap = 0;
+  rs->num_rows = 0;
+}
+
+size_t db_row_memory(const Row *row) {
+  if (!row || !row->cells)
+    return 0;
+
+  size_t bytes = row->num_cells * sizeof(DbValue);
+  for (size_t i = 0; i < row->num_cells; i++) {
+    const DbValue *val = &row->cells[i];
+    switch (val->type) {
+    case DB_TYPE_TEXT:
+    case DB_TYPE_DATE:
+    case DB_TYPE_TIMESTAMP:
+      if (val->text.data)
+        bytes += val->text.len + 1;
+      break;
+    case DB_TYPE_BLOB:
+      if (val->blob.data)
+        bytes += val->blob.len;
+      break;
+    default:
+      break;
+    }
+  }
+  return bytes;
+}
+
+size_t db_result_memory(const ResultSet *rs) {
+  if (!rs || !rs->rows)
+    return 0;
+
+  size_t bytes = rs->num_rows * sizeof(Row);
+  for (size_t i = 0; i < rs->num_rows; i++)
+    bytes += db_row_memory(&rs->rows[i]);
+  return bytes;
+}
+
 ResultSet *db_result_alloc_empty(void) { return safe_calloc(1, sizeof(ResultSet)); }
 
+/* Deep copy of n columns */
+static ColumnDef *columns_copy(const ColumnDef *columns, size_t n) {
+  ColumnDef *copy = safe_calloc(n, sizeof(ColumnDef));
+  for (size_t i = 0; i < n; i++) {
+    const ColumnDef *src = &columns[i];
+    ColumnDef *dst = &copy[i];
+    *dst = *src;
+    dst->name = src->name ? str_dup(src->name) : NULL;
+    dst->type_name = src->type_name ? str_dup(src->type_name) : NULL;
+    dst->default_val = src->default_val ? str_dup(src->default_val) : NULL;
+    dst->foreign_key = src->foreign_key ? str_dup(src->foreign_key) : NULL;
+  }
+  return copy;
+}
+
+DbRowPage *db_result_share(ResultSet *rs) {
+  if (!rs || !rs->rows || rs->num_rows == 0)
+    return NULL;
+
+  DbRowPage *page = safe_calloc(1, sizeof(DbRowPage));
+  page->rows = safe_calloc(rs->num_rows, sizeof(Row));
+  page->num_rows = rs->num_rows;
+  for (size_t i = 0; i < rs->num_rows; i++) {
+    Row *row = &rs->rows[i];
+    db_row_own(row); /* Never nest pages */
+    page->rows[i].cells = row->cells;
+    page->rows[i].num_cells = row->num_cells;
+    if (row->cells) {
+      row->page = page;
+      page->refs++;
+    }
+  }
+  if (page->refs == 0) {
+    free(page->rows);
+    free(page);
+    return NULL;
+  }
+  return page;
+}
+
+ResultSet *db_row_page_view(DbRowPage *page, const ResultSet *columns_from,
+                            size_t first, size_t count) {
+  if (!page || first >= page->num_rows)
+    return NULL;
+  if (count > page->num_rows - first)
+    count = page->num_rows - first;
+
+  ResultSet *view = db_result_alloc_empty();
+  if (columns_from && columns_from->num_columns > 0) {
+    view->columns =
+        columns_copy(columns_from->columns, columns_from->num_columns);
+    view->num_columns = columns_from->num_columns;
+  }
+  view->rows = safe_calloc(count + 1, sizeof(Row));
+  view->num_rows = count;
+  for (size_t i = 0; i < count; i++) {
+    view->rows[i] = page->rows[first + i];
+    if (view->rows[i].cells) {
+      view->rows[i].page = page;
+      page->refs++;
+    }
+  }
+  return view;
+}
+
+void db_row_own(Row *row) {
+  if (!row || !row->page)
+    return;
+  DbRowPage *page = row->page;
+  if (row->cells) {
+    DbValue *cells = safe_calloc(row->num_cells + 1, sizeof(DbValue));
+    for (size_t c = 0; c < row->num_cells; c++)
+      cells[c] = db_value_copy(&row->cells[c]);
+    row->cells = cells;
+    row_page_release(page);
+  }
+  row->page = NULL;
+}
+
+ResultSet *db_result_copy(const ResultSet *rs) {
+  if (!rs)
+    return NULL;
+
+  ResultSet *copy = db_result_alloc_empty();
+  copy->total_rows = rs->total_rows;
+  copy->rows_affected = rs->rows_affected;
+  copy->error = rs->error ? str_dup(rs->error) : NULL;
+
+  if (rs->num_columns > 0) {
+    copy->columns = columns_copy(rs->columns, rs->num_columns);
+    copy->num_columns = rs->num_columns;
+  }
+
+  if (rs->num_rows > 0) {
+    copy->rows = safe_calloc(rs->num_rows, sizeof(Row));
+    copy->num_rows = rs->num_rows;
+    for (size_t r = 0; r < rs->num_rows; r++) {
+      const Row *src = &rs->rows[r];
+      Row *dst = &copy->rows[r];
+      if (src->num_cells == 0)
+        continue;
+      dst->cells = safe_calloc(src->num_cells, sizeof(DbValue));
+      dst->num_cells = src->num_cells;
+      for (size_t c = 0; c < src->num_cells; c++)
+        dst->cells[c] = db_value_copy(&src->cells[c]);
+    }
+  }
+  return copy;
+}
+
 bool db_result_alloc_columns(ResultSet *rs, size_t num_cols, char **err) {
   (void)err; /* safe_calloc aborts on failure */
   if (!rs || num_cols == 0)
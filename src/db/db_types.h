@@ -58,18 +58,29 @@ typedef struct {
   int max_length;    /* For VARCHAR etc, -1 if unlimited */
 } ColumnDef;
 
-/* A single row of data */
+/* Rows whose cells several result sets share (see db_result_share) */
+typedef struct DbRowPage DbRowPage;
+
+/* A single row of data. With page set the cells belong to that shared page
+ * and are read-only: take a private copy with db_row_own before writing. */
 typedef struct {
   DbValue *cells;
   size_t num_cells;
+  DbRowPage *page;
 } Row;
 
-/* Result set from a query */
+/* Result set from a query.
+ * rows may point into a larger rows_base allocation that keeps free slots on
+ * both ends, so pages can be added or dropped at either end without moving
+ * the rest (see db_result_append_rows and friends). Drivers fill rows as a
+ * plain array and leave rows_base NULL. */
 typedef struct {
   ColumnDef *columns;
   size_t num_columns;
   Row *rows;
   size_t num_rows;
+  Row *rows_base;        /* Allocation holding rows, NULL if rows is one */
+  size_t rows_cap;       /* Slots in rows_base */
   size_t total_rows;     /* Total matching rows (for pagination) */
   int64_t rows_affected; /* For INSERT/UPDATE/DELETE */
   char *error;           /* Error message if any */
@@ -134,9 +145,46 @@ void db_value_free(DbValue *val);
 void db_row_free(Row *row);
 void db_result_free(ResultSet *rs);
 
+/* Windowed row storage - each call touches only the rows it adds or drops.
+ * append/prepend move all of src's rows into rs, leaving src's rows empty
+ * (cells NULL) but its num_rows unchanged. */
+void db_result_append_rows(ResultSet *rs, ResultSet *src);
+void db_result_prepend_rows(ResultSet *rs, ResultSet *src);
+void db_result_drop_front(ResultSet *rs, size_t count);
+void db_result_drop_back(ResultSet *rs, size_t count);
+void db_result_clear_rows(ResultSet *rs);
+
+/* Shared pages - copy-on-write rows. db_result_share moves rs's cells into
+ * a new page and leaves rs's rows referring to it; db_row_page_view hands
+ * out more references to rows [first, first + count) of the page. A page
+ * lives until the last row referring to it is freed, then calls on_release
+ * (if set) and frees the cells. Not thread-safe: share, view and free the
+ * rows of a page on one thread. */
+struct DbRowPage {
+  Row *rows;       /* The cells, owned */
+  size_t num_rows;
+  size_t refs;     /* Rows referring to the page */
+  void (*on_release)(DbRowPage *page, void *ctx);
+  void *ctx;
+};
+
+DbRowPage *db_result_share(ResultSet *rs);
+ResultSet *db_row_page_view(DbRowPage *page, const ResultSet *columns_from,
+                            size_t first, size_t count);
+
+/* Give row cells of its own if they are shared (before writing to them) */
+void db_row_own(Row *row);
+
+/* Heap bytes held by a row / by a result set's rows (cells and payloads) */
+size_t db_row_memory(const Row *row);
+size_t db_result_memory(const ResultSet *rs);
+
 /* Allocate an empty result set (for non-SELECT statements) */
 ResultSet *db_result_alloc_empty(void);
 
+/* Deep copy of columns and rows (a compact array, whatever rs's layout) */
+ResultSet *db_result_copy(const ResultSet *rs);
+
 /* Result set construction helpers - reduce driver boilerplate.
  * These return false and set error on failure.
  * On success, rs->columns/rows is allocated and rs->num_columns/num_rows is set.
@@ -159,6 +207,8 @@ DbValue db_value_blob(const uint8_t *data, size_t len);
 DbValue db_value_bool(bool val);
 DbValue db_value_oversized_placeholder(const char *type_label, size_t size);
 DbValue db_value_copy(const DbValue *src);
+/* Copy of n values (NULL for none); free each with db_value_free */
+DbValue *db_values_copy(const DbValue *src, size_t n);
 
 /* Value conversion */
 char *db_value_to_string(const DbValue *val);
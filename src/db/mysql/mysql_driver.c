@@ -6,6 +6,7 @@
  * https://github.com/stychos/lace
  */
 
+#include "../../platform/thread.h"
 #include "../../util/mem.h"
 #include "../../util/str.h"
 #include "../connstr.h"
@@ -129,6 +130,8 @@ static ResultSet *mysql_driver_query(DbConnection *conn, const char *sql,
                                      char **err);
 static int64_t mysql_driver_exec(DbConnection *conn, const char *sql,
                                  char **err);
+static bool mysql_driver_exec_script(DbConnection *conn, DbScript *script,
+                                     char **err);
 static ResultSet *mysql_driver_query_page(DbConnection *conn, const char *table,
                                           size_t offset, size_t limit,
                                           const char *order_by, bool desc,
@@ -155,6 +158,12 @@ static bool mysql_driver_cancel_query(DbConnection *conn, void *cancel_handle,
 static void mysql_driver_free_cancel_handle(void *cancel_handle);
 static int64_t mysql_driver_estimate_row_count(DbConnection *conn,
                                                const char *table, char **err);
+static void *mysql_driver_cursor_open(DbConnection *conn, const char *sql,
+                                      size_t *num_rows, char **err);
+static ResultSet *mysql_driver_cursor_fetch(DbConnection *conn, void *cursor,
+                                            size_t offset, size_t limit,
+                                            char **err);
+static void mysql_driver_cursor_close(DbConnection *conn, void *cursor);
 
 /* Driver definitions - both mysql and mariadb use the same implementation */
 DbDriver mysql_driver = {
@@ -170,6 +179,7 @@ DbDriver mysql_driver = {
     .get_table_schema = mysql_driver_get_table_schema,
     .query = mysql_driver_query,
     .exec = mysql_driver_exec,
+    .exec_script = mysql_driver_exec_script,
     .query_page = mysql_driver_query_page,
     .update_cell = mysql_driver_update_cell,
     .insert_row = mysql_driver_insert_row,
@@ -184,6 +194,9 @@ DbDriver mysql_driver = {
     .cancel_query = mysql_driver_cancel_query,
     .free_cancel_handle = mysql_driver_free_cancel_handle,
     .estimate_row_count = mysql_driver_estimate_row_count,
+    .cursor_open = mysql_driver_cursor_open,
+    .cursor_fetch = mysql_driver_cursor_fetch,
+    .cursor_close = mysql_driver_cursor_close,
     .library_cleanup = mysql_driver_library_cleanup,
 };
 
@@ -200,6 +213,7 @@ DbDriver mariadb_driver = {
     .get_table_schema = mysql_driver_get_table_schema,
     .query = mysql_driver_query,
     .exec = mysql_driver_exec,
+    .exec_script = mysql_driver_exec_script,
     .query_page = mysql_driver_query_page,
     .update_cell = mysql_driver_update_cell,
     .insert_row = mysql_driver_insert_row,
@@ -214,6 +228,9 @@ DbDriver mariadb_driver = {
     .cancel_query = mysql_driver_cancel_query,
     .free_cancel_handle = mysql_driver_free_cancel_handle,
     .estimate_row_count = mysql_driver_estimate_row_count,
+    .cursor_open = mysql_driver_cursor_open,
+    .cursor_fetch = mysql_driver_cursor_fetch,
+    .cursor_close = mysql_driver_cursor_close,
     .library_cleanup = mysql_driver_library_cleanup,
 };
 
@@ -389,8 +406,11 @@ static DbConnection *mysql_driver_connect(const char *connstr, char **err) {
   const char *password = cs->password;
   const char *database = cs->database ? cs->database : "mysql";
 
+  /* Affected rows count the rows an UPDATE matched, as on the other
+   * servers, not only those whose values changed */
   MYSQL *result =
-      mysql_real_connect(mysql, host, user, password, database, port, NULL, 0);
+      mysql_real_connect(mysql, host, user, password, database, port, NULL,
+                         CLIENT_FOUND_ROWS);
   if (!result) {
     err_setf(err, "Connection failed: %s", mysql_error(mysql));
     mysql_close(mysql);
@@ -465,6 +485,94 @@ static int64_t mysql_driver_exec(DbConnection *conn, const char *sql,
   return (int64_t)mysql_affected_rows(data->mysql);
 }
 
+/* Reads the results of one statement of a multi-statement batch; a CALL
+ * returns its procedure's result sets before its own status. Returns
+ * mysql_next_result's verdict on the following statement (0 = it ran,
+ * -1 = there is none, >0 = it failed). */
+static int mysql_script_read_statement(MYSQL *mysql, const char *sql,
+                                       int64_t *rows, bool *ok) {
+  bool is_call = strncasecmp(sql, "CALL", 4) == 0 &&
+                 !isalnum((unsigned char)sql[4]) && sql[4] != '_';
+  *rows = -1;
+  *ok = true;
+  for (int n = 0; n < MAX_RESULT_CONSUME_ITERATIONS; n++) {
+    MYSQL_RES *res = mysql_store_result(mysql);
+    bool status_only = !res && mysql_field_count(mysql) == 0;
+    if (res) {
+      *rows = (int64_t)mysql_num_rows(res);
+      mysql_free_result(res);
+    } else if (status_only) {
+      if (!is_call || *rows < 0)
+        *rows = (int64_t)mysql_affected_rows(mysql);
+    } else {
+      *ok = false; /* Result rows were lost */
+    }
+
+    int next = mysql_next_result(mysql);
+    if (!is_call || status_only || next != 0)
+      return next;
+  }
+  return -1;
+}
+
+/* Sends the script in batches of statements joined into one multi-statement
+ * query. The server stops a batch at its first failing statement; unless
+ * the script stops on errors, the next batch resumes after it. */
+static bool mysql_driver_exec_script(DbConnection *conn, DbScript *script,
+                                     char **err) {
+  DB_REQUIRE_PARAMS_CONN(script, conn, MySqlData, data, mysql, err, false);
+  MYSQL *mysql = data->mysql;
+
+  if (mysql_set_server_option(mysql, MYSQL_OPTION_MULTI_STATEMENTS_ON) != 0) {
+    err_set(err, mysql_error(mysql));
+    return false;
+  }
+
+  bool stop = false;
+  size_t i = 0;
+  while (!stop && i < script->count) {
+    size_t from = i;
+    StringBuilder *sb = sb_new(0);
+    while (i < script->count && i - from < DB_SCRIPT_BATCH_STATEMENTS &&
+           (i == from ||
+            sb->len + strlen(script->stmts[i]) < DB_SCRIPT_BATCH_BYTES)) {
+      if (i > from)
+        sb_append(sb, ";\n");
+      sb_append(sb, script->stmts[i]);
+      i++;
+    }
+    if (!sb_ok(sb)) {
+      sb_free(sb);
+      err_set(err, "Memory allocation failed");
+      break;
+    }
+
+    int next = mysql_real_query(mysql, sb->data, (unsigned long)sb->len);
+    sb_free(sb);
+
+    for (size_t k = from; k < i; k++) {
+      if (next != 0) {
+        /* k failed; the server dropped the rest of the batch */
+        if (!db_script_finish_stmt(script, k, DB_STMT_ERROR, -1,
+                                   mysql_error(mysql)))
+          stop = true;
+        i = k + 1;
+        break;
+      }
+      int64_t rows;
+      bool ok;
+      next = mysql_script_read_statement(mysql, script->stmts[k], &rows, &ok);
+      if (!db_script_finish_stmt(script, k, ok ? DB_STMT_OK : DB_STMT_ERROR,
+                                 rows, ok ? NULL : mysql_error(mysql)))
+        stop = true;
+    }
+    mysql_consume_pending_results(mysql);
+  }
+
+  mysql_set_server_option(mysql, MYSQL_OPTION_MULTI_STATEMENTS_OFF);
+  return true;
+}
+
 static bool mysql_driver_update_cell(DbConnection *conn, const char *table,
                                      const char **pk_cols,
                                      const DbValue *pk_vals, size_t num_pk_cols,
@@ -1024,17 +1132,26 @@ static ResultSet *mysql_driver_query(DbConnection *conn, const char *sql,
                                      char **err) {
   DB_REQUIRE_PARAMS_CONN(sql, conn, MySqlData, data, mysql, err, NULL);
 
+  /* mysql_store_result returns with every row received; the rest is
+   * decoding */
+  bool measure = conn->measure_queries;
+  DbQueryStats stats = {0};
+  uint64_t started = measure ? lace_time_us() : 0;
+
   if (mysql_query(data->mysql, sql) != 0) {
     err_set(err, mysql_error(data->mysql));
     return NULL;
   }
 
   MYSQL_RES *result = mysql_store_result(data->mysql);
+  uint64_t received = measure ? lace_time_us() : 0;
   if (!result) {
     /* Check if this was an INSERT/UPDATE/DELETE (no result expected) */
     if (mysql_field_count(data->mysql) == 0) {
       /* Return empty result set for non-SELECT */
       ResultSet *rs = db_result_alloc_empty();
+      if (measure)
+        conn->last_stats = (DbQueryStats){received - started, 0, 0};
       return rs;
     }
     err_set(err, mysql_error(data->mysql));
@@ -1113,12 +1230,19 @@ static ResultSet *mysql_driver_query(DbConnection *conn, const char *sql,
 
     for (unsigned int i = 0; i < num_fields; i++) {
       r->cells[i] = mysql_get_value(row, lengths, i, &fields[i]);
+      if (measure)
+        stats.bytes += lengths[i];
     }
 
     rs->num_rows++;
   }
 
   mysql_free_result(result);
+  if (measure) {
+    stats.server_us = received - started;
+    stats.decode_us = lace_time_us() - received;
+    conn->last_stats = stats;
+  }
   return rs;
 }
 
@@ -1278,3 +1402,81 @@ static int64_t mysql_driver_estimate_row_count(DbConnection *conn,
   mysql_free_result(result);
   return count;
 }
+
+/* Query result materialized into a temporary table. An AUTO_INCREMENT
+ * column numbers the rows in result order, so any page is a primary key
+ * range. */
+typedef struct {
+  char name[32];
+} MySqlCursor;
+
+static void *mysql_driver_cursor_open(DbConnection *conn, const char *sql,
+                                      size_t *num_rows, char **err) {
+  DB_REQUIRE(sql && num_rows, err, NULL);
+
+  MySqlCursor *cur = safe_calloc(1, sizeof(MySqlCursor));
+  snprintf(cur->name, sizeof(cur->name), "lace_cur_%lx",
+           (unsigned long)(uintptr_t)cur);
+
+  /* Declared columns come before the selected ones */
+  char *create = str_printf("CREATE TEMPORARY TABLE %s "
+                            "(lace_rn BIGINT UNSIGNED AUTO_INCREMENT "
+                            "PRIMARY KEY) %s",
+                            cur->name, sql);
+  int64_t count = create ? mysql_driver_exec(conn, create, err) : -1;
+  free(create);
+  if (count < 0) {
+    free(cur);
+    return NULL;
+  }
+
+  *num_rows = (size_t)count;
+  return cur;
+}
+
+static ResultSet *mysql_driver_cursor_fetch(DbConnection *conn, void *cursor,
+                                            size_t offset, size_t limit,
+                                            char **err) {
+  MySqlCursor *cur = (MySqlCursor *)cursor;
+  DB_REQUIRE(cur, err, NULL);
+
+  char *sql = str_printf(
+      "SELECT * FROM %s WHERE lace_rn > %zu ORDER BY lace_rn LIMIT %zu",
+      cur->name, offset, limit);
+  if (!sql) {
+    err_set(err, "Memory allocation failed");
+    return NULL;
+  }
+  ResultSet *rs = mysql_driver_query(conn, sql, err);
+  free(sql);
+  if (!rs || rs->num_columns == 0)
+    return rs;
+
+  /* Strip the row number column */
+  db_column_free(&rs->columns[0]);
+  memmove(rs->columns, rs->columns + 1,
+          (rs->num_columns - 1) * sizeof(ColumnDef));
+  for (size_t r = 0; r < rs->num_rows; r++) {
+    Row *row = &rs->rows[r];
+    if (row->num_cells == 0)
+      continue;
+    db_value_free(&row->cells[0]);
+    memmove(row->cells, row->cells + 1,
+            (row->num_cells - 1) * sizeof(DbValue));
+    row->num_cells--;
+  }
+  rs->num_columns--;
+  return rs;
+}
+
+static void mysql_driver_cursor_close(DbConnection *conn, void *cursor) {
+  MySqlCursor *cur = (MySqlCursor *)cursor;
+  if (!cur)
+    return;
+
+  char *sql = str_printf("DROP TEMPORARY TABLE IF EXISTS %s", cur->name);
+  if (sql)
+    mysql_driver_exec(conn, sql, NULL);
+  free(sql);
+  free(cur);
+}
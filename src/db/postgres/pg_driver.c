@@ -6,15 +6,18 @@
  * https://github.com/stychos/lace
  */
 
+#include "../../platform/thread.h"
 #include "../../util/mem.h"
 #include "../../util/str.h"
 #include "../connstr.h"
 #include "../db.h"
 #include "../db_common.h"
+#include "../sql_lexer.h"
 #include <ctype.h>
 #include <errno.h>
 #include <libpq-fe.h>
 #include <limits.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
@@ -59,10 +62,21 @@ static bool pg_parse_table_name(const char *full_name, char **schema_out,
   return true;
 }
 
+/* Statements query_params keeps prepared, per connection */
+#define PG_STMT_CACHE_SIZE 16
+
+/* A server-side prepared statement, named lace_stmt_<slot> */
+typedef struct {
+  char *sql; /* NULL for a free slot */
+  uint64_t last_used;
+} PgCachedStmt;
+
 /* PostgreSQL connection data */
 typedef struct {
   PGconn *conn;
   char *database;
+  PgCachedStmt stmts[PG_STMT_CACHE_SIZE];
+  uint64_t stmt_clock;
 } PgData;
 
 /* Forward declarations */
@@ -76,6 +90,9 @@ static TableSchema *pg_get_table_schema(DbConnection *conn, const char *table,
                                         char **err);
 static ResultSet *pg_query(DbConnection *conn, const char *sql, char **err);
 static int64_t pg_exec(DbConnection *conn, const char *sql, char **err);
+#ifdef LIBPQ_HAS_PIPELINING
+static bool pg_exec_script(DbConnection *conn, DbScript *script, char **err);
+#endif
 static ResultSet *pg_query_page(DbConnection *conn, const char *table,
                                 size_t offset, size_t limit,
                                 const char *order_by, bool desc, char **err);
@@ -98,6 +115,16 @@ static bool pg_cancel_query(DbConnection *conn, void *cancel_handle,
 static void pg_free_cancel_handle(void *cancel_handle);
 static int64_t pg_estimate_row_count(DbConnection *conn, const char *table,
                                      char **err);
+static void *pg_cursor_open(DbConnection *conn, const char *sql,
+                            size_t *num_rows, char **err);
+static ResultSet *pg_cursor_fetch(DbConnection *conn, void *cursor,
+                                  size_t offset, size_t limit, char **err);
+static void pg_cursor_close(DbConnection *conn, void *cursor);
+static int64_t pg_data_version(DbConnection *conn, char **err);
+static char **pg_notifications(DbConnection *conn, size_t *count, char **err);
+static ResultSet *pg_query_params(DbConnection *conn, const char *sql,
+                                  const DbValue *params, size_t num_params,
+                                  char **err);
 
 /* Driver definition */
 DbDriver postgres_driver = {
@@ -113,6 +140,9 @@ DbDriver postgres_driver = {
     .get_table_schema = pg_get_table_schema,
     .query = pg_query,
     .exec = pg_exec,
+#ifdef LIBPQ_HAS_PIPELINING
+    .exec_script = pg_exec_script,
+#endif
     .query_page = pg_query_page,
     .update_cell = pg_update_cell,
     .insert_row = pg_insert_row,
@@ -127,6 +157,12 @@ DbDriver postgres_driver = {
     .cancel_query = pg_cancel_query,
     .free_cancel_handle = pg_free_cancel_handle,
     .estimate_row_count = pg_estimate_row_count,
+    .cursor_open = pg_cursor_open,
+    .cursor_fetch = pg_cursor_fetch,
+    .cursor_close = pg_cursor_close,
+    .data_version = pg_data_version,
+    .query_params = pg_query_params,
+    .notifications = pg_notifications,
     .library_cleanup = NULL,
 };
 
@@ -153,7 +189,7 @@ static PgParamValue pg_value_to_param(const DbValue *val) {
     p.length = p.allocated ? safe_size_to_int(strlen(p.allocated)) : 0;
     break;
   case DB_TYPE_FLOAT:
-    p.allocated = str_printf("%g", val->float_val);
+    p.allocated = str_from_double(val->float_val);
     p.value = p.allocated;
     p.length = p.allocated ? safe_size_to_int(strlen(p.allocated)) : 0;
     break;
@@ -431,6 +467,8 @@ static void pg_disconnect(DbConnection *conn) {
     if (data->conn) {
       PQfinish(data->conn);
     }
+    for (size_t i = 0; i < PG_STMT_CACHE_SIZE; i++)
+      free(data->stmts[i].sql);
     free(data->database);
     free(data);
   }
@@ -464,18 +502,53 @@ static const char *pg_get_error(DbConnection *conn) {
   return conn ? conn->last_error : NULL;
 }
 
-static int64_t pg_exec(DbConnection *conn, const char *sql, char **err) {
-  DB_REQUIRE_PARAMS_CONN(sql, conn, PgData, data, conn, err, -1);
+/* Forget the cached statement in slot, deallocating it unless the server
+ * already dropped it */
+static void pg_stmt_forget(PgData *data, int slot, bool deallocate) {
+  PgCachedStmt *c = &data->stmts[slot];
+  if (c->sql && deallocate) {
+    char sql[48];
+    snprintf(sql, sizeof(sql), "DEALLOCATE lace_stmt_%d", slot);
+    PQclear(PQexec(data->conn, sql));
+  }
+  FREE_NULL(c->sql);
+}
 
-  PGresult *res = PQexec(data->conn, sql);
-  ExecStatusType status = PQresultStatus(res);
+/* Forget every cached statement, in one round trip */
+static void pg_stmt_cache_clear(PgData *data, bool deallocate) {
+  char sql[PG_STMT_CACHE_SIZE * 32];
+  size_t len = 0;
+  for (int i = 0; i < PG_STMT_CACHE_SIZE; i++) {
+    if (data->stmts[i].sql && deallocate)
+      len += (size_t)snprintf(sql + len, sizeof(sql) - len,
+                              "DEALLOCATE lace_stmt_%d;", i);
+    FREE_NULL(data->stmts[i].sql);
+  }
+  if (len > 0)
+    PQclear(PQexec(data->conn, sql));
+}
 
-  if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
-    err_set(err, PQerrorMessage(data->conn));
-    PQclear(res);
-    return -1;
-  }
+/* Whether a command with this status tag dropped the cached statements
+ * (DISCARD, DEALLOCATE ALL) or may have changed what they return (DDL) */
+static bool pg_cmd_stales_stmts(PGresult *res, bool *dropped) {
+  const char *tag = res ? PQcmdStatus(res) : NULL;
+  if (!tag)
+    return false;
+  *dropped = strncmp(tag, "DISCARD", 7) == 0 ||
+             strcmp(tag, "DEALLOCATE ALL") == 0;
+  return *dropped || strncmp(tag, "CREATE ", 7) == 0 ||
+         strncmp(tag, "ALTER ", 6) == 0 || strncmp(tag, "DROP ", 5) == 0;
+}
 
+/* Drop the statement cache after a command that stales it */
+static void pg_stmt_cache_check(PgData *data, PGresult *res) {
+  bool dropped = false;
+  if (pg_cmd_stales_stmts(res, &dropped))
+    pg_stmt_cache_clear(data, !dropped);
+}
+
+/* Row count from a command's status tag (0 if it has none) */
+static int64_t pg_affected_rows(PGresult *res) {
   char *affected = PQcmdTuples(res);
   int64_t count = 0;
   if (affected && *affected) {
@@ -486,10 +559,145 @@ static int64_t pg_exec(DbConnection *conn, const char *sql, char **err) {
       count = parsed;
     }
   }
+  return count;
+}
+
+static int64_t pg_exec(DbConnection *conn, const char *sql, char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql, conn, PgData, data, conn, err, -1);
+
+  PGresult *res = PQexec(data->conn, sql);
+  ExecStatusType status = PQresultStatus(res);
+
+  if (status != PGRES_COMMAND_OK && status != PGRES_TUPLES_OK) {
+    err_set(err, PQerrorMessage(data->conn));
+    PQclear(res);
+    return -1;
+  }
+
+  pg_stmt_cache_check(data, res);
+  int64_t count = pg_affected_rows(res);
   PQclear(res);
   return count;
 }
 
+#ifdef LIBPQ_HAS_PIPELINING
+/* Statement that gets a pipeline sync of its own: it can't run inside the
+ * implicit transaction of a multi-statement sync, or it opens or closes a
+ * transaction itself */
+static bool pg_script_runs_alone(const char *sql) {
+  return sql_needs_autocommit(sql) || sql_is_transaction_control(sql);
+}
+
+/* Sends the script in batches through pipeline mode, reading a batch's
+ * results only after all of it is sent. When stopping on errors, a batch
+ * ends with one sync: the server skips the rest of the batch after a
+ * failure and, outside a transaction block, also undoes the batch's
+ * earlier statements. Otherwise each statement is synced (and committed)
+ * on its own. */
+static bool pg_exec_script(DbConnection *conn, DbScript *script, char **err) {
+  DB_REQUIRE_PARAMS_CONN(script, conn, PgData, data, conn, err, false);
+  PGconn *pg = data->conn;
+  bool stop_on_error = script->stop_on_error || script->transaction;
+
+  if (!PQenterPipelineMode(pg)) {
+    err_set(err, PQerrorMessage(pg));
+    return false;
+  }
+
+  bool ok = true, stop = false;
+  bool stale = false, dropped = false; /* Statement cache, see below */
+  size_t i = 0;
+  while (ok && !stop && i < script->count) {
+    bool implicit_txn = PQtransactionStatus(pg) == PQTRANS_IDLE;
+
+    /* Send */
+    size_t from = i, bytes = 0;
+    while (i < script->count && i - from < DB_SCRIPT_BATCH_STATEMENTS &&
+           bytes < DB_SCRIPT_BATCH_BYTES) {
+      const char *sql = script->stmts[i];
+      bool alone = pg_script_runs_alone(sql);
+      if (alone && i > from)
+        break;
+      if (!PQsendQueryParams(pg, sql, 0, NULL, NULL, NULL, NULL, 0) ||
+          (!stop_on_error && !PQpipelineSync(pg))) {
+        ok = false;
+        break;
+      }
+      bytes += strlen(sql);
+      i++;
+      if (alone)
+        break;
+    }
+    if (ok && stop_on_error && !PQpipelineSync(pg))
+      ok = false;
+    if (!ok) {
+      err_set(err, PQerrorMessage(pg));
+      break;
+    }
+
+    /* Receive: each statement's results end with NULL */
+    size_t failed = SIZE_MAX;
+    for (size_t k = from; k < i; k++) {
+      PGresult *res = PQgetResult(pg);
+      if (!res) {
+        err_set(err, PQerrorMessage(pg));
+        ok = false;
+        break;
+      }
+
+      DbStmtStatus status = DB_STMT_OK;
+      int64_t rows = -1;
+      const char *msg = NULL;
+      switch (PQresultStatus(res)) {
+      case PGRES_TUPLES_OK:
+        rows = PQntuples(res);
+        break;
+      case PGRES_COMMAND_OK:
+        rows = pg_affected_rows(res);
+        if (pg_cmd_stales_stmts(res, &dropped))
+          stale = true;
+        break;
+      case PGRES_PIPELINE_ABORTED:
+        status = DB_STMT_SKIPPED;
+        break;
+      default:
+        status = DB_STMT_ERROR;
+        msg = PQresultErrorMessage(res);
+        if (failed == SIZE_MAX)
+          failed = k;
+        break;
+      }
+      /* Drained regardless, the batch is already on the server */
+      if (!db_script_finish_stmt(script, k, status, rows, msg))
+        stop = true;
+      PQclear(res);
+      while ((res = PQgetResult(pg)) != NULL)
+        PQclear(res);
+
+      if (!stop_on_error)
+        PQclear(PQgetResult(pg)); /* PGRES_PIPELINE_SYNC */
+    }
+    if (!ok)
+      break;
+    if (stop_on_error)
+      PQclear(PQgetResult(pg)); /* PGRES_PIPELINE_SYNC */
+
+    if (failed != SIZE_MAX && stop_on_error && implicit_txn)
+      db_script_mark_rolled_back(script, from, failed);
+  }
+
+  if (!PQexitPipelineMode(pg) && ok) {
+    err_set(err, PQerrorMessage(pg));
+    ok = false;
+  }
+  /* Only now: nothing else can be sent while the pipeline is open.
+   * Deallocating what DISCARD already dropped just fails harmlessly. */
+  if (stale)
+    pg_stmt_cache_clear(data, !dropped);
+  return ok;
+}
+#endif
+
 static bool pg_update_cell(DbConnection *conn, const char *table,
                            const char **pk_cols, const DbValue *pk_vals,
                            size_t num_pk_cols, const char *col,
@@ -812,6 +1020,10 @@ static TableSchema *pg_get_table_schema(DbConnection *conn, const char *table,
     return NULL;
   }
 
+  /* The schema is (re)read because the table may have changed: start the
+   * statements over it from fresh plans */
+  pg_stmt_cache_clear(data, true);
+
   /* Query column information */
   const char *sql =
       "SELECT column_name, data_type, is_nullable, column_default "
@@ -1035,10 +1247,13 @@ static TableSchema *pg_get_table_schema(DbConnection *conn, const char *table,
   return schema;
 }
 
-static ResultSet *pg_query(DbConnection *conn, const char *sql, char **err) {
-  DB_REQUIRE_PARAMS_CONN(sql, conn, PgData, data, conn, err, NULL);
-
-  PGresult *res = PQexec(data->conn, sql);
+/* Convert a query result and clear it. started and received time the
+ * query (for conn->measure_queries). */
+static ResultSet *pg_read_result(DbConnection *conn, PgData *data,
+                                 PGresult *res, uint64_t started,
+                                 uint64_t received, char **err) {
+  bool measure = conn->measure_queries;
+  DbQueryStats stats = {0};
   ExecStatusType status = PQresultStatus(res);
 
   if (status != PGRES_TUPLES_OK && status != PGRES_COMMAND_OK) {
@@ -1057,6 +1272,8 @@ static ResultSet *pg_query(DbConnection *conn, const char *sql, char **err) {
   if (status == PGRES_COMMAND_OK) {
     /* Non-SELECT statement */
     PQclear(res);
+    if (measure)
+      conn->last_stats = (DbQueryStats){received - started, 0, 0};
     return rs;
   }
 
@@ -1102,15 +1319,129 @@ static ResultSet *pg_query(DbConnection *conn, const char *sql, char **err) {
 
     for (int c = 0; c < num_fields; c++) {
       row->cells[c] = pg_get_value(res, r, c, PQftype(res, c));
+      if (measure)
+        stats.bytes += (size_t)PQgetlength(res, r, c);
     }
 
     rs->num_rows++;
   }
 
   PQclear(res);
+  if (measure) {
+    stats.server_us = received - started;
+    stats.decode_us = lace_time_us() - received;
+    conn->last_stats = stats;
+  }
   return rs;
 }
 
+static ResultSet *pg_query(DbConnection *conn, const char *sql, char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql, conn, PgData, data, conn, err, NULL);
+
+  /* PQexec returns with the whole result received; the rest is decoding */
+  bool measure = conn->measure_queries;
+  uint64_t started = measure ? lace_time_us() : 0;
+  PGresult *res = PQexec(data->conn, sql);
+  uint64_t received = measure ? lace_time_us() : 0;
+  pg_stmt_cache_check(data, res);
+  return pg_read_result(conn, data, res, started, received, err);
+}
+
+/* Whether res failed because the prepared statement is gone (26000:
+ * dropped by DISCARD ALL or a reconnect behind our back) or its result
+ * type changed under it (0A000, "cached plan must not change result
+ * type", after DDL elsewhere). Either way it is re-prepared, *gone telling
+ * whether there is anything left to deallocate first. */
+static bool pg_stmt_stale(PGresult *res, bool *gone) {
+  const char *state = res ? PQresultErrorField(res, PG_DIAG_SQLSTATE) : NULL;
+  if (!state)
+    return false;
+  *gone = strcmp(state, "26000") == 0;
+  return *gone || strcmp(state, "0A000") == 0;
+}
+
+/* Prepare sql into the slot it is cached in, or the least recently used
+ * one (deallocating what was there). Returns the slot, or -1. */
+static int pg_stmt_prepare(PgData *data, const char *sql, size_t num_params,
+                           char **err) {
+  int slot = -1;
+  for (int i = 0; i < PG_STMT_CACHE_SIZE; i++) {
+    PgCachedStmt *c = &data->stmts[i];
+    if (c->sql && strcmp(c->sql, sql) == 0) {
+      slot = i;
+      break;
+    }
+    if (slot < 0 || !c->sql ||
+        (data->stmts[slot].sql && c->last_used < data->stmts[slot].last_used))
+      slot = i;
+  }
+  PgCachedStmt *c = &data->stmts[slot];
+  c->last_used = ++data->stmt_clock;
+  if (c->sql && strcmp(c->sql, sql) == 0)
+    return slot;
+  pg_stmt_forget(data, slot, true);
+
+  char name[32];
+  snprintf(name, sizeof(name), "lace_stmt_%d", slot);
+  PGresult *res = PQprepare(data->conn, name, sql,
+                            safe_size_to_int(num_params), NULL);
+  if (PQresultStatus(res) != PGRES_COMMAND_OK) {
+    err_set(err, PQerrorMessage(data->conn));
+    PQclear(res);
+    return -1;
+  }
+  PQclear(res);
+  c->sql = str_dup(sql);
+  return c->sql ? slot : -1;
+}
+
+static ResultSet *pg_query_params(DbConnection *conn, const char *sql,
+                                  const DbValue *params, size_t num_params,
+                                  char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql, conn, PgData, data, conn, err, NULL);
+
+  bool measure = conn->measure_queries;
+  uint64_t started = measure ? lace_time_us() : 0;
+
+  const char **values = safe_calloc(num_params, sizeof(char *));
+  int *lengths = safe_calloc(num_params, sizeof(int));
+  char **bufs = safe_calloc(num_params, sizeof(char *));
+  for (size_t i = 0; i < num_params; i++) {
+    PgParamValue p = pg_value_to_param(&params[i]);
+    values[i] = p.value;
+    lengths[i] = p.length;
+    bufs[i] = p.allocated;
+  }
+
+  PGresult *res = NULL;
+  for (int attempt = 0; attempt < 2; attempt++) {
+    PQclear(res);
+    res = NULL;
+    int slot = pg_stmt_prepare(data, sql, num_params, err);
+    if (slot < 0)
+      break;
+    char name[32];
+    snprintf(name, sizeof(name), "lace_stmt_%d", slot);
+    res = PQexecPrepared(data->conn, name, safe_size_to_int(num_params),
+                         values, lengths, NULL, 0);
+    bool gone = false;
+    if (!pg_stmt_stale(res, &gone))
+      break;
+    pg_stmt_forget(data, slot, !gone);
+  }
+
+  for (size_t i = 0; i < num_params; i++)
+    free(bufs[i]);
+  free(bufs);
+  free(lengths);
+  free(values);
+  if (!res)
+    return NULL;
+
+  uint64_t received = measure ? lace_time_us() : 0;
+  return pg_read_result(conn, data, res, started, received, err);
+}
+
 static ResultSet *pg_query_page(DbConnection *conn, const char *table,
                                 size_t offset, size_t limit,
                                 const char *order_by, bool desc, char **err) {
@@ -1138,6 +1469,71 @@ static ResultSet *pg_query_page(DbConnection *conn, const char *table,
   return rs;
 }
 
+/* Scrollable cursor over a query result. WITH HOLD keeps the result
+ * (materialized on the server) past the implicit transaction of DECLARE. */
+typedef struct {
+  char name[32];
+} PgCursor;
+
+static void *pg_cursor_open(DbConnection *conn, const char *sql,
+                            size_t *num_rows, char **err) {
+  DB_REQUIRE(sql && num_rows, err, NULL);
+
+  PgCursor *cur = safe_calloc(1, sizeof(PgCursor));
+  snprintf(cur->name, sizeof(cur->name), "lace_cur_%lx",
+           (unsigned long)(uintptr_t)cur);
+
+  char *declare = str_printf("DECLARE %s SCROLL CURSOR WITH HOLD FOR %s",
+                             cur->name, sql);
+  int64_t declared = declare ? pg_exec(conn, declare, err) : -1;
+  free(declare);
+  if (declared < 0) {
+    free(cur);
+    return NULL;
+  }
+
+  /* MOVE reports how many rows it skipped over - the result size */
+  char *move = str_printf("MOVE ALL IN %s", cur->name);
+  int64_t count = move ? pg_exec(conn, move, err) : -1;
+  free(move);
+  if (count < 0) {
+    pg_cursor_close(conn, cur);
+    return NULL;
+  }
+
+  *num_rows = (size_t)count;
+  return cur;
+}
+
+static ResultSet *pg_cursor_fetch(DbConnection *conn, void *cursor,
+                                  size_t offset, size_t limit, char **err) {
+  PgCursor *cur = (PgCursor *)cursor;
+  DB_REQUIRE(cur, err, NULL);
+
+  /* MOVE ABSOLUTE n stops on row n, so the FETCH starts at row n + 1 */
+  char *sql = str_printf("MOVE ABSOLUTE %zu IN %s; FETCH FORWARD %zu FROM %s",
+                         offset, cur->name, limit, cur->name);
+  if (!sql) {
+    err_set(err, "Memory allocation failed");
+    return NULL;
+  }
+  ResultSet *rs = pg_query(conn, sql, err);
+  free(sql);
+  return rs;
+}
+
+static void pg_cursor_close(DbConnection *conn, void *cursor) {
+  PgCursor *cur = (PgCursor *)cursor;
+  if (!cur)
+    return;
+
+  char *sql = str_printf("CLOSE %s", cur->name);
+  if (sql)
+    pg_exec(conn, sql, NULL); /* Gone anyway if the session ended */
+  free(sql);
+  free(cur);
+}
+
 static void pg_free_result(ResultSet *rs) { db_result_free(rs); }
 
 static void pg_free_schema(TableSchema *schema) { db_schema_free(schema); }
@@ -1226,3 +1622,65 @@ static int64_t pg_estimate_row_count(DbConnection *conn, const char *table,
   PQclear(res);
   return count;
 }
+
+/* Best-effort probe: the write counters and live/dead row counts of user
+ * tables, as the statistics system keeps them, plus the transaction ids
+ * that last wrote each pg_class and pg_attribute row, which move with any
+ * DDL. It is not exact:
+ * - other sessions flush their statistics only every second or so after
+ *   they commit, and not at all with track_counts off, so their writes
+ *   can go unseen for that long; inside a transaction block the counters
+ *   read may also be a snapshot (stats_fetch_consistency);
+ * - a sum can come back to an earlier value by coincidence. */
+static int64_t pg_data_version(DbConnection *conn, char **err) {
+  DB_REQUIRE_CONN(conn, PgData, data, conn, err, -1);
+
+  PGresult *res = PQexec(
+      data->conn,
+      "SELECT (SELECT count(*) + coalesce(sum(n_tup_ins + n_tup_upd + "
+      "n_tup_del + n_live_tup + n_dead_tup), 0) FROM pg_stat_user_tables) + "
+      "(SELECT coalesce(sum(xmin::text::bigint), 0) FROM pg_class) + "
+      "(SELECT coalesce(sum(xmin::text::bigint), 0) FROM pg_attribute)");
+  if (PQresultStatus(res) != PGRES_TUPLES_OK) {
+    err_set(err, PQerrorMessage(data->conn));
+    PQclear(res);
+    return -1;
+  }
+
+  int64_t version = -1;
+  if (PQntuples(res) > 0 && !PQgetisnull(res, 0, 0)) {
+    errno = 0;
+    char *endptr;
+    const char *val = PQgetvalue(res, 0, 0);
+    long long parsed = strtoll(val, &endptr, 10);
+    if (errno == 0 && endptr != val)
+      version = parsed;
+  }
+  PQclear(res);
+  return version;
+}
+
+/* Read whatever arrived on the socket and hand out the queued NOTIFY
+ * payloads; never blocks */
+static char **pg_notifications(DbConnection *conn, size_t *count, char **err) {
+  DB_REQUIRE_PARAMS_CONN(count, conn, PgData, data, conn, err, NULL);
+  *count = 0;
+
+  if (!PQconsumeInput(data->conn)) {
+    err_set(err, PQerrorMessage(data->conn));
+    return NULL;
+  }
+
+  char **payloads = NULL;
+  size_t capacity = 0;
+  PGnotify *notify;
+  while ((notify = PQnotifies(data->conn)) != NULL) {
+    if (*count == capacity) {
+      capacity = capacity ? capacity * 2 : 8;
+      payloads = safe_reallocarray(payloads, capacity, sizeof(char *));
+    }
+    payloads[(*count)++] = str_dup(notify->extra ? notify->extra : "");
+    PQfreemem(notify);
+  }
+  return payloads;
+}
@@ -0,0 +1,409 @@
+/*
+ * Lace
+ * SQL lexer - splits scripts into statements
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "sql_lexer.h"
+#include "../util/mem.h"
+#include "../util/str.h"
+#include <ctype.h>
+#include <stdint.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Longest terminator a DELIMITER line may set */
+#define SQL_DELIMITER_MAX 16
+
+/* Words after CREATE that are looked at for the object kind */
+#define SQL_CREATE_KIND_WORDS 10
+
+static bool is_word_start(char c) {
+  return isalpha((unsigned char)c) || c == '_' || (unsigned char)c >= 0x80;
+}
+
+static bool is_word_char(char c) {
+  return isalnum((unsigned char)c) || c == '_' || c == '$' ||
+         (unsigned char)c >= 0x80;
+}
+
+/* Case-insensitive match of the word at s (n bytes) against kw */
+static bool word_is(const char *s, size_t n, const char *kw) {
+  return strlen(kw) == n && strncasecmp(s, kw, n) == 0;
+}
+
+static bool word_in(const char *s, size_t n, const char *const *list) {
+  for (; *list; list++) {
+    if (word_is(s, n, *list))
+      return true;
+  }
+  return false;
+}
+
+/* CREATE ... <kind>: kinds with a BEGIN ... END body, and kinds that end
+ * the search for one */
+static const char *const routine_kinds[] = {"TRIGGER", "PROCEDURE",
+                                            "FUNCTION", "EVENT", NULL};
+static const char *const object_kinds[] = {
+    "TABLE",     "VIEW",      "INDEX",      "SCHEMA",      "DATABASE",
+    "SEQUENCE",  "TYPE",      "DOMAIN",     "EXTENSION",   "ROLE",
+    "USER",      "POLICY",    "RULE",       "TABLESPACE",  "SERVER",
+    "COLLATION", "CAST",      "OPERATOR",   "PUBLICATION", "SUBSCRIPTION",
+    "LANGUAGE",  "STATISTICS", NULL};
+
+/* Past a quoted run opened at i and closed by close. A doubled closing
+ * quote is an escaped one; with backslash, so is \<any>. */
+static size_t skip_quoted(const char *t, size_t len, size_t i, char close,
+                          bool backslash) {
+  for (i++; i < len; i++) {
+    if (backslash && t[i] == '\\' && i + 1 < len) {
+      i++;
+    } else if (t[i] == close) {
+      if (close != ']' && i + 1 < len && t[i + 1] == close)
+        i++;
+      else
+        return i + 1;
+    }
+  }
+  return len;
+}
+
+/* Past a block comment opened at i; PostgreSQL nests them */
+static size_t skip_block_comment(const char *t, size_t len, size_t i,
+                                 bool nested) {
+  int depth = 0;
+  while (i + 1 < len) {
+    if (t[i] == '/' && t[i + 1] == '*') {
+      depth = nested ? depth + 1 : 1;
+      i += 2;
+    } else if (t[i] == '*' && t[i + 1] == '/') {
+      i += 2;
+      if (--depth == 0)
+        return i;
+    } else {
+      i++;
+    }
+  }
+  return len;
+}
+
+/* Length of a $tag$ opener at i, 0 if there is none */
+static size_t dollar_tag_len(const char *t, size_t len, size_t i) {
+  if (i > 0 && is_word_char(t[i - 1]))
+    return 0; /* Part of an identifier */
+  size_t j = i + 1;
+  if (j < len && is_word_start(t[j]) && (unsigned char)t[j] < 0x80) {
+    while (j < len && (isalnum((unsigned char)t[j]) || t[j] == '_'))
+      j++;
+  }
+  return j < len && t[j] == '$' ? j + 1 - i : 0;
+}
+
+/* Past a dollar-quoted body whose tag (tag_len bytes) starts at i */
+static size_t skip_dollar_quoted(const char *t, size_t len, size_t i,
+                                 size_t tag_len) {
+  for (size_t j = i + tag_len; j + tag_len <= len; j++) {
+    if (t[j] == '$' && memcmp(t + j, t + i, tag_len) == 0)
+      return j + tag_len;
+  }
+  return len;
+}
+
+/* Start of the word after position i (skipping whitespace), or len */
+static size_t next_word(const char *t, size_t len, size_t i, size_t *wlen) {
+  while (i < len && isspace((unsigned char)t[i]))
+    i++;
+  size_t j = i;
+  while (j < len && is_word_char(t[j]))
+    j++;
+  *wlen = j - i;
+  return i;
+}
+
+SqlDialect sql_dialect_for_driver(const char *driver_name) {
+  if (str_eq(driver_name, "sqlite"))
+    return SQL_DIALECT_SQLITE;
+  if (str_eq(driver_name, "postgres"))
+    return SQL_DIALECT_POSTGRES;
+  if (str_eq(driver_name, "mysql") || str_eq(driver_name, "mariadb"))
+    return SQL_DIALECT_MYSQL;
+  return SQL_DIALECT_ANY;
+}
+
+size_t sql_split(const char *text, SqlDialect dialect, SqlStatement **out) {
+  *out = NULL;
+  if (!text)
+    return 0;
+
+  bool pg = dialect == SQL_DIALECT_POSTGRES;
+  bool mysql = dialect == SQL_DIALECT_MYSQL;
+  bool any = dialect == SQL_DIALECT_ANY;
+
+  size_t len = strlen(text);
+  SqlStatement *stmts = NULL;
+  size_t count = 0, cap = 0;
+
+  char delim[SQL_DELIMITER_MAX + 1] = ";";
+  size_t delim_len = 1;
+  bool custom_delim = false;
+
+  /* Current statement */
+  size_t seg = 0, first = SIZE_MAX, last_end = 0;
+  size_t words = 0;
+  bool kind_pending = false; /* After CREATE, object kind not seen yet */
+  bool routine = false;      /* Body statements may hold terminators */
+  int depth = 0;             /* BEGIN/CASE ... END nesting in the body */
+
+  size_t i = 0;
+  while (i < len) {
+    char c = text[i];
+
+    /* A custom DELIMITER is explicit about where statements end */
+    if ((depth == 0 || custom_delim) &&
+        strncmp(text + i, delim, delim_len) == 0) {
+      if (first != SIZE_MAX) {
+        if (count == cap) {
+          cap = cap ? cap * 2 : 16;
+          stmts = safe_reallocarray(stmts, cap, sizeof(SqlStatement));
+        }
+        stmts[count++] = (SqlStatement){seg, first, last_end, i + delim_len};
+      }
+      i += delim_len;
+      seg = i;
+      first = SIZE_MAX;
+      words = 0;
+      kind_pending = routine = false;
+      depth = 0;
+      continue;
+    }
+
+    if (isspace((unsigned char)c)) {
+      i++;
+      continue;
+    }
+
+    /* Comments. MySQL wants whitespace after "--", and its / *! ... * /
+     * comments are executable, so they count as tokens. */
+    if (c == '-' && i + 1 < len && text[i + 1] == '-' &&
+        (!mysql || i + 2 >= len || isspace((unsigned char)text[i + 2]))) {
+      while (i < len && text[i] != '\n')
+        i++;
+      continue;
+    }
+    if (c == '#' && mysql) {
+      while (i < len && text[i] != '\n')
+        i++;
+      continue;
+    }
+    bool executable = (mysql || any) && i + 2 < len && text[i + 2] == '!';
+    if (c == '/' && i + 1 < len && text[i + 1] == '*' && !executable) {
+      i = skip_block_comment(text, len, i, pg);
+      continue;
+    }
+
+    if (first == SIZE_MAX) {
+      first = i;
+
+      /* DELIMITER <terminator> line (MySQL client command) */
+      size_t wlen;
+      next_word(text, len, i, &wlen);
+      if ((mysql || any) && word_is(text + i, wlen, "DELIMITER") &&
+          i + wlen < len && (text[i + wlen] == ' ' || text[i + wlen] == '\t')) {
+        size_t j = i + wlen;
+        while (j < len && (text[j] == ' ' || text[j] == '\t'))
+          j++;
+        size_t k = j;
+        while (k < len && !isspace((unsigned char)text[k]))
+          k++;
+        if (k > j && k - j <= SQL_DELIMITER_MAX) {
+          memcpy(delim, text + j, k - j);
+          delim[k - j] = '\0';
+          delim_len = k - j;
+          custom_delim = !str_eq(delim, ";");
+          while (k < len && text[k] != '\n')
+            k++;
+          i = seg = k;
+          first = SIZE_MAX;
+          continue;
+        }
+      }
+    }
+
+    size_t tag_len;
+    if (c == '\'') {
+      /* PostgreSQL only honours backslashes in E'...' strings */
+      bool escape_string = pg && i > 0 &&
+                           (text[i - 1] == 'E' || text[i - 1] == 'e') &&
+                           (i < 2 || !is_word_char(text[i - 2]));
+      i = skip_quoted(text, len, i, '\'', mysql || any || escape_string);
+    } else if (c == '"') {
+      i = skip_quoted(text, len, i, '"', mysql);
+    } else if (c == '`' && !pg) {
+      i = skip_quoted(text, len, i, '`', false);
+    } else if (c == '[' && dialect == SQL_DIALECT_SQLITE) {
+      i = skip_quoted(text, len, i, ']', false);
+    } else if (c == '/' && i + 1 < len && text[i + 1] == '*') {
+      i = skip_block_comment(text, len, i, false); /* Executable comment */
+    } else if (c == '$' && (pg || (any && !custom_delim)) &&
+               (tag_len = dollar_tag_len(text, len, i)) > 0) {
+      i = skip_dollar_quoted(text, len, i, tag_len);
+    } else if (is_word_start(c)) {
+      size_t j = i;
+      while (j < len && is_word_char(text[j]))
+        j++;
+      const char *w = text + i;
+      size_t n = j - i;
+
+      if (words++ == 0) {
+        kind_pending = word_is(w, n, "CREATE");
+      } else if (kind_pending) {
+        if (word_in(w, n, routine_kinds)) {
+          routine = true;
+          kind_pending = false;
+        } else if (word_in(w, n, object_kinds) ||
+                   words > SQL_CREATE_KIND_WORDS) {
+          kind_pending = false;
+        }
+      } else if (routine) {
+        if (word_is(w, n, "BEGIN")) {
+          depth++;
+        } else if (depth > 0 && word_is(w, n, "CASE")) {
+          depth++;
+        } else if (depth > 0 && word_is(w, n, "END")) {
+          /* END IF / END LOOP ... close blocks that weren't counted */
+          size_t nlen;
+          size_t nw = next_word(text, len, j, &nlen);
+          if (!word_is(text + nw, nlen, "IF") &&
+              !word_is(text + nw, nlen, "LOOP") &&
+              !word_is(text + nw, nlen, "WHILE") &&
+              !word_is(text + nw, nlen, "REPEAT"))
+            depth--;
+        }
+      }
+      i = j;
+    } else if (isdigit((unsigned char)c)) {
+      /* Numbers like 1e5 are not words */
+      while (i < len && is_word_char(text[i]))
+        i++;
+    } else {
+      i++;
+    }
+    last_end = i;
+  }
+
+  if (first != SIZE_MAX) {
+    if (count == cap) {
+      cap = cap ? cap + 1 : 1;
+      stmts = safe_reallocarray(stmts, cap, sizeof(SqlStatement));
+    }
+    stmts[count++] = (SqlStatement){seg, first, last_end, len};
+  }
+
+  *out = stmts;
+  return count;
+}
+
+char *sql_statement_text(const char *text, const SqlStatement *stmt) {
+  return str_ndup(text + stmt->start, stmt->end - stmt->start);
+}
+
+/* Up to max leading words of sql; returns how many were found */
+static size_t leading_words(const char *sql, const char **starts,
+                            size_t *lens, size_t max) {
+  size_t n = 0;
+  const char *p = sql;
+  while (n < max && *p) {
+    while (*p && !is_word_start(*p))
+      p++;
+    const char *s = p;
+    while (*p && is_word_char(*p))
+      p++;
+    if (p > s) {
+      starts[n] = s;
+      lens[n++] = (size_t)(p - s);
+    }
+  }
+  return n;
+}
+
+bool sql_is_transaction_control(const char *sql) {
+  static const char *const words[] = {"BEGIN",    "START",   "COMMIT",
+                                      "END",      "ROLLBACK", "SAVEPOINT",
+                                      "RELEASE",  "ABORT",   NULL};
+  const char *w;
+  size_t n;
+  return sql && leading_words(sql, &w, &n, 1) == 1 && word_in(w, n, words);
+}
+
+bool sql_needs_autocommit(const char *sql) {
+  if (!sql)
+    return false;
+
+  const char *w[3];
+  size_t n[3];
+  size_t count = leading_words(sql, w, n, 3);
+  if (count == 0)
+    return false;
+
+  static const char *const alone[] = {"VACUUM", "ATTACH", "DETACH", "PRAGMA",
+                                      NULL};
+  if (word_in(w[0], n[0], alone))
+    return true;
+  if (count >= 2) {
+    bool create_drop = word_is(w[0], n[0], "CREATE") ||
+                       word_is(w[0], n[0], "DROP");
+    if (create_drop && (word_is(w[1], n[1], "DATABASE") ||
+                        word_is(w[1], n[1], "TABLESPACE")))
+      return true;
+    if (word_is(w[0], n[0], "ALTER") && word_is(w[1], n[1], "SYSTEM"))
+      return true;
+    if (word_is(w[0], n[0], "REINDEX") && (word_is(w[1], n[1], "DATABASE") ||
+                                           word_is(w[1], n[1], "SYSTEM")))
+      return true;
+  }
+
+  /* CREATE INDEX CONCURRENTLY, REINDEX ... CONCURRENTLY, ... */
+  const char *p = sql;
+  while ((p = strpbrk(p, "Cc")) != NULL) {
+    if (strncasecmp(p, "CONCURRENTLY", 12) == 0 &&
+        (p == sql || !is_word_char(p[-1])) && !is_word_char(p[12]))
+      return true;
+    p++;
+  }
+  return false;
+}
+
+bool sql_changes_session(const char *sql) {
+  if (!sql)
+    return false;
+  if (sql_is_transaction_control(sql))
+    return true;
+
+  const char *w[4];
+  size_t n[4];
+  size_t count = leading_words(sql, w, n, 4);
+  if (count == 0)
+    return false;
+
+  static const char *const alone[] = {"SET",     "USE",    "ATTACH",
+                                      "DETACH",  "LOCK",   "DECLARE",
+                                      "PREPARE", "LISTEN", "LOAD",
+                                      NULL};
+  if (word_in(w[0], n[0], alone))
+    return true;
+  /* PRAGMA name = value; a bare PRAGMA only reads */
+  if (word_is(w[0], n[0], "PRAGMA"))
+    return strchr(sql, '=') != NULL;
+
+  /* CREATE [OR REPLACE] [GLOBAL | LOCAL] TEMP[ORARY] ... */
+  if (word_is(w[0], n[0], "CREATE")) {
+    static const char *const temp[] = {"TEMP", "TEMPORARY", NULL};
+    for (size_t i = 1; i < count; i++) {
+      if (word_in(w[i], n[i], temp))
+        return true;
+    }
+  }
+  return false;
+}
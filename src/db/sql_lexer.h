@@ -0,0 +1,60 @@
+/*
+ * Lace
+ * SQL lexer - splits scripts into statements
+ *
+ * Statements end at a top-level terminator (';', or whatever a MySQL
+ * DELIMITER line set). Terminators inside string literals, quoted
+ * identifiers, PostgreSQL dollar-quoted bodies, comments and the
+ * BEGIN ... END body of CREATE TRIGGER/PROCEDURE/FUNCTION don't count.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#ifndef LACE_SQL_LEXER_H
+#define LACE_SQL_LEXER_H
+
+#include <stdbool.h>
+#include <stddef.h>
+
+/* Lexical rules to follow. SQL_DIALECT_ANY accepts the union of the
+ * others where they don't conflict (for text not tied to a connection). */
+typedef enum {
+  SQL_DIALECT_ANY,
+  SQL_DIALECT_SQLITE,   /* [identifiers], `identifiers` */
+  SQL_DIALECT_POSTGRES, /* $tag$ bodies, E'escapes', nested comments */
+  SQL_DIALECT_MYSQL     /* \ escapes, # comments, DELIMITER lines */
+} SqlDialect;
+
+/* One statement of a script, as byte offsets into its text */
+typedef struct {
+  size_t seg_start; /* After the previous terminator (or 0) */
+  size_t start;     /* First token; leading whitespace and comments skipped */
+  size_t end;       /* After the last token, before the terminator */
+  size_t next;      /* After the terminator (or the end of the text) */
+} SqlStatement;
+
+/* Dialect of a driver ("sqlite", "postgres", "mysql", "mariadb") */
+SqlDialect sql_dialect_for_driver(const char *driver_name);
+
+/* Split text into statements; segments holding only whitespace and
+ * comments are left out. Returns the number found, *out (free()) set to
+ * the array, or NULL if there are none. */
+size_t sql_split(const char *text, SqlDialect dialect, SqlStatement **out);
+
+/* Copy of the statement's text (start to end) */
+char *sql_statement_text(const char *text, const SqlStatement *stmt);
+
+/* Transaction control statement (BEGIN, COMMIT, ROLLBACK, SAVEPOINT...) */
+bool sql_is_transaction_control(const char *sql);
+
+/* Statement the server refuses to run inside a transaction block (VACUUM,
+ * CREATE DATABASE, ... CONCURRENTLY, ATTACH) */
+bool sql_needs_autocommit(const char *sql);
+
+/* Statement that leaves state behind in the connection's session (SET,
+ * USE, a transaction, temporary tables...), which later statements may
+ * rely on finding there */
+bool sql_changes_session(const char *sql);
+
+#endif /* LACE_SQL_LEXER_H */
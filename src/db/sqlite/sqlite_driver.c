@@ -6,22 +6,41 @@
  * https://github.com/stychos/lace
  */
 
+#include "../../platform/thread.h"
 #include "../../util/mem.h"
 #include "../../util/str.h"
 #include "../connstr.h"
 #include "../db.h"
 #include "../db_common.h"
+#include "../sql_lexer.h"
 #include <errno.h>
 #include <limits.h>
 #include <sqlite3.h>
+#include <stdint.h>
 #include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
+/* Statements query_params keeps prepared, per connection */
+#define SQLITE_STMT_CACHE_SIZE 16
+
+/* A prepared statement waiting for its next use */
+typedef struct {
+  char *sql;           /* NULL for a free slot */
+  sqlite3_stmt *stmt;
+  uint64_t last_used;
+} SqliteCachedStmt;
+
 /* SQLite connection data */
 typedef struct {
   sqlite3 *db;
   char *path;
+
+  /* A statement is taken out while it runs, so two threads never step
+   * the same one */
+  lace_mutex_t stmt_mutex;
+  SqliteCachedStmt stmts[SQLITE_STMT_CACHE_SIZE];
+  uint64_t stmt_clock;
 } SqliteData;
 
 /* Forward declarations */
@@ -35,6 +54,8 @@ static TableSchema *sqlite_get_table_schema(DbConnection *conn,
                                             const char *table, char **err);
 static ResultSet *sqlite_query(DbConnection *conn, const char *sql, char **err);
 static int64_t sqlite_exec(DbConnection *conn, const char *sql, char **err);
+static bool sqlite_exec_script(DbConnection *conn, DbScript *script,
+                               char **err);
 static ResultSet *sqlite_query_page(DbConnection *conn, const char *table,
                                     size_t offset, size_t limit,
                                     const char *order_by, bool desc,
@@ -58,6 +79,15 @@ static bool sqlite_cancel_query(DbConnection *conn, void *cancel_handle,
 static void sqlite_free_cancel_handle(void *cancel_handle);
 static int64_t sqlite_estimate_row_count(DbConnection *conn, const char *table,
                                          char **err);
+static void *sqlite_cursor_open(DbConnection *conn, const char *sql,
+                                size_t *num_rows, char **err);
+static ResultSet *sqlite_cursor_fetch(DbConnection *conn, void *cursor,
+                                      size_t offset, size_t limit, char **err);
+static void sqlite_cursor_close(DbConnection *conn, void *cursor);
+static int64_t sqlite_data_version(DbConnection *conn, char **err);
+static ResultSet *sqlite_query_params(DbConnection *conn, const char *sql,
+                                      const DbValue *params,
+                                      size_t num_params, char **err);
 
 /* Driver definition */
 DbDriver sqlite_driver = {
@@ -73,6 +103,7 @@ DbDriver sqlite_driver = {
     .get_table_schema = sqlite_get_table_schema,
     .query = sqlite_query,
     .exec = sqlite_exec,
+    .exec_script = sqlite_exec_script,
     .query_page = sqlite_query_page,
     .update_cell = sqlite_update_cell,
     .insert_row = sqlite_insert_row,
@@ -87,6 +118,11 @@ DbDriver sqlite_driver = {
     .cancel_query = sqlite_cancel_query,
     .free_cancel_handle = sqlite_free_cancel_handle,
     .estimate_row_count = sqlite_estimate_row_count,
+    .cursor_open = sqlite_cursor_open,
+    .cursor_fetch = sqlite_cursor_fetch,
+    .cursor_close = sqlite_cursor_close,
+    .data_version = sqlite_data_version,
+    .query_params = sqlite_query_params,
     .library_cleanup = NULL,
 };
 
@@ -206,6 +242,43 @@ static DbValue sqlite_get_value(sqlite3_stmt *stmt, int col) {
   return val;
 }
 
+/* FNV-1a step over len bytes */
+static uint64_t fnv1a(uint64_t hash, const void *bytes, size_t len) {
+  const unsigned char *p = bytes;
+  for (size_t i = 0; i < len; i++) {
+    hash ^= p[i];
+    hash *= 1099511628211ULL;
+  }
+  return hash;
+}
+
+/* lace_row_hash(...): 64-bit hash of its arguments' types and values, the
+ * row version watch mode probes for (SQLite has no built-in hash) */
+static void sqlite_row_hash(sqlite3_context *ctx, int argc,
+                            sqlite3_value **argv) {
+  uint64_t hash = 14695981039346656037ULL;
+  for (int i = 0; i < argc; i++) {
+    unsigned char type = (unsigned char)sqlite3_value_type(argv[i]);
+    hash = fnv1a(hash, &type, 1);
+    if (type == SQLITE_INTEGER) {
+      sqlite3_int64 v = sqlite3_value_int64(argv[i]);
+      hash = fnv1a(hash, &v, sizeof(v));
+    } else if (type == SQLITE_FLOAT) {
+      double v = sqlite3_value_double(argv[i]);
+      hash = fnv1a(hash, &v, sizeof(v));
+    } else if (type != SQLITE_NULL) {
+      const void *data = type == SQLITE_BLOB ? sqlite3_value_blob(argv[i])
+                                             : sqlite3_value_text(argv[i]);
+      int len = sqlite3_value_bytes(argv[i]);
+      /* Length first, so ('ab', 'c') and ('a', 'bc') differ */
+      hash = fnv1a(hash, &len, sizeof(len));
+      if (data && len > 0)
+        hash = fnv1a(hash, data, (size_t)len);
+    }
+  }
+  sqlite3_result_int64(ctx, (sqlite3_int64)hash);
+}
+
 static DbConnection *sqlite_connect(const char *connstr, char **err) {
   ConnString *cs = connstr_parse(connstr, err);
   if (!cs)
@@ -237,8 +310,18 @@ static DbConnection *sqlite_connect(const char *connstr, char **err) {
 
   /* Enable foreign keys */
   (void)sqlite3_exec(db, "PRAGMA foreign_keys = ON", NULL, NULL, NULL);
+  (void)sqlite3_create_function(db, "lace_row_hash", -1,
+                                SQLITE_UTF8 | SQLITE_DETERMINISTIC, NULL,
+                                sqlite_row_hash, NULL, NULL);
 
   SqliteData *data = safe_calloc(1, sizeof(SqliteData));
+  if (!lace_mutex_init(&data->stmt_mutex)) {
+    free(data);
+    sqlite3_close(db);
+    connstr_free(cs);
+    err_set(err, "Failed to initialize statement cache");
+    return NULL;
+  }
   data->db = db;
   data->path = str_dup(cs->database);
 
@@ -268,6 +351,12 @@ static void sqlite_disconnect(DbConnection *conn) {
 
   SqliteData *data = conn->driver_data;
   if (data) {
+    /* Statements left unfinalized keep the database open */
+    for (size_t i = 0; i < SQLITE_STMT_CACHE_SIZE; i++) {
+      sqlite3_finalize(data->stmts[i].stmt);
+      free(data->stmts[i].sql);
+    }
+    lace_mutex_destroy(&data->stmt_mutex);
     if (data->db)
       sqlite3_close(data->db);
     free(data->path);
@@ -580,21 +669,19 @@ static TableSchema *sqlite_get_table_schema(DbConnection *conn,
   return schema;
 }
 
-static ResultSet *sqlite_query(DbConnection *conn, const char *sql,
-                               char **err) {
-  DB_REQUIRE_PARAMS_CONN(sql, conn, SqliteData, data, db, err, NULL);
-
-  sqlite3_stmt *stmt = NULL;
-  int rc = sqlite3_prepare_v2(data->db, sql, -1, &stmt, NULL);
-  if (rc != SQLITE_OK) {
-    if (err)
-      *err = str_printf("Query failed: %s", sqlite3_errmsg(data->db));
-    return NULL;
-  }
+/* Step a prepared (and bound) statement to the end, collecting its rows.
+ * mark is when the query started (for conn->measure_queries). The caller
+ * finalizes or resets stmt. */
+static ResultSet *sqlite_read_rows(DbConnection *conn, SqliteData *data,
+                                   sqlite3_stmt *stmt, uint64_t mark,
+                                   char **err) {
+  /* Stepping is the database's time, reading columns out is decoding */
+  bool measure = conn->measure_queries;
+  DbQueryStats stats = {0};
+  int rc;
 
   ResultSet *rs = db_result_alloc_empty();
   if (!rs) {
-    sqlite3_finalize(stmt);
     err_set(err, "Memory allocation failed");
     return NULL;
   }
@@ -608,7 +695,6 @@ static ResultSet *sqlite_query(DbConnection *conn, const char *sql,
       rs->columns[i].name = str_dup(sqlite3_column_name(stmt, i));
       if (!rs->columns[i].name) {
         db_result_free(rs);
-        sqlite3_finalize(stmt);
         err_set(err, "Memory allocation failed for column name");
         return NULL;
       }
@@ -635,18 +721,32 @@ static ResultSet *sqlite_query(DbConnection *conn, const char *sql,
       row_cap = new_cap;
     }
 
+    uint64_t stepped = measure ? lace_time_us() : 0;
+
     Row *row = &rs->rows[rs->num_rows];
     row->num_cells = num_cols;
     row->cells = safe_calloc(num_cols, sizeof(DbValue));
+    row->page = NULL; /* Grown slots are uninitialized */
 
     for (int i = 0; i < num_cols; i++) {
       row->cells[i] = sqlite_get_value(stmt, i);
+      if (measure)
+        stats.bytes += (size_t)sqlite3_column_bytes(stmt, i);
     }
 
     rs->num_rows++;
+    if (measure) {
+      uint64_t decoded = lace_time_us();
+      stats.server_us += stepped - mark;
+      stats.decode_us += decoded - stepped;
+      mark = decoded;
+    }
   }
 
-  sqlite3_finalize(stmt);
+  if (measure) {
+    stats.server_us += lace_time_us() - mark;
+    conn->last_stats = stats;
+  }
 
   if (rc != SQLITE_DONE && rc != SQLITE_ROW) {
     if (err)
@@ -658,6 +758,99 @@ static ResultSet *sqlite_query(DbConnection *conn, const char *sql,
   return rs;
 }
 
+static ResultSet *sqlite_query(DbConnection *conn, const char *sql,
+                               char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql, conn, SqliteData, data, db, err, NULL);
+
+  uint64_t mark = conn->measure_queries ? lace_time_us() : 0;
+  sqlite3_stmt *stmt = NULL;
+  int rc = sqlite3_prepare_v2(data->db, sql, -1, &stmt, NULL);
+  if (rc != SQLITE_OK) {
+    if (err)
+      *err = str_printf("Query failed: %s", sqlite3_errmsg(data->db));
+    return NULL;
+  }
+
+  ResultSet *rs = sqlite_read_rows(conn, data, stmt, mark, err);
+  sqlite3_finalize(stmt);
+  return rs;
+}
+
+/* Take the cached statement for sql out of the cache (NULL if none) */
+static sqlite3_stmt *sqlite_stmt_take(SqliteData *data, const char *sql) {
+  sqlite3_stmt *stmt = NULL;
+  lace_mutex_lock(&data->stmt_mutex);
+  for (size_t i = 0; i < SQLITE_STMT_CACHE_SIZE && !stmt; i++) {
+    SqliteCachedStmt *c = &data->stmts[i];
+    if (c->sql && strcmp(c->sql, sql) == 0) {
+      stmt = c->stmt;
+      FREE_NULL(c->sql);
+      c->stmt = NULL;
+    }
+  }
+  lace_mutex_unlock(&data->stmt_mutex);
+  return stmt;
+}
+
+/* Put a reset statement back, in place of the least recently used one if
+ * the cache is full (or of another copy of it taken meanwhile) */
+static void sqlite_stmt_give(SqliteData *data, const char *sql,
+                             sqlite3_stmt *stmt) {
+  char *key = str_dup(sql);
+  sqlite3_stmt *evicted = stmt;
+  lace_mutex_lock(&data->stmt_mutex);
+  SqliteCachedStmt *slot = NULL;
+  for (size_t i = 0; i < SQLITE_STMT_CACHE_SIZE; i++) {
+    SqliteCachedStmt *c = &data->stmts[i];
+    if (c->sql && strcmp(c->sql, sql) == 0) {
+      slot = NULL; /* Already cached: drop this one */
+      break;
+    }
+    if (!slot || !c->sql || (slot->sql && c->last_used < slot->last_used))
+      slot = c;
+  }
+  if (key && slot) {
+    evicted = slot->stmt;
+    free(slot->sql);
+    slot->sql = key;
+    slot->stmt = stmt;
+    slot->last_used = ++data->stmt_clock;
+    key = NULL;
+  }
+  lace_mutex_unlock(&data->stmt_mutex);
+  free(key);
+  sqlite3_finalize(evicted);
+}
+
+static ResultSet *sqlite_query_params(DbConnection *conn, const char *sql,
+                                      const DbValue *params,
+                                      size_t num_params, char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql, conn, SqliteData, data, db, err, NULL);
+
+  uint64_t mark = conn->measure_queries ? lace_time_us() : 0;
+  sqlite3_stmt *stmt = sqlite_stmt_take(data, sql);
+  if (!stmt && sqlite3_prepare_v3(data->db, sql, -1, SQLITE_PREPARE_PERSISTENT,
+                                  &stmt, NULL) != SQLITE_OK) {
+    if (err)
+      *err = str_printf("Query failed: %s", sqlite3_errmsg(data->db));
+    return NULL;
+  }
+
+  if ((size_t)sqlite3_bind_parameter_count(stmt) != num_params) {
+    sqlite3_finalize(stmt);
+    err_set(err, "Query parameter count mismatch");
+    return NULL;
+  }
+  for (size_t i = 0; i < num_params; i++)
+    sqlite_bind_value(stmt, (int)i + 1, &params[i]);
+
+  ResultSet *rs = sqlite_read_rows(conn, data, stmt, mark, err);
+  sqlite3_reset(stmt);
+  sqlite3_clear_bindings(stmt);
+  sqlite_stmt_give(data, sql, stmt);
+  return rs;
+}
+
 static int64_t sqlite_exec(DbConnection *conn, const char *sql, char **err) {
   DB_REQUIRE_PARAMS_CONN(sql, conn, SqliteData, data, db, err, -1);
 
@@ -673,6 +866,86 @@ static int64_t sqlite_exec(DbConnection *conn, const char *sql, char **err) {
   return sqlite3_changes(data->db);
 }
 
+/* Step every statement in sql (prepare tail iteration); *rows gets the
+ * rows returned by, or changed by, the last one */
+static bool sqlite_run_script_statement(sqlite3 *db, const char *sql,
+                                        int64_t *rows, char **err) {
+  const char *tail = sql;
+  *rows = 0;
+  while (tail && *tail) {
+    sqlite3_stmt *stmt = NULL;
+    if (sqlite3_prepare_v2(db, tail, -1, &stmt, &tail) != SQLITE_OK) {
+      err_set(err, sqlite3_errmsg(db));
+      return false;
+    }
+    if (!stmt)
+      continue; /* Only whitespace or comments left */
+
+    /* sqlite3_changes keeps the last DML's count across other statements */
+    int64_t changes_before = sqlite3_total_changes(db);
+    int64_t returned = 0;
+    int rc;
+    while ((rc = sqlite3_step(stmt)) == SQLITE_ROW)
+      returned++;
+    if (rc != SQLITE_DONE) {
+      err_set(err, sqlite3_errmsg(db));
+      sqlite3_finalize(stmt);
+      return false;
+    }
+    if (sqlite3_column_count(stmt) > 0)
+      *rows = returned;
+    else
+      *rows = sqlite3_total_changes(db) == changes_before ? 0
+                                                          : sqlite3_changes(db);
+    sqlite3_finalize(stmt);
+  }
+  return true;
+}
+
+/* Runs the script in one transaction (one journal sync instead of one per
+ * statement) unless a transaction is already open or the script controls
+ * transactions itself. */
+static bool sqlite_exec_script(DbConnection *conn, DbScript *script,
+                               char **err) {
+  DB_REQUIRE_PARAMS_CONN(script, conn, SqliteData, data, db, err, false);
+  sqlite3 *db = data->db;
+
+  bool wrap = sqlite3_get_autocommit(db) != 0;
+  for (size_t i = 0; i < script->count && wrap; i++) {
+    if (sql_is_transaction_control(script->stmts[i]) ||
+        sql_needs_autocommit(script->stmts[i]))
+      wrap = false;
+  }
+  if (wrap && sqlite_exec(conn, "BEGIN", err) < 0)
+    return false;
+
+  for (size_t i = 0; i < script->count; i++) {
+    int64_t rows = -1;
+    char *stmt_err = NULL;
+    bool ok = sqlite_run_script_statement(db, script->stmts[i], &rows,
+                                          &stmt_err);
+    bool go = db_script_finish_stmt(script, i, ok ? DB_STMT_OK : DB_STMT_ERROR,
+                                    rows, stmt_err);
+    free(stmt_err);
+
+    /* Some errors (interrupt, disk full) roll back the whole transaction */
+    if (!ok && wrap && sqlite3_get_autocommit(db)) {
+      db_script_mark_rolled_back(script, 0, i);
+      return true;
+    }
+    if (!go)
+      break;
+  }
+
+  if (wrap && !sqlite3_get_autocommit(db) &&
+      sqlite_exec(conn, "COMMIT", err) < 0) {
+    sqlite3_exec(db, "ROLLBACK", NULL, NULL, NULL);
+    db_script_mark_rolled_back(script, 0, script->count);
+    return false;
+  }
+  return true;
+}
+
 static ResultSet *sqlite_query_page(DbConnection *conn, const char *table,
                                     size_t offset, size_t limit,
                                     const char *order_by, bool desc,
@@ -700,6 +973,119 @@ static ResultSet *sqlite_query_page(DbConnection *conn, const char *table,
   return rs;
 }
 
+/* Query result materialized into a temporary table. Its rowids number the
+ * rows in result order, so any page is a rowid range. Unlike a kept
+ * statement, this holds no read lock on the database between pages. */
+typedef struct {
+  char name[32];
+  ColumnDef *columns; /* Names and declared types of the query's columns */
+  size_t num_columns;
+} SqliteCursor;
+
+static void sqlite_cursor_close(DbConnection *conn, void *cursor) {
+  SqliteCursor *cur = (SqliteCursor *)cursor;
+  if (!cur)
+    return;
+
+  if (conn) {
+    char *sql = str_printf("DROP TABLE IF EXISTS temp.%s", cur->name);
+    if (sql)
+      sqlite_exec(conn, sql, NULL);
+    free(sql);
+  }
+  for (size_t i = 0; i < cur->num_columns; i++) {
+    free(cur->columns[i].name);
+    free(cur->columns[i].type_name);
+  }
+  free(cur->columns);
+  free(cur);
+}
+
+static void *sqlite_cursor_open(DbConnection *conn, const char *sql,
+                                size_t *num_rows, char **err) {
+  DB_REQUIRE_PARAMS_CONN(sql && num_rows, conn, SqliteData, data, db, err,
+                         NULL);
+
+  /* The temporary table's columns lose the query's declared types */
+  sqlite3_stmt *stmt = NULL;
+  if (sqlite3_prepare_v2(data->db, sql, -1, &stmt, NULL) != SQLITE_OK) {
+    err_setf(err, "Query failed: %s", sqlite3_errmsg(data->db));
+    return NULL;
+  }
+  SqliteCursor *cur = safe_calloc(1, sizeof(SqliteCursor));
+  snprintf(cur->name, sizeof(cur->name), "lace_cur_%lx",
+           (unsigned long)(uintptr_t)cur);
+  int num_cols = sqlite3_column_count(stmt);
+  if (num_cols > 0) {
+    cur->columns = safe_calloc((size_t)num_cols, sizeof(ColumnDef));
+    cur->num_columns = (size_t)num_cols;
+    for (int i = 0; i < num_cols; i++) {
+      const char *name = sqlite3_column_name(stmt, i);
+      const char *type = sqlite3_column_decltype(stmt, i);
+      cur->columns[i].name = str_dup(name ? name : "?");
+      cur->columns[i].type_name = type ? str_dup(type) : NULL;
+    }
+  }
+  sqlite3_finalize(stmt);
+
+  char *create = str_printf("CREATE TEMP TABLE %s AS %s", cur->name, sql);
+  int64_t created = create ? sqlite_exec(conn, create, err) : -1;
+  free(create);
+  if (created < 0) {
+    sqlite_cursor_close(NULL, cur); /* Nothing to drop */
+    return NULL;
+  }
+
+  /* Rowids run 1..n in insertion order */
+  char *count_sql = str_printf("SELECT max(rowid) FROM temp.%s", cur->name);
+  int64_t count = -1;
+  if (count_sql &&
+      sqlite3_prepare_v2(data->db, count_sql, -1, &stmt, NULL) == SQLITE_OK) {
+    if (sqlite3_step(stmt) == SQLITE_ROW)
+      count = sqlite3_column_int64(stmt, 0);
+    sqlite3_finalize(stmt);
+  }
+  free(count_sql);
+  if (count < 0) {
+    err_setf(err, "Query failed: %s", sqlite3_errmsg(data->db));
+    sqlite_cursor_close(conn, cur);
+    return NULL;
+  }
+
+  *num_rows = (size_t)count;
+  return cur;
+}
+
+static ResultSet *sqlite_cursor_fetch(DbConnection *conn, void *cursor,
+                                      size_t offset, size_t limit,
+                                      char **err) {
+  SqliteCursor *cur = (SqliteCursor *)cursor;
+  DB_REQUIRE(cur, err, NULL);
+
+  char *sql = str_printf(
+      "SELECT * FROM temp.%s WHERE rowid > %zu ORDER BY rowid LIMIT %zu",
+      cur->name, offset, limit);
+  if (!sql) {
+    err_set(err, "Memory allocation failed");
+    return NULL;
+  }
+  ResultSet *rs = sqlite_query(conn, sql, err);
+  free(sql);
+
+  /* Report the query's own column names and types */
+  if (rs && rs->num_columns == cur->num_columns) {
+    for (size_t i = 0; i < rs->num_columns; i++) {
+      free(rs->columns[i].name);
+      rs->columns[i].name = str_dup(cur->columns[i].name);
+      free(rs->columns[i].type_name);
+      rs->columns[i].type_name = cur->columns[i].type_name
+                                     ? str_dup(cur->columns[i].type_name)
+                                     : NULL;
+    }
+  }
+  return rs;
+}
+
 static bool sqlite_update_cell(DbConnection *conn, const char *table,
                                const char **pk_cols, const DbValue *pk_vals,
                                size_t num_pk_cols, const char *col,
@@ -955,3 +1341,22 @@ static int64_t sqlite_estimate_row_count(DbConnection *conn, const char *table,
    * needed */
   return -1;
 }
+
+/* PRAGMA data_version changes when another connection commits to the
+ * database file. This connection's own writes leave it alone. */
+static int64_t sqlite_data_version(DbConnection *conn, char **err) {
+  DB_REQUIRE_CONN(conn, SqliteData, data, db, err, -1);
+
+  sqlite3_stmt *stmt = NULL;
+  if (sqlite3_prepare_v2(data->db, "PRAGMA data_version", -1, &stmt, NULL) !=
+      SQLITE_OK) {
+    err_set(err, sqlite3_errmsg(data->db));
+    return -1;
+  }
+
+  int64_t version = -1;
+  if (sqlite3_step(stmt) == SQLITE_ROW)
+    version = sqlite3_column_int64(stmt, 0);
+  sqlite3_finalize(stmt);
+  return version;
+}
@@ -121,6 +121,9 @@ bool lace_cond_timedwait(lace_cond_t *cond, lace_mutex_t *mutex,
 /* Get current time in milliseconds (monotonic if available) */
 uint64_t lace_time_ms(void);
 
+/* Get current time in microseconds (monotonic if available) */
+uint64_t lace_time_us(void);
+
 /* Sleep for specified milliseconds */
 void lace_sleep_ms(int ms);
 
@@ -204,6 +204,16 @@ uint64_t lace_time_ms(void) {
   return (uint64_t)(counter.QuadPart * 1000 / freq.QuadPart);
 }
 
+uint64_t lace_time_us(void) {
+  LARGE_INTEGER freq, counter;
+  QueryPerformanceFrequency(&freq);
+  QueryPerformanceCounter(&counter);
+  /* Split to avoid overflowing counter * 1000000 */
+  uint64_t secs = (uint64_t)(counter.QuadPart / freq.QuadPart);
+  uint64_t rest = (uint64_t)(counter.QuadPart % freq.QuadPart);
+  return secs * 1000000 + rest * 1000000 / (uint64_t)freq.QuadPart;
+}
+
 void lace_sleep_ms(int ms) {
   if (ms > 0) {
     Sleep((DWORD)ms);
@@ -103,6 +103,10 @@ static void init_colors(RenderContext *ctx) {
   /* UI_COLOR_PK - yellow on default (primary key indicator) */
   init_pair(12, COLOR_YELLOW, -1);
   color_pair_map[UI_COLOR_PK] = 12;
+
+  /* UI_COLOR_CHANGED - black on green (cell changed by a watch refresh) */
+  init_pair(13, COLOR_BLACK, COLOR_GREEN);
+  color_pair_map[UI_COLOR_CHANGED] = 13;
 }
 
 /* ============================================================================
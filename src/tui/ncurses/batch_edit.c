@@ -0,0 +1,299 @@
+/*
+ * Lace
+ * Block paste and batched cell updates
+ *
+ * Multi-cell edits (TSV block paste, setting a value across selected rows)
+ * are grouped by column and written as batched UPDATE statements inside a
+ * single transaction, then patched into the loaded cells in place.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../util/mem.h"
+#include "tui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* ============================================================================
+ * TSV parsing
+ * ============================================================================
+ */
+
+/* Read one field starting at p. Quoted fields ("a\tb", "x""y") may contain
+ * tabs and newlines, as spreadsheets emit them. Advances *pp past the field
+ * (not past the delimiter). */
+static char *tsv_read_field(const char **pp) {
+  const char *p = *pp;
+
+  if (*p == '"') {
+    StringBuilder *sb = sb_new(32);
+    if (!sb)
+      return NULL;
+    p++;
+    while (*p) {
+      if (*p == '"') {
+        if (p[1] == '"') {
+          sb_append_char(sb, '"');
+          p += 2;
+          continue;
+        }
+        p++;
+        break;
+      }
+      sb_append_char(sb, *p++);
+    }
+    /* Ignore anything between the closing quote and the delimiter */
+    while (*p && *p != '\t' && *p != '\n' && *p != '\r')
+      p++;
+    *pp = p;
+    return sb_to_string(sb);
+  }
+
+  const char *start = p;
+  while (*p && *p != '\t' && *p != '\n' && *p != '\r')
+    p++;
+  *pp = p;
+  return str_ndup(start, (size_t)(p - start));
+}
+
+char **tui_parse_tsv(const char *text, size_t *num_rows, size_t *num_cols) {
+  if (num_rows)
+    *num_rows = 0;
+  if (num_cols)
+    *num_cols = 0;
+  if (!text || !num_rows || !num_cols)
+    return NULL;
+
+  /* Parse into a growing list of rows, each a list of fields */
+  char ***rows = NULL;
+  size_t *row_lens = NULL;
+  size_t nrows = 0, row_cap = 0, ncols = 0;
+
+  const char *p = text;
+  while (*p) {
+    char **fields = NULL;
+    size_t nfields = 0, field_cap = 0;
+
+    for (;;) {
+      if (nfields >= field_cap) {
+        field_cap = field_cap == 0 ? 8 : field_cap * 2;
+        fields = safe_reallocarray(fields, field_cap, sizeof(char *));
+      }
+      fields[nfields++] = tsv_read_field(&p);
+      if (*p != '\t')
+        break;
+      p++;
+    }
+
+    /* End of line: \n, \r\n or \r */
+    if (*p == '\r')
+      p++;
+    if (*p == '\n')
+      p++;
+
+    if (nrows >= row_cap) {
+      row_cap = row_cap == 0 ? 16 : row_cap * 2;
+      rows = safe_reallocarray(rows, row_cap, sizeof(char **));
+      row_lens = safe_reallocarray(row_lens, row_cap, sizeof(size_t));
+    }
+    rows[nrows] = fields;
+    row_lens[nrows] = nfields;
+    nrows++;
+    if (nfields > ncols)
+      ncols = nfields;
+  }
+
+  if (nrows == 0) {
+    free(rows);
+    free(row_lens);
+    return NULL;
+  }
+
+  /* Flatten into a rectangle; short rows leave NULL fields */
+  char **grid = safe_calloc(nrows * ncols, sizeof(char *));
+  for (size_t r = 0; r < nrows; r++) {
+    for (size_t c = 0; c < row_lens[r]; c++)
+      grid[r * ncols + c] = rows[r][c];
+    free(rows[r]);
+  }
+  free(rows);
+  free(row_lens);
+
+  *num_rows = nrows;
+  *num_cols = ncols;
+  return grid;
+}
+
+void tui_free_tsv(char **fields, size_t count) {
+  if (!fields)
+    return;
+  for (size_t i = 0; i < count; i++)
+    free(fields[i]);
+  free(fields);
+}
+
+/* ============================================================================
+ * Batched updates
+ * ============================================================================
+ */
+
+void tui_cell_updates_free(CellUpdate *updates, size_t count) {
+  if (!updates)
+    return;
+  for (size_t i = 0; i < count; i++)
+    db_value_free(&updates[i].value);
+  free(updates);
+}
+
+static int cell_update_cmp(const void *a, const void *b) {
+  const CellUpdate *ua = a;
+  const CellUpdate *ub = b;
+  if (ua->col != ub->col)
+    return ua->col < ub->col ? -1 : 1;
+  if (ua->row != ub->row)
+    return ua->row < ub->row ? -1 : 1;
+  return 0;
+}
+
+/* Whether col_name is one of the key columns rows are addressed by */
+static bool is_key_column(const char **pk_cols, size_t num_pk_cols,
+                          const char *col_name) {
+  for (size_t k = 0; k < num_pk_cols; k++) {
+    if (pk_cols[k] && strcmp(pk_cols[k], col_name) == 0)
+      return true;
+  }
+  return false;
+}
+
+/* Write the n updates of one column (run), addressing rows by their keys
+ * before any change. Every row must match, or the caller rolls back. */
+static bool update_column_run(DbConnection *conn, const char *table,
+                              const char **pk_cols, size_t num_pk_cols,
+                              const DbValue *pk_vals, const char *col_name,
+                              const CellUpdate *run, size_t n,
+                              DbValue *run_pks, DbValue *run_vals,
+                              int64_t *total, char **err) {
+  /* Shallow copies: values stay owned by pk_vals / updates */
+  for (size_t i = 0; i < n; i++) {
+    memcpy(&run_pks[i * num_pk_cols], &pk_vals[run[i].pk_index * num_pk_cols],
+           num_pk_cols * sizeof(DbValue));
+    run_vals[i] = run[i].value;
+  }
+
+  int64_t rows = db_update_cells(conn, table, pk_cols, num_pk_cols, run_pks,
+                                 col_name, run_vals, n, err);
+  if (rows < 0)
+    return false;
+  if ((size_t)rows != n) {
+    if (err)
+      *err = str_printf("%s matched %lld of %zu rows", col_name,
+                        (long long)rows, n);
+    return false;
+  }
+  *total += rows;
+  return true;
+}
+
+bool tui_apply_cell_updates(DbConnection *conn, const char *table,
+                            const char **pk_cols, size_t num_pk_cols,
+                            DbValue *pk_vals, ResultSet *data,
+                            ColumnWidthStats *stats, size_t num_stats,
+                            CellUpdate *updates, size_t count,
+                            int64_t *affected, char **err) {
+  if (affected)
+    *affected = 0;
+  if (!conn || !table || !pk_cols || num_pk_cols == 0 || !pk_vals || !data ||
+      !updates || count == 0) {
+    if (err)
+      *err = str_dup("Invalid parameters");
+    return false;
+  }
+
+  /* Group by column; each run becomes one batched statement series */
+  qsort(updates, count, sizeof(CellUpdate), cell_update_cmp);
+
+  /* Rows are found by their old keys, so a key column is written last, and
+   * only one: after it changes the others no longer find their rows */
+  size_t key_start = count, key_end = count;
+  for (size_t start = 0; start < count;) {
+    size_t col = updates[start].col;
+    size_t end = start;
+    while (end < count && updates[end].col == col)
+      end++;
+    if (col >= data->num_columns || !data->columns[col].name) {
+      if (err)
+        *err = str_dup("Invalid column");
+      return false;
+    }
+    if (is_key_column(pk_cols, num_pk_cols, data->columns[col].name)) {
+      if (key_start < count) {
+        if (err)
+          *err = str_dup("Only one key column can be changed at a time");
+        return false;
+      }
+      key_start = start;
+      key_end = end;
+    }
+    start = end;
+  }
+
+  DbValue *run_pks = safe_calloc(count * num_pk_cols, sizeof(DbValue));
+  DbValue *run_vals = safe_calloc(count, sizeof(DbValue));
+
+  char *txn_err = NULL;
+  DbTransaction txn = db_transaction_begin(conn, &txn_err);
+  bool ok = txn_err == NULL;
+  if (!ok) {
+    if (err)
+      *err = txn_err;
+    else
+      free(txn_err);
+  }
+  int64_t total = 0;
+
+  for (size_t start = 0; start < count && ok;) {
+    size_t end = start;
+    while (end < count && updates[end].col == updates[start].col)
+      end++;
+    if (start != key_start)
+      ok = update_column_run(conn, table, pk_cols, num_pk_cols, pk_vals,
+                             data->columns[updates[start].col].name,
+                             &updates[start], end - start, run_pks, run_vals,
+                             &total, err);
+    start = end;
+  }
+  if (ok && key_start < count)
+    ok = update_column_run(conn, table, pk_cols, num_pk_cols, pk_vals,
+                           data->columns[updates[key_start].col].name,
+                           &updates[key_start], key_end - key_start, run_pks,
+                           run_vals, &total, err);
+
+  free(run_pks);
+  free(run_vals);
+
+  if (ok)
+    ok = db_transaction_commit(&txn, err);
+  db_transaction_end(&txn);
+  if (!ok)
+    return false;
+
+  /* Committed: patch the loaded cells in place */
+  for (size_t i = 0; i < count; i++) {
+    CellUpdate *u = &updates[i];
+    if (u->row >= data->num_rows || !data->rows[u->row].cells ||
+        u->col >= data->rows[u->row].num_cells)
+      continue;
+    db_row_own(&data->rows[u->row]); /* Fork a shared page's row */
+    DbValue *cell = &data->rows[u->row].cells[u->col];
+    if (stats && u->col < num_stats)
+      col_stats_replace_value(&stats[u->col], cell, &u->value);
+    db_value_free(cell);
+    *cell = u->value;
+    u->value = db_value_null(); /* Ownership moved to the cell */
+  }
+
+  if (affected)
+    *affected = total;
+  return true;
+}
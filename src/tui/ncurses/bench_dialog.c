@@ -0,0 +1,485 @@
+/*
+ * Lace
+ * Query Benchmark Dialog
+ *
+ * Runs the query under the editor cursor repeatedly and reports latency
+ * percentiles, throughput, bytes received and how each run's time splits
+ * between the database and decoding rows on the client. With more than
+ * one connection, each connection runs its share of the runs at the same
+ * time on its own ASYNC_OP_BENCHMARK worker.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../core/bench.h"
+#include "../../core/result_cache.h"
+#include "../../util/mem.h"
+#include "render_helpers.h"
+#include "tui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Dialog dimensions */
+#define BENCH_SETTINGS_WIDTH 60
+#define BENCH_SETTINGS_HEIGHT 10
+#define BENCH_REPORT_WIDTH 76
+#define BENCH_REPORT_HEIGHT 14
+
+/* Editable settings */
+enum { BENCH_FIELD_RUNS, BENCH_FIELD_WARMUP, BENCH_FIELD_CONNS };
+#define BENCH_NUM_FIELDS 3
+
+typedef struct {
+  size_t values[BENCH_NUM_FIELDS];
+} BenchSettings;
+
+static const char *const field_labels[BENCH_NUM_FIELDS] = {
+    "Measured runs:", "Warmup runs:", "Connections:"};
+static const char *const field_notes[BENCH_NUM_FIELDS] = {
+    "", "per connection", ""};
+static const size_t field_min[BENCH_NUM_FIELDS] = {1, 0, 1};
+static const size_t field_max[BENCH_NUM_FIELDS] = {
+    BENCH_RUNS_MAX, BENCH_WARMUP_MAX, BENCH_CONCURRENCY_MAX};
+
+/* SQL on one line, cut to max_len display bytes */
+static void sql_one_line(const char *sql, char *buf, size_t size,
+                         size_t max_len) {
+  size_t n = 0;
+  bool space = false;
+  for (const char *p = sql; *p && n + 1 < size && n < max_len; p++) {
+    bool ws = *p == ' ' || *p == '\t' || *p == '\n' || *p == '\r';
+    if (ws) {
+      space = n > 0;
+      continue;
+    }
+    if (space && n + 2 < size && n + 1 < max_len)
+      buf[n++] = ' ';
+    space = false;
+    buf[n++] = *p;
+  }
+  buf[n] = '\0';
+}
+
+static void format_us(uint64_t us, char *buf, size_t size) {
+  if (us < 1000)
+    snprintf(buf, size, "%lluus", (unsigned long long)us);
+  else if (us < 1000000)
+    snprintf(buf, size, "%.2fms", (double)us / 1e3);
+  else
+    snprintf(buf, size, "%.2fs", (double)us / 1e6);
+}
+
+static void format_bytes(double bytes, char *buf, size_t size) {
+  if (bytes < 1024)
+    snprintf(buf, size, "%.0f B", bytes);
+  else if (bytes < 1024.0 * 1024)
+    snprintf(buf, size, "%.1f KB", bytes / 1024);
+  else if (bytes < 1024.0 * 1024 * 1024)
+    snprintf(buf, size, "%.1f MB", bytes / (1024.0 * 1024));
+  else
+    snprintf(buf, size, "%.2f GB", bytes / (1024.0 * 1024 * 1024));
+}
+
+static void format_rate(double v, char *buf, size_t size) {
+  if (v < 10000)
+    snprintf(buf, size, "%.1f", v);
+  else if (v < 1e7)
+    snprintf(buf, size, "%.1fk", v / 1e3);
+  else
+    snprintf(buf, size, "%.1fM", v / 1e6);
+}
+
+/* Edit the settings. Returns false if cancelled. */
+static bool edit_settings(TuiState *state, const char *sql,
+                          BenchSettings *settings) {
+  (void)state;
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+  int width = BENCH_SETTINGS_WIDTH;
+  int height = BENCH_SETTINGS_HEIGHT;
+  WINDOW *win = dialog_create(height, width, term_rows, term_cols);
+  if (!win)
+    return false;
+  curs_set(1);
+
+  char inputs[BENCH_NUM_FIELDS][8];
+  for (int i = 0; i < BENCH_NUM_FIELDS; i++)
+    snprintf(inputs[i], sizeof(inputs[i]), "%zu", settings->values[i]);
+  int field = BENCH_FIELD_RUNS;
+
+  char sql_line[128];
+  sql_one_line(sql, sql_line, sizeof(sql_line), (size_t)width - 4);
+
+  bool accepted = false;
+  bool running = true;
+  while (running) {
+    werase(win);
+    DRAW_BOX(win, COLOR_BORDER);
+    WITH_ATTR(win, A_BOLD,
+              mvwprintw(win, 0, (width - 17) / 2, " Benchmark Query "));
+    WITH_ATTR(win, A_DIM, mvwprintw(win, 1, 2, "%s", sql_line));
+
+    for (int i = 0; i < BENCH_NUM_FIELDS; i++) {
+      int y = 3 + i;
+      mvwprintw(win, y, 4, "%-15s", field_labels[i]);
+      if (i == field)
+        wattron(win, A_REVERSE);
+      mvwprintw(win, y, 20, "%-8s", inputs[i]);
+      if (i == field)
+        wattroff(win, A_REVERSE);
+      WITH_ATTR(win, A_DIM, mvwprintw(win, y, 30, "%s", field_notes[i]));
+    }
+
+    WITH_ATTR(win, A_DIM,
+              mvwprintw(win, height - 2, 2,
+                        "[Enter] Run  [Tab/Up/Down] Field  [Esc] Cancel"));
+    wmove(win, 3 + field, 20 + (int)strlen(inputs[field]));
+    wrefresh(win);
+
+    int ch = wgetch(win);
+    size_t len = strlen(inputs[field]);
+
+    if (ch == 27) {
+      running = false;
+    } else if (ch == '\t' || ch == KEY_DOWN) {
+      field = (field + 1) % BENCH_NUM_FIELDS;
+    } else if (ch == KEY_BTAB || ch == KEY_UP) {
+      field = (field + BENCH_NUM_FIELDS - 1) % BENCH_NUM_FIELDS;
+    } else if (ch == KEY_BACKSPACE || ch == 127 || ch == 8) {
+      if (len > 0)
+        inputs[field][len - 1] = '\0';
+    } else if (ch >= '0' && ch <= '9') {
+      if (len + 1 < sizeof(inputs[field])) {
+        inputs[field][len] = (char)ch;
+        inputs[field][len + 1] = '\0';
+      }
+    } else if (ch == '\n' || ch == KEY_ENTER) {
+      /* Every field must be in range; stop on the first one that isn't */
+      int bad = -1;
+      size_t parsed[BENCH_NUM_FIELDS];
+      for (int i = 0; i < BENCH_NUM_FIELDS && bad < 0; i++) {
+        char *end;
+        unsigned long long v = strtoull(inputs[i], &end, 10);
+        if (end == inputs[i] || v < field_min[i] || v > field_max[i])
+          bad = i;
+        else
+          parsed[i] = (size_t)v;
+      }
+      if (bad >= 0) {
+        field = bad;
+        flash();
+        continue;
+      }
+      memcpy(settings->values, parsed, sizeof(parsed));
+      accepted = true;
+      running = false;
+    }
+  }
+
+  curs_set(0);
+  delwin(win);
+  touchwin(stdscr);
+  tui_refresh(state);
+  return accepted;
+}
+
+/* Open count - 1 extra connections like conns[0]. Returns how many
+ * connections are usable (conns[0] included). */
+static size_t open_lanes(TuiState *state, DbConnection **conns, size_t count,
+                         char **err) {
+  size_t opened = 1;
+  for (size_t i = 1; i < count; i++) {
+    AsyncOperation op;
+    async_init(&op);
+    op.op_type = ASYNC_OP_CONNECT;
+    op.connstr = str_dup(conns[0]->connstr);
+
+    char msg[80];
+    snprintf(msg, sizeof(msg), "Opening connection %zu of %zu...", i + 1,
+             count);
+    if (async_start(&op)) {
+      bool completed = tui_show_processing_dialog(state, &op, msg);
+      if (completed && op.state == ASYNC_STATE_COMPLETED && op.result) {
+        conns[opened++] = op.result;
+        op.result = NULL;
+      } else if (op.state == ASYNC_STATE_ERROR) {
+        *err = str_printf("Connection %zu: %s", i + 1,
+                          op.error ? op.error : "connect failed");
+      }
+    }
+    async_free(&op);
+    if (opened != i + 1)
+      break;
+  }
+  return opened;
+}
+
+/* Run the benchmark. Returns false with *err set on failure (NULL if
+ * cancelled). */
+static bool run_benchmark(TuiState *state, const char *sql,
+                          const BenchSettings *settings, BenchSummary *out,
+                          char **err) {
+  size_t runs = settings->values[BENCH_FIELD_RUNS];
+  size_t warmup = settings->values[BENCH_FIELD_WARMUP];
+  size_t lanes = settings->values[BENCH_FIELD_CONNS];
+  if (lanes > runs)
+    lanes = runs;
+
+  DbConnection *conns[BENCH_CONCURRENCY_MAX];
+  conns[0] = TUI_CONN(state);
+  if (open_lanes(state, conns, lanes, err) != lanes) {
+    for (size_t i = 1; i < lanes && conns[i]; i++)
+      db_disconnect(conns[i]);
+    return false;
+  }
+
+  /* Hundreds of identical history entries help no one */
+  void (*history_cb)(void *, const char *, int) = conns[0]->history_callback;
+  void *history_ctx = conns[0]->history_context;
+  conns[0]->history_callback = NULL;
+
+  /* Runs are dealt evenly, the first lanes taking the remainder */
+  AsyncOperation ops[BENCH_CONCURRENCY_MAX];
+  bool started[BENCH_CONCURRENCY_MAX] = {false};
+  size_t total_runs = 0;
+  for (size_t i = 0; i < lanes; i++) {
+    async_init(&ops[i]);
+    ops[i].op_type = ASYNC_OP_BENCHMARK;
+    ops[i].conn = conns[i];
+    ops[i].sql = str_dup(sql);
+    ops[i].offset = warmup;
+    ops[i].limit = runs / lanes + (i < runs % lanes ? 1 : 0);
+    started[i] = async_start(&ops[i]);
+    if (started[i])
+      total_runs += warmup + ops[i].limit;
+  }
+
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+  int width = 50, height = 7;
+  WINDOW *win = dialog_create(height, width, term_rows, term_cols);
+  if (win)
+    wtimeout(win, POLL_INTERVAL_MS);
+
+  bool cancelled = false;
+  for (;;) {
+    size_t done = 0;
+    bool all_finished = true;
+    for (size_t i = 0; i < lanes; i++) {
+      if (!started[i])
+        continue;
+      lace_mutex_lock(&ops[i].mutex);
+      done += (size_t)ops[i].count;
+      lace_mutex_unlock(&ops[i].mutex);
+      if (async_poll(&ops[i]) == ASYNC_STATE_RUNNING)
+        all_finished = false;
+    }
+    if (all_finished || !win)
+      break;
+
+    werase(win);
+    DRAW_BOX(win, COLOR_BORDER);
+    WITH_ATTR(win, A_BOLD, mvwprintw(win, 0, (width - 11) / 2, " Benchmark "));
+    mvwprintw(win, 2, 2, "Run %zu of %zu on %zu connection%s", done,
+              total_runs, lanes, lanes == 1 ? "" : "s");
+    int bar = width - 6;
+    int filled = total_runs ? (int)((double)bar * done / total_runs) : 0;
+    mvwaddch(win, 3, 2, '[');
+    for (int i = 0; i < bar; i++)
+      waddch(win, i < filled ? ACS_CKBOARD : ' ');
+    waddch(win, ']');
+    WITH_ATTR(win, A_DIM, mvwprintw(win, height - 2, 2, "[Esc] Cancel"));
+    wrefresh(win);
+
+    if (wgetch(win) == 27 && !cancelled) {
+      cancelled = true;
+      for (size_t i = 0; i < lanes; i++) {
+        if (started[i])
+          async_cancel(&ops[i]);
+      }
+    }
+  }
+  /* No window to poll from: wait the workers out */
+  for (size_t i = 0; i < lanes; i++) {
+    while (started[i] && async_poll(&ops[i]) == ASYNC_STATE_RUNNING)
+      async_wait(&ops[i], POLL_INTERVAL_MS);
+  }
+  if (win) {
+    delwin(win);
+    touchwin(stdscr);
+  }
+
+  /* Gather the measured runs of every lane */
+  AsyncBenchRun *all = safe_calloc(runs, sizeof(AsyncBenchRun));
+  size_t num_all = 0;
+  for (size_t i = 0; i < lanes; i++) {
+    AsyncOperation *op = &ops[i];
+    if (!started[i]) {
+      if (!*err)
+        *err = str_dup("Failed to start benchmark worker");
+    } else if (op->state == ASYNC_STATE_ERROR) {
+      if (!*err)
+        *err = str_dup(op->error ? op->error : "Query failed");
+    } else if (op->state == ASYNC_STATE_CANCELLED) {
+      cancelled = true;
+    }
+    if (op->result && op->state == ASYNC_STATE_COMPLETED) {
+      memcpy(all + num_all, op->result,
+             op->result_count * sizeof(AsyncBenchRun));
+      num_all += op->result_count;
+    }
+    free(op->result); /* Left behind by an error */
+    op->result = NULL;
+    async_free(op);
+  }
+
+  conns[0]->history_callback = history_cb;
+  conns[0]->history_context = history_ctx;
+  /* A statement that writes is reported once, so the result cache and
+   * history see it */
+  if (history_cb && !result_cache_sql_is_read(sql))
+    history_cb(history_ctx, sql, DB_HISTORY_AUTO);
+  for (size_t i = 1; i < lanes; i++)
+    db_disconnect(conns[i]);
+
+  bool ok = !cancelled && !*err && num_all == runs;
+  if (ok)
+    bench_summarize(all, num_all, out);
+  free(all);
+  return ok;
+}
+
+/* Show the report. Returns 'r' to run again, 's' to change settings, or 0
+ * to close. */
+static int show_report(TuiState *state, const char *sql,
+                       const BenchSettings *settings,
+                       const BenchSummary *sum) {
+  (void)state;
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+  int width = BENCH_REPORT_WIDTH;
+  if (width > term_cols - 2)
+    width = term_cols - 2;
+  int height = BENCH_REPORT_HEIGHT;
+  WINDOW *win = dialog_create(height, width, term_rows, term_cols);
+  if (!win)
+    return 0;
+
+  char sql_line[128];
+  sql_one_line(sql, sql_line, sizeof(sql_line), (size_t)width - 4);
+
+  char wall[16], p50[16], p95[16], p99[16], lo[16], hi[16], mean[16];
+  format_us(sum->wall_us, wall, sizeof(wall));
+  format_us(sum->p50_us, p50, sizeof(p50));
+  format_us(sum->p95_us, p95, sizeof(p95));
+  format_us(sum->p99_us, p99, sizeof(p99));
+  format_us(sum->min_us, lo, sizeof(lo));
+  format_us(sum->max_us, hi, sizeof(hi));
+  format_us(sum->mean_us, mean, sizeof(mean));
+
+  char runs_rate[16], rows_rate[16], bytes_rate[16], per_run_bytes[16];
+  format_rate(sum->runs_per_sec, runs_rate, sizeof(runs_rate));
+  format_rate(sum->rows_per_sec, rows_rate, sizeof(rows_rate));
+  format_bytes(sum->bytes_per_sec, bytes_rate, sizeof(bytes_rate));
+  format_bytes((double)sum->bytes / (double)sum->runs, per_run_bytes,
+               sizeof(per_run_bytes));
+
+  char server[16], decode[16], other[16];
+  format_us(sum->server_us, server, sizeof(server));
+  format_us(sum->decode_us, decode, sizeof(decode));
+  format_us(sum->other_us, other, sizeof(other));
+  double base = sum->mean_us > 0 ? (double)sum->mean_us : 1;
+
+  werase(win);
+  DRAW_BOX(win, COLOR_BORDER);
+  WITH_ATTR(win, A_BOLD,
+            mvwprintw(win, 0, (width - 19) / 2, " Benchmark Results "));
+  WITH_ATTR(win, A_DIM, mvwprintw(win, 1, 2, "%s", sql_line));
+
+  size_t conns = settings->values[BENCH_FIELD_CONNS];
+  mvwprintw(win, 3, 2, "Runs        %zu measured, %zu warmup x %zu conn%s, %s",
+            sum->runs, settings->values[BENCH_FIELD_WARMUP], conns,
+            conns == 1 ? "" : "s", wall);
+  mvwprintw(win, 4, 2, "Latency     ");
+  WITH_ATTR(win, A_BOLD,
+            wprintw(win, "p50 %s  p95 %s  p99 %s", p50, p95, p99));
+  mvwprintw(win, 5, 2, "            min %s  max %s  mean %s", lo, hi, mean);
+  mvwprintw(win, 6, 2, "Throughput  %s runs/s  %s rows/s  %s/s", runs_rate,
+            rows_rate, bytes_rate);
+  mvwprintw(win, 7, 2, "Received    %zu rows, %s per run",
+            sum->rows / sum->runs, per_run_bytes);
+  mvwprintw(win, 8, 2, "Time/run    server %s (%.0f%%)  decode %s (%.0f%%)",
+            server, (double)sum->server_us * 100 / base, decode,
+            (double)sum->decode_us * 100 / base);
+  mvwprintw(win, 9, 2, "            other %s (%.0f%%)", other,
+            (double)sum->other_us * 100 / base);
+
+  WITH_ATTR(win, A_DIM,
+            mvwprintw(win, height - 2, 2,
+                      "[r] Run again  [s] Settings  [Esc] Close"));
+  wrefresh(win);
+
+  int result = 0;
+  for (;;) {
+    int ch = wgetch(win);
+    if (ch == 'r' || ch == 's') {
+      result = ch;
+      break;
+    }
+    if (ch == 27 || ch == 'q' || ch == '\n' || ch == KEY_ENTER)
+      break;
+  }
+
+  delwin(win);
+  touchwin(stdscr);
+  tui_refresh(state);
+  return result;
+}
+
+/* Benchmark sql */
+void tui_show_benchmark_dialog(TuiState *state, const char *sql) {
+  if (!state || !sql || !*sql)
+    return;
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn) {
+    tui_set_error(state, "Not connected to database");
+    return;
+  }
+
+  BenchSettings settings = {
+      {BENCH_RUNS_DEFAULT, BENCH_WARMUP_DEFAULT, 1}};
+  if (!edit_settings(state, sql, &settings))
+    return;
+
+  /* The runs need the connection to themselves */
+  tui_cancel_background_load(state);
+
+  for (;;) {
+    BenchSummary sum;
+    char *err = NULL;
+    if (!run_benchmark(state, sql, &settings, &sum, &err)) {
+      if (err)
+        tui_set_error(state, "Benchmark failed: %s", err);
+      else
+        tui_set_status(state, "Benchmark cancelled");
+      free(err);
+      return;
+    }
+
+    char p50[16], p95[16], p99[16], rate[16];
+    format_us(sum.p50_us, p50, sizeof(p50));
+    format_us(sum.p95_us, p95, sizeof(p95));
+    format_us(sum.p99_us, p99, sizeof(p99));
+    format_rate(sum.runs_per_sec, rate, sizeof(rate));
+    tui_set_status(state, "Benchmark: %zu runs, p50 %s p95 %s p99 %s, %s runs/s",
+                   sum.runs, p50, p95, p99, rate);
+
+    int next = show_report(state, sql, &settings, &sum);
+    if (next == 's' && !edit_settings(state, sql, &settings))
+      return;
+    if (next == 0)
+      return;
+  }
+}
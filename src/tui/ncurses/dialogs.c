@@ -57,6 +57,9 @@ bool tui_show_confirm_dialog(TuiState *state, const char *message) {
   if (!state)
     return false;
 
+  /* Dialog overlaps every region */
+  tui_mark_damage(state, TUI_DAMAGE_ALL);
+
   int msg_len = (int)strlen(message);
   int width = msg_len + 6;
   if (width < 30)
@@ -345,8 +348,11 @@ void tui_show_goto_dialog(TuiState *state) {
   keypad(win, TRUE);
   curs_set(1);
 
-  char input[32] = {0};
+  char input[64] = {0};
   size_t input_len = 0;
+  size_t max_input = (size_t)width - 5; /* Fits the input field */
+  if (max_input > sizeof(input) - 1)
+    max_input = sizeof(input) - 1;
   int selected = 0; /* 0 = Go, 1 = Cancel */
 
   bool running = true;
@@ -355,7 +361,10 @@ void tui_show_goto_dialog(TuiState *state) {
     DRAW_BOX(win, COLOR_BORDER);
     WITH_ATTR(win, A_BOLD, mvwprintw(win, 0, (width - 14) / 2, " Go to Row "));
 
-    mvwprintw(win, 2, 2, "Enter row number (1-%zu):", total_rows);
+    if (is_query)
+      mvwprintw(win, 2, 2, "Enter row number (1-%zu):", total_rows);
+    else
+      mvwprintw(win, 2, 2, "Row number (1-%zu) or =key value:", total_rows);
 
     /* Draw input field */
     mvwprintw(win, 3, 2, "%s", input);
@@ -399,6 +408,16 @@ void tui_show_goto_dialog(TuiState *state) {
         running = false;
         break;
       }
+      if (input_len > 0 && !is_query && input[0] == '=') {
+        /* Jump to the first row at or after a sort key value */
+        curs_set(0);
+        delwin(win);
+        touchwin(stdscr);
+        tui_refresh(state);
+        tui_goto_key(state, input + 1);
+        tui_refresh(state);
+        return;
+      }
       if (input_len > 0) {
         errno = 0;
         char *endptr;
@@ -461,203 +480,8 @@ void tui_show_goto_dialog(TuiState *state) {
             if (ui)
               ui->query_focus_results = true;
           } else {
-            /* Handle regular table navigation */
-            /* Check if target is in currently loaded range */
-            if (target_row >= tab->loaded_offset &&
-                target_row < tab->loaded_offset + tab->loaded_count) {
-              /* Already loaded, just move cursor */
-              tab->cursor_row = target_row - tab->loaded_offset;
-
-              /* Adjust scroll */
-              if (tab->cursor_row < tab->scroll_row) {
-                tab->scroll_row = tab->cursor_row;
-              } else if (tab->cursor_row >=
-                         tab->scroll_row + (size_t)state->content_rows) {
-                tab->scroll_row = tab->cursor_row - state->content_rows + 1;
-              }
-            } else {
-              /* Need to load new data - use async with progress */
-              size_t load_offset =
-                  target_row > PAGE_SIZE / 2 ? target_row - PAGE_SIZE / 2 : 0;
-
-              /* Get table name from Tab */
-              Tab *curr_tab = TUI_TAB(state);
-              DbConnection *conn = TUI_CONN(state);
-              const char *table = curr_tab ? curr_tab->table_name : NULL;
-              char *where_clause = NULL;
-
-              /* Build WHERE clause from filters if applicable */
-              if (curr_tab && curr_tab->filters.num_filters > 0 &&
-                  curr_tab->schema && conn) {
-                char *err = NULL;
-                where_clause =
-                    filters_build_where(&curr_tab->filters, curr_tab->schema,
-                                        conn->driver->name, &err);
-                free(err);
-              }
-
-              /* Use async operation with progress dialog */
-              AsyncOperation op;
-              async_init(&op);
-              op.conn = state->conn;
-              op.table_name = str_dup(table);
-              op.offset = load_offset;
-              op.limit = PAGE_SIZE;
-              op.order_by = NULL;
-              op.desc = false;
-
-              if (where_clause) {
-                op.op_type = ASYNC_OP_QUERY_PAGE_WHERE;
-                op.where_clause = where_clause;
-              } else {
-                op.op_type = ASYNC_OP_QUERY_PAGE;
-              }
-
-              bool load_succeeded = false;
-              if (async_start(&op)) {
-                bool completed =
-                    tui_show_processing_dialog(state, &op, "Loading data...");
-
-                if (completed && op.state == ASYNC_STATE_COMPLETED &&
-                    op.result) {
-                  ResultSet *new_data = (ResultSet *)op.result;
-
-                  /* Check if we got 0 rows with approximate count */
-                  bool was_approximate = false;
-                  Tab *check_tab = TUI_TAB(state);
-                  if (check_tab) {
-                    was_approximate = check_tab->row_count_approximate;
-                  }
-
-                  if (new_data->num_rows == 0 && was_approximate &&
-                      load_offset > 0) {
-                    /* Approximate count was wrong - get exact count */
-                    db_result_free(new_data);
-                    async_free(&op);
-
-                    AsyncOperation count_op;
-                    async_init(&count_op);
-                    count_op.op_type = ASYNC_OP_COUNT_ROWS;
-                    count_op.conn = state->conn;
-                    count_op.table_name = str_dup(table);
-                    count_op.use_approximate = false; /* Force exact */
-
-                    if (count_op.table_name && async_start(&count_op)) {
-                      bool count_done = tui_show_processing_dialog(
-                          state, &count_op, "Counting rows (exact)...");
-                      if (count_done &&
-                          count_op.state == ASYNC_STATE_COMPLETED &&
-                          count_op.count > 0) {
-                        /* Update total rows with exact count */
-                        Tab *update_tab = TUI_TAB(state);
-                        if (update_tab) {
-                          update_tab->total_rows = (size_t)count_op.count;
-                          update_tab->row_count_approximate = false;
-                        }
-
-                        /* Clamp target row to actual data */
-                        size_t total = update_tab ? update_tab->total_rows : 0;
-                        if (target_row >= total) {
-                          target_row = total > 0 ? total - 1 : 0;
-                        }
-
-                        /* Recalculate load offset and reload */
-                        load_offset = target_row > PAGE_SIZE / 2
-                                          ? target_row - PAGE_SIZE / 2
-                                          : 0;
-
-                        /* Clean up count dialog and refresh before next dialog
-                         */
-                        async_free(&count_op);
-                        touchwin(stdscr);
-                        tui_refresh(state);
-
-                        /* Use tui_load_rows_at_with_dialog which handles edge
-                         * cases */
-                        if (tui_load_rows_at_with_dialog(state, load_offset)) {
-                          Tab *load_tab = TUI_TAB(state);
-                          if (load_tab) {
-                            load_tab->cursor_row =
-                                target_row - load_tab->loaded_offset;
-                            if (load_tab->cursor_row < load_tab->scroll_row) {
-                              load_tab->scroll_row = load_tab->cursor_row;
-                            } else if (load_tab->cursor_row >=
-                                       load_tab->scroll_row +
-                                           (size_t)state->content_rows) {
-                              load_tab->scroll_row =
-                                  load_tab->cursor_row - state->content_rows + 1;
-                            }
-                          }
-                        }
-                        tui_refresh(state);
-                        return;
-                      }
-                    }
-                    async_free(&count_op);
-                    tui_refresh(state);
-                    return;
-                  }
-
-                  /* Update tab directly */
-                  Tab *upd_tab = TUI_TAB(state);
-                  if (upd_tab) {
-                    /* Free old data but keep schema */
-                    if (upd_tab->data) {
-                      db_result_free(upd_tab->data);
-                    }
-                    upd_tab->data = new_data;
-                    upd_tab->loaded_offset = load_offset;
-                    upd_tab->loaded_count = new_data->num_rows;
-
-                    /* Apply schema column names */
-                    if (upd_tab->schema && upd_tab->data) {
-                      size_t min_cols = upd_tab->schema->num_columns;
-                      if (upd_tab->data->num_columns < min_cols) {
-                        min_cols = upd_tab->data->num_columns;
-                      }
-                      for (size_t i = 0; i < min_cols; i++) {
-                        if (upd_tab->schema->columns[i].name) {
-                          free(upd_tab->data->columns[i].name);
-                          upd_tab->data->columns[i].name =
-                              str_dup(upd_tab->schema->columns[i].name);
-                          upd_tab->data->columns[i].type =
-                              upd_tab->schema->columns[i].type;
-                        }
-                      }
-                    }
-
-                    /* Tab data is updated directly - no sync needed */
-                    load_succeeded = true;
-                  }
-                }
-              }
-              async_free(&op);
-
-              /* Only update cursor if load succeeded */
-              if (load_succeeded) {
-                Tab *cur_tab = TUI_TAB(state);
-                if (cur_tab && cur_tab->data) {
-                  /* Clamp cursor to actual loaded data if target was beyond */
-                  size_t actual_target = target_row - cur_tab->loaded_offset;
-                  if (actual_target >= cur_tab->data->num_rows) {
-                    actual_target = cur_tab->data->num_rows > 0
-                                        ? cur_tab->data->num_rows - 1
-                                        : 0;
-                  }
-                  cur_tab->cursor_row = actual_target;
-
-                  /* Adjust scroll */
-                  if (cur_tab->cursor_row < cur_tab->scroll_row) {
-                    cur_tab->scroll_row = cur_tab->cursor_row;
-                  } else if (cur_tab->cursor_row >=
-                             cur_tab->scroll_row + (size_t)state->content_rows) {
-                    cur_tab->scroll_row =
-                        cur_tab->cursor_row - state->content_rows + 1;
-                  }
-                }
-              }
-              /* If cancelled/failed, keep current view unchanged */
-            }
+            /* Loads the page around the row when it is not loaded yet */
+            tui_goto_row(state, target_row);
           }
 
           /* Dialog already closed, exit loop */
@@ -681,7 +505,11 @@ void tui_show_goto_dialog(TuiState *state) {
       break;
 
     default:
-      if (ch >= '0' && ch <= '9' && input_len < sizeof(input) - 1) {
+      /* Digits for a row number; any text after '=' for a key value */
+      if (input_len < max_input &&
+          ((ch >= '0' && ch <= '9') ||
+           (!is_query && ch >= 32 && ch < 127 &&
+            (input_len == 0 ? ch == '=' : input[0] == '=')))) {
         input[input_len++] = (char)ch;
         input[input_len] = '\0';
       }
@@ -1010,6 +838,7 @@ void tui_show_connect_dialog(TuiState *state) {
 
     /* Save current workspace state before switching */
     if (state->app->num_workspaces > 0) {
+      tui_cancel_background_load(state);
       tui_sync_to_workspace(state);
     }
 
@@ -1427,6 +1256,8 @@ bool tui_show_processing_dialog_ex(TuiState *state, AsyncOperation *op,
       if (dialog) {
         keypad(dialog, TRUE);
         wtimeout(dialog, POLL_INTERVAL_MS);
+        /* Dialog overlaps every region */
+        tui_mark_damage(state, TUI_DAMAGE_ALL);
       }
     }
 
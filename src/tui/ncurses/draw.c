@@ -12,6 +12,7 @@
 #include "../../config/config.h"
 #include "../../core/app_state.h"
 #include "../../db/connstr.h"
+#include "../../util/str.h"
 #include "render_helpers.h"
 #include "tui_internal.h"
 #include <stdlib.h>
@@ -25,6 +26,24 @@
  * ============================================================================
  */
 
+void tui_draw_cell_text(WINDOW *win, int y, int x, int width,
+                        const char *text) {
+  if (!win || width <= 0)
+    return;
+
+  size_t cols = 0;
+  size_t len = 0;
+  if (text)
+    len = str_display_prefix(text, strlen(text), (size_t)width, &cols);
+
+  wmove(win, y, x);
+  if (len > 0)
+    waddnstr(win, text, (int)len);
+  /* Pad the rest of the field (wide glyphs may leave a column short) */
+  if ((int)cols < width)
+    wprintw(win, "%*s", width - (int)cols, "");
+}
+
 /* Check if tab has active filters (filters that affect the query) */
 static bool has_active_filters(Tab *tab) {
   if (!tab || tab->filters.num_filters == 0)
@@ -53,6 +72,194 @@ static int grid_get_col_width(GridDrawParams *params, size_t col) {
  * ============================================================================
  */
 
+/* Window lines taken by the grid header: optional top border, column names,
+ * optional sort indicator row and the header separator */
+static int grid_header_lines(const GridDrawParams *params) {
+  int lines = 2;
+  if (params->show_header_line)
+    lines++;
+  if (params->num_sort_entries > 0 && params->sort_entries)
+    lines++;
+  return lines;
+}
+
+/* Draw one data row of a grid at window line y */
+static void grid_draw_row(TuiState *state, GridDrawParams *params, size_t row,
+                          int y) {
+  WINDOW *win = params->win;
+  ResultSet *data = params->data;
+  int max_x = params->start_x + params->width;
+
+  Row *r = &data->rows[row];
+  if (!r->cells)
+    return;
+
+  int x = params->start_x + 1;
+  bool is_cursor_row = (row == params->cursor_row) && params->is_focused;
+
+  /* Check if row is in selection set (for bulk operations) */
+  bool is_marked_row = false;
+  Tab *tab = state ? TUI_TAB(state) : NULL;
+  if (tab) {
+    size_t global_row = params->selection_offset + row;
+    is_marked_row = tab_is_row_selected(tab, global_row);
+  }
+
+  /* Determine effective schema for PK detection */
+  TableSchema *effective_schema = NULL;
+  if (tab && tab->type == TAB_TYPE_QUERY && tab->query_source_schema) {
+    effective_schema = tab->query_source_schema;
+  } else if (tab) {
+    effective_schema = tab->schema;
+  }
+
+  /* Apply row-level styling */
+  if (is_marked_row || is_cursor_row) {
+    wattron(win, A_BOLD);
+  }
+
+  for (size_t col = params->scroll_col;
+       col < data->num_columns && col < r->num_cells; col++) {
+    int width = grid_get_col_width(params, col);
+    if (x + width + 3 > max_x)
+      break;
+
+    bool is_selected = is_cursor_row && (col == params->cursor_col);
+    bool is_editing_cell = is_selected && params->is_editing;
+
+    if (is_editing_cell) {
+      /* Draw edit field with distinctive background */
+      wattron(win, COLOR_PAIR(COLOR_EDIT));
+      mvwhline(win, y, x, ' ', width);
+
+      /* Draw the edit buffer */
+      const char *buf = params->edit_buffer ? params->edit_buffer : "";
+      size_t buf_len = strlen(buf);
+
+      /* Calculate scroll for long text */
+      size_t scroll = 0;
+      if (params->edit_pos >= (size_t)(width - 1)) {
+        scroll = params->edit_pos - width + 2;
+      }
+
+      /* Draw visible portion of text */
+      size_t draw_len = buf_len > scroll ? buf_len - scroll : 0;
+      if (draw_len > (size_t)width)
+        draw_len = width;
+      if (draw_len > 0) {
+        mvwaddnstr(win, y, x, buf + scroll, (int)draw_len);
+      }
+
+      wattroff(win, COLOR_PAIR(COLOR_EDIT));
+
+      /* Draw cursor character with reverse video for visibility */
+      int cursor_x = x + (int)(params->edit_pos - scroll);
+      if (cursor_x >= x && cursor_x < x + width) {
+        char cursor_char =
+            (params->edit_pos < buf_len) ? buf[params->edit_pos] : ' ';
+        wattron(win, A_REVERSE | A_BOLD);
+        mvwaddch(win, y, cursor_x, cursor_char);
+        wattroff(win, A_REVERSE | A_BOLD);
+        wmove(win, y, cursor_x);
+      }
+    } else if (is_selected) {
+      /* Check if this column is a primary key */
+      bool is_pk_col = false;
+      if (effective_schema && col < effective_schema->num_columns) {
+        is_pk_col = effective_schema->columns[col].primary_key;
+      }
+
+      /* Use reverse video for PK on marked row to show white text */
+      if (is_pk_col && is_marked_row) {
+        wattron(win, A_REVERSE);
+      } else {
+        wattron(win, COLOR_PAIR(COLOR_SELECTED));
+      }
+
+      DbValue *val = &r->cells[col];
+      if (val->is_null) {
+        mvwprintw(win, y, x, "%-*s", width, "NULL");
+      } else {
+        char *str = db_value_to_string(val);
+        if (str) {
+          char *safe = tui_sanitize_for_display(str);
+          tui_draw_cell_text(win, y, x, width, safe ? safe : str);
+          free(safe);
+          free(str);
+        }
+      }
+
+      if (is_pk_col && is_marked_row) {
+        wattroff(win, A_REVERSE);
+      } else {
+        wattroff(win, COLOR_PAIR(COLOR_SELECTED));
+      }
+    } else {
+      DbValue *val = &r->cells[col];
+      /* Check if this column is a primary key */
+      bool is_pk_col = false;
+      if (effective_schema && col < effective_schema->num_columns) {
+        is_pk_col = effective_schema->columns[col].primary_key;
+      }
+
+      /* Patched by the last watch tick */
+      bool is_changed =
+          row_watch_changed(params->watch, params->selection_offset + row, col);
+
+      if (is_changed) {
+        wattron(win, COLOR_PAIR(COLOR_CHANGED));
+        char *str = val->is_null ? NULL : db_value_to_string(val);
+        char *safe = str ? tui_sanitize_for_display(str) : NULL;
+        tui_draw_cell_text(win, y, x, width,
+                           safe ? safe : (str ? str : "NULL"));
+        free(safe);
+        free(str);
+        wattroff(win, COLOR_PAIR(COLOR_CHANGED));
+      } else if (val->is_null) {
+        wattron(win, COLOR_PAIR(COLOR_NULL));
+        mvwprintw(win, y, x, "%-*s", width, "NULL");
+        wattroff(win, COLOR_PAIR(COLOR_NULL));
+      } else {
+        char *str = db_value_to_string(val);
+        if (str) {
+          char *safe = tui_sanitize_for_display(str);
+          if (is_pk_col && is_marked_row && is_cursor_row) {
+            /* White text for PK on cursor row - no color attr needed */
+          } else if (is_pk_col && is_marked_row) {
+            wattron(win, COLOR_PAIR(COLOR_ERROR_TEXT));
+          } else if (is_pk_col) {
+            wattron(win, COLOR_PAIR(COLOR_PK));
+          } else if (val->type == DB_TYPE_INT || val->type == DB_TYPE_FLOAT) {
+            wattron(win, COLOR_PAIR(COLOR_NUMBER));
+          }
+          tui_draw_cell_text(win, y, x, width, safe ? safe : str);
+          if (is_pk_col && is_marked_row && is_cursor_row) {
+            /* White text for PK on cursor row - no color attr needed */
+          } else if (is_pk_col && is_marked_row) {
+            wattroff(win, COLOR_PAIR(COLOR_ERROR_TEXT));
+          } else if (is_pk_col) {
+            wattroff(win, COLOR_PAIR(COLOR_PK));
+          } else if (val->type == DB_TYPE_INT || val->type == DB_TYPE_FLOAT) {
+            wattroff(win, COLOR_PAIR(COLOR_NUMBER));
+          }
+          free(safe);
+          free(str);
+        }
+      }
+    }
+
+    x += width + 1;
+    wattron(win, COLOR_PAIR(COLOR_BORDER));
+    mvwaddch(win, y, x - 1, ACS_VLINE);
+    wattroff(win, COLOR_PAIR(COLOR_BORDER));
+  }
+
+  /* Remove row-level styling */
+  if (is_marked_row || is_cursor_row) {
+    wattroff(win, A_BOLD);
+  }
+}
+
 /* Draw a result set grid - shared between table view and query results */
 void tui_draw_result_grid(TuiState *state, GridDrawParams *params) {
   if (!params || !params->win || !params->data ||
@@ -115,7 +322,7 @@ void tui_draw_result_grid(TuiState *state, GridDrawParams *params) {
     const char *name = data->columns[col].name;
 
     /* Draw column name at full width */
-    mvwprintw(win, y, x, "%-*.*s", width, width, name ? name : "");
+    tui_draw_cell_text(win, y, x, width, name);
 
     if (col == params->cursor_col && params->is_focused) {
       wattroff(win, A_REVERSE);
@@ -156,7 +363,7 @@ void tui_draw_result_grid(TuiState *state, GridDrawParams *params) {
           char sort_info[24];
           snprintf(sort_info, sizeof(sort_info), "%s %s, %d", arrow, dir_text,
                    (int)(i + 1));
-          mvwprintw(win, y, x, "%-*.*s", width, width, sort_info);
+          tui_draw_cell_text(win, y, x, width, sort_info);
           found = true;
           break;
         }
@@ -194,165 +401,27 @@ void tui_draw_result_grid(TuiState *state, GridDrawParams *params) {
 
   for (size_t row = params->scroll_row; row < data->num_rows && y < max_y;
        row++) {
+    grid_draw_row(state, params, row, y);
+    y++;
+  }
+}
 
-    Row *r = &data->rows[row];
-    if (!r->cells)
-      continue;
-
-    x = x_base + 1;
-    bool is_cursor_row = (row == params->cursor_row) && params->is_focused;
-
-    /* Check if row is in selection set (for bulk operations) */
-    bool is_marked_row = false;
-    Tab *tab = state ? TUI_TAB(state) : NULL;
-    if (tab) {
-      size_t global_row = params->selection_offset + row;
-      is_marked_row = tab_is_row_selected(tab, global_row);
-    }
-
-    /* Determine effective schema for PK detection */
-    TableSchema *effective_schema = NULL;
-    if (tab && tab->type == TAB_TYPE_QUERY && tab->query_source_schema) {
-      effective_schema = tab->query_source_schema;
-    } else if (tab) {
-      effective_schema = tab->schema;
-    }
-
-    /* Apply row-level styling */
-    if (is_marked_row || is_cursor_row) {
-      wattron(win, A_BOLD);
-    }
-
-    for (size_t col = params->scroll_col;
-         col < data->num_columns && col < r->num_cells; col++) {
-      int width = grid_get_col_width(params, col);
-      if (x + width + 3 > max_x)
-        break;
-
-      bool is_selected = is_cursor_row && (col == params->cursor_col);
-      bool is_editing_cell = is_selected && params->is_editing;
-
-      if (is_editing_cell) {
-        /* Draw edit field with distinctive background */
-        wattron(win, COLOR_PAIR(COLOR_EDIT));
-        mvwhline(win, y, x, ' ', width);
-
-        /* Draw the edit buffer */
-        const char *buf = params->edit_buffer ? params->edit_buffer : "";
-        size_t buf_len = strlen(buf);
-
-        /* Calculate scroll for long text */
-        size_t scroll = 0;
-        if (params->edit_pos >= (size_t)(width - 1)) {
-          scroll = params->edit_pos - width + 2;
-        }
-
-        /* Draw visible portion of text */
-        size_t draw_len = buf_len > scroll ? buf_len - scroll : 0;
-        if (draw_len > (size_t)width)
-          draw_len = width;
-        if (draw_len > 0) {
-          mvwaddnstr(win, y, x, buf + scroll, (int)draw_len);
-        }
-
-        wattroff(win, COLOR_PAIR(COLOR_EDIT));
-
-        /* Draw cursor character with reverse video for visibility */
-        int cursor_x = x + (int)(params->edit_pos - scroll);
-        if (cursor_x >= x && cursor_x < x + width) {
-          char cursor_char =
-              (params->edit_pos < buf_len) ? buf[params->edit_pos] : ' ';
-          wattron(win, A_REVERSE | A_BOLD);
-          mvwaddch(win, y, cursor_x, cursor_char);
-          wattroff(win, A_REVERSE | A_BOLD);
-          wmove(win, y, cursor_x);
-        }
-      } else if (is_selected) {
-        /* Check if this column is a primary key */
-        bool is_pk_col = false;
-        if (effective_schema && col < effective_schema->num_columns) {
-          is_pk_col = effective_schema->columns[col].primary_key;
-        }
-
-        /* Use reverse video for PK on marked row to show white text */
-        if (is_pk_col && is_marked_row) {
-          wattron(win, A_REVERSE);
-        } else {
-          wattron(win, COLOR_PAIR(COLOR_SELECTED));
-        }
-
-        DbValue *val = &r->cells[col];
-        if (val->is_null) {
-          mvwprintw(win, y, x, "%-*s", width, "NULL");
-        } else {
-          char *str = db_value_to_string(val);
-          if (str) {
-            char *safe = tui_sanitize_for_display(str);
-            mvwprintw(win, y, x, "%-*.*s", width, width, safe ? safe : str);
-            free(safe);
-            free(str);
-          }
-        }
-
-        if (is_pk_col && is_marked_row) {
-          wattroff(win, A_REVERSE);
-        } else {
-          wattroff(win, COLOR_PAIR(COLOR_SELECTED));
-        }
-      } else {
-        DbValue *val = &r->cells[col];
-        /* Check if this column is a primary key */
-        bool is_pk_col = false;
-        if (effective_schema && col < effective_schema->num_columns) {
-          is_pk_col = effective_schema->columns[col].primary_key;
-        }
-
-        if (val->is_null) {
-          wattron(win, COLOR_PAIR(COLOR_NULL));
-          mvwprintw(win, y, x, "%-*s", width, "NULL");
-          wattroff(win, COLOR_PAIR(COLOR_NULL));
-        } else {
-          char *str = db_value_to_string(val);
-          if (str) {
-            char *safe = tui_sanitize_for_display(str);
-            if (is_pk_col && is_marked_row && is_cursor_row) {
-              /* White text for PK on cursor row - no color attr needed */
-            } else if (is_pk_col && is_marked_row) {
-              wattron(win, COLOR_PAIR(COLOR_ERROR_TEXT));
-            } else if (is_pk_col) {
-              wattron(win, COLOR_PAIR(COLOR_PK));
-            } else if (val->type == DB_TYPE_INT || val->type == DB_TYPE_FLOAT) {
-              wattron(win, COLOR_PAIR(COLOR_NUMBER));
-            }
-            mvwprintw(win, y, x, "%-*.*s", width, width, safe ? safe : str);
-            if (is_pk_col && is_marked_row && is_cursor_row) {
-              /* White text for PK on cursor row - no color attr needed */
-            } else if (is_pk_col && is_marked_row) {
-              wattroff(win, COLOR_PAIR(COLOR_ERROR_TEXT));
-            } else if (is_pk_col) {
-              wattroff(win, COLOR_PAIR(COLOR_PK));
-            } else if (val->type == DB_TYPE_INT || val->type == DB_TYPE_FLOAT) {
-              wattroff(win, COLOR_PAIR(COLOR_NUMBER));
-            }
-            free(safe);
-            free(str);
-          }
-        }
-      }
-
-      x += width + 1;
-      wattron(win, COLOR_PAIR(COLOR_BORDER));
-      mvwaddch(win, y, x - 1, ACS_VLINE);
-      wattroff(win, COLOR_PAIR(COLOR_BORDER));
-    }
+/* Redraw a single data row in place, clearing the line first */
+void tui_draw_result_grid_row(TuiState *state, GridDrawParams *params,
+                              size_t row) {
+  if (!params || !params->win || !params->data || !params->data->rows ||
+      row < params->scroll_row)
+    return;
 
-    /* Remove row-level styling */
-    if (is_marked_row || is_cursor_row) {
-      wattroff(win, A_BOLD);
-    }
+  int y = params->start_y + grid_header_lines(params) +
+          (int)(row - params->scroll_row);
+  if (y >= params->start_y + params->height)
+    return;
 
-    y++;
-  }
+  wmove(params->win, y, params->start_x);
+  wclrtoeol(params->win);
+  if (row < params->data->num_rows)
+    grid_draw_row(state, params, row, y);
 }
 
 /* ============================================================================
@@ -423,7 +492,7 @@ void tui_draw_header(TuiState *state) {
     }
   }
 
-  wrefresh(state->header_win);
+  wnoutrefresh(state->header_win);
 }
 
 /* ============================================================================
@@ -492,7 +561,7 @@ static void draw_add_row_cell(WINDOW *win, int y, int x, int width,
       wattron(win, A_DIM);
       const DbValue *val = &state->new_row_values[col];
       char *str = db_value_to_string(val);
-      mvwprintw(win, y, x, "%-*.*s", width, width, str ? str : "");
+      tui_draw_cell_text(win, y, x, width, str);
       free(str);
       wattroff(win, A_DIM);
     } else {
@@ -503,7 +572,7 @@ static void draw_add_row_cell(WINDOW *win, int y, int x, int width,
         char *str = db_value_to_string(val);
         if (str) {
           char *safe = tui_sanitize_for_display(str);
-          mvwprintw(win, y, x, "%-*.*s", width, width, safe ? safe : str);
+          tui_draw_cell_text(win, y, x, width, safe ? safe : str);
           free(safe);
           free(str);
         }
@@ -522,7 +591,7 @@ static void draw_add_row_cell(WINDOW *win, int y, int x, int width,
       wattron(win, A_DIM);
       const DbValue *val = &state->new_row_values[col];
       char *str = db_value_to_string(val);
-      mvwprintw(win, y, x, "%-*.*s", width, width, str ? str : "");
+      tui_draw_cell_text(win, y, x, width, str);
       free(str);
       wattroff(win, A_DIM);
     } else {
@@ -535,7 +604,7 @@ static void draw_add_row_cell(WINDOW *win, int y, int x, int width,
         char *str = db_value_to_string(val);
         if (str) {
           char *safe = tui_sanitize_for_display(str);
-          mvwprintw(win, y, x, "%-*.*s", width, width, safe ? safe : str);
+          tui_draw_cell_text(win, y, x, width, safe ? safe : str);
           free(safe);
           free(str);
         }
@@ -602,6 +671,39 @@ static void tui_draw_add_row_overlay(TuiState *state, GridDrawParams *params) {
  * ============================================================================
  */
 
+/* Build grid parameters for the current table tab. Model data comes from
+ * Tab, view state from the TableWidget (source of truth). */
+static void table_grid_params(TuiState *state, Tab *tab, int filters_height,
+                              GridDrawParams *params) {
+  TableWidget *widget = TUI_TABLE_WIDGET(state);
+
+  int win_rows, win_cols;
+  getmaxyx(state->main_win, win_rows, win_cols);
+
+  *params = (GridDrawParams){
+      .win = state->main_win,
+      .start_y = filters_height,
+      .start_x = 0,
+      .height = win_rows - filters_height,
+      .width = win_cols,
+      .data = tab->data,
+      .col_widths = widget ? widget->col_widths : tab->col_widths,
+      .num_col_widths = widget ? widget->num_col_widths : tab->num_col_widths,
+      .cursor_row = widget ? widget->base.state.cursor_row : 0,
+      .cursor_col = widget ? widget->base.state.cursor_col : 0,
+      .scroll_row = widget ? widget->base.state.scroll_row : 0,
+      .scroll_col = widget ? widget->base.state.scroll_col : 0,
+      .selection_offset = widget ? widget->loaded_offset : 0,
+      .is_focused = !tui_sidebar_focused(state) && !tui_filters_focused(state),
+      .is_editing = state->editing,
+      .edit_buffer = state->edit_buffer,
+      .edit_pos = state->edit_pos,
+      .show_header_line = true,
+      .sort_entries = tab->sort_entries,
+      .num_sort_entries = tab->num_sort_entries,
+      .watch = tab->watch.enabled ? &tab->watch : NULL};
+}
+
 void tui_draw_table(TuiState *state) {
   if (!state || !state->main_win)
     return;
@@ -619,27 +721,13 @@ void tui_draw_table(TuiState *state) {
     tui_draw_filters_panel(state);
   }
 
-  /* Get tab for model data, widget for view state */
   Tab *tab = TUI_TAB(state);
-  TableWidget *widget = TUI_TABLE_WIDGET(state);
   if (!tab)
     return;
 
   /* Read model data from Tab */
   ResultSet *data = tab->data;
 
-  /* Read view state from TableWidget (source of truth) */
-  int *col_widths = widget ? widget->col_widths : tab->col_widths;
-  size_t num_col_widths = widget ? widget->num_col_widths : tab->num_col_widths;
-  size_t cursor_row = widget ? widget->base.state.cursor_row : 0;
-  size_t cursor_col = widget ? widget->base.state.cursor_col : 0;
-  size_t scroll_row = widget ? widget->base.state.scroll_row : 0;
-  size_t scroll_col = widget ? widget->base.state.scroll_col : 0;
-
-  bool is_editing = state->editing;
-  char *edit_buffer = state->edit_buffer;
-  size_t edit_pos = state->edit_pos;
-
   /* Check if there's a table error (e.g., table doesn't exist) */
   if (tab && tab->table_error) {
     int center_y = filters_height + (win_rows - filters_height) / 2;
@@ -662,39 +750,20 @@ void tui_draw_table(TuiState *state) {
     mvwprintw(state->main_win, center_y + 2, (win_cols - (int)strlen(hint)) / 2,
               "%s", hint);
     wattroff(state->main_win, A_DIM);
-    wrefresh(state->main_win);
+    wnoutrefresh(state->main_win);
     return;
   }
 
   if (!data || data->num_columns == 0 || !data->columns) {
     int msg_y = filters_height + (win_rows - filters_height) / 2;
     mvwprintw(state->main_win, msg_y, (win_cols - 7) / 2, "No data");
-    wrefresh(state->main_win);
+    wnoutrefresh(state->main_win);
     return;
   }
 
   /* Use the shared grid drawing function */
-  GridDrawParams params = {.win = state->main_win,
-                           .start_y = filters_height,
-                           .start_x = 0,
-                           .height = win_rows - filters_height,
-                           .width = win_cols,
-                           .data = data,
-                           .col_widths = col_widths,
-                           .num_col_widths = num_col_widths,
-                           .cursor_row = cursor_row,
-                           .cursor_col = cursor_col,
-                           .scroll_row = scroll_row,
-                           .scroll_col = scroll_col,
-                           .selection_offset = widget ? widget->loaded_offset : 0,
-                           .is_focused = !tui_sidebar_focused(state) &&
-                                         !tui_filters_focused(state),
-                           .is_editing = is_editing,
-                           .edit_buffer = edit_buffer,
-                           .edit_pos = edit_pos,
-                           .show_header_line = true,
-                           .sort_entries = tab ? tab->sort_entries : NULL,
-                           .num_sort_entries = tab ? tab->num_sort_entries : 0};
+  GridDrawParams params;
+  table_grid_params(state, tab, filters_height, &params);
 
   tui_draw_result_grid(state, &params);
 
@@ -704,7 +773,58 @@ void tui_draw_table(TuiState *state) {
     tui_draw_add_row_overlay(state, &params);
   }
 
-  wrefresh(state->main_win);
+  wnoutrefresh(state->main_win);
+}
+
+/* Patch the table grid in place after a pure cursor/scroll move: shift the
+ * data rows by one line with wscrl and redraw only the exposed row and the
+ * old and new cursor rows. Returns false when a full redraw is needed. */
+bool tui_draw_table_partial(TuiState *state, const TuiFrame *prev) {
+  if (!state || !state->main_win || !prev || !prev->valid)
+    return false;
+
+  Tab *tab = TUI_TAB(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || tab->table_error ||
+      state->adding_row || !tab->data || !tab->data->rows ||
+      tab->data->num_columns == 0)
+    return false;
+
+  int filters_height =
+      state->filters_visible ? tui_get_filters_panel_height(state) : 0;
+
+  GridDrawParams params;
+  table_grid_params(state, tab, filters_height, &params);
+
+  int data_y = params.start_y + grid_header_lines(&params);
+  int data_rows = params.start_y + params.height - data_y;
+  if (data_rows < 2)
+    return false;
+
+  long delta = (long)params.scroll_row - (long)prev->scroll_row;
+  if (delta < -1 || delta > 1)
+    return false;
+
+  WINDOW *win = state->main_win;
+  if (delta != 0) {
+    /* Scroll only the data region; header lines stay put */
+    idlok(win, TRUE);
+    wsetscrreg(win, data_y, data_y + data_rows - 1);
+    scrollok(win, TRUE);
+    wscrl(win, (int)delta);
+    scrollok(win, FALSE);
+    wsetscrreg(win, 0, getmaxy(win) - 1);
+
+    size_t exposed = delta > 0 ? params.scroll_row + (size_t)data_rows - 1
+                               : params.scroll_row;
+    tui_draw_result_grid_row(state, &params, exposed);
+  }
+
+  if (prev->cursor_row != params.cursor_row)
+    tui_draw_result_grid_row(state, &params, prev->cursor_row);
+  tui_draw_result_grid_row(state, &params, params.cursor_row);
+
+  wnoutrefresh(win);
+  return true;
 }
 
 /* ============================================================================
@@ -784,7 +904,7 @@ void tui_draw_connection_tab(TuiState *state) {
   mvwprintw(state->main_win, center_y + 5, hint2_x, "%s", hint2);
   wattroff(state->main_win, A_DIM);
 
-  wrefresh(state->main_win);
+  wnoutrefresh(state->main_win);
 }
 
 /* ============================================================================
@@ -960,6 +1080,32 @@ void tui_draw_status(TuiState *state) {
     wattroff(state->status_win, A_BOLD);
   }
 
+  /* Watch mode */
+  if (tab && tab->type == TAB_TYPE_TABLE && tab->watch.enabled) {
+    const char *watching = "[Watch]";
+    int watching_len = (int)strlen(watching);
+    right_pos -= watching_len + 1;
+    mvwprintw(state->status_win, 0, right_pos + 1, "%s", watching);
+  }
+
+  /* Query results answered from the result cache, not the database */
+  if (query_results_active && tab->query_results_cached) {
+    const char *cached = "[Cached]";
+    int cached_len = (int)strlen(cached);
+    right_pos -= cached_len + 1;
+    mvwprintw(state->status_win, 0, right_pos + 1, "%s", cached);
+  }
+
+  /* Marked rows (bulk operations) */
+  size_t num_selected = tab_selection_count(tab);
+  if (num_selected > 0) {
+    char sel[48];
+    snprintf(sel, sizeof(sel), "[%zu selected]", num_selected);
+    int sel_len = (int)strlen(sel);
+    right_pos -= sel_len + 1;
+    mvwprintw(state->status_win, 0, right_pos + 1, "%s", sel);
+  }
+
   if (query_results_active) {
     /* Query results row position */
     char pos[64];
@@ -998,7 +1144,7 @@ void tui_draw_status(TuiState *state) {
     wattroff(state->status_win, COLOR_PAIR(COLOR_ERROR_TEXT));
   }
 
-  wrefresh(state->status_win);
+  wnoutrefresh(state->status_win);
 }
 
 /* ============================================================================
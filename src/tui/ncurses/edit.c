@@ -260,6 +260,328 @@ void tui_cancel_edit(TuiState *state) {
   curs_set(0); /* Hide cursor */
 }
 
+/* ============================================================================
+ * Predicate-based bulk operations
+ *
+ * When the selection is the symbolic "all rows matching the current
+ * filters", deletes and cell updates are compiled from the filter panel into
+ * a single DELETE/UPDATE ... WHERE statement instead of one statement per
+ * row.
+ * ============================================================================
+ */
+
+/* True if the tab's selection covers every row matching its filters */
+static bool selection_is_all_matching(Tab *tab) {
+  return tab && tab->type == TAB_TYPE_TABLE && tab->table_name &&
+         row_set_is_all(&tab->selection);
+}
+
+/* Count rows matching where_clause with a progress dialog.
+ * Returns -1 on error or cancel (status already set). */
+static int64_t count_matching_rows(TuiState *state, DbConnection *conn,
+                                   const char *table,
+                                   const char *where_clause) {
+  AsyncOperation op;
+  async_init(&op);
+  op.op_type = ASYNC_OP_COUNT_ROWS_WHERE;
+  op.conn = conn;
+  op.table_name = str_dup(table);
+  op.where_clause = where_clause ? str_dup(where_clause) : NULL;
+
+  int64_t count = -1;
+  if (op.table_name && async_start(&op)) {
+    bool completed =
+        tui_show_processing_dialog(state, &op, "Counting matching rows...");
+    if (completed && op.state == ASYNC_STATE_COMPLETED) {
+      count = op.count;
+    } else if (op.state == ASYNC_STATE_CANCELLED) {
+      tui_set_status(state, "Operation cancelled");
+    } else {
+      tui_set_error(state, "Count failed: %s",
+                    op.error ? op.error : "unknown error");
+    }
+  }
+  async_free(&op);
+  return count;
+}
+
+/* Run sql in its own transaction with a progress dialog. Takes ownership of
+ * sql. Returns affected rows, or -1 on error or cancel (status already set). */
+static int64_t exec_matching_rows(TuiState *state, DbConnection *conn,
+                                  char *sql, const char *message) {
+  AsyncOperation op;
+  async_init(&op);
+  op.op_type = ASYNC_OP_EXEC_TRANSACTION;
+  op.conn = conn;
+  op.sql = sql;
+
+  int64_t affected = -1;
+  if (async_start(&op)) {
+    bool completed = tui_show_processing_dialog(state, &op, message);
+    if (completed && op.state == ASYNC_STATE_COMPLETED) {
+      affected = op.count;
+    } else if (op.state == ASYNC_STATE_CANCELLED) {
+      tui_set_status(state, "Operation cancelled, changes rolled back");
+    } else {
+      tui_set_error(state, "Bulk operation failed: %s",
+                    op.error ? op.error : "unknown error");
+    }
+  }
+  async_free(&op);
+  return affected;
+}
+
+/* Delete (col_name == NULL) or set col_name to new_val in every row matching
+ * the current filters */
+static void apply_to_matching_rows(TuiState *state, Tab *tab,
+                                   const char *col_name,
+                                   const DbValue *new_val) {
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn || !tab->schema)
+    return;
+
+  char *err = NULL;
+  char *where = filters_build_where(&tab->filters, tab->schema,
+                                    conn->driver->name, &err);
+  if (err) {
+    tui_set_error(state, "Invalid filter: %s", err);
+    free(err);
+    free(where);
+    return;
+  }
+
+  /* Preview: how many rows the statement will touch */
+  int64_t matching = count_matching_rows(state, conn, tab->table_name, where);
+  if (matching < 0) {
+    free(where);
+    return;
+  }
+  if (matching == 0) {
+    tui_set_status(state, "No rows match the current filters");
+    free(where);
+    return;
+  }
+
+  const char *scope = where ? "matching filters" : "in table";
+  char msg[160];
+  if (col_name) {
+    char *val_str = new_val->is_null ? NULL : db_value_to_string(new_val);
+    snprintf(msg, sizeof(msg), "Set %s to %s%.24s%s in %lld rows %s?",
+             col_name, val_str ? "'" : "", val_str ? val_str : "NULL",
+             val_str ? "'" : "", (long long)matching, scope);
+    free(val_str);
+  } else {
+    snprintf(msg, sizeof(msg), "Delete %lld rows %s?", (long long)matching,
+             scope);
+  }
+  /* Always confirm: these statements are not limited to loaded rows */
+  if (!tui_show_confirm_dialog(state, msg)) {
+    tui_set_status(state, col_name ? "Update cancelled" : "Delete cancelled");
+    free(where);
+    return;
+  }
+
+  char *sql = col_name ? db_build_update_where(conn, tab->table_name,
+                                               col_name, new_val, where, &err)
+                       : db_build_delete_where(conn, tab->table_name, where,
+                                               &err);
+  free(where);
+  if (!sql) {
+    tui_set_error(state, "%s", err ? err : "Out of memory");
+    free(err);
+    return;
+  }
+
+  int64_t affected = exec_matching_rows(
+      state, conn, sql, col_name ? "Updating rows..." : "Deleting rows...");
+  if (affected < 0)
+    return;
+
+  tab_clear_selections(tab);
+  app_mark_table_tabs_dirty(state->app, tab->connection_index,
+                            tab->table_name, tab);
+  tui_refresh_table(state);
+
+  tui_set_status(state, col_name ? "%lld rows updated" : "%lld rows deleted",
+                 (long long)affected);
+}
+
+/* ============================================================================
+ * Batched multi-cell updates
+ * ============================================================================
+ */
+
+/* Apply updates to the table tab in one batched transaction. rows lists the
+ * distinct local rows addressed by each update's pk_index. Takes ownership
+ * of updates. Returns false (with error status set) on failure. */
+static bool commit_cell_updates(TuiState *state, Tab *tab, const size_t *rows,
+                                size_t num_rows, CellUpdate *updates,
+                                size_t count, int64_t *affected) {
+  VmTable *vm = tui_vm_table(state);
+  DbConnection *conn = vm ? vm_table_connection(vm) : NULL;
+  const char *table = vm ? vm_table_name(vm) : NULL;
+  const TableSchema *schema = vm ? vm_table_schema(vm) : NULL;
+  if (!conn || !table || !schema || !tab->data || num_rows == 0) {
+    tui_cell_updates_free(updates, count);
+    return false;
+  }
+
+  /* Gather primary keys for every touched row */
+  PkInfo first = {0};
+  DbValue *pk_vals = NULL;
+  size_t num_pk = 0;
+  size_t built = 0;
+  bool ok = true;
+  for (size_t r = 0; r < num_rows; r++) {
+    PkInfo pk = {0};
+    if (!pk_info_build(&pk, tab->data, rows[r], (TableSchema *)schema)) {
+      tui_set_error(state, "Cannot update: no primary key found");
+      ok = false;
+      break;
+    }
+    if (r == 0) {
+      num_pk = pk.count;
+      pk_vals = safe_calloc(num_rows * num_pk, sizeof(DbValue));
+    }
+    /* Move key values into the flat array */
+    memcpy(&pk_vals[r * num_pk], pk.values, num_pk * sizeof(DbValue));
+    free(pk.values);
+    pk.values = NULL;
+    built++;
+    if (r == 0)
+      first = pk; /* Keep column names */
+    else
+      pk_info_free(&pk);
+  }
+
+  if (ok) {
+    char *err = NULL;
+    ok = tui_apply_cell_updates(conn, table, first.col_names, num_pk, pk_vals,
+                                tab->data, tab->col_stats, tab->num_col_widths,
+                                updates, count, affected, &err);
+    if (!ok) {
+      tui_set_error(state, "Update failed (rolled back): %s",
+                    err ? err : "unknown error");
+      free(err);
+    } else {
+      app_mark_table_tabs_dirty(state->app, tab->connection_index, table, tab);
+    }
+  }
+
+  for (size_t i = 0; i < built * num_pk; i++)
+    db_value_free(&pk_vals[i]);
+  free(pk_vals);
+  pk_info_free(&first);
+  tui_cell_updates_free(updates, count);
+  return ok;
+}
+
+/* Set col to val in every selected row that is loaded */
+static void set_selected_rows(TuiState *state, Tab *tab, size_t col,
+                              const DbValue *val) {
+  ResultSet *data = tab->data;
+  if (!data || col >= data->num_columns)
+    return;
+
+  size_t *rows = safe_malloc(data->num_rows * sizeof(size_t));
+  size_t num_rows = 0;
+  for (size_t r = 0; r < data->num_rows; r++) {
+    if (tab_is_row_selected(tab, tab->loaded_offset + r))
+      rows[num_rows++] = r;
+  }
+  size_t skipped = tab_selection_count(tab) - num_rows;
+  if (num_rows == 0) {
+    tui_set_error(state, "Selected rows are not loaded");
+    free(rows);
+    return;
+  }
+
+  char msg[128];
+  snprintf(msg, sizeof(msg), "Set %s in %zu selected rows?",
+           data->columns[col].name ? data->columns[col].name : "column",
+           num_rows);
+  if (!tui_show_confirm_dialog(state, msg)) {
+    tui_set_status(state, "Update cancelled");
+    free(rows);
+    return;
+  }
+
+  CellUpdate *updates = safe_calloc(num_rows, sizeof(CellUpdate));
+  for (size_t i = 0; i < num_rows; i++) {
+    updates[i].row = rows[i];
+    updates[i].col = col;
+    updates[i].pk_index = i;
+    updates[i].value = db_value_copy(val);
+  }
+
+  int64_t affected = 0;
+  if (commit_cell_updates(state, tab, rows, num_rows, updates, num_rows,
+                          &affected)) {
+    if (skipped > 0)
+      tui_set_status(state, "%lld rows updated, %zu selected rows not loaded",
+                     (long long)affected, skipped);
+    else
+      tui_set_status(state, "%lld rows updated", (long long)affected);
+  }
+  free(rows);
+}
+
+/* Paste a prows x pcols block with its top-left corner at the cursor.
+ * Returns false if the user declined the block paste. */
+static bool paste_block(TuiState *state, Tab *tab, char **fields,
+                        size_t prows, size_t pcols, size_t cursor_row,
+                        size_t cursor_col) {
+  ResultSet *data = tab->data;
+  if (!data || cursor_row >= data->num_rows ||
+      cursor_col >= data->num_columns)
+    return true;
+
+  /* Clip to the loaded rows and existing columns */
+  size_t nrows = prows;
+  size_t ncols = pcols;
+  if (nrows > data->num_rows - cursor_row)
+    nrows = data->num_rows - cursor_row;
+  if (ncols > data->num_columns - cursor_col)
+    ncols = data->num_columns - cursor_col;
+  bool clipped = nrows < prows || ncols < pcols;
+
+  char msg[128];
+  if (pcols == 1)
+    snprintf(msg, sizeof(msg), "Paste %zu lines into %zu row%s%s?", prows,
+             nrows, nrows == 1 ? "" : "s", clipped ? " (clipped)" : "");
+  else
+    snprintf(msg, sizeof(msg), "Paste %zu row%s x %zu column%s%s?", nrows,
+             nrows == 1 ? "" : "s", ncols, ncols == 1 ? "" : "s",
+             clipped ? " (clipped)" : "");
+  if (!tui_show_confirm_dialog(state, msg))
+    return false;
+
+  size_t *rows = safe_malloc(nrows * sizeof(size_t));
+  CellUpdate *updates = safe_calloc(nrows * ncols, sizeof(CellUpdate));
+  size_t count = 0;
+  for (size_t r = 0; r < nrows; r++) {
+    rows[r] = cursor_row + r;
+    for (size_t c = 0; c < ncols; c++) {
+      const char *field = fields[r * pcols + c];
+      CellUpdate *u = &updates[count++];
+      u->row = cursor_row + r;
+      u->col = cursor_col + c;
+      u->pk_index = r;
+      /* Empty field = NULL, as for single-cell paste */
+      u->value = (field && *field) ? db_value_text(field) : db_value_null();
+    }
+  }
+
+  int64_t affected = 0;
+  if (commit_cell_updates(state, tab, rows, nrows, updates, count,
+                          &affected)) {
+    tui_set_status(state, "Pasted %zu cells into %zu rows%s", count, nrows,
+                   clipped ? " (block clipped to loaded data)" : "");
+  }
+  free(rows);
+  return true;
+}
+
 /* Confirm edit and update database */
 void tui_confirm_edit(TuiState *state) {
   if (!state || !state->editing) {
@@ -286,8 +608,35 @@ void tui_confirm_edit(TuiState *state) {
   size_t cursor_row, cursor_col;
   vm_table_get_cursor(vm, &cursor_row, &cursor_col);
 
-  /* Build primary key info - use Tab as authoritative data source */
   Tab *tab = TUI_TAB(state);
+
+  /* All rows matching filters selected: one UPDATE ... WHERE */
+  if (selection_is_all_matching(tab)) {
+    const char *bulk_col = vm_table_column_name(vm, cursor_col);
+    DbValue bulk_val = (state->edit_buffer == NULL ||
+                        state->edit_buffer[0] == '\0')
+                           ? db_value_null()
+                           : db_value_text(state->edit_buffer);
+    tui_cancel_edit(state);
+    if (bulk_col)
+      apply_to_matching_rows(state, tab, bulk_col, &bulk_val);
+    db_value_free(&bulk_val);
+    return;
+  }
+
+  /* Rows selected: set the value in all of them in one transaction */
+  if (tab_selection_count(tab) > 0) {
+    DbValue sel_val = (state->edit_buffer == NULL ||
+                       state->edit_buffer[0] == '\0')
+                          ? db_value_null()
+                          : db_value_text(state->edit_buffer);
+    tui_cancel_edit(state);
+    set_selected_rows(state, tab, cursor_col, &sel_val);
+    db_value_free(&sel_val);
+    return;
+  }
+
+  /* Build primary key info - use Tab as authoritative data source */
   ResultSet *data = tab ? tab->data : NULL;
   PkInfo pk = {0};
   if (!pk_info_build(&pk, data, cursor_row, (TableSchema *)schema)) {
@@ -325,7 +674,11 @@ void tui_confirm_edit(TuiState *state) {
     if (data && cursor_row < data->num_rows &&
         data->rows && data->rows[cursor_row].cells &&
         cursor_col < data->rows[cursor_row].num_cells) {
+      db_row_own(&data->rows[cursor_row]); /* Fork a shared page's row */
       DbValue *cell = &data->rows[cursor_row].cells[cursor_col];
+      if (tab && tab->col_stats && cursor_col < tab->num_col_widths) {
+        col_stats_replace_value(&tab->col_stats[cursor_col], cell, &new_val);
+      }
       db_value_free(cell);
       *cell = new_val;
     } else {
@@ -370,8 +723,27 @@ void tui_set_cell_direct(TuiState *state, bool set_null) {
   if (cursor_row >= num_rows || cursor_col >= num_cols)
     return;
 
-  /* Build primary key info - use Tab as authoritative data source */
   Tab *tab = TUI_TAB(state);
+
+  /* All rows matching filters selected: one UPDATE ... WHERE */
+  if (selection_is_all_matching(tab)) {
+    const char *bulk_col = vm_table_column_name(vm, cursor_col);
+    DbValue bulk_val = set_null ? db_value_null() : db_value_text("");
+    if (bulk_col)
+      apply_to_matching_rows(state, tab, bulk_col, &bulk_val);
+    db_value_free(&bulk_val);
+    return;
+  }
+
+  /* Rows selected: set the value in all of them in one transaction */
+  if (tab_selection_count(tab) > 0) {
+    DbValue sel_val = set_null ? db_value_null() : db_value_text("");
+    set_selected_rows(state, tab, cursor_col, &sel_val);
+    db_value_free(&sel_val);
+    return;
+  }
+
+  /* Build primary key info - use Tab as authoritative data source */
   ResultSet *data = tab ? tab->data : NULL;
   PkInfo pk = {0};
   if (!pk_info_build(&pk, data, cursor_row, (TableSchema *)schema)) {
@@ -400,7 +772,11 @@ void tui_set_cell_direct(TuiState *state, bool set_null) {
     if (data && cursor_row < data->num_rows &&
         data->rows && data->rows[cursor_row].cells &&
         cursor_col < data->rows[cursor_row].num_cells) {
+      db_row_own(&data->rows[cursor_row]); /* Fork a shared page's row */
       DbValue *cell = &data->rows[cursor_row].cells[cursor_col];
+      if (tab && tab->col_stats && cursor_col < tab->num_col_widths) {
+        col_stats_replace_value(&tab->col_stats[cursor_col], cell, &new_val);
+      }
       db_value_free(cell);
       *cell = new_val;
     } else {
@@ -582,8 +958,43 @@ void tui_cell_paste(TuiState *state) {
     return;
   }
 
-  /* Build primary key info - use Tab as authoritative data source */
   Tab *tab = TUI_TAB(state);
+
+  /* Tab-separated or multi-line text pastes as a block at the cursor */
+  size_t prows = 0, pcols = 0;
+  char **fields = tab ? tui_parse_tsv(paste_text, &prows, &pcols) : NULL;
+  bool is_block = fields && (pcols > 1 || prows > 1);
+  if (is_block &&
+      !paste_block(state, tab, fields, prows, pcols, cursor_row, cursor_col)) {
+    /* Declined lines without tabs paste as one multi-line value */
+    if (pcols > 1)
+      tui_set_status(state, "Paste cancelled");
+    else
+      is_block = false;
+  }
+  tui_free_tsv(fields, prows * pcols);
+  if (is_block) {
+    free(paste_text);
+    return;
+  }
+
+  /* Single value with rows selected: set it in all of them */
+  if (tab && tab_selection_count(tab) > 0) {
+    DbValue sel_val =
+        paste_text[0] ? db_value_text(paste_text) : db_value_null();
+    if (selection_is_all_matching(tab)) {
+      const char *bulk_col = vm_table_column_name(vm, cursor_col);
+      if (bulk_col)
+        apply_to_matching_rows(state, tab, bulk_col, &sel_val);
+    } else {
+      set_selected_rows(state, tab, cursor_col, &sel_val);
+    }
+    db_value_free(&sel_val);
+    free(paste_text);
+    return;
+  }
+
+  /* Build primary key info - use Tab as authoritative data source */
   ResultSet *data = tab ? tab->data : NULL;
   PkInfo pk = {0};
   if (!pk_info_build(&pk, data, cursor_row, (TableSchema *)schema)) {
@@ -620,7 +1031,11 @@ void tui_cell_paste(TuiState *state) {
     if (data && cursor_row < data->num_rows &&
         data->rows && data->rows[cursor_row].cells &&
         cursor_col < data->rows[cursor_row].num_cells) {
+      db_row_own(&data->rows[cursor_row]); /* Fork a shared page's row */
       DbValue *cell = &data->rows[cursor_row].cells[cursor_col];
+      if (tab && tab->col_stats && cursor_col < tab->num_col_widths) {
+        col_stats_replace_value(&tab->col_stats[cursor_col], cell, &new_val);
+      }
       db_value_free(cell);
       *cell = new_val;
     } else {
@@ -698,8 +1113,14 @@ void tui_delete_row(TuiState *state) {
   if (cursor_row >= num_rows)
     return;
 
+  /* All rows matching filters selected: one DELETE ... WHERE */
+  if (selection_is_all_matching(tab)) {
+    apply_to_matching_rows(state, tab, NULL, NULL);
+    return;
+  }
+
   /* Check if we have selected rows for bulk delete */
-  size_t num_selected = tab->num_selected;
+  size_t num_selected = tab_selection_count(tab);
   bool bulk_delete = (num_selected > 0);
   size_t rows_to_delete = bulk_delete ? num_selected : 1;
 
@@ -727,43 +1148,17 @@ void tui_delete_row(TuiState *state) {
   size_t failed_count = 0;
 
   if (bulk_delete) {
-    /* Delete selected rows - iterate in reverse to avoid index shifting issues
-     */
-    /* First, collect global indices and sort in descending order */
-    /* Check for overflow before allocation */
-    if (num_selected > SIZE_MAX / sizeof(size_t)) {
-      tui_set_error(state, "Too many rows selected");
-      return;
-    }
-    size_t *to_delete = safe_malloc(num_selected * sizeof(size_t));
-    memcpy(to_delete, tab->selected_rows, num_selected * sizeof(size_t));
-
-    /* Sort descending so we delete from highest index first */
-    for (size_t i = 0; i < num_selected - 1; i++) {
-      for (size_t j = i + 1; j < num_selected; j++) {
-        if (to_delete[j] > to_delete[i]) {
-          size_t tmp = to_delete[i];
-          to_delete[i] = to_delete[j];
-          to_delete[j] = tmp;
-        }
-      }
-    }
-
-    /* Delete each selected row */
-    for (size_t i = 0; i < num_selected; i++) {
-      size_t global_row = to_delete[i];
-
-      /* Check if this row is in the currently loaded data */
-      /* Overflow-safe check: global_row >= loaded_offset + num_rows
-       * becomes: global_row - loaded_offset >= num_rows (since global_row >= loaded_offset) */
-      if (global_row < loaded_offset ||
-          (global_row - loaded_offset) >= num_rows) {
-        /* Row not loaded - would need to load it first, skip for now */
-        failed_count++;
+    /* Delete selected loaded rows, highest index first so deleting one
+     * does not shift the local index of rows still to visit. Selected rows
+     * outside the loaded window would need loading first and are counted
+     * as failed. */
+    size_t visited = 0;
+    for (size_t i = num_rows; i > 0; i--) {
+      size_t local_row = i - 1;
+      if (!tab_is_row_selected(tab, loaded_offset + local_row))
         continue;
-      }
+      visited++;
 
-      size_t local_row = global_row - loaded_offset;
       char *err = NULL;
       if (delete_single_row(state, local_row, &err)) {
         deleted_count++;
@@ -774,8 +1169,7 @@ void tui_delete_row(TuiState *state) {
         free(err);
       }
     }
-
-    free(to_delete);
+    failed_count += num_selected - visited;
 
     /* Clear selections after bulk delete */
     tab_clear_selections(tab);
@@ -821,7 +1215,8 @@ void tui_delete_row(TuiState *state) {
         abs_row = total_rows - 1;
     }
 
-    size_t target_offset = (abs_row / PAGE_SIZE) * PAGE_SIZE;
+    size_t page_rows = tui_page_rows(state);
+    size_t target_offset = (abs_row / page_rows) * page_rows;
     tui_load_rows_at(state, target_offset);
 
     /* Re-read state after reload */
@@ -92,7 +92,8 @@ void tui_draw_filters_panel(TuiState *state) {
   int op_x = start_x + 17;
   int val_x = start_x + 31;
   int del_x = panel_width - 4;
-  int val_width = del_x - val_x - 1; /* Dynamic width to fill available space */
+  int badge_x = del_x - 5;
+  int val_width = badge_x - val_x - 1; /* Fill available space */
   if (val_width < 10)
     val_width = 10;
   if (val_width > 255)
@@ -132,6 +133,9 @@ void tui_draw_filters_panel(TuiState *state) {
 
   int y = start_y + 1;
 
+  DbConnection *conn = TUI_CONN(state);
+  const char *driver = conn && conn->driver ? conn->driver->name : NULL;
+
   /* Draw filter rows */
   size_t visible_start = state->filters_scroll;
   size_t visible_count = f->num_filters - visible_start;
@@ -270,6 +274,16 @@ void tui_draw_filters_panel(TuiState *state) {
       }
     }
 
+    /* Whether an index serves the filter, or every row gets read */
+    FilterIndexUse use = filter_index_use(cf, tab->schema, driver);
+    if (use == FILTER_INDEX_USED) {
+      WITH_ATTR(state->main_win, A_DIM,
+                mvwprintw(state->main_win, y, badge_x, "idx"));
+    } else if (use == FILTER_INDEX_SCAN) {
+      WITH_ATTR(state->main_win, A_BOLD,
+                mvwprintw(state->main_win, y, badge_x, "scan"));
+    }
+
     /* Delete button - column 3 for regular ops, column 4 for BETWEEN */
     int del_col = is_between ? 4 : 3;
     if (row_selected && state->filters_cursor_col == (size_t)del_col)
@@ -479,7 +493,7 @@ static int show_operator_dropdown(TuiState *state, FilterOperator current_op,
       max_width = len;
   }
 
-  int width = max_width + 6;
+  int width = max_width + 10; /* Room for the "idx" mark */
   if (width < 18)
     width = 18;
 
@@ -517,8 +531,19 @@ static int show_operator_dropdown(TuiState *state, FilterOperator current_op,
   /* Create menu items (exclude RAW) */
   ITEM **items = safe_calloc(FILTER_OP_VISIBLE + 1, sizeof(ITEM *));
 
+  /* Mark the operators an index on the filter's column serves */
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  size_t col = tab && filter_row < tab->filters.num_filters
+                   ? tab->filters.filters[filter_row].column_index
+                   : SIZE_MAX;
   for (int i = 0; i < FILTER_OP_VISIBLE; i++) {
-    items[i] = new_item(filter_op_name((FilterOperator)i), "");
+    bool indexed =
+        tab && conn && conn->driver &&
+        filter_op_uses_index((FilterOperator)i, col, tab->schema,
+                             conn->driver->name);
+    items[i] =
+        new_item(filter_op_name((FilterOperator)i), indexed ? "idx" : "");
   }
   items[FILTER_OP_VISIBLE] = NULL;
 
@@ -627,6 +652,21 @@ static int show_operator_dropdown(TuiState *state, FilterOperator current_op,
   return result;
 }
 
+/* Start editing a filter's value. A pasted list too long for the edit
+ * buffer can only be replaced. */
+static void start_value_edit(TuiState *state, const ColumnFilter *cf) {
+  if (cf->long_value) {
+    tui_set_status(state, "List too long to edit - paste (v) or type to "
+                          "replace it");
+    return;
+  }
+  state->filters_editing = true;
+  strncpy(state->filters_edit_buffer, cf->value,
+          sizeof(state->filters_edit_buffer) - 1);
+  state->filters_edit_buffer[sizeof(state->filters_edit_buffer) - 1] = '\0';
+  state->filters_edit_len = strlen(state->filters_edit_buffer);
+}
+
 /* Handle filters panel input */
 bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
   if (!state || !tui_filters_visible(state) || !tui_filters_focused(state))
@@ -663,8 +703,7 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
         size_t filter_idx = state->filters_cursor_row;
         ColumnFilter *cf = &f->filters[filter_idx];
         if (state->filters_cursor_col == 2) {
-          strncpy(cf->value, state->filters_edit_buffer, sizeof(cf->value) - 1);
-          cf->value[sizeof(cf->value) - 1] = '\0';
+          filter_set_value(cf, state->filters_edit_buffer);
         } else if (state->filters_cursor_col == 3 &&
                    cf->op == FILTER_OP_BETWEEN) {
           strncpy(cf->value2, state->filters_edit_buffer,
@@ -696,8 +735,21 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
         size_t paste_len = strlen(paste_text);
         size_t space_left =
             sizeof(state->filters_edit_buffer) - 1 - state->filters_edit_len;
-        if (paste_len > space_left)
+        if (paste_len > space_left && state->filters_cursor_col == 2 &&
+            state->filters_cursor_row < f->num_filters) {
+          /* Too long to edit (a list of IDs): it becomes the value */
+          char *joined =
+              str_printf("%s%s", state->filters_edit_buffer, paste_text);
+          if (joined) {
+            filter_set_value(&f->filters[state->filters_cursor_row], joined);
+            free(joined);
+            state->filters_editing = false;
+            tui_apply_filters(state);
+          }
+          paste_len = 0;
+        } else if (paste_len > space_left) {
           paste_len = space_left;
+        }
         if (paste_len > 0) {
           memcpy(state->filters_edit_buffer + state->filters_edit_len,
                  paste_text, paste_len);
@@ -876,14 +928,8 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
       }
     } else if (state->filters_cursor_col == 2) {
       /* Value - edit */
-      if (is_raw || filter_op_needs_value(cf->op)) {
-        state->filters_editing = true;
-        strncpy(state->filters_edit_buffer, cf->value,
-                sizeof(state->filters_edit_buffer) - 1);
-        state->filters_edit_buffer[sizeof(state->filters_edit_buffer) - 1] =
-            '\0';
-        state->filters_edit_len = strlen(state->filters_edit_buffer);
-      }
+      if (is_raw || filter_op_needs_value(cf->op))
+        start_value_edit(state, cf);
     } else if (state->filters_cursor_col == 3 && is_between) {
       /* Value2 - edit (only for BETWEEN) */
       state->filters_editing = true;
@@ -935,13 +981,13 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
       ColumnFilter *cf = &f->filters[filter_idx];
       const char *value_to_copy = NULL;
       if (state->filters_cursor_col == 2 && cf->value[0]) {
-        value_to_copy = cf->value;
+        value_to_copy = filter_value(cf);
       } else if (state->filters_cursor_col == 3 &&
                  cf->op == FILTER_OP_BETWEEN && cf->value2[0]) {
         value_to_copy = cf->value2;
       } else if (cf->value[0]) {
         /* Default to value if cursor not on a value column */
-        value_to_copy = cf->value;
+        value_to_copy = filter_value(cf);
       }
       if (value_to_copy) {
         tui_clipboard_copy(state, value_to_copy);
@@ -966,8 +1012,7 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
           strncpy(cf->value2, paste_text, sizeof(cf->value2) - 1);
           cf->value2[sizeof(cf->value2) - 1] = '\0';
         } else {
-          strncpy(cf->value, paste_text, sizeof(cf->value) - 1);
-          cf->value[sizeof(cf->value) - 1] = '\0';
+          filter_set_value(cf, paste_text);
           /* Move cursor to value column if not there */
           if (state->filters_cursor_col < 2)
             state->filters_cursor_col = 2;
@@ -1069,6 +1114,69 @@ bool tui_handle_filters_input(TuiState *state, const UiEvent *event) {
   return true;
 }
 
+/* Before filters no index serves run on a large table, ask the planner
+ * whether they really read all of it and if so the user whether to go on.
+ * False if the filters should not be applied. */
+static bool confirm_filter_scan(TuiState *state, Tab *tab) {
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn || !conn->driver || !tab->schema || !tab->data ||
+      tab->data->num_rows == 0)
+    return true;
+
+  /* One indexed filter narrows the read for all of them (they are ANDed) */
+  const char *driver = conn->driver->name;
+  const ColumnFilter *scanning = NULL;
+  for (size_t i = 0; i < tab->filters.num_filters; i++) {
+    const ColumnFilter *cf = &tab->filters.filters[i];
+    if (!filter_is_active(cf))
+      continue;
+    FilterIndexUse use = filter_index_use(cf, tab->schema, driver);
+    if (use == FILTER_INDEX_USED)
+      return true;
+    if (!scanning && use == FILTER_INDEX_SCAN)
+      scanning = cf;
+  }
+
+  /* Size from the loaded rows' average and the unfiltered row count */
+  size_t rows = tab->unfiltered_total_rows ? tab->unfiltered_total_rows
+                                           : tab->total_rows;
+  double row_bytes =
+      (double)db_result_memory(tab->data) / (double)tab->data->num_rows;
+  double table_bytes = row_bytes * (double)rows;
+  if (table_bytes < FILTER_SCAN_PROBE_BYTES)
+    return true;
+
+  char *where = tui_build_filter_where(state);
+  bool full_scan = false;
+  char *err = NULL;
+  bool probed = where && db_explain_full_scan(conn, tab->table_name, where,
+                                              &full_scan, &err);
+  free(where);
+  free(err);
+  if (!probed || !full_scan)
+    return true;
+
+  char *msg = str_printf("No index serves this filter: it reads all %zu rows "
+                         "(~%.1f GB). Apply?",
+                         rows, table_bytes / (1024.0 * 1024 * 1024));
+  bool go = msg && tui_show_confirm_dialog(state, msg);
+  free(msg);
+  if (go)
+    return true;
+
+  FilterOperator better =
+      scanning ? filter_index_suggestion(scanning, tab->schema, driver)
+               : FILTER_OP_EQ;
+  if (scanning && better != scanning->op) {
+    tui_set_status(state, "Filter not applied - '%s' on %s can use an index",
+                   filter_op_name(better),
+                   tab->schema->columns[scanning->column_index].name);
+  } else {
+    tui_set_status(state, "Filter not applied");
+  }
+  return false;
+}
+
 /* Apply current filters and reload data */
 void tui_apply_filters(TuiState *state) {
   Tab *tab = TUI_TAB(state);
@@ -1078,8 +1186,30 @@ void tui_apply_filters(TuiState *state) {
   /* Cancel any pending background load before reload */
   tui_cancel_background_load(state);
 
-  /* Reload table data with filters applied */
-  tui_load_table_data(state, tab->table_name);
+  /* Narrow fully loaded rows in memory, otherwise reload with filters.
+   * Selections are positions within the filtered rows (and "all" means all
+   * rows matching the old filters), so they go once the rows change. */
+  if (tui_filter_loaded_rows(state)) {
+    tab_clear_selections(tab);
+  } else {
+    if (!confirm_filter_scan(state, tab)) {
+      /* Back to the filters the rows were loaded with */
+      TableFilters *f = &tab->filters;
+      if (tab->data_filters_known)
+        filters_copy(f, &tab->data_filters);
+      if (state->filters_cursor_row >= f->num_filters)
+        state->filters_cursor_row = f->num_filters ? f->num_filters - 1 : 0;
+      size_t max_col = 3; /* BETWEEN has extra value2 column */
+      if (f->num_filters &&
+          f->filters[state->filters_cursor_row].op == FILTER_OP_BETWEEN)
+        max_col = 4;
+      if (state->filters_cursor_col > max_col)
+        state->filters_cursor_col = max_col;
+      return;
+    }
+    tab_clear_selections(tab);
+    tui_load_table_data(state, tab->table_name);
+  }
 
   /* Update status - count only active (non-empty) filters */
   TableFilters *f = &tab->filters;
@@ -1209,11 +1339,7 @@ bool tui_handle_filters_click(TuiState *state, int rel_x, int rel_y) {
     }
   } else if (target_col == 2 && (is_raw || filter_op_needs_value(cf->op))) {
     /* Value field - start editing */
-    state->filters_editing = true;
-    strncpy(state->filters_edit_buffer, cf->value,
-            sizeof(state->filters_edit_buffer) - 1);
-    state->filters_edit_buffer[sizeof(state->filters_edit_buffer) - 1] = '\0';
-    state->filters_edit_len = strlen(state->filters_edit_buffer);
+    start_value_edit(state, cf);
   } else if (target_col == 3 && is_between) {
     /* Value2 field for BETWEEN - start editing */
     state->filters_editing = true;
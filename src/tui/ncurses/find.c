@@ -0,0 +1,503 @@
+/*
+ * Lace
+ * Find in grid - incremental search over loaded rows with server fallback
+ *
+ * The search first scans the rows already in memory, moving the cursor as
+ * the user types. When the loaded window holds no further match, table tabs
+ * continue on the server: one query returns the offset of the next matching
+ * row under the active filters and sort, and the window is reloaded there.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../db/db.h"
+#include "../../util/mem.h"
+#include "../../util/str.h"
+#include "query_internal.h"
+#include "tui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+#define FIND_INPUT_MAX 256
+
+/* ============================================================================
+ * Matching
+ * ============================================================================
+ */
+
+static inline unsigned char ascii_lower(unsigned char c) {
+  return (c >= 'A' && c <= 'Z') ? (unsigned char)(c + 32) : c;
+}
+
+static bool ascii_ieq(const char *a, const char *b, size_t len) {
+  for (size_t i = 0; i < len; i++) {
+    if (ascii_lower((unsigned char)a[i]) != ascii_lower((unsigned char)b[i]))
+      return false;
+  }
+  return true;
+}
+
+/* ASCII case-insensitive substring test. Candidates are located with memchr
+ * on both cases of the first needle byte, which libc scans in vector-sized
+ * blocks; only those positions are compared in full. */
+static bool text_contains(const char *hay, size_t hay_len, const char *needle,
+                          size_t needle_len) {
+  if (needle_len == 0)
+    return true;
+  if (!hay || hay_len < needle_len)
+    return false;
+
+  unsigned char lo = ascii_lower((unsigned char)needle[0]);
+  unsigned char up = (lo >= 'a' && lo <= 'z') ? (unsigned char)(lo - 32) : lo;
+  const char *p = hay;
+  const char *last = hay + (hay_len - needle_len);
+
+  while (p <= last) {
+    size_t span = (size_t)(last - p) + 1;
+    const char *a = memchr(p, lo, span);
+    const char *b = up != lo ? memchr(p, up, a ? (size_t)(a - p) : span) : NULL;
+    const char *hit = b ? b : a;
+    if (!hit)
+      return false;
+    if (ascii_ieq(hit + 1, needle + 1, needle_len - 1))
+      return true;
+    p = hit + 1;
+  }
+  return false;
+}
+
+/* Match a cell against the needle using its displayed text */
+static bool cell_matches(const DbValue *val, const char *needle,
+                         size_t needle_len) {
+  if (!val || val->is_null)
+    return false;
+
+  switch (val->type) {
+  case DB_TYPE_NULL:
+  case DB_TYPE_BLOB:
+    return false;
+  case DB_TYPE_TEXT:
+    return text_contains(val->text.data, val->text.len, needle, needle_len);
+  case DB_TYPE_INT: {
+    char buf[32];
+    int n = snprintf(buf, sizeof(buf), "%lld", (long long)val->int_val);
+    return n > 0 && text_contains(buf, (size_t)n, needle, needle_len);
+  }
+  default: {
+    char *str = db_value_to_string(val);
+    bool match = str && text_contains(str, strlen(str), needle, needle_len);
+    free(str);
+    return match;
+  }
+  }
+}
+
+/* Find the first matching cell at or after (row, col) in row-major order */
+static bool find_in_rows(const ResultSet *rs, size_t row, size_t col,
+                         const char *needle, size_t *out_row,
+                         size_t *out_col) {
+  if (!rs || !needle || !*needle)
+    return false;
+  size_t needle_len = strlen(needle);
+
+  for (size_t r = row; r < rs->num_rows; r++, col = 0) {
+    const Row *rw = &rs->rows[r];
+    if (!rw->cells)
+      continue;
+    for (size_t c = col; c < rw->num_cells; c++) {
+      if (cell_matches(&rw->cells[c], needle, needle_len)) {
+        *out_row = r;
+        *out_col = c;
+        return true;
+      }
+    }
+  }
+  return false;
+}
+
+/* ============================================================================
+ * Cursor placement
+ * ============================================================================
+ */
+
+/* Loaded rows of the grid being searched (table data or query results) */
+static ResultSet *find_rows(Tab *tab) {
+  if (!tab)
+    return NULL;
+  return tab->type == TAB_TYPE_QUERY ? tab->query_results : tab->data;
+}
+
+static void get_cursor(TuiState *state, Tab *tab, size_t *row, size_t *col) {
+  *row = 0;
+  *col = 0;
+  if (tab->type == TAB_TYPE_QUERY) {
+    *row = tab->query_result_row;
+    *col = tab->query_result_col;
+    return;
+  }
+  VmTable *vm = tui_vm_table(state);
+  if (vm)
+    vm_table_get_cursor(vm, row, col);
+}
+
+static void set_cursor(TuiState *state, Tab *tab, size_t row, size_t col) {
+  if (tab->type != TAB_TYPE_QUERY) {
+    VmTable *vm = tui_vm_table(state);
+    if (!vm)
+      return;
+    vm_table_set_cursor(vm, row, col);
+    tui_move_cursor(state, 0, 0); /* Scroll the cursor into view */
+    return;
+  }
+
+  tab->query_result_row = row;
+  tab->query_result_col = col;
+
+  /* Same visible-row estimate as the go-to dialog */
+  int win_rows = state->term_rows - 4;
+  int editor_height = (win_rows - 1) * 3 / 10;
+  if (editor_height < 3)
+    editor_height = 3;
+  int visible = win_rows - editor_height - 4;
+  if (visible < 1)
+    visible = 1;
+  if (row < tab->query_result_scroll_row) {
+    tab->query_result_scroll_row = row;
+  } else if (row >= tab->query_result_scroll_row + (size_t)visible) {
+    tab->query_result_scroll_row = row - (size_t)visible + 1;
+  }
+
+  /* Bring the column into view, leftmost if it was off screen */
+  int win_cols = state->main_win ? getmaxx(state->main_win) : state->term_cols;
+  int x = 1;
+  size_t last_visible = tab->query_result_scroll_col;
+  for (size_t c = tab->query_result_scroll_col;
+       tab->query_results && c < tab->query_results->num_columns; c++) {
+    int w = query_get_col_width(tab, c);
+    if (x + w + 3 > win_cols)
+      break;
+    x += w + 1;
+    last_visible = c;
+  }
+  if (col < tab->query_result_scroll_col || col > last_visible)
+    tab->query_result_scroll_col = col;
+
+  UITabState *ui = TUI_TAB_UI(state);
+  if (ui)
+    ui->query_focus_results = true;
+}
+
+/* ============================================================================
+ * Server continuation
+ * ============================================================================
+ */
+
+/* Ask the server for the first matching row after global offset `after`,
+ * under the current filters and sort. Returns false if there is none or the
+ * search failed (status/error already set). */
+static bool find_on_server(TuiState *state, Tab *tab, const char *needle,
+                           size_t after, size_t *found) {
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn || !tab->table_name || !tab->schema ||
+      tab->schema->num_columns == 0)
+    return false;
+
+  const char **columns =
+      safe_calloc(tab->schema->num_columns, sizeof(const char *));
+  for (size_t i = 0; i < tab->schema->num_columns; i++)
+    columns[i] = tab->schema->columns[i].name;
+
+  char *where = tui_build_filter_where(state);
+  char *order = tui_build_order_clause(state);
+  char *err = NULL;
+  char *sql = db_build_find_row_sql(conn, tab->table_name, columns,
+                                    tab->schema->num_columns, where, order,
+                                    needle, (int64_t)after, &err);
+  free(columns);
+  free(where);
+  free(order);
+  if (!sql) {
+    tui_set_error(state, "Find failed: %s", err ? err : "unknown error");
+    free(err);
+    return false;
+  }
+
+  AsyncOperation op;
+  async_init(&op);
+  op.op_type = ASYNC_OP_QUERY;
+  op.conn = conn;
+  op.sql = sql; /* ownership transferred */
+
+  bool ok = false;
+  if (async_start(&op)) {
+    bool completed = tui_show_processing_dialog(state, &op, "Searching...");
+    if (completed && op.state == ASYNC_STATE_COMPLETED) {
+      ResultSet *rs = op.result;
+      if (rs && rs->num_rows > 0 && rs->rows[0].num_cells > 0) {
+        const DbValue *v = &rs->rows[0].cells[0];
+        if (!v->is_null && v->type == DB_TYPE_INT && v->int_val >= 0) {
+          *found = (size_t)v->int_val;
+          ok = true;
+        } else if (!v->is_null && v->type == DB_TYPE_TEXT && v->text.data) {
+          *found = (size_t)strtoull(v->text.data, NULL, 10);
+          ok = true;
+        }
+      }
+      db_result_free(rs);
+      op.result = NULL;
+    } else if (op.state == ASYNC_STATE_ERROR) {
+      tui_set_error(state, "Find failed: %s",
+                    op.error ? op.error : "unknown error");
+    } else if (op.state == ASYNC_STATE_CANCELLED) {
+      tui_set_status(state, "Find cancelled");
+    }
+  }
+  async_free(&op);
+  return ok;
+}
+
+/* ============================================================================
+ * Search driver
+ * ============================================================================
+ */
+
+/* Move to the next match at or after (row, col) of the loaded window, then
+ * past the window on the server. Returns true if the cursor moved. */
+static bool find_from(TuiState *state, Tab *tab, size_t row, size_t col,
+                      bool use_server) {
+  const char *needle = state->find_text;
+  ResultSet *rs = find_rows(tab);
+  if (!rs || !needle || !*needle)
+    return false;
+
+  size_t hit_row, hit_col;
+  if (find_in_rows(rs, row, col, needle, &hit_row, &hit_col)) {
+    set_cursor(state, tab, hit_row, hit_col);
+    return true;
+  }
+
+  /* Query results and fully loaded tables have nothing more to offer */
+  bool more = tab->type != TAB_TYPE_QUERY &&
+              tab->loaded_offset + rs->num_rows < tab->total_rows;
+  if (!use_server || !more) {
+    if (tab->type == TAB_TYPE_QUERY && tab->query_paginated &&
+        tab->query_loaded_offset + rs->num_rows < tab->query_total_rows)
+      tui_set_status(state, "No further matches for '%s' in loaded rows",
+                     needle);
+    else
+      tui_set_status(state, "No further matches for '%s'", needle);
+    return false;
+  }
+
+  size_t after = tab->loaded_offset + rs->num_rows - 1;
+  size_t target;
+  if (!find_on_server(state, tab, needle, after, &target)) {
+    if (!state->status_is_error)
+      tui_set_status(state, "No further matches for '%s'", needle);
+    return false;
+  }
+
+  /* Reload the window around the match, as go-to does */
+  size_t half_page = tui_page_rows(state) / 2;
+  size_t load_offset = target > half_page ? target - half_page : 0;
+  if (!tui_load_rows_at_with_dialog(state, load_offset))
+    return false;
+  rs = find_rows(tab);
+  if (!rs || target < tab->loaded_offset ||
+      target >= tab->loaded_offset + rs->num_rows)
+    return false;
+
+  size_t local = target - tab->loaded_offset;
+  if (!find_in_rows(rs, local, 0, needle, &hit_row, &hit_col) ||
+      hit_row != local)
+    hit_col = 0; /* Server matched where local folding differs */
+  set_cursor(state, tab, local, hit_col);
+  tui_set_status(state, "Found '%s' at row %zu", needle, target + 1);
+  return true;
+}
+
+void tui_find_next(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  if (!tab)
+    return;
+  if (!state->find_text || !*state->find_text) {
+    tui_show_find_dialog(state);
+    return;
+  }
+
+  size_t row, col;
+  get_cursor(state, tab, &row, &col);
+  find_from(state, tab, row, col + 1, true);
+}
+
+/* ============================================================================
+ * Dialog
+ * ============================================================================
+ */
+
+/* Drop the last UTF-8 character from buf */
+static void input_backspace(char *buf, size_t *len) {
+  while (*len > 0) {
+    unsigned char c = (unsigned char)buf[--(*len)];
+    if ((c & 0xC0) != 0x80)
+      break;
+  }
+  buf[*len] = '\0';
+}
+
+void tui_show_find_dialog(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  if (!state || !tab || !find_rows(tab) || find_rows(tab)->num_rows == 0)
+    return;
+
+  /* Remember where the search started; typing re-searches from here */
+  size_t origin_row, origin_col;
+  get_cursor(state, tab, &origin_row, &origin_col);
+  size_t base = tab->type == TAB_TYPE_QUERY ? tab->query_loaded_offset
+                                            : tab->loaded_offset;
+  size_t origin_global = base + origin_row;
+
+  char input[FIND_INPUT_MAX] = {0};
+  size_t input_len = 0;
+  if (state->find_text) {
+    input_len = strlen(state->find_text);
+    if (input_len >= sizeof(input))
+      input_len = sizeof(input) - 1;
+    memcpy(input, state->find_text, input_len);
+  }
+
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+  int width = term_cols < 60 ? term_cols : 60;
+  int height = 3;
+  /* Bottom of the grid, so matches above stay visible */
+  int starty = term_rows - height - 1;
+  int startx = (term_cols - width) / 2;
+  if (starty < 0)
+    starty = 0;
+
+  WINDOW *win = newwin(height, width, starty, startx);
+  if (!win)
+    return;
+  keypad(win, TRUE);
+  curs_set(1);
+
+  bool matched = true;
+  bool running = true;
+  bool accept = false;
+  bool step = false; /* Move past the current match */
+  bool dirty = false;
+
+  while (running) {
+    if (dirty) {
+      /* Incremental: re-run from the origin over loaded rows only */
+      free(state->find_text);
+      state->find_text = str_dup(input);
+      ResultSet *rs = find_rows(tab);
+      base = tab->type == TAB_TYPE_QUERY ? tab->query_loaded_offset
+                                         : tab->loaded_offset;
+      size_t from = origin_global >= base ? origin_global - base : 0;
+      size_t hit_row, hit_col;
+      if (input_len == 0) {
+        matched = true;
+      } else if (find_in_rows(rs, from, origin_col, input, &hit_row,
+                              &hit_col)) {
+        matched = true;
+        set_cursor(state, tab, hit_row, hit_col);
+      } else {
+        matched = false;
+      }
+      dirty = false;
+      tui_refresh(state);
+      touchwin(win);
+    }
+
+    werase(win);
+    DRAW_BOX(win, COLOR_BORDER);
+    WITH_ATTR(win, A_BOLD, mvwprintw(win, 0, 2, " Find "));
+    const char *hint = matched ? "Enter/^F:next" : "Enter:search server";
+    int hint_x = width - (int)strlen(hint) - 2;
+    mvwprintw(win, height - 1, hint_x > 8 ? hint_x : 8, "%s", hint);
+
+    /* Show the tail of long input */
+    int field = width - 4;
+    const char *shown = input;
+    if ((int)input_len > field - 1)
+      shown = input + input_len - (size_t)(field - 1);
+    if (!matched && input_len > 0)
+      WITH_ATTR(win, COLOR_PAIR(COLOR_ERROR_TEXT),
+                mvwprintw(win, 1, 2, "%s", shown));
+    else
+      mvwprintw(win, 1, 2, "%s", shown);
+    wrefresh(win);
+
+    int ch = wgetch(win);
+    switch (ch) {
+    case 27: /* Escape: restore the cursor */
+      running = false;
+      break;
+    case '\n':
+    case KEY_ENTER:
+      accept = true;
+      running = false;
+      break;
+    case 6: /* Ctrl+F: next match */
+    case KEY_DOWN:
+      if (input_len > 0) {
+        accept = true;
+        step = true;
+        running = false;
+      }
+      break;
+    case KEY_BACKSPACE:
+    case 127:
+    case 8:
+      if (input_len > 0) {
+        input_backspace(input, &input_len);
+        dirty = true;
+      }
+      break;
+    default:
+      if (ch >= 32 && ch < 256 && input_len < sizeof(input) - 1) {
+        input[input_len++] = (char)ch;
+        input[input_len] = '\0';
+        dirty = true;
+      }
+      break;
+    }
+  }
+
+  curs_set(0);
+  delwin(win);
+  touchwin(stdscr);
+
+  free(state->find_text);
+  state->find_text = input_len > 0 ? str_dup(input) : NULL;
+
+  if (!accept || input_len == 0) {
+    /* Cancelled: put the cursor back if the window still holds it */
+    base = tab->type == TAB_TYPE_QUERY ? tab->query_loaded_offset
+                                       : tab->loaded_offset;
+    ResultSet *rs = find_rows(tab);
+    if (!accept && rs && origin_global >= base &&
+        origin_global - base < rs->num_rows)
+      set_cursor(state, tab, origin_global - base, origin_col);
+    tui_refresh(state);
+    return;
+  }
+
+  if (matched && step) {
+    size_t row, col;
+    get_cursor(state, tab, &row, &col);
+    find_from(state, tab, row, col + 1, true);
+  } else if (!matched) {
+    /* Nothing left in the loaded rows: continue on the server */
+    base = tab->type == TAB_TYPE_QUERY ? tab->query_loaded_offset
+                                       : tab->loaded_offset;
+    size_t from = origin_global >= base ? origin_global - base : 0;
+    find_from(state, tab, from, origin_col, true);
+  }
+  tui_refresh(state);
+}
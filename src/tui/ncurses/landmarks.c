@@ -0,0 +1,177 @@
+/*
+ * Lace
+ * Landmark seeks - random access into large tables without deep OFFSETs
+ *
+ * While the UI is idle, large table tabs sample their sort key every
+ * stride-th row in the background (see core/landmark.h). Page loads deeper
+ * than one stride then start from the nearest landmark with a keyset
+ * predicate and only OFFSET the rest. Jumping to a key value counts the
+ * rows ordered before it, which the database answers from the index.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../db/db.h"
+#include "../../util/str.h"
+#include "tui_internal.h"
+#include <stdlib.h>
+
+/* Schema names of the index's key columns; false if the schema changed */
+static bool key_names(const Tab *tab, const SortKey *key, const char **names) {
+  if (!tab->schema)
+    return false;
+  for (size_t i = 0; i < key->num_cols; i++) {
+    if (key->cols[i] >= tab->schema->num_columns)
+      return false;
+    names[i] = tab->schema->columns[key->cols[i]].name;
+  }
+  return true;
+}
+
+/* AND two predicates, either of which may be NULL. Takes ownership. */
+static char *and_where(char *a, char *b) {
+  if (!a)
+    return b;
+  if (!b)
+    return a;
+  char *both = str_printf("(%s) AND (%s)", a, b);
+  free(a);
+  free(b);
+  return both;
+}
+
+char *tui_build_page_where(TuiState *state, size_t *offset) {
+  return tui_build_page_where_params(state, offset, NULL, NULL);
+}
+
+char *tui_build_page_where_params(TuiState *state, size_t *offset,
+                                  DbValue **params, size_t *num_params) {
+  char *where = tui_build_filter_where_params(state, params, num_params);
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || !conn || !offset || *offset < LANDMARK_MIN_STRIDE ||
+      !tab->landmarks.ready)
+    return where;
+
+  /* Landmarks were sampled under the filters' literal WHERE */
+  LandmarkIndex *lm = &tab->landmarks;
+  char *literal = params ? tui_build_filter_where(state) : NULL;
+  char *order = tui_build_order_clause(state);
+  bool current = landmark_matches(lm, tab->table_name,
+                                  params ? literal : where, order);
+  free(literal);
+  free(order);
+
+  size_t mark_row = 0;
+  const DbValue *keys = current ? landmark_seek(lm, *offset, &mark_row) : NULL;
+  const char *names[MAX_KEY_COLUMNS];
+  if (!keys || mark_row == 0 || !key_names(tab, &lm->key, names))
+    return where;
+
+  char *err = NULL;
+  char *seek = db_build_key_where(conn, names, lm->key.desc, keys,
+                                  lm->key.num_cols, true, &err);
+  free(err);
+  if (!seek)
+    return where;
+
+  *offset -= mark_row;
+  return and_where(where, seek);
+}
+
+bool tui_poll_landmarks(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !tab->table_name ||
+      !tab->schema)
+    return false;
+
+  LandmarkIndex *lm = &tab->landmarks;
+  if (lm->build_op && !landmark_build_poll(lm))
+    return false;
+  if (tab->total_rows < LANDMARK_MIN_ROWS)
+    return false;
+
+  DbConnection *conn = TUI_CONN(state);
+  SortKey key;
+  if (!conn || !tab_sort_key(tab, &key) ||
+      !landmark_key_usable(&key, tab->schema))
+    return false;
+
+  char *where = tui_build_filter_where(state);
+  char *order = tui_build_order_clause(state);
+  bool started = false;
+  if (!landmark_matches(lm, tab->table_name, where, order)) {
+    /* Filters or sort changed: a build for the old ones is wasted work */
+    if (lm->build_op)
+      landmark_invalidate(lm);
+    else
+      started = landmark_build_start(lm, conn, tab->schema, tab->table_name,
+                                     where, order, &key, tab->total_rows);
+  }
+  free(where);
+  free(order);
+  return started;
+}
+
+bool tui_goto_key(TuiState *state, const char *value) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || !conn || tab->type != TAB_TYPE_TABLE || !tab->table_name ||
+      !value || !*value)
+    return false;
+
+  SortKey key;
+  const char *names[MAX_KEY_COLUMNS];
+  if (!tab_sort_key(tab, &key) || !key_names(tab, &key, names)) {
+    tui_set_error(state, "Table has no sort or primary key to search by");
+    return false;
+  }
+
+  /* Rows ordered before the value on the leading key column */
+  DbValue val = db_value_text(value);
+  char *err = NULL;
+  char *before =
+      db_build_key_where(conn, names, key.desc, &val, 1, false, &err);
+  db_value_free(&val);
+  if (!before) {
+    tui_set_error(state, "Jump failed: %s", err ? err : "unknown error");
+    free(err);
+    return false;
+  }
+
+  AsyncOperation op;
+  async_init(&op);
+  op.op_type = ASYNC_OP_COUNT_ROWS_WHERE;
+  op.conn = conn;
+  op.table_name = str_dup(tab->table_name);
+  op.where_clause = and_where(tui_build_filter_where(state), before);
+
+  bool found = false;
+  size_t row = 0;
+  if (async_start(&op)) {
+    bool completed = tui_show_processing_dialog(state, &op, "Locating key...");
+    if (completed && op.state == ASYNC_STATE_COMPLETED && op.count >= 0) {
+      row = (size_t)op.count;
+      found = true;
+    } else if (op.state == ASYNC_STATE_ERROR) {
+      tui_set_error(state, "Jump failed: %s",
+                    op.error ? op.error : "unknown error");
+    } else if (op.state == ASYNC_STATE_CANCELLED) {
+      tui_set_status(state, "Jump cancelled");
+    }
+  }
+  async_free(&op);
+  if (!found)
+    return false;
+
+  if (row >= tab->total_rows) {
+    tui_set_status(state, "No rows at or after %s = %s", names[0], value);
+    return false;
+  }
+  if (!tui_goto_row(state, row))
+    return false;
+  tui_set_status(state, "Row %zu: first %s at or after '%s'", row + 1,
+                 names[0], value);
+  return true;
+}
@@ -0,0 +1,126 @@
+/*
+ * Lace
+ * Live updates - refresh tabs when other sessions write
+ *
+ * With general.live_updates on, every connection runs a live feed (see
+ * core/live_feed.h). Tables it reports mark their tabs for refresh like an
+ * edit in another tab would; the current tab refreshes right away, by
+ * patching its rows in view when it can instead of reloading the page.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../core/live_feed.h"
+#include "../../util/str.h"
+#include "query_internal.h"
+#include "tui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Start or stop conn's feed to match the configuration */
+static void live_sync_feed(TuiState *state, Connection *conn, bool want) {
+  if (!want) {
+    live_feed_stop(conn->live);
+    conn->live = NULL;
+  } else if (!conn->live && live_feed_supported(conn->conn)) {
+    conn->live = live_feed_start(conn->conn->connstr,
+                                 (int)tui_watch_interval_ms(state));
+  }
+}
+
+/* Mark the tabs of what conn's feed reported since the last poll */
+static void live_take_changes(TuiState *state, size_t index) {
+  Connection *conn = &state->app->connections[index];
+  size_t count = 0;
+  bool all = false;
+  char *err = NULL;
+  char **tables = live_feed_take(conn->live, &count, &all, &err);
+
+  if (all)
+    app_mark_connection_tabs_dirty(state->app, index);
+  for (size_t i = 0; i < count; i++) {
+    if (!all)
+      app_mark_table_tabs_dirty(state->app, index, tables[i], NULL);
+    free(tables[i]);
+  }
+  free(tables);
+
+  /* The stopped feed stays until live updates are turned off, so it is
+   * not restarted over and over */
+  if (err) {
+    tui_set_error(state, "Live updates stopped: %s", err);
+    free(err);
+  }
+}
+
+void tui_poll_live(TuiState *state) {
+  AppState *app = state->app;
+  if (!app)
+    return;
+  bool want = app->config && app->config->general.live_updates;
+
+  for (size_t i = 0; i < app->num_connections; i++) {
+    Connection *conn = &app->connections[i];
+    if (!conn->active || !conn->conn)
+      continue;
+    live_sync_feed(state, conn, want);
+    if (conn->live)
+      live_take_changes(state, i);
+  }
+
+  /* Refresh the current tab now; others refresh when switched to */
+  Tab *tab = TUI_TAB(state);
+  if (!tab || !tab->needs_refresh || tab->type != TAB_TYPE_TABLE ||
+      !tab->table_name)
+    return;
+  if (state->editing || tab->bg_load_op || tab->rows_evicted)
+    return; /* Next time */
+
+  tab->needs_refresh = false;
+  if (!tui_watch_refresh(state))
+    tui_refresh_table(state);
+  tui_mark_damage(state, TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS);
+}
+
+void tui_show_live_trigger(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !tab->table_name || !conn)
+    return;
+
+  if (!str_eq(conn->driver->name, "postgres")) {
+    tui_set_status(state, "%s needs no trigger for live updates",
+                   conn->driver->display_name);
+    return;
+  }
+
+  char *err = NULL;
+  char *sql = db_build_notify_trigger_sql(conn, tab->table_name,
+                                          LIVE_FEED_CHANNEL, &err);
+  if (!sql) {
+    tui_set_error(state, "%s", err ? err : "Cannot build trigger");
+    free(err);
+    return;
+  }
+
+  char *table = str_dup(tab->table_name);
+  size_t len = strlen(sql);
+  if (!tab_create_query(state) || !(tab = TUI_TAB(state)) ||
+      !query_ensure_capacity(tab, len + 1)) {
+    free(sql);
+    free(table);
+    return;
+  }
+  memcpy(tab->query_text, sql, len + 1);
+  tab->query_len = len;
+  tab->query_cursor = 0;
+  free(sql);
+
+  char *all_key = hotkey_get_display(state->app->config, HOTKEY_EXECUTE_ALL);
+  tui_set_status(state, "Run all (%s) to install the live update trigger on %s",
+                 all_key ? all_key : "Ctrl+A", table);
+  free(all_key);
+  free(table);
+  tui_mark_damage(state, TUI_DAMAGE_ALL);
+}
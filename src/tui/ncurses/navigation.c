@@ -36,15 +36,18 @@ void tui_move_cursor(TuiState *state, int row_delta, int col_delta) {
     if (loaded_end < total_rows) {
       /* Load more data with blocking dialog */
       if (tui_load_page_with_dialog(state, true)) {
-        /* Data loaded, move cursor */
+        /* Data loaded (a trim may have shifted the cursor), move cursor */
+        vm_table_get_cursor(vm, &cursor_row, &cursor_col);
         cursor_row++;
       }
     }
   } else if (row_delta < 0 && cursor_row == 0 && loaded_offset > 0) {
     /* At first loaded row but not at beginning of data */
     if (tui_load_page_with_dialog(state, false)) {
-      /* Data prepended, cursor_row was adjusted by merge */
-      cursor_row--;
+      /* Data prepended, cursor_row was adjusted by merge - re-read */
+      vm_table_get_cursor(vm, &cursor_row, &cursor_col);
+      if (cursor_row > 0)
+        cursor_row--;
     }
   }
 
@@ -186,12 +189,17 @@ void tui_page_down(TuiState *state) {
     size_t loaded_end = loaded_offset + loaded_count;
     if (loaded_end < total_rows) {
       /* Need to load more data - show blocking dialog */
-      tui_load_page_with_dialog(state, true);
-      /* Re-read loaded row count after loading */
-      loaded_rows = vm_table_row_count(vm);
+      if (tui_load_page_with_dialog(state, true)) {
+        /* Re-read after loading: trimming may have shifted the window */
+        loaded_rows = vm_table_row_count(vm);
+        vm_table_get_cursor(vm, &cursor_row, &cursor_col);
+        vm_table_get_scroll(vm, &scroll_row, &scroll_col);
+        target_row = cursor_row + page_size;
+      }
     }
     /* Clamp to available data */
-    target_row = loaded_rows > 0 ? loaded_rows - 1 : 0;
+    if (target_row >= loaded_rows)
+      target_row = loaded_rows > 0 ? loaded_rows - 1 : 0;
   }
 
   cursor_row = target_row;
@@ -249,8 +257,9 @@ void tui_end(TuiState *state) {
   size_t loaded_end = loaded_offset + loaded_count;
   if (loaded_end < total_rows) {
     /* Load last page of data */
+    size_t page_rows = tui_page_rows(state);
     size_t last_page_offset =
-        total_rows > PAGE_SIZE ? total_rows - PAGE_SIZE : 0;
+        total_rows > page_rows ? total_rows - page_rows : 0;
     if (!tui_load_rows_at_with_dialog(state, last_page_offset)) {
       return; /* Cancelled or failed */
     }
@@ -274,6 +283,34 @@ void tui_end(TuiState *state) {
   vm_table_set_scroll(vm, scroll_row, 0);
 }
 
+bool tui_goto_row(TuiState *state, size_t row) {
+  Tab *tab = TUI_TAB(state);
+  VmTable *vm = tui_vm_table(state);
+  if (!tab || !vm || row >= tab->total_rows)
+    return false;
+
+  if (row < tab->loaded_offset ||
+      row >= tab->loaded_offset + tab->loaded_count) {
+    size_t half_page = tui_page_rows(state) / 2;
+    size_t load_offset = row > half_page ? row - half_page : 0;
+    if (!tui_load_rows_at_with_dialog(state, load_offset))
+      return false; /* Cancelled or failed */
+  }
+  if (tab->loaded_count == 0 || row < tab->loaded_offset)
+    return false;
+
+  /* The exact count may have come out shorter than the estimate */
+  size_t local = row - tab->loaded_offset;
+  if (local >= tab->loaded_count)
+    local = tab->loaded_count - 1;
+
+  size_t cursor_col;
+  vm_table_get_cursor(vm, NULL, &cursor_col);
+  vm_table_set_cursor(vm, local, cursor_col);
+  tui_move_cursor(state, 0, 0); /* Scroll the cursor into view */
+  return true;
+}
+
 void tui_column_first(TuiState *state) {
   VmTable *vm = tui_vm_table(state);
   if (!vm)
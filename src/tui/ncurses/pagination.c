@@ -10,7 +10,11 @@
 
 #include "../../async/async.h"
 #include "../../config/config.h"
+#include "../../core/local_ops.h"
+#include "../../core/mem_budget.h"
+#include "../../core/prefetch.h"
 #include "../../util/mem.h"
+#include "query_internal.h"
 #include "tui_internal.h"
 #include <stdlib.h>
 #include <string.h>
@@ -19,7 +23,9 @@
 /* Note: History recording is now handled automatically by the database layer
  * via the history callback set up in app_add_connection(). */
 
-/* Calculate column widths based on data */
+/* Calculate column widths based on data.
+ * Rebuilds the per-column display width statistics from every loaded row;
+ * page merges and trims then keep them current incrementally. */
 void tui_calculate_column_widths(TuiState *state) {
   Tab *tab = TUI_TAB(state);
   ResultSet *data = tab ? tab->data : NULL;
@@ -30,42 +36,45 @@ void tui_calculate_column_widths(TuiState *state) {
   if (!data->columns || data->num_columns == 0)
     return;
 
-  free(tab->col_widths);
-  tab->num_col_widths = data->num_columns;
-  tab->col_widths = safe_calloc(tab->num_col_widths, sizeof(int));
+  col_widths_rebuild(data, &tab->col_stats, &tab->col_widths,
+                     &tab->num_col_widths);
 
-  /* Start with column name widths */
-  for (size_t i = 0; i < data->num_columns; i++) {
-    const char *name = data->columns[i].name;
-    int len = name ? (int)strlen(name) : 0;
-    tab->col_widths[i] = len < MIN_COL_WIDTH ? MIN_COL_WIDTH : len;
-  }
+  /* Tab owns column widths - no cache sync needed */
+}
 
-  /* Check data widths */
-  for (size_t row = 0; row < data->num_rows && row < 100; row++) {
-    Row *r = &data->rows[row];
-    if (!r->cells)
-      continue;
-    for (size_t col = 0; col < data->num_columns && col < r->num_cells; col++) {
-      char *str = db_value_to_string(&r->cells[col]);
-      if (str) {
-        int len = (int)strlen(str);
-        if (len > tab->col_widths[col]) {
-          tab->col_widths[col] = len;
-        }
-        free(str);
-      }
-    }
-  }
+/* Fold rows [first, first + count) of tab->data into the column statistics.
+ * Widths only grow so the layout stays put while scrolling. */
+void tui_column_stats_add(Tab *tab, size_t first, size_t count) {
+  if (!tab->data || !tab->col_stats ||
+      tab->num_col_widths != tab->data->num_columns)
+    return;
+  col_stats_add_rows(tab->col_stats, tab->num_col_widths,
+                     tab->data->rows + first, count);
+  col_widths_grow(tab->col_stats, tab->data, tab->col_widths,
+                  tab->num_col_widths);
+}
 
-  /* Apply max width */
-  for (size_t i = 0; i < tab->num_col_widths; i++) {
-    if (tab->col_widths[i] > MAX_COL_WIDTH) {
-      tab->col_widths[i] = MAX_COL_WIDTH;
-    }
-  }
+/* Drop rows [first, first + count) of tab->data from the column statistics
+ * (call before the rows are freed) */
+void tui_column_stats_remove(Tab *tab, size_t first, size_t count) {
+  if (!tab->data || !tab->col_stats ||
+      tab->num_col_widths != tab->data->num_columns)
+    return;
+  col_stats_remove_rows(tab->col_stats, tab->num_col_widths,
+                        tab->data->rows + first, count);
+}
 
-  /* Tab owns column widths - no cache sync needed */
+/* Re-seed statistics after tab->data was replaced by a page elsewhere in
+ * the same table, keeping the current widths as a floor */
+static void column_stats_replace(TuiState *state, Tab *tab) {
+  if (!tab->data)
+    return;
+  if (!tab->col_stats || tab->num_col_widths != tab->data->num_columns) {
+    tui_calculate_column_widths(state);
+    return;
+  }
+  memset(tab->col_stats, 0, tab->num_col_widths * sizeof(ColumnWidthStats));
+  tui_column_stats_add(tab, 0, tab->data->num_rows);
 }
 
 /* Get column width */
@@ -77,8 +86,141 @@ int tui_get_column_width(TuiState *state, size_t col) {
   return tab->col_widths[col];
 }
 
+/* Re-point the table viewmodel at a replaced ResultSet; it caches the data
+ * pointer and window bounds, which go stale when a load swaps tab->data */
+static void sync_vm_window(TuiState *state, Tab *tab) {
+  VmTable *vm = state->vm_table;
+  if (vm && vm->tab == tab)
+    vm_table_sync_from_tab(vm);
+}
+
+/* Rows per table page, from the configuration */
+size_t tui_page_rows(TuiState *state) {
+  Config *config = state && state->app ? state->app->config : NULL;
+  if (!config || config->general.page_size <= 0)
+    return CONFIG_PAGE_SIZE_DEFAULT;
+  return (size_t)config->general.page_size;
+}
+
+/* Pages fetched by a plain (non-adaptive) load, from the configuration */
+static size_t prefetch_pages(TuiState *state) {
+  Config *config = state && state->app ? state->app->config : NULL;
+  if (!config || config->general.prefetch_pages <= 0)
+    return CONFIG_PREFETCH_PAGES_DEFAULT;
+  return (size_t)config->general.prefetch_pages;
+}
+
+/* Pages a table window may hold; always room for a full prefetch plus the
+ * cursor page and one page behind it */
+static size_t window_pages(TuiState *state) {
+  size_t pages = prefetch_pages(state) + 2;
+  return pages > MAX_LOADED_PAGES ? pages : MAX_LOADED_PAGES;
+}
+
+/* Size the next page load of tab from the connection's measured latency and
+ * the cursor's speed */
+static void plan_page_load(TuiState *state, Tab *tab, PrefetchPlan *plan) {
+  Connection *conn = app_get_tab_connection(state->app, tab);
+  if (tab->type == TAB_TYPE_QUERY) {
+    /* Query results are trimmed in fixed pages around the cursor */
+    prefetch_plan(conn ? &conn->link : NULL, &tab->motion, PAGE_SIZE,
+                  PAGE_SIZE, PAGE_SIZE * TRIM_DISTANCE_PAGES, plan);
+    return;
+  }
+  size_t page_rows = tui_page_rows(state);
+  prefetch_plan(conn ? &conn->link : NULL, &tab->motion, page_rows,
+                page_rows * prefetch_pages(state),
+                page_rows * (window_pages(state) - 2), plan);
+}
+
+/* Feed a finished page load into the connection's latency estimate */
+static void record_page_load(TuiState *state, Tab *tab, uint64_t started,
+                             const ResultSet *rs) {
+  Connection *conn = app_get_tab_connection(state->app, tab);
+  if (!conn || !rs || rs->num_rows == 0)
+    return;
+  prefetch_link_record(&conn->link, lace_time_ms() - started, rs->num_rows,
+                       db_result_memory(rs));
+}
+
+/* Rows [offset, offset + limit) of tab's table under where (with params
+ * bound) and order, from a page another tab of the connection holds. NULL
+ * if none does (the load must run). */
+static ResultSet *shared_page_get(TuiState *state, Tab *tab, const char *where,
+                                  const DbValue *params, size_t num_params,
+                                  const char *order, size_t offset,
+                                  size_t limit) {
+  Connection *conn = app_get_tab_connection(state->app, tab);
+  if (!conn || tab->type != TAB_TYPE_TABLE)
+    return NULL;
+  return page_cache_get(conn->page_cache, tab->table_name, where, params,
+                        num_params, order, offset, limit);
+}
+
+/* Offer rows just loaded for the same request to the connection's other
+ * tabs */
+static void shared_page_put(TuiState *state, Tab *tab, const char *where,
+                            const DbValue *params, size_t num_params,
+                            const char *order, size_t offset, size_t limit,
+                            ResultSet *rs) {
+  Connection *conn = app_get_tab_connection(state->app, tab);
+  if (!conn || tab->type != TAB_TYPE_TABLE)
+    return;
+  page_cache_put(conn->page_cache, tab->table_name, where, params, num_params,
+                 order, offset, limit, rs);
+}
+
+/* The same for a table page load operation */
+static ResultSet *shared_page_get_op(TuiState *state, Tab *tab,
+                                     const AsyncOperation *op) {
+  return shared_page_get(state, tab, op->where_clause, op->params,
+                         op->num_params, op->order_by, op->offset, op->limit);
+}
+
+static void shared_page_put_op(TuiState *state, Tab *tab,
+                               const AsyncOperation *op, ResultSet *rs) {
+  shared_page_put(state, tab, op->where_clause, op->params, op->num_params,
+                  op->order_by, op->offset, op->limit, rs);
+}
+
+/* Fetch a table page on the main thread, from a page another tab holds when
+ * one covers it */
+static ResultSet *fetch_table_page(TuiState *state, Tab *tab,
+                                   DbConnection *conn, const char *where,
+                                   const DbValue *params, size_t num_params,
+                                   const char *order, size_t offset,
+                                   size_t limit, char **err) {
+  ResultSet *rs = shared_page_get(state, tab, where, params, num_params,
+                                  order, offset, limit);
+  if (rs)
+    return rs;
+
+  uint64_t started = lace_time_ms();
+  if (where) {
+    rs = db_query_page_where_params(conn, tab->table_name, offset, limit,
+                                    where, params, num_params, order, false,
+                                    err);
+  } else {
+    rs = db_query_page(conn, tab->table_name, offset, limit, order, false,
+                       err);
+  }
+  record_page_load(state, tab, started, rs);
+  shared_page_put(state, tab, where, params, num_params, order, offset, limit,
+                  rs);
+  return rs;
+}
+
 /* Build WHERE clause for current tab filters */
-static char *build_filter_where(TuiState *state) {
+char *tui_build_filter_where(TuiState *state) {
+  return tui_build_filter_where_params(state, NULL, NULL);
+}
+
+char *tui_build_filter_where_params(TuiState *state, DbValue **params,
+                                    size_t *num_params) {
+  if (params)
+    *params = NULL;
+  if (num_params)
+    *num_params = 0;
   Tab *tab = TUI_TAB(state);
   if (!tab || tab->filters.num_filters == 0)
     return NULL;
@@ -88,65 +230,22 @@ static char *build_filter_where(TuiState *state) {
     return NULL;
 
   char *err = NULL;
-  char *where =
-      filters_build_where(&tab->filters, tab->schema, conn->driver->name, &err);
+  char *where = filters_compile_where(&tab->filters, tab->schema,
+                                      conn->driver->name, params, num_params,
+                                      &err);
   free(err);
   return where;
 }
 
-/* Build multi-column ORDER BY clause for current tab (NULL if no sorting)
+/* Build multi-column ORDER BY clause for current tab: its sort columns,
+ * then primary key tie-breakers (NULL if neither exists)
  * Caller must free the returned string */
-static char *build_order_clause(TuiState *state) {
+char *tui_build_order_clause(TuiState *state) {
   Tab *tab = TUI_TAB(state);
-  if (!tab || tab->num_sort_entries == 0)
-    return NULL;
-
   DbConnection *conn = TUI_CONN(state);
-  if (!tab->schema || !conn)
+  if (!tab || !conn || !conn->driver)
     return NULL;
-
-  /* Determine quote character based on driver */
-  bool use_backtick = conn->driver &&
-                      (strcmp(conn->driver->name, "mysql") == 0 ||
-                       strcmp(conn->driver->name, "mariadb") == 0);
-
-  /* Build ORDER BY clause */
-  StringBuilder *sb = sb_new(128);
-  if (!sb)
-    return NULL;
-
-  bool first_added = false;
-  for (size_t i = 0; i < tab->num_sort_entries; i++) {
-    SortEntry *entry = &tab->sort_entries[i];
-    if (entry->column >= tab->schema->num_columns)
-      continue;
-
-    const char *col_name = tab->schema->columns[entry->column].name;
-    if (!col_name)
-      continue;
-
-    /* Escape column name */
-    char *escaped = use_backtick ? str_escape_identifier_backtick(col_name)
-                                 : str_escape_identifier_dquote(col_name);
-    if (!escaped) {
-      sb_free(sb);
-      return NULL;
-    }
-
-    /* Add separator if not first valid entry */
-    if (first_added) {
-      sb_append(sb, ", ");
-    }
-    first_added = true;
-
-    /* Add column with direction */
-    sb_printf(sb, "%s %s", escaped,
-              entry->direction == SORT_ASC ? "ASC" : "DESC");
-    free(escaped);
-  }
-
-  char *result = sb_to_string(sb);
-  return result;
+  return tab_build_order_clause(tab, conn->driver->name);
 }
 
 /* Load table data */
@@ -168,6 +267,7 @@ bool tui_load_table_data(TuiState *state, const char *table) {
     db_result_free(tab->data);
     tab->data = NULL;
   }
+  tab->data_filters_known = false;
 
   if (tab->schema) {
     db_schema_free(tab->schema);
@@ -195,8 +295,11 @@ bool tui_load_table_data(TuiState *state, const char *table) {
   }
   async_free(&schema_op);
 
-  /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
+  /* Build WHERE clause from filters, its values bound as parameters */
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_filter_where_params(state, &params, &num_params);
 
   /* Get total row count with progress dialog (uses approximate if available) */
   AsyncOperation count_op;
@@ -210,6 +313,8 @@ bool tui_load_table_data(TuiState *state, const char *table) {
     /* Filtered count - must be exact */
     count_op.op_type = ASYNC_OP_COUNT_ROWS_WHERE;
     count_op.where_clause = str_dup(where_clause);
+    count_op.params = db_values_copy(params, num_params);
+    count_op.num_params = count_op.params ? num_params : 0;
   } else {
     /* Unfiltered - can use approximate count */
     count_op.op_type = ASYNC_OP_COUNT_ROWS;
@@ -225,6 +330,7 @@ bool tui_load_table_data(TuiState *state, const char *table) {
     } else if (count_op.state == ASYNC_STATE_CANCELLED) {
       async_free(&count_op);
       free(where_clause);
+      FREE_ARRAY(params, num_params, db_value_free);
       tui_set_status(state, "Operation cancelled");
       return false;
     }
@@ -246,44 +352,54 @@ bool tui_load_table_data(TuiState *state, const char *table) {
   data_op.conn = conn;
   data_op.table_name = str_dup(table);
   data_op.offset = 0;
-  data_op.limit = PAGE_SIZE * PREFETCH_PAGES;
-  data_op.order_by = build_order_clause(state);
+  data_op.limit = tui_page_rows(state) * prefetch_pages(state);
+  data_op.order_by = tui_build_order_clause(state);
   data_op.desc = false; /* Direction is in the clause */
 
   if (where_clause) {
     data_op.op_type = ASYNC_OP_QUERY_PAGE_WHERE;
     data_op.where_clause = str_dup(where_clause);
+    data_op.params = params; /* Takes ownership */
+    data_op.num_params = num_params;
   } else {
     data_op.op_type = ASYNC_OP_QUERY_PAGE;
   }
   free(where_clause);
 
-  if (!data_op.table_name || !async_start(&data_op)) {
-    async_free(&data_op);
-    tui_set_error(state, "Failed to start data load");
-    return false;
-  }
+  /* Another tab on the same rows may hold the page already */
+  uint64_t started = lace_time_ms();
+  tab->data = data_op.table_name ? shared_page_get_op(state, tab, &data_op)
+                                 : NULL;
+  bool shared = tab->data != NULL;
+  if (!shared) {
+    if (!data_op.table_name || !async_start(&data_op)) {
+      async_free(&data_op);
+      tui_set_error(state, "Failed to start data load");
+      return false;
+    }
 
-  bool completed =
-      tui_show_processing_dialog(state, &data_op, "Loading data...");
+    bool completed =
+        tui_show_processing_dialog(state, &data_op, "Loading data...");
 
-  if (!completed || data_op.state == ASYNC_STATE_CANCELLED) {
-    async_free(&data_op);
-    tui_set_status(state, "Operation cancelled");
-    return false;
-  }
+    if (!completed || data_op.state == ASYNC_STATE_CANCELLED) {
+      async_free(&data_op);
+      tui_set_status(state, "Operation cancelled");
+      return false;
+    }
 
-  if (data_op.state == ASYNC_STATE_ERROR) {
-    const char *err_msg = data_op.error ? data_op.error : "Unknown error";
-    tui_set_error(state, "Query failed: %s", err_msg);
-    /* Store error in tab for display */
-    free(tab->table_error);
-    tab->table_error = str_dup(err_msg);
-    async_free(&data_op);
-    return false;
-  }
+    if (data_op.state == ASYNC_STATE_ERROR) {
+      const char *err_msg = data_op.error ? data_op.error : "Unknown error";
+      tui_set_error(state, "Query failed: %s", err_msg);
+      /* Store error in tab for display */
+      free(tab->table_error);
+      tab->table_error = str_dup(err_msg);
+      async_free(&data_op);
+      return false;
+    }
 
-  tab->data = (ResultSet *)data_op.result;
+    tab->data = (ResultSet *)data_op.result;
+    shared_page_put_op(state, tab, &data_op, tab->data);
+  }
   async_free(&data_op);
 
   if (!tab->data) {
@@ -292,6 +408,10 @@ bool tui_load_table_data(TuiState *state, const char *table) {
   }
 
   tab->loaded_count = tab->data->num_rows;
+  tab_record_data_filters(tab);
+  if (!shared)
+    record_page_load(state, tab, started, tab->data);
+  prefetch_motion_reset(&tab->motion);
 
   /* Apply schema column names to result set */
   if (tab->schema && tab->data) {
@@ -339,6 +459,8 @@ bool tui_load_table_data(TuiState *state, const char *table) {
     filters_widget_bind(ui->filters_widget, &tab->filters, tab->schema);
   }
 
+  tui_enforce_memory_budget(state);
+
   /* History is recorded automatically by database layer */
   return true;
 }
@@ -366,6 +488,11 @@ bool tui_refresh_table(TuiState *state) {
   /* Calculate absolute row position (offset + cursor) */
   size_t abs_row = saved_offset + saved_cursor_row;
 
+  /* A refresh reads the server, not pages other tabs hold */
+  Connection *app_conn = app_get_tab_connection(state->app, tab);
+  if (app_conn)
+    page_cache_forget(app_conn->page_cache, tab->table_name);
+
   /* Reload table data */
   if (!tui_load_table_data(state, tab->table_name)) {
     return false;
@@ -380,7 +507,8 @@ bool tui_refresh_table(TuiState *state) {
     }
 
     /* Calculate target offset to load data containing the absolute row */
-    size_t target_offset = (abs_row / PAGE_SIZE) * PAGE_SIZE;
+    size_t page_rows = tui_page_rows(state);
+    size_t target_offset = (abs_row / page_rows) * page_rows;
 
     /* Load data at target offset if not already at offset 0 */
     if (target_offset > 0 && target_offset != tab->loaded_offset) {
@@ -449,6 +577,91 @@ bool tui_refresh_table(TuiState *state) {
   return true;
 }
 
+/* True when every row matching the loaded filters is in memory */
+static bool table_fully_loaded(Tab *tab) {
+  return tab->data && tab->loaded_offset == 0 && !tab->row_count_approximate &&
+         !tab->bg_load_op && tab->data->num_rows == tab->total_rows;
+}
+
+/* Re-sort the loaded rows in memory instead of reloading */
+bool tui_sort_loaded_rows(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !conn || !conn->driver)
+    return false;
+  /* Without sort columns the server's natural order is wanted */
+  if (tab->num_sort_entries == 0 || !table_fully_loaded(tab))
+    return false;
+
+  LocalRules rules;
+  local_rules_for_driver(conn->driver->name, &rules);
+  if (!local_sort_rows(tab->data, tab->sort_entries, tab->num_sort_entries,
+                       &rules))
+    return false;
+
+  tui_set_status(state, "Sorted %zu rows in memory", tab->data->num_rows);
+  return true;
+}
+
+/* Narrow the loaded rows in memory instead of reloading. Only possible when
+ * the new filters keep every filter the rows were fetched with and add
+ * locally evaluable ones. */
+bool tui_filter_loaded_rows(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !conn || !conn->driver ||
+      !tab->schema || !table_fully_loaded(tab) || !tab->data_filters_known)
+    return false;
+
+  TableFilters *cur = &tab->filters;
+  TableFilters *old = &tab->data_filters;
+
+  /* Every filter the rows satisfy must still apply */
+  for (size_t i = 0; i < old->num_filters; i++) {
+    if (!filter_is_active(&old->filters[i]))
+      continue;
+    bool kept = false;
+    for (size_t j = 0; j < cur->num_filters && !kept; j++)
+      kept = filter_equal(&old->filters[i], &cur->filters[j]);
+    if (!kept)
+      return false;
+  }
+
+  /* Collect the added filters */
+  ColumnFilter *added =
+      safe_malloc((cur->num_filters ? cur->num_filters : 1) *
+                  sizeof(ColumnFilter));
+  size_t num_added = 0;
+  for (size_t j = 0; j < cur->num_filters; j++) {
+    if (!filter_is_active(&cur->filters[j]))
+      continue;
+    bool known = false;
+    for (size_t i = 0; i < old->num_filters && !known; i++)
+      known = filter_is_active(&old->filters[i]) &&
+              filter_equal(&old->filters[i], &cur->filters[j]);
+    if (!known)
+      added[num_added++] = cur->filters[j];
+  }
+
+  /* Nothing new: applying again means reloading */
+  LocalRules rules;
+  local_rules_for_driver(conn->driver->name, &rules);
+  bool ok = num_added > 0 && local_filter_rows(tab->data, added, num_added,
+                                               tab->schema, &rules);
+  free(added);
+  if (!ok)
+    return false;
+
+  tab->total_rows = tab->data->num_rows;
+  tab->loaded_count = tab->data->num_rows;
+  tab_record_data_filters(tab);
+
+  tab->cursor_row = 0;
+  tab->scroll_row = 0;
+  tui_calculate_column_widths(state);
+  return true;
+}
+
 /* Load more rows at end of current data */
 bool tui_load_more_rows(TuiState *state) {
   Tab *tab = TUI_TAB(state);
@@ -463,19 +676,20 @@ bool tui_load_more_rows(TuiState *state) {
     return false;
 
   /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
+  size_t query_offset = new_offset;
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_page_where_params(state, &query_offset, &params, &num_params);
+  char *order_clause = tui_build_order_clause(state);
 
   char *err = NULL;
-  ResultSet *more;
-  if (where_clause) {
-    more = db_query_page_where(conn, tab->table_name, new_offset, PAGE_SIZE,
-                               where_clause, order_clause, false, &err);
-  } else {
-    more = db_query_page(conn, tab->table_name, new_offset, PAGE_SIZE,
-                         order_clause, false, &err);
-  }
+  size_t page_rows = tui_page_rows(state);
+  ResultSet *more = fetch_table_page(state, tab, conn, where_clause, params,
+                                     num_params, order_clause, query_offset,
+                                     page_rows, &err);
   free(where_clause);
+  FREE_ARRAY(params, num_params, db_value_free);
   free(order_clause);
   if (!more || more->num_rows == 0) {
     if (more)
@@ -501,18 +715,10 @@ bool tui_load_more_rows(TuiState *state) {
     return false;
   }
 
-  tab->data->rows = safe_reallocarray(tab->data->rows, new_count, sizeof(Row));
-
-  /* Copy new rows */
-  for (size_t i = 0; i < more->num_rows; i++) {
-    tab->data->rows[old_count + i] = more->rows[i];
-    /* Clear source so free doesn't deallocate the cells we moved */
-    more->rows[i].cells = NULL;
-    more->rows[i].num_cells = 0;
-  }
-
-  tab->data->num_rows = new_count;
+  db_result_append_rows(tab->data, more);
   tab->loaded_count = new_count;
+  tui_column_stats_add(tab, old_count, more->num_rows);
+  sync_vm_window(state, tab);
 
   db_result_free(more);
 
@@ -532,24 +738,25 @@ bool tui_load_rows_at(TuiState *state, size_t offset) {
     return false;
 
   /* Clamp offset */
+  size_t page_rows = tui_page_rows(state);
   if (offset >= tab->total_rows) {
-    offset = tab->total_rows > PAGE_SIZE ? tab->total_rows - PAGE_SIZE : 0;
+    offset = tab->total_rows > page_rows ? tab->total_rows - page_rows : 0;
   }
 
   /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
+  size_t query_offset = offset;
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_page_where_params(state, &query_offset, &params, &num_params);
+  char *order_clause = tui_build_order_clause(state);
 
   char *err = NULL;
-  ResultSet *data;
-  if (where_clause) {
-    data = db_query_page_where(conn, tab->table_name, offset, PAGE_SIZE,
-                               where_clause, order_clause, false, &err);
-  } else {
-    data = db_query_page(conn, tab->table_name, offset, PAGE_SIZE, order_clause,
-                         false, &err);
-  }
+  ResultSet *data = fetch_table_page(state, tab, conn, where_clause, params,
+                                     num_params, order_clause, query_offset,
+                                     page_rows, &err);
   free(where_clause);
+  FREE_ARRAY(params, num_params, db_value_free);
   free(order_clause);
   if (!data) {
     tui_set_error(state, "Query failed: %s", err ? err : "Unknown error");
@@ -564,6 +771,8 @@ bool tui_load_rows_at(TuiState *state, size_t offset) {
   tab->data = data;
   tab->loaded_offset = offset;
   tab->loaded_count = data->num_rows;
+  tab_record_data_filters(tab);
+  sync_vm_window(state, tab);
 
   /* Apply schema column names */
   if (tab->schema && tab->data) {
@@ -580,6 +789,7 @@ bool tui_load_rows_at(TuiState *state, size_t offset) {
     }
   }
 
+  column_stats_replace(state, tab);
   return true;
 }
 
@@ -593,7 +803,7 @@ bool tui_load_prev_rows(TuiState *state) {
     return false; /* Already at beginning */
 
   /* Calculate how many rows to load before current offset */
-  size_t load_count = PAGE_SIZE;
+  size_t load_count = tui_page_rows(state);
   size_t new_offset = 0;
   if (tab->loaded_offset > load_count) {
     new_offset = tab->loaded_offset - load_count;
@@ -603,19 +813,19 @@ bool tui_load_prev_rows(TuiState *state) {
   }
 
   /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
+  size_t query_offset = new_offset;
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_page_where_params(state, &query_offset, &params, &num_params);
+  char *order_clause = tui_build_order_clause(state);
 
   char *err = NULL;
-  ResultSet *more;
-  if (where_clause) {
-    more = db_query_page_where(conn, tab->table_name, new_offset, load_count,
-                               where_clause, order_clause, false, &err);
-  } else {
-    more = db_query_page(conn, tab->table_name, new_offset, load_count,
-                         order_clause, false, &err);
-  }
+  ResultSet *more = fetch_table_page(state, tab, conn, where_clause, params,
+                                     num_params, order_clause, query_offset,
+                                     load_count, &err);
   free(where_clause);
+  FREE_ARRAY(params, num_params, db_value_free);
   free(order_clause);
   if (!more || more->num_rows == 0) {
     if (more)
@@ -635,25 +845,8 @@ bool tui_load_prev_rows(TuiState *state) {
     return false;
   }
 
-  Row *new_rows = safe_reallocarray(NULL, new_count, sizeof(Row));
-
-  /* Copy new rows first (prepend) */
-  for (size_t i = 0; i < more->num_rows; i++) {
-    new_rows[i] = more->rows[i];
-    /* Clear source so free doesn't deallocate the cells we moved */
-    more->rows[i].cells = NULL;
-    more->rows[i].num_cells = 0;
-  }
-
-  /* Then copy old rows */
-  for (size_t i = 0; i < old_count; i++) {
-    new_rows[more->num_rows + i] = tab->data->rows[i];
-  }
-
-  /* Free old array (but not the cells which we moved) */
-  free(tab->data->rows);
-  tab->data->rows = new_rows;
-  tab->data->num_rows = new_count;
+  db_result_prepend_rows(tab->data, more);
+  tui_column_stats_add(tab, 0, more->num_rows);
 
   /* Get current cursor/scroll from tab (authoritative source) */
   size_t cursor_row = tab->cursor_row;
@@ -677,6 +870,7 @@ bool tui_load_prev_rows(TuiState *state) {
   /* Update tracking */
   tab->loaded_offset = new_offset;
   tab->loaded_count = new_count;
+  sync_vm_window(state, tab);
 
   db_result_free(more);
 
@@ -688,13 +882,14 @@ bool tui_load_prev_rows(TuiState *state) {
   return true;
 }
 
-/* Trim loaded data to keep memory bounded */
-void tui_trim_loaded_data(TuiState *state) {
+/* Trim the loaded window to at most max_pages pages around the cursor */
+static void trim_table_rows(TuiState *state, size_t max_pages) {
   Tab *tab = TUI_TAB(state);
   if (!tab || !tab->data || tab->data->num_rows == 0)
     return;
 
-  size_t max_rows = MAX_LOADED_PAGES * PAGE_SIZE;
+  size_t page_rows = tui_page_rows(state);
+  size_t max_rows = max_pages * page_rows;
   if (tab->loaded_count <= max_rows)
     return;
 
@@ -703,25 +898,36 @@ void tui_trim_loaded_data(TuiState *state) {
   size_t scroll_row = tab->scroll_row;
 
   /* Calculate cursor's page within loaded data */
-  size_t cursor_page = cursor_row / PAGE_SIZE;
-  size_t total_pages = (tab->loaded_count + PAGE_SIZE - 1) / PAGE_SIZE;
+  size_t cursor_page = cursor_row / page_rows;
+  size_t total_pages = (tab->loaded_count + page_rows - 1) / page_rows;
+
+  /* Determine pages to keep: TRIM_DISTANCE_PAGES on each side of cursor
+   * while idle; while scrolling, one page behind and the rest ahead so the
+   * prefetched rows survive */
+  size_t pages_before = TRIM_DISTANCE_PAGES;
+  size_t pages_after = TRIM_DISTANCE_PAGES;
+  int direction = prefetch_motion_direction(&tab->motion);
+  if (direction != 0 && max_pages > 2) {
+    size_t ahead = max_pages - 2;
+    pages_before = direction > 0 ? 1 : ahead;
+    pages_after = direction > 0 ? ahead : 1;
+  }
 
-  /* Determine pages to keep: TRIM_DISTANCE_PAGES on each side of cursor */
   size_t keep_start_page = 0;
   size_t keep_end_page = total_pages;
 
-  if (cursor_page > TRIM_DISTANCE_PAGES) {
-    keep_start_page = cursor_page - TRIM_DISTANCE_PAGES;
+  if (cursor_page > pages_before) {
+    keep_start_page = cursor_page - pages_before;
   }
-  if (cursor_page + TRIM_DISTANCE_PAGES + 1 < total_pages) {
-    keep_end_page = cursor_page + TRIM_DISTANCE_PAGES + 1;
+  if (cursor_page + pages_after + 1 < total_pages) {
+    keep_end_page = cursor_page + pages_after + 1;
   }
 
-  /* Ensure we don't exceed MAX_LOADED_PAGES */
+  /* Ensure we don't exceed max_pages */
   size_t pages_to_keep = keep_end_page - keep_start_page;
-  if (pages_to_keep > MAX_LOADED_PAGES) {
+  if (pages_to_keep > max_pages) {
     /* Trim from the end that's farther from cursor */
-    size_t excess = pages_to_keep - MAX_LOADED_PAGES;
+    size_t excess = pages_to_keep - max_pages;
     size_t pages_before_cursor = cursor_page - keep_start_page;
     size_t pages_after_cursor = keep_end_page - cursor_page - 1;
 
@@ -733,8 +939,8 @@ void tui_trim_loaded_data(TuiState *state) {
   }
 
   /* Convert pages to row indices */
-  size_t trim_start = keep_start_page * PAGE_SIZE;
-  size_t trim_end = keep_end_page * PAGE_SIZE;
+  size_t trim_start = keep_start_page * page_rows;
+  size_t trim_end = keep_end_page * page_rows;
   if (trim_end > tab->loaded_count)
     trim_end = tab->loaded_count;
 
@@ -742,34 +948,14 @@ void tui_trim_loaded_data(TuiState *state) {
   if (trim_start == 0 && trim_end >= tab->loaded_count)
     return;
 
-  /* Free rows before trim_start */
-  for (size_t i = 0; i < trim_start; i++) {
-    Row *row = &tab->data->rows[i];
-    for (size_t j = 0; j < row->num_cells; j++) {
-      db_value_free(&row->cells[j]);
-    }
-    free(row->cells);
-  }
-
-  /* Free rows after trim_end */
-  for (size_t i = trim_end; i < tab->loaded_count; i++) {
-    Row *row = &tab->data->rows[i];
-    for (size_t j = 0; j < row->num_cells; j++) {
-      db_value_free(&row->cells[j]);
-    }
-    free(row->cells);
-  }
+  /* Drop trimmed rows from column width statistics */
+  tui_column_stats_remove(tab, 0, trim_start);
+  tui_column_stats_remove(tab, trim_end, tab->loaded_count - trim_end);
 
-  /* Move remaining rows to beginning of array */
+  /* Free rows outside [trim_start, trim_end); the kept rows stay in place */
   size_t new_count = trim_end - trim_start;
-  if (trim_start > 0) {
-    memmove(tab->data->rows, tab->data->rows + trim_start,
-            new_count * sizeof(Row));
-  }
-
-  /* Resize array (realloc to shrink) */
-  tab->data->rows = safe_reallocarray(tab->data->rows, new_count, sizeof(Row));
-  tab->data->num_rows = new_count;
+  db_result_drop_back(tab->data, tab->loaded_count - trim_end);
+  db_result_drop_front(tab->data, trim_start);
 
   /* Adjust cursor and scroll positions */
   if (cursor_row >= trim_start) {
@@ -798,6 +984,111 @@ void tui_trim_loaded_data(TuiState *state) {
   /* Update tracking */
   tab->loaded_offset += trim_start;
   tab->loaded_count = new_count;
+  sync_vm_window(state, tab);
+}
+
+/* Trim loaded data to keep memory bounded */
+void tui_trim_loaded_data(TuiState *state) {
+  trim_table_rows(state, window_pages(state));
+  tui_enforce_memory_budget(state);
+}
+
+/* Pages of a rows-long window (holding bytes) to keep so that over bytes
+ * are shed, never fewer than the cursor page */
+static size_t budget_keep_pages(size_t rows, size_t page_rows, size_t bytes,
+                                size_t over) {
+  size_t pages = (rows + page_rows - 1) / page_rows;
+  if (pages <= 1 || bytes == 0)
+    return pages;
+  size_t page_bytes = bytes / pages;
+  if (page_bytes == 0)
+    page_bytes = 1;
+  size_t drop = (over + page_bytes - 1) / page_bytes;
+  return drop < pages ? pages - drop : 1;
+}
+
+void tui_enforce_memory_budget(TuiState *state) {
+  AppState *app = state ? state->app : NULL;
+  Tab *tab = TUI_TAB(state);
+  if (!app || !tab)
+    return;
+
+  mem_budget_touch(app, tab);
+  size_t limit = mem_budget_limit(app);
+  if (limit == 0)
+    return;
+
+  /* Other tabs go first, least recently used first */
+  size_t total = mem_budget_evict_lru(app, tab, limit);
+  if (total <= limit)
+    return;
+
+  /* Still over: shrink this tab's window towards the cursor page */
+  size_t over = total - limit;
+  if (tab->type == TAB_TYPE_TABLE && tab->data) {
+    trim_table_rows(state,
+                    budget_keep_pages(tab->loaded_count, tui_page_rows(state),
+                                      tab->mem_bytes, over));
+  } else if (tab->type == TAB_TYPE_QUERY && tab->query_paginated &&
+             tab->query_results) {
+    query_trim_to_pages(tab, budget_keep_pages(tab->query_loaded_count,
+                                               PAGE_SIZE, tab->mem_bytes,
+                                               over));
+  }
+  mem_budget_touch(app, tab);
+}
+
+void tui_restore_evicted_rows(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  if (!tab || !tab->rows_evicted)
+    return;
+  if (tab->needs_refresh) {
+    tab->rows_evicted = false; /* The refresh reloads around the cursor */
+    return;
+  }
+
+  if (tab->type == TAB_TYPE_TABLE) {
+    size_t abs_row = tab->loaded_offset + tab->cursor_row;
+    size_t abs_scroll = tab->loaded_offset + tab->scroll_row;
+    size_t page_rows = tui_page_rows(state);
+    if (!tui_load_rows_at_with_dialog(state, (abs_row / page_rows) * page_rows))
+      return;
+
+    size_t rows = tab->data ? tab->data->num_rows : 0;
+    tab->cursor_row =
+        abs_row >= tab->loaded_offset ? abs_row - tab->loaded_offset : 0;
+    if (rows > 0 && tab->cursor_row >= rows)
+      tab->cursor_row = rows - 1;
+    tab->scroll_row =
+        abs_scroll >= tab->loaded_offset ? abs_scroll - tab->loaded_offset : 0;
+    if (tab->scroll_row > tab->cursor_row)
+      tab->scroll_row = tab->cursor_row;
+
+    VmTable *vm = tui_vm_table(state);
+    if (vm) {
+      vm_table_set_cursor(vm, tab->cursor_row, tab->cursor_col);
+      vm_table_set_scroll(vm, tab->scroll_row, tab->scroll_col);
+    }
+    UITabState *ui = TUI_TAB_UI(state);
+    if (ui && ui->table_widget)
+      table_widget_sync_from_tab(ui->table_widget);
+  } else if (tab->type == TAB_TYPE_QUERY) {
+    size_t abs_row = tab->query_loaded_offset + tab->query_result_row;
+    size_t abs_scroll = tab->query_loaded_offset + tab->query_result_scroll_row;
+    if (!query_load_rows_at(state, tab, (abs_row / PAGE_SIZE) * PAGE_SIZE))
+      return;
+
+    size_t rows = tab->query_results ? tab->query_results->num_rows : 0;
+    size_t base = tab->query_loaded_offset;
+    tab->query_result_row = abs_row >= base ? abs_row - base : 0;
+    if (rows > 0 && tab->query_result_row >= rows)
+      tab->query_result_row = rows - 1;
+    tab->query_result_scroll_row = abs_scroll >= base ? abs_scroll - base : 0;
+    if (tab->query_result_scroll_row > tab->query_result_row)
+      tab->query_result_scroll_row = tab->query_result_row;
+  }
+
+  tab->rows_evicted = false;
 }
 
 /* Check if more rows need to be loaded based on cursor position */
@@ -806,6 +1097,11 @@ void tui_check_load_more(TuiState *state) {
   if (!tab || !tab->data)
     return;
 
+  /* Held keys never reach the idle poll: merge a finished prefetch and
+   * start the next one from here */
+  tui_poll_background_load(state);
+  tui_check_speculative_prefetch(state);
+
   /* Don't do synchronous load if background load is in progress */
   if (tab->bg_load_op != NULL)
     return;
@@ -853,38 +1149,12 @@ static bool merge_page_result(TuiState *state, ResultSet *new_data,
   }
 
   if (forward) {
-    /* Append: extend existing rows array */
-    tab->data->rows = safe_reallocarray(tab->data->rows, new_count, sizeof(Row));
-
-    /* Copy new rows at end */
-    for (size_t i = 0; i < new_data->num_rows; i++) {
-      tab->data->rows[old_count + i] = new_data->rows[i];
-      /* Clear source so free doesn't deallocate cells we moved */
-      new_data->rows[i].cells = NULL;
-      new_data->rows[i].num_cells = 0;
-    }
-
-    tab->data->num_rows = new_count;
+    db_result_append_rows(tab->data, new_data);
     tab->loaded_count = new_count;
+    tui_column_stats_add(tab, old_count, new_data->num_rows);
   } else {
-    /* Prepend: allocate new array */
-    Row *new_rows = safe_reallocarray(NULL, new_count, sizeof(Row));
-
-    /* Copy new rows first */
-    for (size_t i = 0; i < new_data->num_rows; i++) {
-      new_rows[i] = new_data->rows[i];
-      new_data->rows[i].cells = NULL;
-      new_data->rows[i].num_cells = 0;
-    }
-
-    /* Then copy old rows */
-    for (size_t i = 0; i < old_count; i++) {
-      new_rows[new_data->num_rows + i] = tab->data->rows[i];
-    }
-
-    free(tab->data->rows);
-    tab->data->rows = new_rows;
-    tab->data->num_rows = new_count;
+    db_result_prepend_rows(tab->data, new_data);
+    tui_column_stats_add(tab, 0, new_data->num_rows);
 
     /* Get current cursor/scroll from tab (authoritative source) */
     size_t cursor_row = tab->cursor_row;
@@ -910,9 +1180,40 @@ static bool merge_page_result(TuiState *state, ResultSet *new_data,
     tab->loaded_count = new_count;
   }
 
+  sync_vm_window(state, tab);
   return true;
 }
 
+/* Make new_data, loaded from the absolute offset, the loaded window */
+static void replace_loaded_rows(TuiState *state, Tab *tab, ResultSet *new_data,
+                                size_t offset) {
+  /* Apply schema column names */
+  if (tab->schema) {
+    size_t min_cols = tab->schema->num_columns;
+    if (new_data->num_columns < min_cols) {
+      min_cols = new_data->num_columns;
+    }
+    for (size_t i = 0; i < min_cols; i++) {
+      if (tab->schema->columns[i].name) {
+        free(new_data->columns[i].name);
+        new_data->columns[i].name = str_dup(tab->schema->columns[i].name);
+        new_data->columns[i].type = tab->schema->columns[i].type;
+      }
+    }
+  }
+
+  /* Free old data and replace */
+  if (tab->data) {
+    db_result_free(tab->data);
+  }
+  tab->data = new_data;
+  tab->loaded_offset = offset;
+  tab->loaded_count = new_data->num_rows;
+  tab_record_data_filters(tab);
+  sync_vm_window(state, tab);
+  column_stats_replace(state, tab);
+}
+
 /* Load rows at specific offset with blocking dialog (for goto/home/end) */
 bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset) {
   Tab *tab = TUI_TAB(state);
@@ -927,32 +1228,48 @@ bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset) {
   bool was_approximate = tab->row_count_approximate;
 
   /* Clamp offset */
+  size_t page_rows = tui_page_rows(state);
   if (offset >= tab->total_rows) {
-    offset = tab->total_rows > PAGE_SIZE ? tab->total_rows - PAGE_SIZE : 0;
+    offset = tab->total_rows > page_rows ? tab->total_rows - page_rows : 0;
   }
 
   /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
+  size_t query_offset = offset;
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_page_where_params(state, &query_offset, &params, &num_params);
+  char *order_clause = tui_build_order_clause(state);
 
   /* Setup async operation */
   AsyncOperation op;
   async_init(&op);
   op.conn = conn;
   op.table_name = str_dup(tab->table_name);
-  op.offset = offset;
-  op.limit = PAGE_SIZE * PREFETCH_PAGES;
+  op.offset = query_offset;
+  op.limit = page_rows * prefetch_pages(state);
   op.order_by = order_clause; /* Takes ownership */
   op.desc = false;
 
   if (where_clause) {
     op.op_type = ASYNC_OP_QUERY_PAGE_WHERE;
     op.where_clause = str_dup(where_clause);
+    op.params = params; /* Takes ownership */
+    op.num_params = num_params;
   } else {
     op.op_type = ASYNC_OP_QUERY_PAGE;
   }
   free(where_clause);
 
+  /* Another tab on the same rows may hold the page already */
+  ResultSet *shared = shared_page_get_op(state, tab, &op);
+  if (shared) {
+    async_free(&op);
+    replace_loaded_rows(state, tab, shared, offset);
+    return true;
+  }
+
+  uint64_t started = lace_time_ms();
   if (!async_start(&op)) {
     async_free(&op);
     return false;
@@ -1003,8 +1320,8 @@ bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset) {
         tab->row_count_approximate = false;
 
         /* Recalculate offset and retry */
-        size_t new_offset = (size_t)exact_count > PAGE_SIZE
-                                ? (size_t)exact_count - PAGE_SIZE
+        size_t new_offset = (size_t)exact_count > page_rows
+                                ? (size_t)exact_count - page_rows
                                 : 0;
 
         /* Refresh screen before next dialog */
@@ -1017,29 +1334,9 @@ bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset) {
       return false;
     }
 
-    /* Apply schema column names */
-    if (tab->schema && new_data) {
-      size_t min_cols = tab->schema->num_columns;
-      if (new_data->num_columns < min_cols) {
-        min_cols = new_data->num_columns;
-      }
-      for (size_t i = 0; i < min_cols; i++) {
-        if (tab->schema->columns[i].name) {
-          free(new_data->columns[i].name);
-          new_data->columns[i].name = str_dup(tab->schema->columns[i].name);
-          new_data->columns[i].type = tab->schema->columns[i].type;
-        }
-      }
-    }
-
-    /* Free old data and replace */
-    if (tab->data) {
-      db_result_free(tab->data);
-    }
-    tab->data = new_data;
-    tab->loaded_offset = offset;
-    tab->loaded_count = new_data->num_rows;
-
+    record_page_load(state, tab, started, new_data);
+    shared_page_put_op(state, tab, &op, new_data);
+    replace_loaded_rows(state, tab, new_data, offset);
     success = true;
   } else if (op.state == ASYNC_STATE_CANCELLED) {
     tui_set_status(state, "Load cancelled");
@@ -1052,155 +1349,209 @@ bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset) {
   return success;
 }
 
-/* Load a page with blocking dialog (for fast scrolling past loaded data) */
-bool tui_load_page_with_dialog(TuiState *state, bool forward) {
-  Tab *tab = TUI_TAB(state);
-  DbConnection *conn = TUI_CONN(state);
-  if (!tab || !conn || !tab->table_name)
+/* Loaded window of a table or query tab: absolute offset of its first row,
+ * rows held and rows in total */
+static void loaded_window(const Tab *tab, size_t *offset, size_t *count,
+                          size_t *total) {
+  if (tab->type == TAB_TYPE_QUERY) {
+    *offset = tab->query_loaded_offset;
+    *count = tab->query_loaded_count;
+    *total = tab->query_total_rows;
+  } else {
+    *offset = tab->loaded_offset;
+    *count = tab->loaded_count;
+    *total = tab->total_rows;
+  }
+}
+
+/* Whether the background load still borders the loaded window. A load the
+ * window moved away from (jump, trim, reload) is stale and must not be
+ * merged. */
+static bool bg_load_adjacent(const Tab *tab) {
+  const AsyncOperation *op = (const AsyncOperation *)tab->bg_load_op;
+  if (!op)
     return false;
+  size_t first, count, total;
+  loaded_window(tab, &first, &count, &total);
+  /* op->offset may be relative to a landmark; the target is absolute */
+  if (tab->bg_load_forward)
+    return tab->bg_load_target_offset == first + count;
+  return tab->bg_load_target_offset + op->limit == first;
+}
 
-  /* Check if a background load is already running in the same direction */
-  if (tab->bg_load_op != NULL && tab->bg_load_forward == forward) {
-    AsyncOperation *bg_op = (AsyncOperation *)tab->bg_load_op;
+/* Offset and size of the next page load beside the loaded window.
+ * Returns false at the edge of the data. */
+static bool next_page_range(TuiState *state, Tab *tab, bool forward,
+                            size_t *offset, size_t *count) {
+  PrefetchPlan plan;
+  plan_page_load(state, tab, &plan);
 
-    /* Show progress dialog and wait for existing operation */
-    bool completed =
-        tui_show_processing_dialog(state, bg_op, "Loading data...");
+  size_t first, loaded, total;
+  loaded_window(tab, &first, &loaded, &total);
+  if (forward) {
+    *offset = first + loaded;
+    if (*offset >= total)
+      return false; /* No more data */
+    *count = plan.rows;
+  } else {
+    if (first == 0)
+      return false; /* Already at beginning */
+    /* End exactly at the window so prepended rows never overlap it */
+    *count = plan.rows < first ? plan.rows : first;
+    *offset = first - *count;
+  }
+  return true;
+}
+
+/* Build (but don't start) an operation loading count rows of tab from the
+ * absolute offset. Query tabs read from their server-side cursor when they
+ * hold one and re-run the query with LIMIT/OFFSET otherwise. */
+static AsyncOperation *new_page_load(TuiState *state, Tab *tab, size_t offset,
+                                     size_t count) {
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn)
+    return NULL;
+
+  AsyncOperation *op = NULL;
+  if (tab->type == TAB_TYPE_QUERY) {
+    if (!tab->query_paginated || !tab->query_base_sql)
+      return NULL;
+    op = safe_malloc(sizeof(AsyncOperation));
+    async_init(op);
+    op->conn = conn;
+    op->offset = offset;
+    op->limit = count;
+    if (tab->query_server_cursor) {
+      op->op_type = ASYNC_OP_CURSOR_FETCH;
+      op->cursor = tab->query_server_cursor;
+      /* The cursor may hold a connection of its own (cancel goes there) */
+      op->conn = tab->query_server_cursor->conn;
+    } else {
+      op->op_type = ASYNC_OP_QUERY;
+      op->sql = str_printf("%s LIMIT %zu OFFSET %zu", tab->query_base_sql,
+                           count, offset);
+    }
+    return op;
+  }
+
+  if (!tab->table_name)
+    return NULL;
+
+  /* Build WHERE clause from filters */
+  size_t query_offset = offset;
+  DbValue *params = NULL;
+  size_t num_params = 0;
+  char *where_clause =
+      tui_build_page_where_params(state, &query_offset, &params, &num_params);
+  char *order_clause = tui_build_order_clause(state);
+
+  op = safe_malloc(sizeof(AsyncOperation));
+  async_init(op);
+  op->conn = conn;
+  op->table_name = str_dup(tab->table_name);
+  op->offset = query_offset;
+  op->limit = count;
+  op->order_by = order_clause; /* Takes ownership */
+  op->desc = false;
+
+  if (where_clause) {
+    op->op_type = ASYNC_OP_QUERY_PAGE_WHERE;
+    op->where_clause = where_clause; /* Takes ownership */
+    op->params = params;
+    op->num_params = num_params;
+  } else {
+    op->op_type = ASYNC_OP_QUERY_PAGE;
+  }
+  return op;
+}
 
-    bool success = false;
-    if (completed && bg_op->state == ASYNC_STATE_COMPLETED && bg_op->result) {
-      ResultSet *new_data = (ResultSet *)bg_op->result;
+/* Collect the finished background load: merge it if it still borders the
+ * window, report the outcome if asked to, and free the operation.
+ * Returns true if rows were merged. */
+static bool finish_background_load(TuiState *state, Tab *tab, bool report) {
+  AsyncOperation *op = (AsyncOperation *)tab->bg_load_op;
+  bool merged = false;
 
+  if (op->state == ASYNC_STATE_COMPLETED && op->result) {
+    ResultSet *new_data = (ResultSet *)op->result;
+    op->result = NULL;
+    record_page_load(state, tab, tab->bg_load_started, new_data);
+
+    if (tab->type == TAB_TYPE_QUERY) {
+      /* Query pages trim themselves as they merge */
+      if (bg_load_adjacent(tab))
+        merged = query_merge_rows(state, tab, new_data,
+                                  tab->bg_load_target_offset);
+    } else {
       /* Apply schema column names */
-      if (tab->schema && new_data) {
+      if (tab->schema) {
         size_t min_cols = tab->schema->num_columns;
         if (new_data->num_columns < min_cols) {
           min_cols = new_data->num_columns;
         }
         for (size_t i = 0; i < min_cols; i++) {
           if (tab->schema->columns[i].name) {
-            char *dup = str_dup(tab->schema->columns[i].name);
-            if (dup) {
-              free(new_data->columns[i].name);
-              new_data->columns[i].name = dup;
-            }
+            free(new_data->columns[i].name);
+            new_data->columns[i].name = str_dup(tab->schema->columns[i].name);
             new_data->columns[i].type = tab->schema->columns[i].type;
           }
         }
       }
 
-      /* Merge into existing data */
-      success = merge_page_result(state, new_data, forward);
-      if (success) {
-        tui_trim_loaded_data(state);
-        tui_set_status(state, "Loaded %zu/%zu rows", tab->loaded_count,
-                       tab->total_rows);
+      /* Merge into existing data, unless the window moved meanwhile */
+      if (bg_load_adjacent(tab)) {
+        shared_page_put_op(state, tab, op, new_data);
+        merged = merge_page_result(state, new_data, tab->bg_load_forward);
       }
-
-      db_result_free(new_data);
-    } else if (bg_op->state == ASYNC_STATE_CANCELLED) {
-      tui_set_status(state, "Load cancelled");
-    } else if (bg_op->state == ASYNC_STATE_ERROR) {
-      tui_set_error(state, "Load failed: %s",
-                    bg_op->error ? bg_op->error : "Unknown error");
+      if (merged)
+        tui_trim_loaded_data(state);
     }
 
-    /* Clean up background operation */
-    async_free(bg_op);
-    free(bg_op);
-    tab->bg_load_op = NULL;
-    state->bg_loading_active = false;
-
-    return success;
-  }
-
-  /* No compatible background load - cancel any existing and start new */
-  tui_cancel_background_load(state);
+    /* Free the result set structure (cells were moved) */
+    db_result_free(new_data);
 
-  /* Calculate target offset */
-  size_t target_offset;
-  if (forward) {
-    target_offset = tab->loaded_offset + tab->loaded_count;
-    /* Check if there are more rows */
-    if (target_offset >= tab->total_rows)
-      return false;
-  } else {
-    if (tab->loaded_offset == 0)
-      return false; /* Already at beginning */
-    target_offset = tab->loaded_offset >= PAGE_SIZE
-                        ? tab->loaded_offset - PAGE_SIZE
-                        : 0;
+    if (merged && report) {
+      size_t first, count, total;
+      loaded_window(tab, &first, &count, &total);
+      tui_set_status(state, "Loaded %zu/%zu rows", count, total);
+    }
+  } else if (report && op->state == ASYNC_STATE_CANCELLED) {
+    tui_set_status(state, "Load cancelled");
+  } else if (report && op->state == ASYNC_STATE_ERROR) {
+    tui_set_error(state, "Load failed: %s",
+                  op->error ? op->error : "Unknown error");
   }
 
-  /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
-
-  /* Setup async operation */
-  AsyncOperation op;
-  async_init(&op);
-  op.conn = conn;
-  op.table_name = str_dup(tab->table_name);
-  op.offset = target_offset;
-  op.limit = PAGE_SIZE * PREFETCH_PAGES;
-  op.order_by = order_clause; /* Takes ownership */
-  op.desc = false;
+  /* Clean up */
+  async_free(op);
+  free(op);
+  tab->bg_load_op = NULL;
+  state->bg_loading_active = false;
 
-  if (where_clause) {
-    op.op_type = ASYNC_OP_QUERY_PAGE_WHERE;
-    op.where_clause = str_dup(where_clause);
-  } else {
-    op.op_type = ASYNC_OP_QUERY_PAGE;
-  }
-  free(where_clause);
+  return merged;
+}
 
-  if (!async_start(&op)) {
-    async_free(&op);
+/* Load a page with blocking dialog (for fast scrolling past loaded data) */
+bool tui_load_page_with_dialog(TuiState *state, bool forward) {
+  Tab *tab = TUI_TAB(state);
+  if (!tab)
     return false;
-  }
-
-  /* Show blocking dialog - same as table open */
-  bool completed = tui_show_processing_dialog(state, &op, "Loading data...");
 
-  bool success = false;
-  if (completed && op.state == ASYNC_STATE_COMPLETED && op.result) {
-    ResultSet *new_data = (ResultSet *)op.result;
-
-    /* Apply schema column names */
-    if (tab->schema && new_data) {
-      size_t min_cols = tab->schema->num_columns;
-      if (new_data->num_columns < min_cols) {
-        min_cols = new_data->num_columns;
-      }
-      for (size_t i = 0; i < min_cols; i++) {
-        if (tab->schema->columns[i].name) {
-          free(new_data->columns[i].name);
-          new_data->columns[i].name = str_dup(tab->schema->columns[i].name);
-          new_data->columns[i].type = tab->schema->columns[i].type;
-        }
-      }
-    }
-
-    /* Merge into existing data */
-    success = merge_page_result(state, new_data, forward);
-    if (success) {
-      /* Trim old data to keep memory bounded */
-      tui_trim_loaded_data(state);
-      tui_set_status(state, "Loaded %zu/%zu rows", tab->loaded_count,
-                     tab->total_rows);
-    }
-
-    /* Free the result set structure (cells were moved) */
-    db_result_free(new_data);
-  } else if (op.state == ASYNC_STATE_CANCELLED) {
-    tui_set_status(state, "Load cancelled");
-  } else if (op.state == ASYNC_STATE_ERROR) {
-    tui_set_error(state, "Load failed: %s",
-                  op.error ? op.error : "Unknown error");
+  /* Wait for a background load already running in the same direction;
+   * anything else is superseded by a fresh load */
+  if (tab->bg_load_op == NULL || tab->bg_load_forward != forward ||
+      !bg_load_adjacent(tab)) {
+    tui_cancel_background_load(state);
+    if (!tui_start_background_load(state, forward))
+      return false;
+    if (!tab->bg_load_op)
+      return true; /* Merged from a shared page */
   }
 
-  async_free(&op);
-  return success;
+  /* Show progress dialog - same as table open */
+  tui_show_processing_dialog(state, (AsyncOperation *)tab->bg_load_op,
+                             "Loading data...");
+  return finish_background_load(state, tab, true);
 }
 
 /* ============================================================================
@@ -1208,53 +1559,37 @@ bool tui_load_page_with_dialog(TuiState *state, bool forward) {
  * ============================================================================
  */
 
-/* Start background load (non-blocking) - returns true if started */
+/* Start background load (non-blocking) - returns true if started, or if
+ * the rows came from a page another tab holds (no load is left running) */
 bool tui_start_background_load(TuiState *state, bool forward) {
   Tab *tab = TUI_TAB(state);
-  DbConnection *conn = TUI_CONN(state);
-  if (!tab || !conn || !tab->table_name)
+  if (!tab)
     return false;
 
   /* Already have a background load in progress */
   if (tab->bg_load_op != NULL)
     return false;
 
-  /* Calculate target offset */
-  size_t target_offset;
-  if (forward) {
-    target_offset = tab->loaded_offset + tab->loaded_count;
-    if (target_offset >= tab->total_rows)
-      return false; /* No more data */
-  } else {
-    if (tab->loaded_offset == 0)
-      return false; /* Already at beginning */
-    target_offset = tab->loaded_offset >= PAGE_SIZE
-                        ? tab->loaded_offset - PAGE_SIZE
-                        : 0;
-  }
-
-  /* Build WHERE clause from filters */
-  char *where_clause = build_filter_where(state);
-  char *order_clause = build_order_clause(state);
-
-  /* Allocate and setup async operation */
-  AsyncOperation *op = safe_malloc(sizeof(AsyncOperation));
+  /* Calculate target range */
+  size_t target_offset, target_count;
+  if (!next_page_range(state, tab, forward, &target_offset, &target_count))
+    return false;
 
-  async_init(op);
-  op->conn = conn;
-  op->table_name = str_dup(tab->table_name);
-  op->offset = target_offset;
-  op->limit = PAGE_SIZE * PREFETCH_PAGES;
-  op->order_by = order_clause; /* Takes ownership */
-  op->desc = false;
+  AsyncOperation *op = new_page_load(state, tab, target_offset, target_count);
+  if (!op)
+    return false;
 
-  if (where_clause) {
-    op->op_type = ASYNC_OP_QUERY_PAGE_WHERE;
-    op->where_clause = str_dup(where_clause);
-  } else {
-    op->op_type = ASYNC_OP_QUERY_PAGE;
+  /* Another tab on the same rows may hold the page: merge it right away */
+  ResultSet *shared = shared_page_get_op(state, tab, op);
+  if (shared) {
+    async_free(op);
+    free(op);
+    bool merged = merge_page_result(state, shared, forward);
+    if (merged)
+      tui_trim_loaded_data(state);
+    db_result_free(shared);
+    return merged;
   }
-  free(where_clause);
 
   if (!async_start(op)) {
     async_free(op);
@@ -1266,6 +1601,7 @@ bool tui_start_background_load(TuiState *state, bool forward) {
   tab->bg_load_op = op;
   tab->bg_load_forward = forward;
   tab->bg_load_target_offset = target_offset;
+  tab->bg_load_started = lace_time_ms();
   state->bg_loading_active = true;
 
   return true;
@@ -1282,49 +1618,12 @@ bool tui_poll_background_load(TuiState *state) {
   if (!op)
     return false;
 
-  AsyncState op_state = async_poll(op);
-
-  if (op_state == ASYNC_STATE_RUNNING) {
+  if (async_poll(op) == ASYNC_STATE_RUNNING) {
     return true; /* Still running */
   }
 
   /* Operation completed (success, error, or cancelled) */
-  bool merged = false;
-
-  if (op_state == ASYNC_STATE_COMPLETED && op->result) {
-    ResultSet *new_data = (ResultSet *)op->result;
-
-    /* Apply schema column names */
-    if (tab->schema && new_data) {
-      size_t min_cols = tab->schema->num_columns;
-      if (new_data->num_columns < min_cols) {
-        min_cols = new_data->num_columns;
-      }
-      for (size_t i = 0; i < min_cols; i++) {
-        if (tab->schema->columns[i].name) {
-          free(new_data->columns[i].name);
-          new_data->columns[i].name = str_dup(tab->schema->columns[i].name);
-          new_data->columns[i].type = tab->schema->columns[i].type;
-        }
-      }
-    }
-
-    /* Merge into existing data */
-    merged = merge_page_result(state, new_data, tab->bg_load_forward);
-    if (merged) {
-      tui_trim_loaded_data(state);
-    }
-
-    db_result_free(new_data);
-  }
-
-  /* Clean up */
-  async_free(op);
-  free(op);
-  tab->bg_load_op = NULL;
-  state->bg_loading_active = false;
-
-  return merged; /* Return true if we merged data (need redraw) */
+  return finish_background_load(state, tab, false);
 }
 
 /* Cancel pending background load */
@@ -1370,34 +1669,63 @@ void tui_cancel_background_load(TuiState *state) {
 /* Check if speculative prefetch should start */
 void tui_check_speculative_prefetch(TuiState *state) {
   Tab *tab = TUI_TAB(state);
-  if (!tab || !tab->data)
+  if (!tab)
     return;
 
-  /* Skip if background load already in progress */
-  if (tab->bg_load_op != NULL)
+  /* Table and paginated query tabs share the pipeline; other tab types
+   * have nothing to page */
+  const ResultSet *data;
+  size_t cursor_row;
+  size_t motion_page;
+  if (tab->type == TAB_TYPE_TABLE) {
+    data = tab->data;
+    cursor_row = tab->cursor_row; /* Authoritative source */
+    motion_page = tui_page_rows(state);
+  } else if (tab->type == TAB_TYPE_QUERY && tab->query_paginated) {
+    data = tab->query_results;
+    cursor_row = tab->query_result_row;
+    motion_page = PAGE_SIZE;
+  } else {
     return;
-
-  /* Skip if we're in a special tab type */
-  if (tab->type != TAB_TYPE_TABLE)
+  }
+  if (!data)
     return;
 
-  /* Get cursor position from tab (authoritative source) */
-  size_t cursor_row = tab->cursor_row;
+  size_t loaded_offset, loaded_count, total_rows;
+  loaded_window(tab, &loaded_offset, &loaded_count, &total_rows);
+  prefetch_motion_sample(&tab->motion, loaded_offset + cursor_row,
+                         motion_page, lace_time_ms());
+
+  /* Start early enough for the load to land before the cursor gets there */
+  PrefetchPlan plan;
+  plan_page_load(state, tab, &plan);
 
   /* Calculate distance from edges */
   size_t rows_from_end =
-      tab->data->num_rows > cursor_row ? tab->data->num_rows - cursor_row : 0;
+      data->num_rows > cursor_row ? data->num_rows - cursor_row : 0;
   size_t rows_from_start = cursor_row;
-
-  /* Prefetch forward when within PREFETCH_THRESHOLD of end */
-  size_t loaded_end = tab->loaded_offset + tab->loaded_count;
-  if (rows_from_end < PREFETCH_THRESHOLD && loaded_end < tab->total_rows) {
+  size_t loaded_end = loaded_offset + loaded_count;
+
+  /* While scrolling only extend the window ahead of the cursor (the rows
+   * behind it are the next to be trimmed); when idle, either edge will do */
+  int direction = prefetch_motion_direction(&tab->motion);
+  bool want_forward = direction >= 0 && rows_from_end < plan.lead &&
+                      loaded_end < total_rows;
+  bool want_backward = direction <= 0 && !want_forward &&
+                       rows_from_start < plan.lead && loaded_offset > 0;
+
+  /* Keep a load in flight while it still borders the window and doesn't
+   * run against the scrolling; supersede it after a jump or a turnaround */
+  if (tab->bg_load_op != NULL) {
+    bool against = direction != 0 && (direction > 0) != tab->bg_load_forward;
+    if (bg_load_adjacent(tab) && !against)
+      return;
+    tui_cancel_background_load(state);
+  }
+
+  if (want_forward) {
     tui_start_background_load(state, true);
-    return;
-  }
-
-  /* Prefetch backward when within PREFETCH_THRESHOLD of start */
-  if (rows_from_start < PREFETCH_THRESHOLD && tab->loaded_offset > 0) {
+  } else if (want_backward) {
     tui_start_background_load(state, false);
   }
 }
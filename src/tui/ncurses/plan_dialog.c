@@ -0,0 +1,414 @@
+/*
+ * Lace
+ * Query Plan Dialog
+ *
+ * Popup showing the plan of the query under the editor cursor as a
+ * collapsible tree. Analyzed plans show per-node time, estimated vs actual
+ * rows and buffers; the nodes doing most of the work are highlighted.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../core/plan.h"
+#include "../../core/result_cache.h"
+#include "../../util/mem.h"
+#include "render_helpers.h"
+#include "tui_internal.h"
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Dialog dimensions */
+#define PLAN_DIALOG_MIN_WIDTH 70
+#define PLAN_DIALOG_MIN_HEIGHT 15
+#define PLAN_DIALOG_MAX_WIDTH_RATIO 0.9
+#define PLAN_DIALOG_MAX_HEIGHT_RATIO 0.85
+
+/* Actual rows this many times off the estimate are flagged */
+#define PLAN_MISESTIMATE_FACTOR 10.0
+
+/* A node on screen */
+typedef struct {
+  PlanNode *node;
+  int depth;
+} PlanLine;
+
+/* Run the EXPLAIN statement for sql, trying each syntax variant the driver
+ * has. Returns the plan, or NULL with *err set (NULL if cancelled). */
+static QueryPlan *run_explain(TuiState *state, const char *sql, bool analyze,
+                              char **err) {
+  DbConnection *conn = TUI_CONN(state);
+  for (int variant = 0;; variant++) {
+    char *explain_sql = plan_explain_sql(conn, sql, analyze, variant);
+    if (!explain_sql)
+      return NULL; /* *err holds the last variant's error */
+
+    AsyncOperation op;
+    async_init(&op);
+    op.op_type = ASYNC_OP_QUERY;
+    op.conn = conn;
+    op.sql = explain_sql; /* ownership transferred */
+
+    ResultSet *rs = NULL;
+    bool cancelled = false;
+    if (async_start(&op)) {
+      bool completed = tui_show_processing_dialog(
+          state, &op, analyze ? "Analyzing query..." : "Explaining query...");
+      if (completed && op.state == ASYNC_STATE_COMPLETED) {
+        rs = (ResultSet *)op.result;
+        op.result = NULL;
+      } else if (op.state == ASYNC_STATE_ERROR) {
+        free(*err);
+        *err = str_dup(op.error ? op.error : "EXPLAIN failed");
+      } else {
+        cancelled = true;
+      }
+    } else {
+      free(*err);
+      *err = str_dup("Failed to start query");
+    }
+    async_free(&op);
+
+    if (cancelled) {
+      free(*err);
+      *err = NULL;
+      return NULL;
+    }
+    if (rs) {
+      free(*err);
+      *err = NULL;
+      QueryPlan *plan = plan_parse(conn, rs, err);
+      db_result_free(rs);
+      if (plan)
+        plan_mark_hot(plan);
+      return plan;
+    }
+  }
+}
+
+/* Nodes in display order, skipping children of collapsed nodes */
+static void flatten(PlanNode *node, int depth, PlanLine **lines, size_t *count,
+                    size_t *cap) {
+  if (*count == *cap) {
+    *cap = *cap ? *cap * 2 : 32;
+    *lines = safe_reallocarray(*lines, *cap, sizeof(PlanLine));
+  }
+  (*lines)[(*count)++] = (PlanLine){node, depth};
+  if (node->collapsed)
+    return;
+  for (size_t i = 0; i < node->num_children; i++)
+    flatten(node->children[i], depth + 1, lines, count, cap);
+}
+
+/* Whether any node of the tree reports buffers */
+static bool has_buffers(const PlanNode *node) {
+  if (node->buf_hit >= 0 || node->buf_read >= 0)
+    return true;
+  for (size_t i = 0; i < node->num_children; i++) {
+    if (has_buffers(node->children[i]))
+      return true;
+  }
+  return false;
+}
+
+/* Row count in at most 7 columns: 950, 12.3k, 4.5M */
+static void format_count(double v, char *buf, size_t size) {
+  if (v < 0)
+    snprintf(buf, size, "-");
+  else if (v < 10000)
+    snprintf(buf, size, "%.0f", v);
+  else if (v < 1e6)
+    snprintf(buf, size, "%.1fk", v / 1e3);
+  else if (v < 1e9)
+    snprintf(buf, size, "%.1fM", v / 1e6);
+  else
+    snprintf(buf, size, "%.1fG", v / 1e9);
+}
+
+static void format_ms(double ms, char *buf, size_t size) {
+  if (ms < 0)
+    snprintf(buf, size, "-");
+  else if (ms < 1000)
+    snprintf(buf, size, "%.2fms", ms);
+  else
+    snprintf(buf, size, "%.2fs", ms / 1000);
+}
+
+static bool misestimated(const PlanNode *n) {
+  if (n->est_rows < 0 || n->act_rows < 0)
+    return false;
+  double est = n->est_rows > 1 ? n->est_rows : 1;
+  double act = n->act_rows > 1 ? n->act_rows : 1;
+  return est / act >= PLAN_MISESTIMATE_FACTOR ||
+         act / est >= PLAN_MISESTIMATE_FACTOR;
+}
+
+/* Measure columns right of the tree */
+static void format_measures(const QueryPlan *plan, const PlanNode *n,
+                            bool buffers, char *buf, size_t size) {
+  char a[16], b[16], c[16], d[16];
+  if (plan->analyzed) {
+    double total = plan->root->total_ms;
+    char share[16] = "-";
+    if (n->self_ms >= 0 && total > 0)
+      snprintf(share, sizeof(share), "%.0f%%", n->self_ms * 100 / total);
+    format_ms(n->total_ms, a, sizeof(a));
+    format_count(n->est_rows, b, sizeof(b));
+    format_count(n->act_rows, c, sizeof(c));
+    format_count(n->loops, d, sizeof(d));
+    int len = snprintf(buf, size, "%10s %5s %8s %8s %6s", a, share, b, c, d);
+    if (buffers && len > 0 && (size_t)len < size) {
+      char hit[16], read[16], both[40];
+      format_count((double)n->buf_hit, hit, sizeof(hit));
+      format_count((double)n->buf_read, read, sizeof(read));
+      snprintf(both, sizeof(both), "%s/%s", hit, read);
+      snprintf(buf + len, size - (size_t)len, " %13s", both);
+    }
+  } else if (n->cost >= 0 || n->est_rows >= 0) {
+    if (n->cost >= 0)
+      snprintf(a, sizeof(a), "%.2f", n->cost);
+    else
+      snprintf(a, sizeof(a), "-");
+    format_count(n->est_rows, b, sizeof(b));
+    snprintf(buf, size, "%12s %8s", a, b);
+  } else {
+    buf[0] = '\0';
+  }
+}
+
+/* Column header matching format_measures */
+static const char *measures_header(const QueryPlan *plan, bool buffers) {
+  if (plan->analyzed)
+    return buffers ? "      Time  Self      Est   Actual  Loops     Hit/Read"
+                   : "      Time  Self      Est   Actual  Loops";
+  return "        Cost      Est";
+}
+
+/* Show the plan of sql */
+void tui_show_plan_dialog(TuiState *state, const char *sql) {
+  if (!state || !state->app || !sql || !*sql)
+    return;
+  DbConnection *conn = TUI_CONN(state);
+  if (!conn) {
+    tui_set_error(state, "Not connected to database");
+    return;
+  }
+
+  /* The plan query needs the connection */
+  tui_cancel_background_load(state);
+
+  /* ANALYZE runs the statement: only offered for reads, and SQLite only
+   * has estimates */
+  bool is_sqlite = str_eq(conn->driver->name, "sqlite");
+  bool can_analyze = !is_sqlite && result_cache_sql_is_read(sql);
+  bool analyze = can_analyze;
+
+  char *err = NULL;
+  QueryPlan *plan = run_explain(state, sql, analyze, &err);
+  if (!plan) {
+    if (err)
+      tui_set_error(state, "EXPLAIN failed: %s", err);
+    else
+      tui_set_status(state, "EXPLAIN cancelled");
+    free(err);
+    return;
+  }
+
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+
+  int width = (int)(term_cols * PLAN_DIALOG_MAX_WIDTH_RATIO);
+  if (width < PLAN_DIALOG_MIN_WIDTH)
+    width = PLAN_DIALOG_MIN_WIDTH;
+  if (width > term_cols - 2)
+    width = term_cols - 2;
+
+  int height = (int)(term_rows * PLAN_DIALOG_MAX_HEIGHT_RATIO);
+  if (height < PLAN_DIALOG_MIN_HEIGHT)
+    height = PLAN_DIALOG_MIN_HEIGHT;
+  if (height > term_rows - 2)
+    height = term_rows - 2;
+
+  WINDOW *dialog = dialog_create(height, width, term_rows, term_cols);
+  if (!dialog) {
+    plan_free(plan);
+    return;
+  }
+
+  /* Layout: header line, node list, detail line, footer */
+  int list_y = 2;
+  size_t visible_rows = height > 6 ? (size_t)(height - 6) : 1;
+  int content_width = width - 2;
+
+  PlanLine *lines = NULL;
+  size_t num_lines = 0, lines_cap = 0;
+  size_t selected = 0;
+  size_t scroll_offset = 0;
+
+  bool running = true;
+  while (running) {
+    num_lines = 0;
+    flatten(plan->root, 0, &lines, &num_lines, &lines_cap);
+    if (selected >= num_lines)
+      selected = num_lines - 1;
+    if (selected < scroll_offset)
+      scroll_offset = selected;
+    if (selected >= scroll_offset + visible_rows)
+      scroll_offset = selected - visible_rows + 1;
+
+    bool buffers = plan->analyzed && has_buffers(plan->root);
+    const char *header = measures_header(plan, buffers);
+    int measures_width =
+        plan->analyzed || plan->root->cost >= 0 || plan->root->est_rows >= 0
+            ? (int)strlen(header)
+            : 0;
+    int tree_width = content_width - 2 - measures_width - 1;
+    if (tree_width < 10)
+      tree_width = 10;
+
+    werase(dialog);
+    DRAW_BOX(dialog, COLOR_BORDER);
+    const char *title = plan->analyzed  ? " Plan (EXPLAIN ANALYZE) "
+                        : is_sqlite     ? " Plan (EXPLAIN QUERY PLAN) "
+                                        : " Plan (EXPLAIN) ";
+    WITH_ATTR(dialog, A_BOLD,
+              mvwprintw(dialog, 0, (width - (int)strlen(title)) / 2, "%s",
+                        title));
+
+    /* Timing summary */
+    if (plan->planning_ms >= 0 || plan->execution_ms >= 0) {
+      char plan_ms[16], exec_ms[16], summary[64];
+      format_ms(plan->planning_ms, plan_ms, sizeof(plan_ms));
+      format_ms(plan->execution_ms, exec_ms, sizeof(exec_ms));
+      snprintf(summary, sizeof(summary), " planning %s, execution %s ",
+               plan_ms, exec_ms);
+      mvwprintw(dialog, 0, width - (int)strlen(summary) - 2, "%s", summary);
+    }
+
+    /* Column header */
+    wattron(dialog, A_BOLD);
+    mvwprintw(dialog, 1, 2, "%-*s", tree_width, "Node");
+    if (measures_width > 0)
+      mvwprintw(dialog, 1, 2 + tree_width + 1, "%s", header);
+    wattroff(dialog, A_BOLD);
+
+    for (size_t i = 0;
+         i < visible_rows && scroll_offset + i < num_lines; i++) {
+      const PlanLine *line = &lines[scroll_offset + i];
+      const PlanNode *n = line->node;
+      int row = list_y + (int)i;
+      bool is_selected = scroll_offset + i == selected;
+
+      int attr = is_selected ? A_REVERSE : 0;
+      if (n->hot)
+        attr |= A_BOLD | (is_selected ? 0 : COLOR_PAIR(COLOR_ERROR));
+      wattron(dialog, attr);
+      mvwhline(dialog, row, 1, ' ', content_width);
+
+      /* Tree: indent, fold marker, label */
+      char tree[512];
+      const char *marker =
+          n->num_children == 0 ? "  " : n->collapsed ? "+ " : "- ";
+      int indent = line->depth * 2;
+      if (indent > tree_width / 2)
+        indent = tree_width / 2;
+      snprintf(tree, sizeof(tree), "%*s%s%s", indent, "", marker, n->label);
+      mvwprintw(dialog, row, 2, "%.*s", tree_width, tree);
+
+      if (measures_width > 0) {
+        char measures[128];
+        format_measures(plan, n, buffers, measures, sizeof(measures));
+        mvwprintw(dialog, row, 2 + tree_width + 1, "%s", measures);
+
+        /* Actual rows far from the estimate explain most bad plans */
+        if (plan->analyzed && misestimated(n) && !n->hot && !is_selected) {
+          mvwchgat(dialog, row, 2 + tree_width + 1 + 26, 8, A_BOLD,
+                   COLOR_NUMBER, NULL);
+        }
+      }
+      wattroff(dialog, attr);
+    }
+
+    /* Detail of the selected node */
+    const PlanNode *current = num_lines > 0 ? lines[selected].node : NULL;
+    if (current && current->detail) {
+      wattron(dialog, A_DIM);
+      mvwprintw(dialog, height - 3, 2, "%.*s", content_width - 2,
+                current->detail);
+      wattroff(dialog, A_DIM);
+    }
+
+    /* Footer */
+    wattron(dialog, A_DIM);
+    if (can_analyze) {
+      mvwprintw(dialog, height - 2, 2,
+                "[Enter] Fold  [h/l] Collapse/Expand  [a] %s  [Esc] Close",
+                analyze ? "Estimate only" : "Analyze");
+    } else {
+      mvwprintw(dialog, height - 2, 2,
+                "[Enter] Fold  [h/l] Collapse/Expand  [Esc] Close%s",
+                is_sqlite ? "" : "  (writes: ANALYZE skipped)");
+    }
+    wattroff(dialog, A_DIM);
+
+    wrefresh(dialog);
+
+    int ch = wgetch(dialog);
+    PlanNode *node = num_lines > 0 ? lines[selected].node : NULL;
+
+    if (ch == 'k' || ch == KEY_UP) {
+      if (selected > 0)
+        selected--;
+    } else if (ch == 'j' || ch == KEY_DOWN) {
+      if (selected + 1 < num_lines)
+        selected++;
+    } else if (ch == KEY_PPAGE) {
+      selected = selected > visible_rows ? selected - visible_rows : 0;
+    } else if (ch == KEY_NPAGE) {
+      selected += visible_rows;
+      if (selected >= num_lines)
+        selected = num_lines - 1;
+    } else if (ch == 'g' || ch == KEY_HOME) {
+      selected = 0;
+    } else if (ch == 'G' || ch == KEY_END) {
+      selected = num_lines - 1;
+    } else if (ch == '\n' || ch == KEY_ENTER || ch == ' ') {
+      if (node && node->num_children > 0)
+        node->collapsed = !node->collapsed;
+    } else if (ch == 'h' || ch == KEY_LEFT) {
+      /* Collapse, or move to the parent */
+      if (node && node->num_children > 0 && !node->collapsed) {
+        node->collapsed = true;
+      } else if (node && node->parent) {
+        while (selected > 0 && lines[selected].node != node->parent)
+          selected--;
+      }
+    } else if (ch == 'l' || ch == KEY_RIGHT) {
+      if (node && node->collapsed)
+        node->collapsed = false;
+    } else if (ch == 'a' && can_analyze) {
+      QueryPlan *other = run_explain(state, sql, !analyze, &err);
+      if (other) {
+        plan_free(plan);
+        plan = other;
+        analyze = !analyze;
+        selected = 0;
+        scroll_offset = 0;
+      } else if (err) {
+        tui_set_error(state, "EXPLAIN failed: %s", err);
+        free(err);
+        err = NULL;
+      }
+      touchwin(dialog);
+    } else if (ch == 27 || ch == 'q') {
+      running = false;
+    }
+  }
+
+  free(lines);
+  plan_free(plan);
+  delwin(dialog);
+  touchwin(stdscr);
+  refresh();
+}
@@ -12,7 +12,6 @@
 #include "../../util/mem.h"
 #include "../../viewmodel/query_viewmodel.h"
 #include "query_internal.h"
-#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -139,6 +138,9 @@ bool query_load_rows_at(TuiState *state, Tab *tab, size_t offset) {
       !tab->query_base_sql)
     return false;
 
+  /* The window is replaced: a prefetch beside the old one is stale */
+  tui_cancel_background_load(state);
+
   /* Clamp offset */
   if (offset >= tab->query_total_rows) {
     offset = tab->query_total_rows > PAGE_SIZE
@@ -146,14 +148,8 @@ bool query_load_rows_at(TuiState *state, Tab *tab, size_t offset) {
                  : 0;
   }
 
-  char *paginated_sql = str_printf("%s LIMIT %d OFFSET %zu",
-                                   tab->query_base_sql, PAGE_SIZE, offset);
-  if (!paginated_sql)
-    return false;
-
   char *err = NULL;
-  ResultSet *data = db_query(state->conn, paginated_sql, &err);
-  free(paginated_sql);
+  ResultSet *data = query_fetch_page(state, tab, offset, PAGE_SIZE, &err);
 
   if (!data) {
     tui_set_error(state, "Query failed: %s", err ? err : "Unknown error");
@@ -171,34 +167,7 @@ bool query_load_rows_at(TuiState *state, Tab *tab, size_t offset) {
   tab->query_loaded_count = data->num_rows;
 
   /* Recalculate column widths */
-  free(tab->query_result_col_widths);
-  tab->query_result_col_widths = NULL;
-  if (data->num_columns > 0) {
-    tab->query_result_col_widths = safe_calloc(data->num_columns, sizeof(int));
-    for (size_t c = 0; c < data->num_columns; c++) {
-      int w = data->columns[c].name ? (int)strlen(data->columns[c].name) : 0;
-      if (w < 8)
-        w = 8;
-      for (size_t r = 0; r < data->num_rows && r < 100; r++) {
-        if (r < data->num_rows && c < data->rows[r].num_cells) {
-          DbValue *v = &data->rows[r].cells[c];
-          int vw = 0;
-          if (v->type == DB_TYPE_TEXT && v->text.data) {
-            vw = (int)strlen(v->text.data);
-          } else if (v->type == DB_TYPE_INT) {
-            vw = 12;
-          } else if (v->type == DB_TYPE_FLOAT) {
-            vw = 15;
-          }
-          if (vw > w)
-            w = vw;
-        }
-      }
-      if (w > 50)
-        w = 50;
-      tab->query_result_col_widths[c] = w;
-    }
-  }
+  query_calculate_result_widths(tab);
 
   tui_set_status(state, "Loaded %zu/%zu rows", tab->query_loaded_count,
                  tab->query_total_rows);
@@ -374,7 +343,18 @@ void tui_draw_query(TuiState *state) {
   wattroff(state->main_win, COLOR_PAIR(COLOR_BORDER));
 
   /* Draw results area */
-  if (tab->query_error) {
+  if (tab->query_op) {
+    /* Running in the background */
+    double secs = (double)(lace_time_ms() - tab->query_op_started) / 1000.0;
+    char *cancel_key =
+        hotkey_get_display(state->app->config, HOTKEY_CANCEL_QUERY);
+    wattron(state->main_win, A_DIM);
+    mvwprintw(state->main_win, results_start + 1, 1,
+              "Running query... %.1fs (%s to cancel)", secs,
+              cancel_key ? cancel_key : "Ctrl+O");
+    wattroff(state->main_win, A_DIM);
+    free(cancel_key);
+  } else if (tab->query_error) {
     /* Show error */
     wattron(state->main_win, COLOR_PAIR(COLOR_ERROR));
     mvwprintw(state->main_win, results_start, 1, "Error: %s", tab->query_error);
@@ -427,7 +407,7 @@ void tui_draw_query(TuiState *state) {
     wattroff(state->main_win, A_DIM);
   }
 
-  wrefresh(state->main_win);
+  wnoutrefresh(state->main_win);
 }
 
 /* Public wrapper for starting edit from mouse handler */
@@ -504,6 +484,20 @@ void tui_query_scroll_results(TuiState *state, int delta) {
   query_check_load_more(state, tab);
 }
 
+/* Result grid keys that only move the cursor. A running prefetch survives
+ * them; other result keys may need the connection. */
+static bool query_key_is_navigation(const Config *cfg, const UiEvent *event) {
+  static const HotkeyAction keys[] = {
+      HOTKEY_MOVE_UP,   HOTKEY_MOVE_DOWN, HOTKEY_MOVE_LEFT, HOTKEY_MOVE_RIGHT,
+      HOTKEY_FIRST_COL, HOTKEY_LAST_COL,  HOTKEY_PAGE_UP,   HOTKEY_PAGE_DOWN,
+      HOTKEY_FIRST_ROW, HOTKEY_LAST_ROW};
+  for (size_t i = 0; i < sizeof(keys) / sizeof(keys[0]); i++) {
+    if (hotkey_matches(cfg, event, keys[i]))
+      return true;
+  }
+  return false;
+}
+
 /* Handle query tab input */
 bool tui_handle_query_input(TuiState *state, const UiEvent *event) {
   if (!state)
@@ -519,6 +513,10 @@ bool tui_handle_query_input(TuiState *state, const UiEvent *event) {
   int key_char = render_event_get_char(event);
   const Config *cfg = state->app ? state->app->config : NULL;
 
+  if (ui->query_focus_results &&
+      (ui->query_result_editing || !query_key_is_navigation(cfg, event)))
+    tui_cancel_background_load(state);
+
   /* Handle edit mode first if active */
   if (ui->query_result_editing) {
     return query_result_handle_edit_input(state, tab, event);
@@ -530,6 +528,36 @@ bool tui_handle_query_input(TuiState *state, const UiEvent *event) {
     return true;
   }
 
+  /* Ctrl+O - cancel the query running in the background */
+  if (hotkey_matches(cfg, event, HOTKEY_CANCEL_QUERY)) {
+    query_cancel_background(state);
+    return true;
+  }
+
+  /* Ctrl+P - show the plan of the query under the editor cursor */
+  if (hotkey_matches(cfg, event, HOTKEY_EXPLAIN_QUERY)) {
+    char *query = query_find_at_cursor(tab->query_text, tab->query_cursor);
+    if (query && *query) {
+      tui_show_plan_dialog(state, query);
+    } else {
+      tui_set_error(state, "No query at cursor");
+    }
+    free(query);
+    return true;
+  }
+
+  /* Ctrl+B - run the query under the cursor repeatedly and time it */
+  if (hotkey_matches(cfg, event, HOTKEY_BENCHMARK_QUERY)) {
+    char *query = query_find_at_cursor(tab->query_text, tab->query_cursor);
+    if (query && *query) {
+      tui_show_benchmark_dialog(state, query);
+    } else {
+      tui_set_error(state, "No query at cursor");
+    }
+    free(query);
+    return true;
+  }
+
   /* Handle results navigation when focused on results */
   if (ui->query_focus_results) {
     if (!tab->query_results) {
@@ -593,9 +621,16 @@ bool tui_handle_query_input(TuiState *state, const UiEvent *event) {
       return true;
     }
 
+    /* Select all result rows */
+    if (hotkey_matches(cfg, event, HOTKEY_SELECT_ALL)) {
+      tab_select_all(tab);
+      tui_set_status(state, "%zu rows selected", tab_selection_count(tab));
+      return true;
+    }
+
     /* Escape - clear selections (only if there are selections) */
     if (hotkey_matches(cfg, event, HOTKEY_CLEAR_SELECTIONS)) {
-      if (tab->num_selected > 0) {
+      if (tab_selection_count(tab) > 0) {
         tab_clear_selections(tab);
         return true;
       }
@@ -849,182 +884,13 @@ bool tui_handle_query_input(TuiState *state, const UiEvent *event) {
 
   /* Ctrl+A - run all queries */
   if (hotkey_matches(cfg, event, HOTKEY_EXECUTE_ALL)) {
-    if (!tab->query_text || !*tab->query_text) {
-      tui_set_error(state, "No queries to execute");
-      return true;
-    }
-
-    /* Execute all queries separated by semicolons */
-    char *text = str_dup(tab->query_text);
-    char *p = text;
-    int count = 0;
-    int errors = 0;
-
-    while (p && *p) {
-      /* Skip whitespace */
-      while (*p && isspace((unsigned char)*p))
-        p++;
-      if (!*p)
-        break;
-
-      /* Find end of query */
-      char *end = p;
-      bool in_string = false;
-      char quote_char = 0;
-      while (*end) {
-        if (in_string) {
-          if (*end == quote_char && (end == p || *(end - 1) != '\\')) {
-            in_string = false;
-          }
-        } else {
-          if (*end == '\'' || *end == '"') {
-            in_string = true;
-            quote_char = *end;
-          } else if (*end == ';') {
-            break;
-          }
-        }
-        end++;
-      }
-
-      /* Extract query */
-      char saved = *end;
-      *end = '\0';
-
-      /* Trim */
-      char *q = p;
-      while (*q && isspace((unsigned char)*q))
-        q++;
-      size_t qlen = strlen(q);
-      while (qlen > 0 && isspace((unsigned char)q[qlen - 1]))
-        qlen--;
-
-      if (qlen > 0) {
-        char *query = safe_malloc(qlen + 1);
-        memcpy(query, q, qlen);
-        query[qlen] = '\0';
-        query_execute(state, query);
-        count++;
-        if (tab->query_error) {
-          errors++;
-        }
-        free(query);
-      }
-
-      *end = saved;
-      p = *end ? end + 1 : end;
-    }
-
-    free(text);
-
-    if (errors > 0) {
-      tui_set_error(state, "Executed %d queries, %d errors", count, errors);
-    } else {
-      tui_set_status(state, "Executed %d queries", count);
-    }
+    query_execute_script(state, false);
     return true;
   }
 
   /* Ctrl+T - run all queries in a transaction */
   if (hotkey_matches(cfg, event, HOTKEY_EXECUTE_TRANSACTION)) {
-    if (!tab->query_text || !*tab->query_text) {
-      tui_set_error(state, "No queries to execute");
-      return true;
-    }
-
-    if (!state->conn) {
-      tui_set_error(state, "Not connected to database");
-      return true;
-    }
-
-    /* Start transaction */
-    char *err = NULL;
-    db_exec(state->conn, "BEGIN", &err);
-    if (err) {
-      tui_set_error(state, "Failed to start transaction: %s", err);
-      free(err);
-      return true;
-    }
-
-    /* Execute all queries separated by semicolons */
-    char *text = str_dup(tab->query_text);
-    char *p = text;
-    int count = 0;
-    bool had_error = false;
-
-    while (p && *p && !had_error) {
-      /* Skip whitespace */
-      while (*p && isspace((unsigned char)*p))
-        p++;
-      if (!*p)
-        break;
-
-      /* Find end of query */
-      char *end = p;
-      bool in_string = false;
-      char quote_char = 0;
-      while (*end) {
-        if (in_string) {
-          if (*end == quote_char && (end == p || *(end - 1) != '\\')) {
-            in_string = false;
-          }
-        } else {
-          if (*end == '\'' || *end == '"') {
-            in_string = true;
-            quote_char = *end;
-          } else if (*end == ';') {
-            break;
-          }
-        }
-        end++;
-      }
-
-      /* Extract query */
-      char saved = *end;
-      *end = '\0';
-
-      /* Trim */
-      char *q = p;
-      while (*q && isspace((unsigned char)*q))
-        q++;
-      size_t qlen = strlen(q);
-      while (qlen > 0 && isspace((unsigned char)q[qlen - 1]))
-        qlen--;
-
-      if (qlen > 0) {
-        char *query = safe_malloc(qlen + 1);
-        memcpy(query, q, qlen);
-        query[qlen] = '\0';
-        query_execute(state, query);
-        count++;
-        if (tab->query_error) {
-          had_error = true;
-        }
-        free(query);
-      }
-
-      *end = saved;
-      p = *end ? end + 1 : end;
-    }
-
-    free(text);
-
-    /* Commit or rollback */
-    err = NULL;
-    if (had_error) {
-      db_exec(state->conn, "ROLLBACK", &err);
-      free(err);
-      tui_set_error(state, "Transaction rolled back after error in query %d",
-                    count);
-    } else {
-      db_exec(state->conn, "COMMIT", &err);
-      if (err) {
-        tui_set_error(state, "Commit failed: %s", err);
-        free(err);
-      } else {
-        tui_set_status(state, "Transaction committed (%d queries)", count);
-      }
-    }
+    query_execute_script(state, true);
     return true;
   }
 
@@ -7,8 +7,8 @@
  */
 
 #include "query_internal.h"
+#include "../../db/sql_lexer.h"
 #include "../../util/mem.h"
-#include <ctype.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -121,208 +121,52 @@ void query_backspace(Tab *tab) {
   query_delete_char(tab);
 }
 
+/* Index of the statement at cursor: the one whose segment holds it, else
+ * the one before it (cursor in blank space after a statement), else the
+ * first one. */
+static size_t statement_at_cursor(const SqlStatement *stmts, size_t count,
+                                  size_t cursor) {
+  size_t found = 0;
+  for (size_t i = 0; i < count; i++) {
+    if (stmts[i].seg_start > cursor)
+      break;
+    found = i;
+    if (cursor < stmts[i].next)
+      break;
+  }
+  return found;
+}
+
 /* Find the byte boundaries of the query at cursor position.
  * Returns true if a valid query range was found.
  * out_start and out_end are set to the byte positions (not trimmed).
  * If cursor is in empty space after a query, falls back to the last query. */
 bool query_find_bounds_at_cursor(const char *text, size_t cursor,
                                  size_t *out_start, size_t *out_end) {
-  if (!text || !*text) {
-    *out_start = 0;
-    *out_end = 0;
-    return false;
-  }
-
-  size_t len = strlen(text);
-  if (cursor > len)
-    cursor = len;
-
-  /* Scan from beginning to cursor to find query start (after last ';') */
-  size_t last_semi = 0;
-  size_t prev_semi = 0; /* Track the semicolon before last_semi */
-  bool in_string = false;
-  char quote_char = 0;
-
-  for (size_t i = 0; i < cursor; i++) {
-    char c = text[i];
-    if (in_string) {
-      if (c == quote_char && (i == 0 || text[i - 1] != '\\')) {
-        in_string = false;
-      }
-    } else {
-      if (c == '\'' || c == '"') {
-        in_string = true;
-        quote_char = c;
-      } else if (c == ';') {
-        prev_semi = last_semi;
-        last_semi = i + 1;
-      }
-    }
-  }
-
-  size_t start = last_semi;
+  *out_start = 0;
+  *out_end = 0;
 
-  /* Scan forward from cursor to find query end (next ';' or end of text) */
-  size_t end = len;
-  in_string = false;
-  quote_char = 0;
-
-  for (size_t i = cursor; i < len; i++) {
-    char c = text[i];
-    if (in_string) {
-      if (c == quote_char && (i == 0 || text[i - 1] != '\\')) {
-        in_string = false;
-      }
-    } else {
-      if (c == '\'' || c == '"') {
-        in_string = true;
-        quote_char = c;
-      } else if (c == ';') {
-        end = i + 1; /* Include the semicolon */
-        break;
-      }
-    }
-  }
-
-  /* Check if the current range is empty/whitespace only */
-  bool is_empty = true;
-  for (size_t i = start; i < end && is_empty; i++) {
-    char c = text[i];
-    if (c != ' ' && c != '\t' && c != '\n' && c != '\r' && c != ';') {
-      is_empty = false;
-    }
-  }
-
-  /* If empty and we have a previous query, use that instead */
-  if (is_empty && last_semi > 0) {
-    start = prev_semi;
-    end = last_semi; /* Include the semicolon of the previous query */
-  }
+  SqlStatement *stmts = NULL;
+  size_t count = sql_split(text, SQL_DIALECT_ANY, &stmts);
+  if (count == 0)
+    return false;
 
-  *out_start = start;
-  *out_end = end;
-  return start < end;
+  const SqlStatement *st = &stmts[statement_at_cursor(stmts, count, cursor)];
+  *out_start = st->seg_start;
+  *out_end = st->next; /* Includes the terminator */
+  free(stmts);
+  return *out_start < *out_end;
 }
 
 /* Find the query at cursor position (caller must free result) */
 char *query_find_at_cursor(const char *text, size_t cursor) {
-  if (!text || !*text)
+  SqlStatement *stmts = NULL;
+  size_t count = sql_split(text, SQL_DIALECT_ANY, &stmts);
+  if (count == 0)
     return str_dup("");
 
-  size_t len = strlen(text);
-  if (cursor > len)
-    cursor = len;
-
-  /* Scan backward to find query start (after ';' or at beginning) */
-  bool in_string = false;
-  char quote_char = 0;
-
-  /* First pass: find start by scanning from beginning to cursor */
-  size_t last_semi = 0;
-  in_string = false;
-  for (size_t i = 0; i < cursor; i++) {
-    char c = text[i];
-    if (in_string) {
-      if (c == quote_char && (i == 0 || text[i - 1] != '\\')) {
-        in_string = false;
-      }
-    } else {
-      if (c == '\'' || c == '"') {
-        in_string = true;
-        quote_char = c;
-      } else if (c == ';') {
-        last_semi = i + 1;
-      }
-    }
-  }
-  size_t start = last_semi;
-
-  /* Scan forward to find query end */
-  size_t end = cursor;
-  in_string = false;
-  for (size_t i = cursor; i < len; i++) {
-    char c = text[i];
-    if (in_string) {
-      if (c == quote_char && (i == 0 || text[i - 1] != '\\')) {
-        in_string = false;
-      }
-    } else {
-      if (c == '\'' || c == '"') {
-        in_string = true;
-        quote_char = c;
-      } else if (c == ';') {
-        end = i;
-        break;
-      }
-    }
-    end = i + 1;
-  }
-
-  /* Extract query */
-  size_t query_len = end - start;
-  char *query = safe_malloc(query_len + 1);
-
-  memcpy(query, text + start, query_len);
-  query[query_len] = '\0';
-
-  /* Trim whitespace */
-  char *trimmed = query;
-  while (*trimmed && isspace((unsigned char)*trimmed))
-    trimmed++;
-
-  size_t trim_len = strlen(trimmed);
-  while (trim_len > 0 && isspace((unsigned char)trimmed[trim_len - 1]))
-    trim_len--;
-
-  /* If empty, try to find the last available query */
-  if (trim_len == 0 && last_semi > 0) {
-    free(query);
-
-    /* Find the query before last_semi */
-    size_t prev_end = last_semi - 1; /* Position of the ';' */
-    size_t prev_start = 0;
-
-    /* Scan from beginning to find the start of the previous query */
-    in_string = false;
-    size_t prev_semi = 0;
-    for (size_t i = 0; i < prev_end; i++) {
-      char c = text[i];
-      if (in_string) {
-        if (c == quote_char && (i == 0 || text[i - 1] != '\\')) {
-          in_string = false;
-        }
-      } else {
-        if (c == '\'' || c == '"') {
-          in_string = true;
-          quote_char = c;
-        } else if (c == ';') {
-          prev_semi = i + 1;
-        }
-      }
-    }
-    prev_start = prev_semi;
-
-    /* Extract the previous query */
-    query_len = prev_end - prev_start;
-    query = safe_malloc(query_len + 1);
-
-    memcpy(query, text + prev_start, query_len);
-    query[query_len] = '\0';
-
-    /* Trim again */
-    trimmed = query;
-    while (*trimmed && isspace((unsigned char)*trimmed))
-      trimmed++;
-
-    trim_len = strlen(trimmed);
-    while (trim_len > 0 && isspace((unsigned char)trimmed[trim_len - 1]))
-      trim_len--;
-  }
-
-  char *result = safe_malloc(trim_len + 1);
-  memcpy(result, trimmed, trim_len);
-  result[trim_len] = '\0';
-
-  free(query);
-  return result;
+  char *query = sql_statement_text(
+      text, &stmts[statement_at_cursor(stmts, count, cursor)]);
+  free(stmts);
+  return query;
 }
@@ -7,9 +7,11 @@
  */
 
 #include "query_internal.h"
+#include "../../db/sql_lexer.h"
 #include "../../util/mem.h"
 #include <ctype.h>
 #include <errno.h>
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 #include <strings.h>
@@ -184,27 +186,55 @@ int64_t query_count_rows(TuiState *state, const char *base_sql) {
   return count;
 }
 
-/* Execute a SQL query and store results */
-void query_execute(TuiState *state, const char *sql) {
-  if (!state || !sql || !*sql)
-    return;
+ResultSet *query_fetch_page(TuiState *state, Tab *tab, size_t offset,
+                            size_t limit, char **err) {
+  if (!state || !state->conn || !tab || !tab->query_base_sql)
+    return NULL;
 
-  Tab *tab = TUI_TAB(state);
-  UITabState *ui = TUI_TAB_UI(state);
-  if (!tab || tab->type != TAB_TYPE_QUERY || !ui)
-    return;
+  if (tab->query_server_cursor) {
+    ResultSet *rs =
+        db_cursor_fetch(tab->query_server_cursor, offset, limit, err);
+    if (rs)
+      return rs;
+    /* The cursor is gone (e.g. closed by a rollback): re-run the query */
+    db_cursor_close(tab->query_server_cursor);
+    tab->query_server_cursor = NULL;
+    if (err)
+      FREE_NULL(*err);
+  }
+
+  char *paginated_sql = str_printf("%s LIMIT %zu OFFSET %zu",
+                                   tab->query_base_sql, limit, offset);
+  if (!paginated_sql)
+    return NULL;
+  ResultSet *rs = db_query(state->conn, paginated_sql, err);
+  free(paginated_sql);
+  return rs;
+}
 
-  /* Free previous results */
+/* Byte bound of each connection's result cache (0 = caching off) */
+static size_t query_cache_limit(TuiState *state) {
+  Config *config = state->app ? state->app->config : NULL;
+  if (!config || config->general.query_cache_mb <= 0)
+    return 0;
+  return (size_t)config->general.query_cache_mb * 1024 * 1024;
+}
+
+/* Free the tab's results and reset the result cursor */
+void query_clear_results(Tab *tab) {
   if (tab->query_results) {
     db_result_free(tab->query_results);
     tab->query_results = NULL;
   }
+  tab->query_results_cached = false;
   free(tab->query_error);
   tab->query_error = NULL;
   tab->query_affected = 0;
   tab->query_exec_success = false;
   free(tab->query_result_col_widths);
   tab->query_result_col_widths = NULL;
+  free(tab->query_result_col_stats);
+  tab->query_result_col_stats = NULL;
   tab->query_result_num_cols = 0;
   free(tab->query_source_table);
   tab->query_source_table = NULL;
@@ -212,6 +242,8 @@ void query_execute(TuiState *state, const char *sql) {
   tab->query_source_schema = NULL;
   free(tab->query_base_sql);
   tab->query_base_sql = NULL;
+  db_cursor_close(tab->query_server_cursor);
+  tab->query_server_cursor = NULL;
   tab->query_total_rows = 0;
   tab->query_loaded_offset = 0;
   tab->query_loaded_count = 0;
@@ -225,6 +257,106 @@ void query_execute(TuiState *state, const char *sql) {
   tab->query_result_col = 0;
   tab->query_result_scroll_row = 0;
   tab->query_result_scroll_col = 0;
+}
+
+/* Finish showing a read's results: cache them if complete, size the
+ * columns, and look up the source table for editing. conn is the tab's
+ * connection. */
+static void query_show_results(TuiState *state, Tab *tab, DbConnection *conn,
+                               const char *sql, bool cached,
+                               int64_t data_version) {
+  /* Only complete results are cached */
+  Connection *app_conn = app_get_tab_connection(state->app, tab);
+  size_t cache_limit = query_cache_limit(state);
+  if (!cached && data_version >= 0 && app_conn && cache_limit > 0 &&
+      (!tab->query_paginated ||
+       tab->query_loaded_count == tab->query_total_rows))
+    result_cache_put(app_conn->result_cache, sql, tab->query_results,
+                     data_version, cache_limit);
+
+  query_calculate_result_widths(tab);
+  /* Try to extract table name for editing support */
+  tab->query_source_table = query_extract_table_name(sql);
+  /* Load table schema for primary key info (needed for SQLite/PostgreSQL) */
+  if (tab->query_source_table) {
+    char *schema_err = NULL;
+    tab->query_source_schema =
+        db_get_table_schema(conn, tab->query_source_table, &schema_err);
+    free(schema_err); /* Ignore schema errors */
+  }
+  tui_enforce_memory_budget(state);
+}
+
+/* Run a read on a connection of its own, so the UI stays usable while it
+ * runs: a paginated SELECT opens a cursor that keeps the connection for its
+ * pages, anything else runs once. Returns false if the statement has to run
+ * on the tab's connection. */
+static bool query_start_background(TuiState *state, Tab *tab, const char *sql,
+                                   bool paginate, int64_t data_version) {
+  DbConnection *conn = state->conn;
+  Connection *app_conn = app_get_tab_connection(state->app, tab);
+  if (!conn->connstr || !conn->driver || !app_conn)
+    return false;
+
+  /* Another connection wouldn't see this one's session or transaction */
+  if (app_conn->session_bound || conn->in_transaction ||
+      sql_changes_session(sql))
+    return false;
+  /* ...nor its in-memory database */
+  if (!conn->database || strstr(conn->database, ":memory:"))
+    return false;
+  /* Without a cursor every page would run the query again */
+  if (paginate && !conn->driver->cursor_open)
+    return false;
+
+  AsyncOperation *op = safe_malloc(sizeof(AsyncOperation));
+  async_init(op);
+  op->op_type = paginate ? ASYNC_OP_CURSOR_OPEN : ASYNC_OP_QUERY_PRIVATE;
+  op->connstr = str_dup(conn->connstr);
+  op->sql = str_dup(sql);
+  if (!async_start(op)) {
+    async_free(op);
+    free(op);
+    return false;
+  }
+
+  tab->query_op = op;
+  tab->query_op_sql = str_dup(sql);
+  tab->query_op_version = data_version;
+  tab->query_op_started = lace_time_ms();
+
+  char *key = hotkey_get_display(state->app->config, HOTKEY_CANCEL_QUERY);
+  tui_set_status(state, "Running query... (%s to cancel)",
+                 key ? key : "Ctrl+O");
+  free(key);
+  tui_mark_damage(state, TUI_DAMAGE_TABS);
+  return true;
+}
+
+/* Execute a SQL query and store results, in the background if allowed */
+static void query_execute_in(TuiState *state, const char *sql,
+                             bool background) {
+  if (!state || !sql || !*sql)
+    return;
+
+  Tab *tab = TUI_TAB(state);
+  UITabState *ui = TUI_TAB_UI(state);
+  if (!tab || tab->type != TAB_TYPE_QUERY || !ui)
+    return;
+
+  if (tab->query_op) {
+    char *key = hotkey_get_display(state->app->config, HOTKEY_CANCEL_QUERY);
+    tui_set_error(state, "A query is still running in this tab (%s cancels it)",
+                  key ? key : "Ctrl+O");
+    free(key);
+    return;
+  }
+
+  /* A prefetch of the previous results must not land in the new ones */
+  tui_cancel_background_load(state);
+  prefetch_motion_reset(&tab->motion);
+
+  query_clear_results(tab);
 
   if (!state->conn) {
     tab->query_error = str_dup("Not connected to database");
@@ -248,47 +380,106 @@ void query_execute(TuiState *state, const char *sql) {
     /* Check if pagination should be applied (SELECT only, no existing LIMIT) */
     bool should_paginate = is_select && !query_has_limit_offset(sql);
 
-    if (should_paginate) {
+    /* Answer a repeated SELECT from the cache while the data version it
+     * was read at is current. No version probe, no caching; neither for
+     * results that change without a write. */
+    Connection *app_conn = app_get_tab_connection(state->app, tab);
+    ResultCache *cache = app_conn && query_cache_limit(state) > 0
+                             ? app_conn->result_cache
+                             : NULL;
+    int64_t data_version = -1;
+    if (cache && is_select && result_cache_sql_cacheable(sql)) {
+      data_version = db_data_version(state->conn, NULL);
+      if (data_version >= 0)
+        tab->query_results = result_cache_get(cache, sql, data_version);
+    }
+    bool cached = tab->query_results != NULL;
+    tab->query_results_cached = cached;
+
+    if (cached) {
+      /* Whole result in hand: nothing to page */
+    } else if (background && query_start_background(state, tab, sql,
+                                                    should_paginate,
+                                                    data_version)) {
+      return; /* Collected by tui_poll_query_ops */
+    } else if (should_paginate) {
       /* Store base SQL for pagination */
       tab->query_base_sql = str_dup(sql);
 
-      /* Get total row count */
-      int64_t total = query_count_rows(state, sql);
-      if (total >= 0) {
-        tab->query_total_rows = (size_t)total;
-      } else {
-        /* Fallback: can't count, disable pagination */
-        tab->query_total_rows = 0;
-      }
-
-      /* Execute with LIMIT/OFFSET for first page using async operation */
-      char *paginated_sql = str_printf("%s LIMIT %d OFFSET 0", sql, PAGE_SIZE);
-      if (paginated_sql) {
+      /* Prefer a server-side cursor: the query runs once and every page,
+       * and the row count, come from its kept result */
+      bool cancelled = false;
+      if (state->conn->driver && state->conn->driver->cursor_open) {
         AsyncOperation op;
         async_init(&op);
-        op.op_type = ASYNC_OP_QUERY;
+        op.op_type = ASYNC_OP_CURSOR_OPEN;
         op.conn = state->conn;
-        op.sql = paginated_sql; /* ownership transferred */
+        op.sql = str_dup(sql);
 
-        if (async_start(&op)) {
+        if (op.sql && async_start(&op)) {
           bool completed =
               tui_show_processing_dialog(state, &op, "Executing query...");
           if (completed && op.state == ASYNC_STATE_COMPLETED) {
-            tab->query_results = (ResultSet *)op.result;
-            if (tab->query_results) {
-              tab->query_paginated = true;
-              tab->query_loaded_offset = 0;
-              tab->query_loaded_count = tab->query_results->num_rows;
-            }
-          } else if (op.state == ASYNC_STATE_ERROR) {
-            err = op.error ? str_dup(op.error) : str_dup("Query failed");
+            tab->query_server_cursor = (DbCursor *)op.result;
           } else if (op.state == ASYNC_STATE_CANCELLED) {
             tui_set_status(state, "Query cancelled");
+            cancelled = true;
           }
+          /* On error fall back to LIMIT/OFFSET paging below, which reports
+           * the error if it is the query's own */
         }
-        op.sql = NULL; /* Prevent double free */
         async_free(&op);
-        free(paginated_sql);
+      }
+
+      if (tab->query_server_cursor) {
+        tab->query_total_rows = tab->query_server_cursor->num_rows;
+        tab->query_results =
+            db_cursor_fetch(tab->query_server_cursor, 0, PAGE_SIZE, &err);
+        if (tab->query_results) {
+          tab->query_paginated = true;
+          tab->query_loaded_offset = 0;
+          tab->query_loaded_count = tab->query_results->num_rows;
+        }
+      } else if (!cancelled) {
+        /* Get total row count */
+        int64_t total = query_count_rows(state, sql);
+        if (total >= 0) {
+          tab->query_total_rows = (size_t)total;
+        } else {
+          /* Fallback: can't count, disable pagination */
+          tab->query_total_rows = 0;
+        }
+
+        /* Execute with LIMIT/OFFSET for first page using async operation */
+        char *paginated_sql =
+            str_printf("%s LIMIT %d OFFSET 0", sql, PAGE_SIZE);
+        if (paginated_sql) {
+          AsyncOperation op;
+          async_init(&op);
+          op.op_type = ASYNC_OP_QUERY;
+          op.conn = state->conn;
+          op.sql = paginated_sql; /* ownership transferred */
+
+          if (async_start(&op)) {
+            bool completed =
+                tui_show_processing_dialog(state, &op, "Executing query...");
+            if (completed && op.state == ASYNC_STATE_COMPLETED) {
+              tab->query_results = (ResultSet *)op.result;
+              if (tab->query_results) {
+                tab->query_paginated = true;
+                tab->query_loaded_offset = 0;
+                tab->query_loaded_count = tab->query_results->num_rows;
+              }
+            } else if (op.state == ASYNC_STATE_ERROR) {
+              err = op.error ? str_dup(op.error) : str_dup("Query failed");
+            } else if (op.state == ASYNC_STATE_CANCELLED) {
+              tui_set_status(state, "Query cancelled");
+            }
+          }
+          op.sql = NULL; /* Prevent double free */
+          async_free(&op);
+          free(paginated_sql);
+        }
       }
     } else {
       /* Execute as-is (has LIMIT/OFFSET or not a SELECT) using async */
@@ -314,20 +505,13 @@ void query_execute(TuiState *state, const char *sql) {
     if (err) {
       tab->query_error = err;
     } else if (tab->query_results) {
-      query_calculate_result_widths(tab);
-      /* Try to extract table name for editing support */
-      tab->query_source_table = query_extract_table_name(sql);
-      /* Load table schema for primary key info (needed for SQLite/PostgreSQL)
-       */
-      if (tab->query_source_table) {
-        char *schema_err = NULL;
-        tab->query_source_schema = db_get_table_schema(
-            state->conn, tab->query_source_table, &schema_err);
-        free(schema_err); /* Ignore schema errors */
-      }
+      query_show_results(state, tab, state->conn, sql, cached, data_version);
       if (tab->query_paginated && tab->query_total_rows > 0) {
         tui_set_status(state, "Loaded %zu/%zu rows", tab->query_loaded_count,
                        tab->query_total_rows);
+      } else if (cached) {
+        tui_set_status(state, "%zu rows returned (cached)",
+                       tab->query_results->num_rows);
       } else {
         tui_set_status(state, "%zu rows returned",
                        tab->query_results->num_rows);
@@ -367,106 +551,220 @@ void query_execute(TuiState *state, const char *sql) {
   }
 }
 
-/* Calculate column widths for query results */
-void query_calculate_result_widths(Tab *tab) {
-  if (!tab->query_results || tab->query_results->num_columns == 0)
-    return;
+void query_execute(TuiState *state, const char *sql) {
+  query_execute_in(state, sql, true);
+}
 
-  size_t num_cols = tab->query_results->num_columns;
+void query_execute_foreground(TuiState *state, const char *sql) {
+  query_execute_in(state, sql, false);
+}
 
-  tab->query_result_col_widths = safe_calloc(num_cols, sizeof(int));
-  tab->query_result_num_cols = num_cols;
+/* Move tab's finished background query into its results and report it.
+ * name identifies the tab when it isn't the current one. */
+static void query_finish_background(TuiState *state, Tab *tab, UITabState *ui,
+                                    const char *name) {
+  AsyncOperation *op = (AsyncOperation *)tab->query_op;
+  char *sql = tab->query_op_sql;
+  double secs = (double)(lace_time_ms() - tab->query_op_started) / 1000.0;
+  tab->query_op = NULL;
+  tab->query_op_sql = NULL;
+
+  Connection *app_conn = app_get_tab_connection(state->app, tab);
+  DbConnection *conn = app_conn ? app_conn->conn : NULL;
+  char *err = NULL;
 
-  /* Start with column name widths */
-  for (size_t c = 0; c < num_cols; c++) {
-    const char *name = tab->query_results->columns[c].name;
-    int w = name ? (int)strlen(name) : 4;
-    if (w < MIN_COL_WIDTH)
-      w = MIN_COL_WIDTH;
-    tab->query_result_col_widths[c] = w;
+  if (op->state == ASYNC_STATE_COMPLETED && op->result) {
+    /* Run on another connection: record it in this one's history */
+    db_record_history(conn, sql, DB_HISTORY_AUTO);
+    if (op->op_type == ASYNC_OP_CURSOR_OPEN) {
+      tab->query_server_cursor = (DbCursor *)op->result;
+      tab->query_base_sql = str_dup(sql);
+      tab->query_total_rows = tab->query_server_cursor->num_rows;
+      tab->query_results =
+          db_cursor_fetch(tab->query_server_cursor, 0, PAGE_SIZE, &err);
+      if (tab->query_results) {
+        tab->query_paginated = true;
+        tab->query_loaded_offset = 0;
+        tab->query_loaded_count = tab->query_results->num_rows;
+      } else {
+        /* Release the cursor's connection along with it */
+        db_cursor_close(tab->query_server_cursor);
+        tab->query_server_cursor = NULL;
+        if (!err)
+          err = str_dup("Query failed");
+      }
+    } else {
+      tab->query_results = (ResultSet *)op->result;
+    }
+    op->result = NULL;
+  } else if (op->state == ASYNC_STATE_ERROR) {
+    err = str_dup(op->error ? op->error : "Query failed");
+  }
+  AsyncState outcome = op->state;
+  async_free(op);
+  free(op);
+
+  const char *prefix = name ? name : "Query";
+  if (err) {
+    tab->query_error = err;
+    tui_set_error(state, "%s failed after %.1fs", prefix, secs);
+  } else if (tab->query_results) {
+    query_show_results(state, tab, conn, sql, false, tab->query_op_version);
+    if (tab->query_paginated && tab->query_total_rows > 0) {
+      tui_set_status(state, "%s finished in %.1fs: loaded %zu/%zu rows",
+                     prefix, secs, tab->query_loaded_count,
+                     tab->query_total_rows);
+    } else {
+      tui_set_status(state, "%s finished in %.1fs: %zu rows returned", prefix,
+                     secs, tab->query_results->num_rows);
+    }
+    if (ui && tab->query_results->num_rows > 0)
+      ui->query_focus_results = true;
+  } else if (outcome == ASYNC_STATE_CANCELLED) {
+    tui_set_status(state, "%s cancelled", prefix);
   }
+  free(sql);
+}
 
-  /* Check data values */
-  for (size_t r = 0; r < tab->query_results->num_rows && r < 100; r++) {
-    Row *row = &tab->query_results->rows[r];
-    for (size_t c = 0; c < num_cols && c < row->num_cells; c++) {
-      char *str = db_value_to_string(&row->cells[c]);
-      if (str) {
-        int w = (int)strlen(str);
-        if (w > tab->query_result_col_widths[c]) {
-          tab->query_result_col_widths[c] = w;
-        }
-        free(str);
+bool tui_poll_query_ops(TuiState *state) {
+  if (!state || !state->app)
+    return false;
+
+  AppState *app = state->app;
+  Tab *current = TUI_TAB(state);
+  bool running = false;
+  for (size_t w = 0; w < app->num_workspaces; w++) {
+    Workspace *ws = &app->workspaces[w];
+    for (size_t t = 0; t < ws->num_tabs; t++) {
+      Tab *tab = &ws->tabs[t];
+      if (!tab->query_op)
+        continue;
+      if (async_poll((AsyncOperation *)tab->query_op) ==
+          ASYNC_STATE_RUNNING) {
+        running = true;
+        continue;
       }
+
+      /* Name the tab in the report unless it is in view */
+      char name[96];
+      bool in_view = tab == current;
+      if (!in_view)
+        snprintf(name, sizeof(name), "Query in \"%s\"",
+                 tab->table_name ? tab->table_name : "?");
+      query_finish_background(state, tab, tui_get_tab_ui(state, w, t),
+                              in_view ? NULL : name);
+      tui_mark_damage(state, TUI_DAMAGE_ALL);
     }
   }
 
-  /* Clamp to max width */
-  for (size_t c = 0; c < num_cols; c++) {
-    if (tab->query_result_col_widths[c] > MAX_COL_WIDTH) {
-      tab->query_result_col_widths[c] = MAX_COL_WIDTH;
-    }
+  /* Spinners in the tab bar, and the elapsed time in a running tab */
+  if (running) {
+    tui_mark_damage(state, TUI_DAMAGE_TABS);
+    if (current && current->query_op)
+      tui_mark_damage(state, TUI_DAMAGE_CONTENT);
   }
+  return running;
 }
 
-/* Load more rows at end of current query results */
-bool query_load_more_rows(TuiState *state, Tab *tab) {
-  if (!state || !state->conn || !tab || !tab->query_paginated ||
-      !tab->query_base_sql)
-    return false;
-  if (!tab->query_results)
-    return false;
+void query_cancel_background(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  if (!tab || !tab->query_op) {
+    tui_set_status(state, "No query running in this tab");
+    return;
+  }
+  tab_cancel_query_op(tab);
+  tui_set_status(state, "Query cancelled");
+  tui_mark_damage(state, TUI_DAMAGE_ALL);
+}
 
-  size_t new_offset = tab->query_loaded_offset + tab->query_loaded_count;
+/* Calculate column widths for query results */
+void query_calculate_result_widths(Tab *tab) {
+  if (!tab->query_results || tab->query_results->num_columns == 0)
+    return;
 
-  /* Check if there are more rows to load */
-  if (tab->query_total_rows > 0 && new_offset >= tab->query_total_rows)
-    return false;
+  col_widths_rebuild(tab->query_results, &tab->query_result_col_stats,
+                     &tab->query_result_col_widths,
+                     &tab->query_result_num_cols);
+}
 
-  char *paginated_sql = str_printf("%s LIMIT %d OFFSET %zu",
-                                   tab->query_base_sql, PAGE_SIZE, new_offset);
-  if (!paginated_sql)
-    return false;
+/* Fold result rows [first, first + count) into the column statistics,
+ * growing widths as needed */
+static void query_column_stats_add(Tab *tab, size_t first, size_t count) {
+  ResultSet *data = tab->query_results;
+  if (!data || !tab->query_result_col_stats ||
+      tab->query_result_num_cols != data->num_columns)
+    return;
+  col_stats_add_rows(tab->query_result_col_stats, tab->query_result_num_cols,
+                     data->rows + first, count);
+  col_widths_grow(tab->query_result_col_stats, data,
+                  tab->query_result_col_widths, tab->query_result_num_cols);
+}
 
-  char *err = NULL;
-  ResultSet *more = db_query(state->conn, paginated_sql, &err);
-  free(paginated_sql);
+/* Drop result rows [first, first + count) from the column statistics */
+static void query_column_stats_remove(Tab *tab, size_t first, size_t count) {
+  ResultSet *data = tab->query_results;
+  if (!data || !tab->query_result_col_stats ||
+      tab->query_result_num_cols != data->num_columns)
+    return;
+  col_stats_remove_rows(tab->query_result_col_stats,
+                        tab->query_result_num_cols, data->rows + first, count);
+}
 
-  if (!more || more->num_rows == 0) {
-    if (more)
-      db_result_free(more);
-    free(err);
+bool query_merge_rows(TuiState *state, Tab *tab, ResultSet *more,
+                      size_t offset) {
+  if (!tab || !tab->query_results || !more || more->num_rows == 0 ||
+      more->num_columns != tab->query_results->num_columns)
     return false;
-  }
 
-  /* Extend existing rows array */
   size_t old_count = tab->query_results->num_rows;
   size_t new_count = old_count + more->num_rows;
 
   /* Check for overflow and enforce maximum row limit (1M rows) */
   if (new_count < old_count || new_count > SIZE_MAX / sizeof(Row) ||
-      new_count > 1000000) {
-    db_result_free(more);
+      new_count > 1000000)
     return false;
-  }
 
-  tab->query_results->rows = safe_reallocarray(tab->query_results->rows, new_count, sizeof(Row));
+  if (offset >= tab->query_loaded_offset) {
+    db_result_append_rows(tab->query_results, more);
+    query_column_stats_add(tab, old_count, more->num_rows);
+  } else {
+    db_result_prepend_rows(tab->query_results, more);
+    query_column_stats_add(tab, 0, more->num_rows);
 
-  /* Copy new rows */
-  for (size_t i = 0; i < more->num_rows; i++) {
-    tab->query_results->rows[old_count + i] = more->rows[i];
-    /* Clear source so free doesn't deallocate the cells we moved */
-    more->rows[i].cells = NULL;
-    more->rows[i].num_cells = 0;
+    /* Adjust cursor position (it's now offset by the prepended rows) */
+    tab->query_result_row += more->num_rows;
+    tab->query_result_scroll_row += more->num_rows;
+    tab->query_loaded_offset = offset;
   }
-
-  tab->query_results->num_rows = new_count;
   tab->query_loaded_count = new_count;
 
-  db_result_free(more);
-
   /* Trim old data to keep memory bounded */
   query_trim_loaded_data(state, tab);
+  return true;
+}
+
+/* Load more rows at end of current query results */
+bool query_load_more_rows(TuiState *state, Tab *tab) {
+  if (!state || !state->conn || !tab || !tab->query_paginated ||
+      !tab->query_base_sql)
+    return false;
+  if (!tab->query_results)
+    return false;
+
+  size_t new_offset = tab->query_loaded_offset + tab->query_loaded_count;
+
+  /* Check if there are more rows to load */
+  if (tab->query_total_rows > 0 && new_offset >= tab->query_total_rows)
+    return false;
+
+  char *err = NULL;
+  ResultSet *more = query_fetch_page(state, tab, new_offset, PAGE_SIZE, &err);
+  free(err);
+
+  bool merged = query_merge_rows(state, tab, more, new_offset);
+  db_result_free(more);
+  if (!merged)
+    return false;
 
   tui_set_status(state, "Loaded %zu/%zu rows", tab->query_loaded_count,
                  tab->query_total_rows);
@@ -493,78 +791,26 @@ bool query_load_prev_rows(TuiState *state, Tab *tab) {
     new_offset = 0;
   }
 
-  char *paginated_sql = str_printf("%s LIMIT %zu OFFSET %zu",
-                                   tab->query_base_sql, load_count, new_offset);
-  if (!paginated_sql)
-    return false;
-
   char *err = NULL;
-  ResultSet *more = db_query(state->conn, paginated_sql, &err);
-  free(paginated_sql);
-
-  if (!more || more->num_rows == 0) {
-    if (more)
-      db_result_free(more);
-    free(err);
-    return false;
-  }
-
-  /* Prepend rows to existing data */
-  size_t old_count = tab->query_results->num_rows;
-  size_t new_count = old_count + more->num_rows;
-
-  /* Check for overflow */
-  if (new_count < old_count || new_count > SIZE_MAX / sizeof(Row)) {
-    db_result_free(more);
-    return false;
-  }
-
-  Row *new_rows = safe_reallocarray(NULL, new_count, sizeof(Row));
-
-  /* Copy new rows first (prepend) */
-  for (size_t i = 0; i < more->num_rows; i++) {
-    new_rows[i] = more->rows[i];
-    /* Clear source so free doesn't deallocate the cells we moved */
-    more->rows[i].cells = NULL;
-    more->rows[i].num_cells = 0;
-  }
-
-  /* Then copy old rows */
-  for (size_t i = 0; i < old_count; i++) {
-    new_rows[more->num_rows + i] = tab->query_results->rows[i];
-  }
-
-  /* Free old array (but not the cells which we moved) */
-  free(tab->query_results->rows);
-  tab->query_results->rows = new_rows;
-  tab->query_results->num_rows = new_count;
-
-  /* Adjust cursor position (it's now offset by the prepended rows) */
-  tab->query_result_row += more->num_rows;
-  tab->query_result_scroll_row += more->num_rows;
-
-  /* Update tracking */
-  tab->query_loaded_offset = new_offset;
-  tab->query_loaded_count = new_count;
+  ResultSet *more = query_fetch_page(state, tab, new_offset, load_count, &err);
+  free(err);
 
+  bool merged = query_merge_rows(state, tab, more, new_offset);
   db_result_free(more);
-
-  /* Trim old data to keep memory bounded */
-  query_trim_loaded_data(state, tab);
+  if (!merged)
+    return false;
 
   tui_set_status(state, "Loaded %zu/%zu rows", tab->query_loaded_count,
                  tab->query_total_rows);
   return true;
 }
 
-/* Trim loaded query data to keep memory bounded */
-void query_trim_loaded_data(TuiState *state, Tab *tab) {
-  (void)state; /* Currently unused */
-
+/* Trim loaded query results to at most max_pages pages around the cursor */
+void query_trim_to_pages(Tab *tab, size_t max_pages) {
   if (!tab || !tab->query_results || tab->query_results->num_rows == 0)
     return;
 
-  size_t max_rows = MAX_LOADED_PAGES * PAGE_SIZE;
+  size_t max_rows = max_pages * PAGE_SIZE;
   if (tab->query_loaded_count <= max_rows)
     return;
 
@@ -583,10 +829,10 @@ void query_trim_loaded_data(TuiState *state, Tab *tab) {
     keep_end_page = cursor_page + TRIM_DISTANCE_PAGES + 1;
   }
 
-  /* Ensure we don't exceed MAX_LOADED_PAGES */
+  /* Ensure we don't exceed max_pages */
   size_t pages_to_keep = keep_end_page - keep_start_page;
-  if (pages_to_keep > MAX_LOADED_PAGES) {
-    size_t excess = pages_to_keep - MAX_LOADED_PAGES;
+  if (pages_to_keep > max_pages) {
+    size_t excess = pages_to_keep - max_pages;
     size_t pages_before_cursor = cursor_page - keep_start_page;
     size_t pages_after_cursor = keep_end_page - cursor_page - 1;
 
@@ -607,34 +853,14 @@ void query_trim_loaded_data(TuiState *state, Tab *tab) {
   if (trim_start == 0 && trim_end >= tab->query_loaded_count)
     return;
 
-  /* Free rows before trim_start */
-  for (size_t i = 0; i < trim_start; i++) {
-    Row *row = &tab->query_results->rows[i];
-    for (size_t j = 0; j < row->num_cells; j++) {
-      db_value_free(&row->cells[j]);
-    }
-    free(row->cells);
-  }
+  /* Drop trimmed rows from column width statistics */
+  query_column_stats_remove(tab, 0, trim_start);
+  query_column_stats_remove(tab, trim_end, tab->query_loaded_count - trim_end);
 
-  /* Free rows after trim_end */
-  for (size_t i = trim_end; i < tab->query_loaded_count; i++) {
-    Row *row = &tab->query_results->rows[i];
-    for (size_t j = 0; j < row->num_cells; j++) {
-      db_value_free(&row->cells[j]);
-    }
-    free(row->cells);
-  }
-
-  /* Move remaining rows to beginning of array */
+  /* Free rows outside [trim_start, trim_end); the kept rows stay in place */
   size_t new_count = trim_end - trim_start;
-  if (trim_start > 0) {
-    memmove(tab->query_results->rows, tab->query_results->rows + trim_start,
-            new_count * sizeof(Row));
-  }
-
-  /* Resize array */
-  tab->query_results->rows = safe_reallocarray(tab->query_results->rows, new_count, sizeof(Row));
-  tab->query_results->num_rows = new_count;
+  db_result_drop_back(tab->query_results, tab->query_loaded_count - trim_end);
+  db_result_drop_front(tab->query_results, trim_start);
 
   /* Adjust cursor and scroll positions */
   if (tab->query_result_row >= trim_start) {
@@ -654,11 +880,34 @@ void query_trim_loaded_data(TuiState *state, Tab *tab) {
   tab->query_loaded_count = new_count;
 }
 
+/* Trim loaded query data to keep memory bounded */
+void query_trim_loaded_data(TuiState *state, Tab *tab) {
+  query_trim_to_pages(tab, MAX_LOADED_PAGES);
+  tui_enforce_memory_budget(state);
+}
+
 /* Check if more rows need to be loaded based on cursor position */
 void query_check_load_more(TuiState *state, Tab *tab) {
   if (!tab || !tab->query_results || !tab->query_paginated)
     return;
 
+  /* Held keys never reach the idle poll: merge a finished prefetch and
+   * start the next one from here */
+  tui_poll_background_load(state);
+  tui_check_speculative_prefetch(state);
+
+  /* With a prefetch in flight only block once the cursor reaches the edge
+   * it is filling */
+  if (tab->bg_load_op != NULL) {
+    bool at_edge = tab->bg_load_forward
+                       ? tab->query_result_row + 1 >=
+                             tab->query_results->num_rows
+                       : tab->query_result_row == 0;
+    if (at_edge)
+      tui_load_page_with_dialog(state, tab->bg_load_forward);
+    return;
+  }
+
   /* If cursor is within LOAD_THRESHOLD of the END, load more at end */
   size_t rows_from_end =
       tab->query_results->num_rows > tab->query_result_row
@@ -80,12 +80,37 @@ bool query_has_limit_offset(const char *sql);
 /* Count total rows for a SELECT query using COUNT wrapper */
 int64_t query_count_rows(TuiState *state, const char *base_sql);
 
-/* Execute a SQL query and store results */
+/* Free the tab's results and reset the result cursor */
+void query_clear_results(Tab *tab);
+
+/* Execute a SQL query and store results. Reads that can run on a
+ * connection of their own do so in the background (see tui_poll_query_ops);
+ * the rest run behind a processing dialog. */
 void query_execute(TuiState *state, const char *sql);
 
+/* query_execute always on the tab's connection, for callers that need the
+ * outcome on return */
+void query_execute_foreground(TuiState *state, const char *sql);
+
+/* Cancel the current tab's background query */
+void query_cancel_background(TuiState *state);
+
+/* Fetch rows [offset, offset + limit) of a paginated query: from its
+ * server-side cursor when it has one, else by re-running it with
+ * LIMIT/OFFSET */
+ResultSet *query_fetch_page(TuiState *state, Tab *tab, size_t offset,
+                            size_t limit, char **err);
+
 /* Calculate column widths for query results */
 void query_calculate_result_widths(Tab *tab);
 
+/* Merge rows fetched from the absolute offset into the loaded results:
+ * appended at the end of the window, else prepended before it (keeping the
+ * cursor on its row). Trims afterwards; more is left for the caller to free.
+ * Returns false if the rows don't fit the results. */
+bool query_merge_rows(TuiState *state, Tab *tab, ResultSet *more,
+                      size_t offset);
+
 /* Load more rows at end of current query results */
 bool query_load_more_rows(TuiState *state, Tab *tab);
 
@@ -95,9 +120,22 @@ bool query_load_prev_rows(TuiState *state, Tab *tab);
 /* Trim loaded query data to keep memory bounded */
 void query_trim_loaded_data(TuiState *state, Tab *tab);
 
+/* Trim loaded query results to at most max_pages pages around the cursor */
+void query_trim_to_pages(Tab *tab, size_t max_pages);
+
 /* Check if more rows need to be loaded based on cursor position */
 void query_check_load_more(TuiState *state, Tab *tab);
 
+/* ============================================================================
+ * query_script.c - Running every statement in the editor
+ * ============================================================================
+ */
+
+/* Run all statements in the editor as one script, in a transaction if
+ * asked, then show how each of them went. A trailing read runs last on its
+ * own so its rows fill the results pane. */
+void query_execute_script(TuiState *state, bool transaction);
+
 /* ============================================================================
  * query_results.c - Result grid editing functions
  * ============================================================================
@@ -308,6 +308,7 @@ void query_result_confirm_edit(TuiState *state, Tab *tab) {
   }
 
   /* Update the local cell value */
+  db_row_own(row);
   DbValue *cell = &row->cells[tab->query_result_col];
   db_value_free(cell);
   *cell = new_val;
@@ -397,6 +398,101 @@ void query_result_cell_copy(TuiState *state, Tab *tab) {
   free(content);
 }
 
+/* Paste a prows x pcols block at the cursor as one batched transaction.
+ * Returns false if the user declined the block paste. */
+static bool query_result_paste_block(TuiState *state, Tab *tab, char **fields,
+                                     size_t prows, size_t pcols) {
+  ResultSet *data = tab->query_results;
+  size_t cursor_row = tab->query_result_row;
+  size_t cursor_col = tab->query_result_col;
+
+  /* Clip to the loaded rows and existing columns */
+  size_t nrows = prows;
+  size_t ncols = pcols;
+  if (nrows > data->num_rows - cursor_row)
+    nrows = data->num_rows - cursor_row;
+  if (ncols > data->num_columns - cursor_col)
+    ncols = data->num_columns - cursor_col;
+  bool clipped = nrows < prows || ncols < pcols;
+
+  char msg[128];
+  if (pcols == 1)
+    snprintf(msg, sizeof(msg), "Paste %zu lines into %zu row%s%s?", prows,
+             nrows, nrows == 1 ? "" : "s", clipped ? " (clipped)" : "");
+  else
+    snprintf(msg, sizeof(msg), "Paste %zu row%s x %zu column%s%s?", nrows,
+             nrows == 1 ? "" : "s", ncols, ncols == 1 ? "" : "s",
+             clipped ? " (clipped)" : "");
+  if (!tui_show_confirm_dialog(state, msg))
+    return false;
+
+  /* Gather primary keys for every touched row */
+  QueryPkInfo first = {0};
+  DbValue *pk_vals = NULL;
+  size_t num_pk = 0;
+  size_t built = 0;
+  bool ok = true;
+  for (size_t r = 0; r < nrows; r++) {
+    QueryPkInfo pk = {0};
+    if (!query_pk_info_build(&pk, tab, cursor_row + r)) {
+      tui_set_error(state, "Cannot paste: no primary key found");
+      ok = false;
+      break;
+    }
+    if (r == 0) {
+      num_pk = pk.count;
+      pk_vals = safe_calloc(nrows * num_pk, sizeof(DbValue));
+    }
+    memcpy(&pk_vals[r * num_pk], pk.values, num_pk * sizeof(DbValue));
+    free(pk.values);
+    pk.values = NULL;
+    built++;
+    if (r == 0)
+      first = pk; /* Keep column names */
+    else
+      query_pk_info_free(&pk);
+  }
+
+  if (ok) {
+    CellUpdate *updates = safe_calloc(nrows * ncols, sizeof(CellUpdate));
+    size_t count = 0;
+    for (size_t r = 0; r < nrows; r++) {
+      for (size_t c = 0; c < ncols; c++) {
+        const char *field = fields[r * pcols + c];
+        CellUpdate *u = &updates[count++];
+        u->row = cursor_row + r;
+        u->col = cursor_col + c;
+        u->pk_index = r;
+        u->value = (field && *field) ? db_value_text(field) : db_value_null();
+      }
+    }
+
+    char *err = NULL;
+    int64_t affected = 0;
+    if (tui_apply_cell_updates(state->conn, tab->query_source_table,
+                               first.col_names, num_pk, pk_vals, data,
+                               tab->query_result_col_stats,
+                               tab->query_result_num_cols, updates, count,
+                               &affected, &err)) {
+      tui_set_status(state, "Pasted %zu cells into %zu rows%s", count, nrows,
+                     clipped ? " (block clipped to loaded data)" : "");
+      app_mark_table_tabs_dirty(state->app, tab->connection_index,
+                                tab->query_source_table, tab);
+    } else {
+      tui_set_error(state, "Paste failed (rolled back): %s",
+                    err ? err : "unknown error");
+      free(err);
+    }
+    tui_cell_updates_free(updates, count);
+  }
+
+  for (size_t i = 0; i < built * num_pk; i++)
+    db_value_free(&pk_vals[i]);
+  free(pk_vals);
+  query_pk_info_free(&first);
+  return true;
+}
+
 /* Paste clipboard content to query result cell */
 void query_result_cell_paste(TuiState *state, Tab *tab) {
   UITabState *ui = TUI_TAB_UI(state);
@@ -467,6 +563,25 @@ void query_result_cell_paste(TuiState *state, Tab *tab) {
     return;
   }
 
+  /* Tab-separated or multi-line text pastes as a block at the cursor */
+  size_t prows = 0, pcols = 0;
+  char **fields = state->conn ? tui_parse_tsv(paste_text, &prows, &pcols)
+                              : NULL;
+  bool is_block = fields && (pcols > 1 || prows > 1);
+  if (is_block &&
+      !query_result_paste_block(state, tab, fields, prows, pcols)) {
+    /* Declined lines without tabs paste as one multi-line value */
+    if (pcols > 1)
+      tui_set_status(state, "Paste cancelled");
+    else
+      is_block = false;
+  }
+  tui_free_tsv(fields, prows * pcols);
+  if (is_block) {
+    free(paste_text);
+    return;
+  }
+
   /* Set the edit buffer and trigger confirm to update database */
   free(ui->query_result_edit_buf);
   if (paste_text[0] == '\0') {
@@ -503,11 +618,7 @@ static void query_result_remove_local_row(Tab *tab, size_t local_row) {
   if (local_row >= tab->query_results->num_rows)
     return;
 
-  Row *row = &tab->query_results->rows[local_row];
-  for (size_t j = 0; j < row->num_cells; j++) {
-    db_value_free(&row->cells[j]);
-  }
-  free(row->cells);
+  db_row_free(&tab->query_results->rows[local_row]);
 
   for (size_t i = local_row; i < tab->query_results->num_rows - 1; i++) {
     tab->query_results->rows[i] = tab->query_results->rows[i + 1];
@@ -531,23 +642,21 @@ void query_result_delete_row(TuiState *state, Tab *tab) {
   }
 
   /* Check if we have selections for bulk delete */
-  size_t num_selected = tab->num_selected;
+  size_t num_selected = tab_selection_count(tab);
 
   if (num_selected > 0) {
     /* Bulk delete of selected rows */
-    /* Verify all selected rows can be deleted (have PKs) */
-    for (size_t i = 0; i < num_selected; i++) {
-      size_t global_row = tab->selected_rows[i];
-      if (global_row < tab->query_loaded_offset)
-        continue;
-      size_t local_row = global_row - tab->query_loaded_offset;
-      if (local_row >= tab->query_results->num_rows)
+    /* Verify all selected loaded rows can be deleted (have PKs) */
+    size_t offset = tab->query_loaded_offset;
+    for (size_t local_row = 0; local_row < tab->query_results->num_rows;
+         local_row++) {
+      if (!tab_is_row_selected(tab, offset + local_row))
         continue;
 
       QueryPkInfo pk = {0};
       if (!query_pk_info_build(&pk, tab, local_row)) {
         tui_set_error(state, "Cannot delete: row %zu has no primary key",
-                      global_row + 1);
+                      offset + local_row + 1);
         return;
       }
       query_pk_info_free(&pk);
@@ -561,37 +670,14 @@ void query_result_delete_row(TuiState *state, Tab *tab) {
       return;
     }
 
-    /* Delete rows from database (in reverse order to preserve indices) */
+    /* Delete rows from database in descending order so removing a row
+     * does not shift the local index of rows still to visit */
     size_t deleted = 0;
     size_t errors = 0;
 
-    /* Sort selections in descending order by local index for safe removal */
-    /* Check for overflow before allocation */
-    if (num_selected > SIZE_MAX / sizeof(size_t)) {
-      tui_set_error(state, "Too many rows selected");
-      return;
-    }
-    size_t *sorted = safe_malloc(num_selected * sizeof(size_t));
-    memcpy(sorted, tab->selected_rows, num_selected * sizeof(size_t));
-
-    /* Simple bubble sort (selections are typically small) */
-    for (size_t i = 0; i < num_selected; i++) {
-      for (size_t j = i + 1; j < num_selected; j++) {
-        if (sorted[i] < sorted[j]) {
-          size_t tmp = sorted[i];
-          sorted[i] = sorted[j];
-          sorted[j] = tmp;
-        }
-      }
-    }
-
-    /* Delete in descending order */
-    for (size_t i = 0; i < num_selected; i++) {
-      size_t global_row = sorted[i];
-      if (global_row < tab->query_loaded_offset)
-        continue;
-      size_t local_row = global_row - tab->query_loaded_offset;
-      if (local_row >= tab->query_results->num_rows)
+    for (size_t i = tab->query_results->num_rows; i > 0; i--) {
+      size_t local_row = i - 1;
+      if (!tab_is_row_selected(tab, offset + local_row))
         continue;
 
       char *err = NULL;
@@ -604,7 +690,6 @@ void query_result_delete_row(TuiState *state, Tab *tab) {
       }
     }
 
-    free(sorted);
     tab_clear_selections(tab);
 
     /* Adjust cursor position */
@@ -669,8 +754,8 @@ void query_result_delete_row(TuiState *state, Tab *tab) {
       char *str = db_value_to_string(val);
       if (str) {
         char *safe = tui_sanitize_for_display(str);
-        mvwprintw(state->main_win, row_y, x, "%-*.*s", col_width, col_width,
-                  safe ? safe : str);
+        tui_draw_cell_text(state->main_win, row_y, x, col_width,
+                           safe ? safe : str);
         free(safe);
         free(str);
       }
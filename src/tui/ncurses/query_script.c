@@ -0,0 +1,426 @@
+/*
+ * Lace
+ * Query tab script execution
+ *
+ * Runs every statement in the editor as one script: split by the SQL lexer
+ * for the connection's dialect, sent to the server in batches by the
+ * driver, and reported statement by statement in a summary dialog.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../core/result_cache.h"
+#include "../../db/sql_lexer.h"
+#include "../../util/mem.h"
+#include "query_internal.h"
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+
+/* Summary dialog dimensions */
+#define SCRIPT_DIALOG_MIN_WIDTH 60
+#define SCRIPT_DIALOG_MIN_HEIGHT 12
+#define SCRIPT_DIALOG_MAX_WIDTH_RATIO 0.9
+#define SCRIPT_DIALOG_MAX_HEIGHT_RATIO 0.8
+
+/* Scripts finishing sooner never show the progress window */
+#define SCRIPT_PROGRESS_DELAY_US 250000
+
+static const char *const status_names[] = {
+    [DB_STMT_SKIPPED] = "skipped",
+    [DB_STMT_OK] = "ok",
+    [DB_STMT_ERROR] = "FAILED",
+    [DB_STMT_ROLLED_BACK] = "rolled back",
+};
+
+/* First line of sql with tabs as spaces, cut to max_len bytes */
+static void first_line(const char *sql, char *buf, size_t size,
+                       size_t max_len) {
+  size_t n = 0;
+  for (const char *p = sql; *p && *p != '\n' && *p != '\r'; p++) {
+    if (n + 1 >= size || n >= max_len)
+      break;
+    buf[n++] = *p == '\t' ? ' ' : *p;
+  }
+  buf[n] = '\0';
+}
+
+static void format_elapsed(uint64_t us, char *buf, size_t size) {
+  if (us < 1000000)
+    snprintf(buf, size, "%.1fms", (double)us / 1e3);
+  else
+    snprintf(buf, size, "%.2fs", (double)us / 1e6);
+}
+
+/* Wait for the script, showing how far it got once it takes a while */
+static void wait_with_progress(TuiState *state, AsyncOperation *op,
+                               size_t total) {
+  int width = 50, height = 7;
+  WINDOW *win = NULL;
+  uint64_t started = lace_time_us();
+  bool cancelled = false;
+
+  while (async_poll(op) == ASYNC_STATE_RUNNING) {
+    if (!win && lace_time_us() - started >= SCRIPT_PROGRESS_DELAY_US) {
+      int term_rows, term_cols;
+      getmaxyx(stdscr, term_rows, term_cols);
+      win = dialog_create(height, width, term_rows, term_cols);
+      if (win) {
+        wtimeout(win, POLL_INTERVAL_MS);
+        tui_mark_damage(state, TUI_DAMAGE_ALL);
+      }
+    }
+    if (!win) {
+      async_wait(op, POLL_INTERVAL_MS);
+      continue;
+    }
+
+    lace_mutex_lock(&op->mutex);
+    size_t done = (size_t)op->count;
+    lace_mutex_unlock(&op->mutex);
+
+    werase(win);
+    DRAW_BOX(win, COLOR_BORDER);
+    WITH_ATTR(win, A_BOLD,
+              mvwprintw(win, 0, (width - 18) / 2, " Executing Script "));
+    mvwprintw(win, 2, 2, "Statement %zu of %zu", done, total);
+    int bar = width - 6;
+    int filled = total ? (int)((double)bar * done / total) : 0;
+    mvwaddch(win, 3, 2, '[');
+    for (int i = 0; i < bar; i++)
+      waddch(win, i < filled ? ACS_CKBOARD : ' ');
+    waddch(win, ']');
+    WITH_ATTR(win, A_DIM,
+              mvwprintw(win, height - 2, 2,
+                        cancelled ? "Cancelling..." : "[Esc] Cancel"));
+    wrefresh(win);
+
+    if (wgetch(win) == 27 && !cancelled) {
+      cancelled = true;
+      async_cancel(op);
+    }
+  }
+
+  if (win) {
+    delwin(win);
+    touchwin(stdscr);
+  }
+}
+
+/* Next failed statement after from, wrapping around; from if none */
+static size_t next_error(const DbScript *script, size_t from) {
+  for (size_t n = 1; n <= script->count; n++) {
+    size_t i = (from + n) % script->count;
+    if (script->results[i].status == DB_STMT_ERROR)
+      return i;
+  }
+  return from;
+}
+
+/* Show the per-statement outcome. Returns the statement to move the editor
+ * cursor to, or SIZE_MAX to stay. */
+static size_t show_summary(const DbScript *script, const char *outcome,
+                           uint64_t elapsed_us) {
+  size_t counts[DB_STMT_ROLLED_BACK + 1] = {0};
+  for (size_t i = 0; i < script->count; i++)
+    counts[script->results[i].status]++;
+
+  int term_rows, term_cols;
+  getmaxyx(stdscr, term_rows, term_cols);
+
+  int width = (int)(term_cols * SCRIPT_DIALOG_MAX_WIDTH_RATIO);
+  if (width < SCRIPT_DIALOG_MIN_WIDTH)
+    width = SCRIPT_DIALOG_MIN_WIDTH;
+  if (width > term_cols - 2)
+    width = term_cols - 2;
+
+  /* Header, column titles, list, detail line, footer */
+  int height = (int)script->count + 7;
+  int max_height = (int)(term_rows * SCRIPT_DIALOG_MAX_HEIGHT_RATIO);
+  if (height > max_height)
+    height = max_height;
+  if (height < SCRIPT_DIALOG_MIN_HEIGHT)
+    height = SCRIPT_DIALOG_MIN_HEIGHT;
+  if (height > term_rows - 2)
+    height = term_rows - 2;
+
+  WINDOW *dialog = dialog_create(height, width, term_rows, term_cols);
+  if (!dialog)
+    return SIZE_MAX;
+
+  int list_y = 3;
+  size_t visible_rows = height > 7 ? (size_t)(height - 7) : 1;
+  int content_width = width - 2;
+  int sql_x = 2 + 5 + 12 + 10;
+
+  char elapsed[16];
+  format_elapsed(elapsed_us, elapsed, sizeof(elapsed));
+  char totals[160];
+  snprintf(totals, sizeof(totals),
+           "%zu ok, %zu failed, %zu skipped, %zu rolled back in %s",
+           counts[DB_STMT_OK], counts[DB_STMT_ERROR], counts[DB_STMT_SKIPPED],
+           counts[DB_STMT_ROLLED_BACK], elapsed);
+
+  size_t selected =
+      counts[DB_STMT_ERROR] > 0 ? next_error(script, script->count - 1) : 0;
+  size_t scroll_offset = 0;
+  size_t jump = SIZE_MAX;
+
+  bool running = true;
+  while (running) {
+    if (selected < scroll_offset)
+      scroll_offset = selected;
+    if (selected >= scroll_offset + visible_rows)
+      scroll_offset = selected - visible_rows + 1;
+
+    werase(dialog);
+    DRAW_BOX(dialog, COLOR_BORDER);
+    WITH_ATTR(dialog, A_BOLD,
+              mvwprintw(dialog, 0, (width - 16) / 2, " Script Results "));
+
+    wattron(dialog, A_BOLD);
+    mvwprintw(dialog, 1, 2, "%.*s%.*s", content_width - 2, outcome,
+              content_width - 2 - (int)strlen(outcome), totals);
+    mvwprintw(dialog, 2, 2, "%-5s%-12s%9s %s", "#", "Status", "Rows",
+              "Statement");
+    wattroff(dialog, A_BOLD);
+
+    for (size_t i = 0;
+         i < visible_rows && scroll_offset + i < script->count; i++) {
+      size_t idx = scroll_offset + i;
+      const DbStmtResult *r = &script->results[idx];
+      int row = list_y + (int)i;
+      bool is_selected = idx == selected;
+
+      int attr = is_selected ? A_REVERSE : 0;
+      if (r->status == DB_STMT_ERROR)
+        attr |= A_BOLD | (is_selected ? 0 : COLOR_PAIR(COLOR_ERROR));
+      else if (r->status != DB_STMT_OK)
+        attr |= A_DIM;
+      wattron(dialog, attr);
+      mvwhline(dialog, row, 1, ' ', content_width);
+
+      char rows[16] = "";
+      if (r->status == DB_STMT_OK && r->rows >= 0)
+        snprintf(rows, sizeof(rows), "%lld", (long long)r->rows);
+      mvwprintw(dialog, row, 2, "%-5zu%-12s%9s", idx + 1,
+                status_names[r->status], rows);
+
+      char sql[512];
+      int sql_width = content_width - sql_x;
+      first_line(script->stmts[idx], sql, sizeof(sql),
+                 sql_width > 0 ? (size_t)sql_width : 0);
+      mvwprintw(dialog, row, sql_x, "%s", sql);
+      wattroff(dialog, attr);
+    }
+
+    /* Error of the selected statement */
+    const DbStmtResult *current = &script->results[selected];
+    if (current->status == DB_STMT_ERROR && current->error) {
+      char msg[512];
+      first_line(current->error, msg, sizeof(msg), (size_t)content_width - 2);
+      WITH_ATTR(dialog, COLOR_PAIR(COLOR_ERROR),
+                mvwprintw(dialog, height - 3, 2, "%s", msg));
+    }
+
+    WITH_ATTR(dialog, A_DIM,
+              mvwprintw(dialog, height - 2, 2,
+                        "[Enter] Go to statement  [e] Next error  [Esc] "
+                        "Close"));
+    wrefresh(dialog);
+
+    int ch = wgetch(dialog);
+    if (ch == 'k' || ch == KEY_UP) {
+      if (selected > 0)
+        selected--;
+    } else if (ch == 'j' || ch == KEY_DOWN) {
+      if (selected + 1 < script->count)
+        selected++;
+    } else if (ch == KEY_PPAGE) {
+      selected = selected > visible_rows ? selected - visible_rows : 0;
+    } else if (ch == KEY_NPAGE) {
+      selected += visible_rows;
+      if (selected >= script->count)
+        selected = script->count - 1;
+    } else if (ch == 'g' || ch == KEY_HOME) {
+      selected = 0;
+    } else if (ch == 'G' || ch == KEY_END) {
+      selected = script->count - 1;
+    } else if (ch == 'e') {
+      selected = next_error(script, selected);
+    } else if (ch == '\n' || ch == KEY_ENTER) {
+      jump = selected;
+      running = false;
+    } else if (ch == 27 || ch == 'q') {
+      running = false;
+    }
+  }
+
+  delwin(dialog);
+  touchwin(stdscr);
+  return jump;
+}
+
+void query_execute_script(TuiState *state, bool transaction) {
+  Tab *tab = TUI_TAB(state);
+  UITabState *ui = TUI_TAB_UI(state);
+  if (!tab || tab->type != TAB_TYPE_QUERY || !ui)
+    return;
+  if (!state->conn) {
+    tui_set_error(state, "Not connected to database");
+    return;
+  }
+  if (tab->query_op) {
+    tui_set_error(state, "A query is still running in this tab");
+    return;
+  }
+
+  const char *text = tab->query_text;
+  SqlStatement *stmts = NULL;
+  size_t count =
+      sql_split(text, sql_dialect_for_driver(state->conn->driver->name),
+                &stmts);
+  if (count == 0) {
+    tui_set_error(state, "No queries to execute");
+    return;
+  }
+
+  /* A lone statement runs like Execute query */
+  if (count == 1 && !transaction) {
+    char *sql = sql_statement_text(text, &stmts[0]);
+    query_execute(state, sql);
+    free(sql);
+    free(stmts);
+    return;
+  }
+
+  char **sqls = safe_calloc(count, sizeof(char *));
+  for (size_t i = 0; i < count; i++)
+    sqls[i] = sql_statement_text(text, &stmts[i]);
+
+  /* A trailing read runs on its own afterwards, so its rows end up in the
+   * results pane */
+  size_t batch = count;
+  if (count > 1 && result_cache_sql_is_read(sqls[count - 1]))
+    batch = count - 1;
+
+  tui_cancel_background_load(state);
+  prefetch_motion_reset(&tab->motion);
+  query_clear_results(tab);
+
+  Config *config = state->app ? state->app->config : NULL;
+  DbScript script = {
+      .stmts = (const char *const *)sqls,
+      .count = batch,
+      .stop_on_error = !config || config->general.script_stop_on_error,
+      .transaction = transaction,
+  };
+
+  AsyncOperation op;
+  async_init(&op);
+  op.op_type = ASYNC_OP_SCRIPT;
+  op.conn = state->conn;
+  op.script = &script;
+
+  uint64_t started = lace_time_us();
+  bool ran = async_start(&op);
+  if (ran)
+    wait_with_progress(state, &op, batch);
+  uint64_t elapsed_us = lace_time_us() - started;
+  bool cancelled = op.state == ASYNC_STATE_CANCELLED;
+  bool all_ok = op.state == ASYNC_STATE_COMPLETED;
+  char *err = op.error ? str_dup(op.error) : NULL;
+  async_free(&op);
+
+  if (!ran || !script.results) {
+    tui_set_error(state, "Script failed: %s",
+                  err ? err : "could not start worker");
+    tab->query_error = err;
+    err = NULL;
+    goto cleanup;
+  }
+
+  int64_t affected = 0;
+  size_t failed = 0;
+  for (size_t i = 0; i < batch; i++) {
+    const DbStmtResult *r = &script.results[i];
+    if (r->status == DB_STMT_ERROR)
+      failed++;
+    else if (r->status == DB_STMT_OK && r->rows > 0 &&
+             !result_cache_sql_is_read(sqls[i]))
+      affected += r->rows;
+  }
+
+  if (batch < count) {
+    script.results = safe_reallocarray(script.results, count,
+                                       sizeof(DbStmtResult));
+    DbStmtResult *tail = &script.results[batch];
+    *tail = (DbStmtResult){DB_STMT_SKIPPED, -1, NULL};
+    script.count = count;
+
+    bool run_tail = all_ok || (!cancelled && !script.stop_on_error &&
+                               !script.transaction);
+    if (run_tail) {
+      query_execute_foreground(state, sqls[batch]);
+      if (tab->query_error) {
+        tail->status = DB_STMT_ERROR;
+        tail->error = str_dup(tab->query_error);
+        failed++;
+      } else if (tab->query_results) {
+        tail->status = DB_STMT_OK;
+        tail->rows = (int64_t)(tab->query_paginated
+                                   ? tab->query_total_rows
+                                   : tab->query_results->num_rows);
+      }
+    }
+  }
+
+  /* Without result rows, the pane shows how the script went */
+  if (!tab->query_results && !tab->query_error) {
+    if (all_ok) {
+      tab->query_exec_success = true;
+      tab->query_affected = affected;
+    } else if (err) {
+      tab->query_error = str_dup(err);
+    }
+  }
+
+  if (cancelled) {
+    tui_set_status(state, "Script cancelled after %zu of %zu statements",
+                   script.done, count);
+  } else if (transaction) {
+    if (all_ok)
+      tui_set_status(state, "Transaction committed (%zu statements)", batch);
+    else
+      tui_set_error(state, "Transaction rolled back: %s",
+                    err ? err : "statement failed");
+  } else if (failed > 0) {
+    size_t skipped = 0;
+    for (size_t i = 0; i < count; i++)
+      skipped += script.results[i].status == DB_STMT_SKIPPED;
+    tui_set_error(state, "Executed %zu of %zu statements, %zu failed",
+                  count - skipped, count, failed);
+  } else {
+    tui_set_status(state, "Executed %zu statements", count);
+  }
+
+  const char *outcome = cancelled      ? "Cancelled: "
+                        : !transaction ? ""
+                        : all_ok       ? "Committed: "
+                                       : "Rolled back: ";
+  size_t jump = show_summary(&script, outcome, elapsed_us);
+  if (jump < count) {
+    tab->query_cursor = stmts[jump].start;
+    ui->query_focus_results = false;
+  }
+
+cleanup:
+  db_script_free_results(&script);
+  for (size_t i = 0; i < count; i++)
+    free(sqls[i]);
+  free(sqls);
+  free(stmts);
+  free(err);
+}
@@ -421,6 +421,8 @@ bool tui_handle_sidebar_input(TuiState *state, const UiEvent *event) {
           db_schema_free(old_schema);
           free(tab->col_widths);
           tab->col_widths = NULL;
+          free(tab->col_stats);
+          tab->col_stats = NULL;
           free(tab->table_name);
 
           /* Update tab */
@@ -605,7 +607,7 @@ void tui_draw_sidebar(TuiState *state) {
       curs_set(1);
       wmove(state->sidebar_win, filter_y, 2 + (int)filter_len);
     }
-    wrefresh(state->sidebar_win);
+    wnoutrefresh(state->sidebar_win);
     return;
   }
 
@@ -636,7 +638,7 @@ void tui_draw_sidebar(TuiState *state) {
       curs_set(1);
       wmove(state->sidebar_win, filter_y, 2 + (int)filter_len);
     }
-    wrefresh(state->sidebar_win);
+    wnoutrefresh(state->sidebar_win);
     return;
   }
 
@@ -727,5 +729,5 @@ void tui_draw_sidebar(TuiState *state) {
     wmove(state->sidebar_win, filter_y, 2 + (int)filter_len);
   }
 
-  wrefresh(state->sidebar_win);
+  wnoutrefresh(state->sidebar_win);
 }
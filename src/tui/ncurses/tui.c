@@ -324,6 +324,10 @@ void tui_sync_from_app(TuiState *state) {
     tui_recreate_windows(state);
   }
 
+  /* Refetch rows dropped under memory pressure, then rebalance the budget */
+  tui_restore_evicted_rows(state);
+  tui_enforce_memory_budget(state);
+
   /* Check if tab needs refresh due to changes in another tab */
   Tab *refresh_tab = app_current_tab(app);
   if (refresh_tab && refresh_tab->needs_refresh &&
@@ -343,9 +347,6 @@ void tui_sync_to_workspace(TuiState *state) {
 
   AppState *app = state->app;
 
-  /* Cancel any pending background load before switching away */
-  tui_cancel_background_load(state);
-
   /* Save visibility toggles to app level */
   app->header_visible = state->header_visible;
   app->status_visible = state->status_visible;
@@ -618,8 +619,9 @@ bool tui_init(TuiState *state, AppState *app) {
   /* Set locale for UTF-8 support */
   setlocale(LC_ALL, "");
 
-  /* Initialize ncurses */
-  initscr();
+  /* Initialize ncurses, unless the caller set up its own screen (newterm) */
+  if (!stdscr)
+    initscr();
   cbreak();
   noecho();
   keypad(stdscr, TRUE);
@@ -654,6 +656,7 @@ bool tui_init(TuiState *state, AppState *app) {
     init_pair(COLOR_EDIT, COLOR_BLACK, COLOR_YELLOW);
     init_pair(COLOR_ERROR_TEXT, COLOR_RED, -1);
     init_pair(COLOR_PK, COLOR_YELLOW, -1);
+    init_pair(COLOR_CHANGED, COLOR_BLACK, COLOR_GREEN);
   }
 
   /* Create render context for backend abstraction (wraps existing ncurses
@@ -748,6 +751,7 @@ void tui_cleanup(TuiState *state) {
 
   /* Free internal clipboard buffer */
   free(state->clipboard_buffer);
+  free(state->find_text);
 
   /* Delete windows */
   if (state->main_win)
@@ -857,6 +861,9 @@ void tui_recreate_windows(TuiState *state) {
                              state->sidebar_win);
     render_set_region_handle(state->render_ctx, UI_REGION_TABS, state->tab_win);
   }
+
+  /* New windows start blank */
+  state->damage |= TUI_DAMAGE_ALL;
 }
 
 bool tui_connect(TuiState *state, const char *connstr) {
@@ -1137,7 +1144,140 @@ bool tui_load_tables(TuiState *state) {
   return true;
 }
 
+/* Capture the view state that drives what is on screen */
+static void tui_capture_frame(TuiState *state, TuiFrame *f) {
+  memset(f, 0, sizeof(*f));
+  f->valid = true;
+
+  Tab *tab = TUI_TAB(state);
+  Workspace *ws = TUI_WORKSPACE(state);
+  TableWidget *widget = TUI_TABLE_WIDGET(state);
+
+  f->tab = tab;
+  if (tab) {
+    f->data = tab->data;
+    f->schema = tab->schema;
+    f->loaded_offset = tab->loaded_offset;
+    f->loaded_count = tab->loaded_count;
+    f->total_rows = tab->total_rows;
+    f->num_selected = tab_selection_count(tab);
+    f->num_sort_entries = tab->num_sort_entries;
+    f->num_filters = tab->filters.num_filters;
+  }
+  if (widget && tab && tab->type == TAB_TYPE_TABLE) {
+    f->cursor_row = widget->base.state.cursor_row;
+    f->cursor_col = widget->base.state.cursor_col;
+    f->scroll_row = widget->base.state.scroll_row;
+    f->scroll_col = widget->base.state.scroll_col;
+  } else if (tab) {
+    f->cursor_row = tab->cursor_row;
+    f->cursor_col = tab->cursor_col;
+    f->scroll_row = tab->scroll_row;
+    f->scroll_col = tab->scroll_col;
+  }
+
+  f->current_workspace = state->app ? state->app->current_workspace : 0;
+  f->num_tabs = ws ? ws->num_tabs : 0;
+  f->editing = state->editing;
+  f->adding_row = state->adding_row;
+  f->header_visible = state->header_visible;
+  f->status_visible = state->status_visible;
+  f->sidebar_visible = state->sidebar_visible;
+  f->sidebar_focused = state->sidebar_focused;
+  f->sidebar_filter_active = state->sidebar_filter_active;
+  f->sidebar_filter_len = state->sidebar_filter_len;
+  f->sidebar_highlight = tui_sidebar_highlight(state);
+  f->sidebar_scroll = state->sidebar_scroll;
+  f->sidebar_name_scroll = state->sidebar_name_scroll;
+  f->filters_visible = state->filters_visible;
+  f->filters_focused = state->filters_focused;
+  f->bg_loading_active = state->bg_loading_active;
+  f->term_rows = state->term_rows;
+  f->term_cols = state->term_cols;
+}
+
+/* Derive damaged regions from the difference between two frames */
+static unsigned tui_frame_damage(const TuiFrame *prev, const TuiFrame *cur) {
+  if (!prev->valid)
+    return TUI_DAMAGE_ALL;
+
+  /* Layout or tab switch - everything moves */
+  if (prev->term_rows != cur->term_rows || prev->term_cols != cur->term_cols ||
+      prev->header_visible != cur->header_visible ||
+      prev->status_visible != cur->status_visible ||
+      prev->sidebar_visible != cur->sidebar_visible ||
+      prev->filters_visible != cur->filters_visible || prev->tab != cur->tab ||
+      prev->current_workspace != cur->current_workspace)
+    return TUI_DAMAGE_ALL;
+
+  unsigned damage = TUI_DAMAGE_NONE;
+
+  if (prev->num_tabs != cur->num_tabs)
+    damage |= TUI_DAMAGE_TABS | TUI_DAMAGE_HEADER;
+
+  if (prev->sidebar_focused != cur->sidebar_focused)
+    damage |= TUI_DAMAGE_SIDEBAR | TUI_DAMAGE_TABS | TUI_DAMAGE_CONTENT |
+              TUI_DAMAGE_STATUS;
+
+  if (prev->sidebar_filter_active != cur->sidebar_filter_active ||
+      prev->sidebar_filter_len != cur->sidebar_filter_len ||
+      prev->sidebar_highlight != cur->sidebar_highlight ||
+      prev->sidebar_scroll != cur->sidebar_scroll ||
+      prev->sidebar_name_scroll != cur->sidebar_name_scroll)
+    damage |= TUI_DAMAGE_SIDEBAR | TUI_DAMAGE_STATUS;
+
+  if (prev->data != cur->data || prev->schema != cur->schema ||
+      prev->loaded_offset != cur->loaded_offset ||
+      prev->loaded_count != cur->loaded_count ||
+      prev->total_rows != cur->total_rows ||
+      prev->num_selected != cur->num_selected ||
+      prev->num_sort_entries != cur->num_sort_entries ||
+      prev->num_filters != cur->num_filters ||
+      prev->cursor_col != cur->cursor_col ||
+      prev->scroll_col != cur->scroll_col || prev->editing != cur->editing ||
+      prev->adding_row != cur->adding_row ||
+      prev->filters_focused != cur->filters_focused ||
+      prev->bg_loading_active != cur->bg_loading_active)
+    damage |= TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS;
+
+  if (prev->cursor_row != cur->cursor_row ||
+      prev->scroll_row != cur->scroll_row)
+    damage |= TUI_DAMAGE_GRID_ROWS | TUI_DAMAGE_STATUS;
+
+  return damage;
+}
+
+/* Map table viewmodel change flags to screen regions */
+static unsigned tui_vm_damage(VMChangeFlags flags) {
+  unsigned damage = TUI_DAMAGE_NONE;
+  if (flags & (VM_CHANGE_CURSOR | VM_CHANGE_SCROLL))
+    damage |= TUI_DAMAGE_GRID_ROWS | TUI_DAMAGE_STATUS;
+  if (flags & (VM_CHANGE_SELECTION | VM_CHANGE_DATA | VM_CHANGE_VISIBLE |
+               VM_CHANGE_EDITING | TABLE_VM_CHANGE_COLUMN_WIDTHS |
+               TABLE_VM_CHANGE_LOADING | TABLE_VM_CHANGE_SORT |
+               TABLE_VM_CHANGE_FILTER))
+    damage |= TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS;
+  if (flags & (VM_CHANGE_FOCUS | TABLE_VM_CHANGE_ERROR))
+    damage |= TUI_DAMAGE_STATUS;
+  return damage;
+}
+
+void tui_mark_damage(TuiState *state, unsigned regions) {
+  if (state)
+    state->damage |= regions;
+}
+
 void tui_refresh(TuiState *state) {
+  if (!state)
+    return;
+  state->damage |= TUI_DAMAGE_ALL;
+  tui_refresh_damaged(state);
+}
+
+void tui_refresh_damaged(TuiState *state) {
+  if (!state)
+    return;
+
   /* Sync TableWidget from Tab before drawing (Tab is modified by pagination) */
   Tab *tab = TUI_TAB(state);
   TableWidget *widget = TUI_TABLE_WIDGET(state);
@@ -1145,35 +1285,66 @@ void tui_refresh(TuiState *state) {
     table_widget_sync_from_tab(widget);
   }
 
-  tui_draw_header(state);
-  tui_draw_tabs(state);
-  tui_draw_sidebar(state);
+  TuiFrame frame;
+  tui_capture_frame(state, &frame);
+
+  unsigned damage = state->damage | tui_frame_damage(&state->last_frame, &frame);
+  VmTable *vm = tui_vm_table(state);
+  if (vm) {
+    damage |= tui_vm_damage(vm->base.state.dirty);
+    vm_clear_dirty(&vm->base);
+  }
+  if (widget && widget != vm) {
+    damage |= tui_vm_damage(widget->base.state.dirty);
+    vm_clear_dirty(&widget->base);
+  }
+
+  if (damage & TUI_DAMAGE_HEADER)
+    tui_draw_header(state);
+  if (damage & TUI_DAMAGE_TABS)
+    tui_draw_tabs(state);
+  if (damage & TUI_DAMAGE_SIDEBAR)
+    tui_draw_sidebar(state);
 
   /* Dispatch drawing based on tab type */
-  if (tab) {
-    if (tab->type == TAB_TYPE_QUERY) {
-      tui_draw_query(state);
-    } else if (tab->type == TAB_TYPE_CONNECTION) {
-      tui_draw_connection_tab(state);
+  bool content = (damage & TUI_DAMAGE_CONTENT) != 0;
+  if (!content && (damage & TUI_DAMAGE_GRID_ROWS)) {
+    /* Cursor/scroll-only change: patch rows in place when possible */
+    content = !tui_draw_table_partial(state, &state->last_frame);
+  }
+  if (content) {
+    if (tab) {
+      if (tab->type == TAB_TYPE_QUERY) {
+        tui_draw_query(state);
+      } else if (tab->type == TAB_TYPE_CONNECTION) {
+        tui_draw_connection_tab(state);
+      } else {
+        tui_draw_table(state);
+      }
     } else {
       tui_draw_table(state);
     }
-  } else {
-    tui_draw_table(state);
   }
 
-  tui_draw_status(state);
+  if (damage & TUI_DAMAGE_STATUS)
+    tui_draw_status(state);
 
   /* Ensure cursor is only visible when filter is active */
   if (state->sidebar_filter_active && state->sidebar_focused) {
     curs_set(1);
     if (state->sidebar_win) {
       wmove(state->sidebar_win, 1, 2 + (int)state->sidebar_filter_len);
-      wrefresh(state->sidebar_win);
+      wnoutrefresh(state->sidebar_win);
     }
   } else {
     curs_set(0);
   }
+
+  /* Flush all staged windows to the terminal in one update */
+  doupdate();
+
+  state->damage = TUI_DAMAGE_NONE;
+  state->last_frame = frame;
 }
 
 void tui_set_status(TuiState *state, const char *fmt, ...) {
@@ -1188,6 +1359,7 @@ void tui_set_status(TuiState *state, const char *fmt, ...) {
   va_end(args);
 
   state->status_is_error = false;
+  state->damage |= TUI_DAMAGE_STATUS;
 }
 
 void tui_set_error(TuiState *state, const char *fmt, ...) {
@@ -1202,6 +1374,7 @@ void tui_set_error(TuiState *state, const char *fmt, ...) {
   va_end(args);
 
   state->status_is_error = true;
+  state->damage |= TUI_DAMAGE_STATUS;
 }
 
 /* ============================================================================
@@ -1265,9 +1438,13 @@ typedef struct {
 static const DialogHotkeyEntry dialog_hotkey_table[] = {
     {HOTKEY_SHOW_SCHEMA, tui_show_schema},
     {HOTKEY_GOTO_ROW, tui_show_goto_dialog},
+    {HOTKEY_FIND, tui_show_find_dialog},
+    {HOTKEY_FIND_NEXT, tui_find_next},
     {HOTKEY_CONNECT_DIALOG, tui_show_connect_dialog},
     {HOTKEY_TOGGLE_HISTORY, tui_show_history_dialog},
     {HOTKEY_CONFIG, tui_show_config},
+    {HOTKEY_TOGGLE_WATCH, tui_toggle_watch},
+    {HOTKEY_LIVE_TRIGGER, tui_show_live_trigger},
 };
 
 /* Lookup dialog hotkey handler. Returns true if found and executed. */
@@ -1329,6 +1506,10 @@ static Action handle_toggle_selection(TuiState *state) {
   (void)state;
   return action_row_toggle_select();
 }
+static Action handle_select_all(TuiState *state) {
+  (void)state;
+  return action_rows_select_all();
+}
 
 static const ContextHotkeyEntry context_hotkey_table[] = {
     /* Navigation - context-aware cursor movement */
@@ -1341,6 +1522,7 @@ static const ContextHotkeyEntry context_hotkey_table[] = {
     {HOTKEY_CELL_PASTE, FOCUS_TABLE_ONLY, handle_cell_paste},
     /* Selection - requires table focus */
     {HOTKEY_TOGGLE_SELECTION, FOCUS_TABLE_ONLY, handle_toggle_selection},
+    {HOTKEY_SELECT_ALL, FOCUS_TABLE_ONLY, handle_select_all},
     /* UI Focus */
     {HOTKEY_TOGGLE_SIDEBAR, FOCUS_ANY, handle_toggle_sidebar},
     {HOTKEY_TOGGLE_FILTERS, FOCUS_ANY, handle_toggle_filters},
@@ -1558,7 +1740,7 @@ static bool handle_quit(TuiState *state, Action *action) {
 
 static bool handle_clear_selections(TuiState *state, Action *action) {
   Tab *tab = TUI_TAB(state);
-  if (tab && tab->num_selected > 0) {
+  if (tab && tab_selection_count(tab) > 0) {
     *action = action_rows_clear_select();
     return true;
   }
@@ -1641,7 +1823,9 @@ static bool handle_cycle_sort(TuiState *state, Action *action) {
         }
         tab->num_sort_entries--;
       }
-      tui_refresh_table(state);
+      /* Everything loaded: sort in memory, no round trip */
+      if (!tui_sort_loaded_rows(state))
+        tui_refresh_table(state);
       return true;
     }
   }
@@ -1656,6 +1840,24 @@ static bool handle_help(TuiState *state, Action *action) {
   return true;
 }
 
+/* Actions whose visual effect is fully captured by frame diffing, so they
+ * can take the damage-tracked redraw path instead of a full refresh */
+static bool action_is_navigation(ActionType type) {
+  switch (type) {
+  case ACTION_CURSOR_MOVE:
+  case ACTION_PAGE_UP:
+  case ACTION_PAGE_DOWN:
+  case ACTION_HOME:
+  case ACTION_END:
+  case ACTION_COLUMN_FIRST:
+  case ACTION_COLUMN_LAST:
+  case ACTION_SIDEBAR_MOVE:
+    return true;
+  default:
+    return false;
+  }
+}
+
 void tui_run(TuiState *state) {
   if (!state)
     return;
@@ -1689,14 +1891,25 @@ void tui_run(TuiState *state) {
         tui_check_speculative_prefetch(state);
       }
 
+      /* Sample large tables for deep jumps */
+      tui_poll_landmarks(state);
+
+      /* Collect background queries (marks its own damage) */
+      tui_poll_query_ops(state);
+
+      /* Patch watched rows that changed (marks its own damage) */
+      tui_poll_watch(state);
+
+      /* Refresh tables other sessions wrote to (marks its own damage) */
+      tui_poll_live(state);
+
       tui_update_sidebar_scroll_animation(state);
 
-      /* Redraw if background activity completed */
+      /* Redraw only what background activity or the animation touched */
       if (bg_activity) {
-        tui_refresh(state);
-      } else {
-        tui_draw_sidebar(state);
+        tui_mark_damage(state, TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS);
       }
+      tui_refresh_damaged(state);
       continue;
     }
 
@@ -1705,6 +1918,7 @@ void tui_run(TuiState *state) {
       free(state->status_msg);
       state->status_msg = NULL;
       state->status_is_error = false;
+      state->damage |= TUI_DAMAGE_STATUS;
     }
 
     /* Handle mouse events first - they should work regardless of mode */
@@ -1725,7 +1939,11 @@ void tui_run(TuiState *state) {
 
     /* Handle edit mode input */
     if (state->editing && tui_handle_edit_input(state, &event)) {
-      tui_refresh(state);
+      /* Typing into a cell only touches the cursor row */
+      tui_mark_damage(state, state->editing
+                                 ? TUI_DAMAGE_GRID_ROWS | TUI_DAMAGE_STATUS
+                                 : TUI_DAMAGE_ALL);
+      tui_refresh_damaged(state);
       continue;
     }
 
@@ -1758,7 +1976,10 @@ void tui_run(TuiState *state) {
 
     /* Handle sidebar input (filter text or navigation) */
     if (state->sidebar_focused && tui_handle_sidebar_input(state, &event)) {
-      tui_refresh(state);
+      /* Tab/data switches are picked up by frame diffing */
+      tui_mark_damage(state, TUI_DAMAGE_SIDEBAR | TUI_DAMAGE_TABS |
+                                 TUI_DAMAGE_STATUS);
+      tui_refresh_damaged(state);
       continue;
     }
 
@@ -1794,6 +2015,11 @@ void tui_run(TuiState *state) {
 
     /* Dispatch action if one was created */
     if (handled && action.type != ACTION_NONE) {
+      /* Cursor moves keep the background prefetch running; anything that
+       * may switch away from the tab cancels it first */
+      if (!action_is_navigation(action.type))
+        tui_cancel_background_load(state);
+
       /* Sync TuiState to workspace before dispatch so core sees current state
        */
       tui_sync_to_workspace(state);
@@ -1807,8 +2033,14 @@ void tui_run(TuiState *state) {
         tui_sync_from_app(state);
       }
       /* Tab is now the source of truth - draw code reads from Tab directly */
+      if (!action_is_navigation(action.type)) {
+        state->damage |= TUI_DAMAGE_ALL;
+      }
+    } else if (handled) {
+      /* Stateful handlers mutate state directly (sort, dialogs, ...) */
+      state->damage |= TUI_DAMAGE_ALL;
     }
 
-    tui_refresh(state);
+    tui_refresh_damaged(state);
   }
 }
@@ -38,6 +38,7 @@
 #define COLOR_EDIT UI_COLOR_EDIT
 #define COLOR_ERROR_TEXT UI_COLOR_ERROR_TEXT
 #define COLOR_PK UI_COLOR_PK
+#define COLOR_CHANGED UI_COLOR_CHANGED
 
 /* UI dimensions are in core/constants.h:
  * SIDEBAR_WIDTH, TAB_BAR_HEIGHT, MIN_TERM_ROWS, MIN_TERM_COLS */
@@ -101,6 +102,61 @@ typedef struct UITabState {
   size_t query_result_edit_pos;
 } UITabState;
 
+/* ============================================================================
+ * Damage tracking - which screen regions need redrawing on the next frame
+ * ============================================================================
+ */
+typedef enum {
+  TUI_DAMAGE_NONE = 0,
+  TUI_DAMAGE_HEADER = 1 << 0,
+  TUI_DAMAGE_TABS = 1 << 1,
+  TUI_DAMAGE_SIDEBAR = 1 << 2,
+  TUI_DAMAGE_CONTENT = 1 << 3, /* Whole main window */
+  TUI_DAMAGE_STATUS = 1 << 4,
+  TUI_DAMAGE_ALL = 0x1F,
+  /* Only cursor/scroll moved within already drawn rows: the grid can be
+   * patched in place (one-row wscrl + cursor rows) instead of redrawn */
+  TUI_DAMAGE_GRID_ROWS = 1 << 5,
+} TuiDamage;
+
+/* Snapshot of view state at the last drawn frame. Much of the TUI mutates
+ * Tab directly (pagination, app dispatch), so damage is derived by diffing
+ * this against the current state in addition to viewmodel change flags. */
+typedef struct {
+  bool valid;
+  const Tab *tab;
+  const ResultSet *data;
+  const TableSchema *schema;
+  size_t loaded_offset;
+  size_t loaded_count;
+  size_t total_rows;
+  size_t cursor_row;
+  size_t cursor_col;
+  size_t scroll_row;
+  size_t scroll_col;
+  size_t num_selected;
+  size_t num_sort_entries;
+  size_t num_filters;
+  size_t current_workspace;
+  size_t num_tabs;
+  bool editing;
+  bool adding_row;
+  bool header_visible;
+  bool status_visible;
+  bool sidebar_visible;
+  bool sidebar_focused;
+  bool sidebar_filter_active;
+  size_t sidebar_filter_len;
+  size_t sidebar_highlight;
+  size_t sidebar_scroll;
+  size_t sidebar_name_scroll;
+  bool filters_visible;
+  bool filters_focused;
+  bool bg_loading_active;
+  int term_rows;
+  int term_cols;
+} TuiFrame;
+
 /* TUI state - contains UI-specific state and reference to core AppState */
 struct TuiState {
   /* Core application state (platform-independent) */
@@ -177,6 +233,9 @@ struct TuiState {
   /* Internal clipboard buffer (fallback when external clipboard unavailable) */
   char *clipboard_buffer;
 
+  /* Last find-in-grid search text */
+  char *find_text;
+
   /* Add row mode (temporary row being created) */
   bool adding_row;              /* True when in add-row mode */
   DbValue *new_row_values;      /* Array of values for new row (num_columns) */
@@ -197,6 +256,10 @@ struct TuiState {
   /* Background loading indicator */
   bool bg_loading_active;
 
+  /* Damage tracking for partial redraw */
+  unsigned damage;      /* Pending TuiDamage regions */
+  TuiFrame last_frame;  /* View state as of the last drawn frame */
+
   /* =========================================================================
    * Cached connection/tables for sidebar (performance optimization)
    * These are synced in tui_sync_from_app() when tab changes.
@@ -484,9 +547,15 @@ void tui_disconnect(TuiState *state);
 /* Main loop */
 void tui_run(TuiState *state);
 
-/* Refresh display */
+/* Refresh display (redraws every region) */
 void tui_refresh(TuiState *state);
 
+/* Redraw only regions damaged since the last frame, then doupdate() */
+void tui_refresh_damaged(TuiState *state);
+
+/* Mark screen regions (TuiDamage flags) for the next damaged refresh */
+void tui_mark_damage(TuiState *state, unsigned regions);
+
 /* Recreate windows after layout change (sidebar visibility, etc.) */
 void tui_recreate_windows(TuiState *state);
 
@@ -513,6 +582,8 @@ void tui_draw_tabs(TuiState *state);
 bool tui_load_tables(TuiState *state);
 bool tui_load_table_data(TuiState *state, const char *table);
 bool tui_refresh_table(TuiState *state);
+bool tui_sort_loaded_rows(TuiState *state);
+bool tui_filter_loaded_rows(TuiState *state);
 bool tui_load_schema(TuiState *state, const char *table);
 
 /* ============================================================================
@@ -538,6 +609,8 @@ void tui_prev_table(TuiState *state);
 void tui_show_schema(TuiState *state);
 void tui_show_connect_dialog(TuiState *state);
 void tui_show_history_dialog(TuiState *state);
+void tui_show_plan_dialog(TuiState *state, const char *sql);
+void tui_show_benchmark_dialog(TuiState *state, const char *sql);
 void tui_show_table_selector(TuiState *state);
 void tui_show_config(TuiState *state);
 
@@ -370,6 +370,44 @@ static inline void menu_cleanup(MENU *menu, ITEM **items, size_t num_items) {
   free(items);
 }
 
+/* ============================================================================
+ * Block paste and batched cell updates (batch_edit.c)
+ * ============================================================================
+ */
+
+/* Pending update of one loaded cell */
+typedef struct {
+  size_t row;      /* Local row index in data */
+  size_t col;      /* Column index in data */
+  size_t pk_index; /* Index of the row's key in the caller's pk_vals */
+  DbValue value;   /* New value (owned) */
+} CellUpdate;
+
+/* Parse clipboard text as a tab-separated block. Returns num_rows * num_cols
+ * fields in row-major order (NULL where a row is short), or NULL if empty. */
+char **tui_parse_tsv(const char *text, size_t *num_rows, size_t *num_cols);
+
+/* Free fields returned by tui_parse_tsv */
+void tui_free_tsv(char **fields, size_t count);
+
+/* Free update values and the array itself */
+void tui_cell_updates_free(CellUpdate *updates, size_t count);
+
+/* Write updates to table in one transaction, grouped by column into batched
+ * UPDATE statements. pk_vals holds num_pk_cols key values per distinct row,
+ * addressed by CellUpdate.pk_index; a key column among the updates is
+ * written last, and at most one may be. On success the new values are moved
+ * into data's cells (keeping stats current) and *affected is set; on failure,
+ * including a statement matching fewer rows than it addresses, the
+ * transaction is rolled back, nothing is patched and *err is set. Reorders
+ * updates. */
+bool tui_apply_cell_updates(DbConnection *conn, const char *table,
+                            const char **pk_cols, size_t num_pk_cols,
+                            DbValue *pk_vals, ResultSet *data,
+                            ColumnWidthStats *stats, size_t num_stats,
+                            CellUpdate *updates, size_t count,
+                            int64_t *affected, char **err);
+
 /* ============================================================================
  * Helper functions (tui.c)
  * ============================================================================
@@ -457,16 +495,88 @@ bool tui_load_prev_rows(TuiState *state);
 /* Trim loaded data to keep memory bounded */
 void tui_trim_loaded_data(TuiState *state);
 
+/* Fold rows [first, first + count) of tab->data into / out of the column
+ * width statistics (remove before the rows are freed) */
+void tui_column_stats_add(Tab *tab, size_t first, size_t count);
+void tui_column_stats_remove(Tab *tab, size_t first, size_t count);
+
+/* Rows per table page (general.page_size) */
+size_t tui_page_rows(TuiState *state);
+
+/* Charge the current tab against the global memory budget: evict other tabs
+ * least recently used first, then shrink the current window if needed */
+void tui_enforce_memory_budget(TuiState *state);
+
+/* Refetch the current tab's rows if the memory budget evicted them */
+void tui_restore_evicted_rows(TuiState *state);
+
 /* Check if more rows need to be loaded based on cursor position */
 void tui_check_load_more(TuiState *state);
 
 /* Load a page with blocking dialog (for fast scrolling past loaded data) */
 bool tui_load_page_with_dialog(TuiState *state, bool forward);
 
+/* WHERE / ORDER BY clauses for the current tab's filters and sort, as used
+ * by paged loads (NULL if none). Caller must free. */
+char *tui_build_filter_where(TuiState *state);
+char *tui_build_order_clause(TuiState *state);
+
+/* The filters' WHERE with placeholders in place of their values, which go
+ * to *params for binding (see filters_compile_where). Free both. */
+char *tui_build_filter_where_params(TuiState *state, DbValue **params,
+                                    size_t *num_params);
+
 /* Load rows at specific offset with blocking dialog (for goto/home/end) */
 bool tui_load_rows_at_with_dialog(TuiState *state, size_t offset);
 
-/* Start background load (non-blocking) - returns true if started */
+/* WHERE clause for a page load at *offset: the filters, plus a seek from the
+ * nearest landmark when the tab's landmark index covers them, in which case
+ * *offset becomes relative to the landmark. Caller must free. */
+char *tui_build_page_where(TuiState *state, size_t *offset);
+
+/* The same with the filters' values bound as parameters */
+char *tui_build_page_where_params(TuiState *state, size_t *offset,
+                                  DbValue **params, size_t *num_params);
+
+/* Collect a finished landmark build and start one for the current table
+ * when it is large and not covered yet - call when idle */
+bool tui_poll_landmarks(TuiState *state);
+
+/* Collect finished background queries of query tabs in every workspace and
+ * mark what needs redrawing - call when idle. Returns true while any still
+ * runs. */
+bool tui_poll_query_ops(TuiState *state);
+
+/* Turn watch mode on or off for the current table tab */
+void tui_toggle_watch(TuiState *state);
+
+/* Probe the current tab's rows in view when its watch interval is up and
+ * patch the ones that changed (see watch.c) - call when idle */
+bool tui_poll_watch(TuiState *state);
+
+/* Milliseconds between watch probes and live feed looks */
+uint64_t tui_watch_interval_ms(TuiState *state);
+
+/* Bring the current table tab's rows in view up to date once, as a watch
+ * tick would. False if that cannot be done incrementally (no primary key,
+ * nothing loaded, probe failed). */
+bool tui_watch_refresh(TuiState *state);
+
+/* Start or stop the connections' live feeds to match the configuration,
+ * mark the tabs of tables other sessions wrote to and refresh the current
+ * one (see live.c) - call when idle */
+void tui_poll_live(TuiState *state);
+
+/* Open a query tab with the statements installing the live update trigger
+ * on the current table */
+void tui_show_live_trigger(TuiState *state);
+
+/* Move the cursor to the first row whose leading sort key column is at or
+ * after value (in sort order) */
+bool tui_goto_key(TuiState *state, const char *value);
+
+/* Start background load (non-blocking) - returns true if started, or if
+ * the rows came from a page another tab holds (nothing left running) */
 bool tui_start_background_load(TuiState *state, bool forward);
 
 /* Poll background load, merge if complete - call from main loop */
@@ -527,6 +637,9 @@ bool tui_handle_edit_input(TuiState *state, const UiEvent *event);
 /* Note: tui_move_cursor, tui_page_up/down, tui_home/end,
  * tui_next/prev_table are declared in tui.h as public API */
 
+/* Move the table cursor to an absolute row, loading the page around it */
+bool tui_goto_row(TuiState *state, size_t row);
+
 /* ============================================================================
  * Draw functions (draw.c)
  * ============================================================================
@@ -557,11 +670,24 @@ typedef struct {
   bool show_header_line;   /* Whether to draw top border line */
   SortEntry *sort_entries; /* Array of sort columns (NULL if none) */
   size_t num_sort_entries; /* Number of sort columns */
+  const RowWatch *watch;   /* Cells to highlight as changed (NULL if none) */
 } GridDrawParams;
 
 /* Draw a result set grid (used by table view and query results) */
 void tui_draw_result_grid(TuiState *state, GridDrawParams *params);
 
+/* Print text left-aligned in a field width display columns wide, truncating
+ * by display width and padding with spaces */
+void tui_draw_cell_text(WINDOW *win, int y, int x, int width, const char *text);
+
+/* Redraw one data row of a grid in place (row is relative to params->data) */
+void tui_draw_result_grid_row(TuiState *state, GridDrawParams *params,
+                              size_t row);
+
+/* Patch the table grid after a cursor/scroll-only change since prev.
+ * Returns false if the main window needs a full redraw instead. */
+bool tui_draw_table_partial(TuiState *state, const TuiFrame *prev);
+
 /* Handle mouse events (using pre-translated UiEvent) */
 bool tui_handle_mouse_event(TuiState *state, const UiEvent *event);
 
@@ -576,6 +702,17 @@ bool tui_show_confirm_dialog(TuiState *state, const char *message);
 /* Show go-to row dialog */
 void tui_show_goto_dialog(TuiState *state);
 
+/* ============================================================================
+ * Find in grid (find.c)
+ * ============================================================================
+ */
+
+/* Show incremental find dialog */
+void tui_show_find_dialog(TuiState *state);
+
+/* Jump to the next match of the last search */
+void tui_find_next(TuiState *state);
+
 /* Note: tui_show_schema, tui_show_connect_dialog, tui_show_table_selector,
  * tui_show_config are declared in tui.h as public API */
 
@@ -19,7 +19,7 @@
 #define MIN_DIALOG_WIDTH 60
 #define MIN_DIALOG_HEIGHT 20
 #define MAX_DIALOG_WIDTH 80
-#define MAX_DIALOG_HEIGHT 35
+#define MAX_DIALOG_HEIGHT 38
 
 /* Dialog tabs */
 typedef enum { TAB_GENERAL, TAB_HOTKEYS, TAB_COUNT } ConfigTab;
@@ -34,7 +34,12 @@ typedef enum {
   FIELD_PAGE_SIZE,
   FIELD_PREFETCH_PAGES,
   FIELD_MAX_RESULT_ROWS,
+  FIELD_MEMORY_BUDGET,
+  FIELD_QUERY_CACHE,
+  FIELD_WATCH_INTERVAL,
+  FIELD_LIVE_UPDATES,
   FIELD_DELETE_CONFIRM,
+  FIELD_SCRIPT_STOP_ON_ERROR,
   FIELD_HISTORY_MODE,
   FIELD_HISTORY_MAX_SIZE,
   FIELD_AUTO_OPEN_TABLE,
@@ -294,10 +299,45 @@ static void draw_general_tab(WINDOW *win, DialogState *ds, int start_y,
     *cursor_x = cursor_x_temp;
   }
 
+  draw_number_field(win, y++, start_x + 2, "Memory budget (MB, 0=off)",
+                    ds->config->general.memory_budget_mb,
+                    ds->selected_field == FIELD_MEMORY_BUDGET, focused,
+                    ds->editing_number, &ds->num_input, &cursor_x_temp);
+  if (ds->selected_field == FIELD_MEMORY_BUDGET && ds->editing_number) {
+    *cursor_y = y - 1;
+    *cursor_x = cursor_x_temp;
+  }
+
+  draw_number_field(win, y++, start_x + 2, "Query cache (MB, 0=off)",
+                    ds->config->general.query_cache_mb,
+                    ds->selected_field == FIELD_QUERY_CACHE, focused,
+                    ds->editing_number, &ds->num_input, &cursor_x_temp);
+  if (ds->selected_field == FIELD_QUERY_CACHE && ds->editing_number) {
+    *cursor_y = y - 1;
+    *cursor_x = cursor_x_temp;
+  }
+
+  draw_number_field(win, y++, start_x + 2, "Watch interval (seconds)",
+                    ds->config->general.watch_interval_sec,
+                    ds->selected_field == FIELD_WATCH_INTERVAL, focused,
+                    ds->editing_number, &ds->num_input, &cursor_x_temp);
+  if (ds->selected_field == FIELD_WATCH_INTERVAL && ds->editing_number) {
+    *cursor_y = y - 1;
+    *cursor_x = cursor_x_temp;
+  }
+
+  draw_checkbox(win, y++, start_x + 2, "Live updates from other sessions",
+                ds->config->general.live_updates,
+                ds->selected_field == FIELD_LIVE_UPDATES, focused);
+
   draw_checkbox(win, y++, start_x + 2, "Confirm before delete",
                 ds->config->general.delete_confirmation,
                 ds->selected_field == FIELD_DELETE_CONFIRM, focused);
 
+  draw_checkbox(win, y++, start_x + 2, "Stop script on first error",
+                ds->config->general.script_stop_on_error,
+                ds->selected_field == FIELD_SCRIPT_STOP_ON_ERROR, focused);
+
   y++;
 
   /* Section: Query History */
@@ -867,6 +907,12 @@ static bool handle_general_input(DialogState *ds, const UiEvent *event) {
         ds->config->general.prefetch_pages = value;
       } else if (ds->selected_field == FIELD_MAX_RESULT_ROWS) {
         ds->config->general.max_result_rows = value;
+      } else if (ds->selected_field == FIELD_MEMORY_BUDGET) {
+        ds->config->general.memory_budget_mb = value;
+      } else if (ds->selected_field == FIELD_QUERY_CACHE) {
+        ds->config->general.query_cache_mb = value;
+      } else if (ds->selected_field == FIELD_WATCH_INTERVAL) {
+        ds->config->general.watch_interval_sec = value;
       } else if (ds->selected_field == FIELD_HISTORY_MAX_SIZE) {
         ds->config->general.history_max_size = value;
       }
@@ -923,6 +969,23 @@ static bool handle_general_input(DialogState *ds, const UiEvent *event) {
                         CONFIG_MAX_RESULT_ROWS_MIN, CONFIG_MAX_RESULT_ROWS_MAX);
       ds->editing_number = true;
       break;
+    case FIELD_MEMORY_BUDGET:
+      number_input_init(&ds->num_input, ds->config->general.memory_budget_mb,
+                        CONFIG_MEMORY_BUDGET_MB_MIN,
+                        CONFIG_MEMORY_BUDGET_MB_MAX);
+      ds->editing_number = true;
+      break;
+    case FIELD_QUERY_CACHE:
+      number_input_init(&ds->num_input, ds->config->general.query_cache_mb,
+                        CONFIG_QUERY_CACHE_MB_MIN, CONFIG_QUERY_CACHE_MB_MAX);
+      ds->editing_number = true;
+      break;
+    case FIELD_WATCH_INTERVAL:
+      number_input_init(&ds->num_input, ds->config->general.watch_interval_sec,
+                        CONFIG_WATCH_INTERVAL_SEC_MIN,
+                        CONFIG_WATCH_INTERVAL_SEC_MAX);
+      ds->editing_number = true;
+      break;
     case FIELD_RESTORE_SESSION:
       ds->config->general.restore_session =
           !ds->config->general.restore_session;
@@ -931,10 +994,17 @@ static bool handle_general_input(DialogState *ds, const UiEvent *event) {
       ds->config->general.quit_confirmation =
           !ds->config->general.quit_confirmation;
       break;
+    case FIELD_LIVE_UPDATES:
+      ds->config->general.live_updates = !ds->config->general.live_updates;
+      break;
     case FIELD_DELETE_CONFIRM:
       ds->config->general.delete_confirmation =
           !ds->config->general.delete_confirmation;
       break;
+    case FIELD_SCRIPT_STOP_ON_ERROR:
+      ds->config->general.script_stop_on_error =
+          !ds->config->general.script_stop_on_error;
+      break;
     case FIELD_HISTORY_MODE:
       /* Cycle through history modes: Off -> Session -> Persistent -> Off */
       ds->config->general.history_mode =
@@ -1214,6 +1284,12 @@ ConfigResult config_view_show_tab(TuiState *state, ConfigStartTab start_tab) {
           ds.config->general.prefetch_pages = value;
         } else if (ds.selected_field == FIELD_MAX_RESULT_ROWS) {
           ds.config->general.max_result_rows = value;
+        } else if (ds.selected_field == FIELD_MEMORY_BUDGET) {
+          ds.config->general.memory_budget_mb = value;
+        } else if (ds.selected_field == FIELD_QUERY_CACHE) {
+          ds.config->general.query_cache_mb = value;
+        } else if (ds.selected_field == FIELD_WATCH_INTERVAL) {
+          ds.config->general.watch_interval_sec = value;
         } else if (ds.selected_field == FIELD_HISTORY_MAX_SIZE) {
           ds.config->general.history_max_size = value;
         }
@@ -0,0 +1,438 @@
+/*
+ * Lace
+ * Watch mode - incremental refresh of the rows in view
+ *
+ * Every watch interval the current table tab probes the key and row version
+ * of the rows on screen (see core/row_watch.h). Rows whose version changed
+ * are fetched by key and patched in place, with the cells that differ
+ * highlighted until the next tick. When rows were inserted or deleted ahead
+ * of or inside the view, the loaded window shrinks to the rows in view
+ * (rows that only moved are reused, not fetched) and the rest reloads on
+ * scroll as usual.
+ *
+ * (c) iloveyou, 2025. MIT License.
+ * https://github.com/stychos/lace
+ */
+
+#include "../../core/mem_budget.h"
+#include "../../db/db.h"
+#include "../../util/mem.h"
+#include "../../util/str.h"
+#include "tui_internal.h"
+#include <stdlib.h>
+#include <string.h>
+
+/* Milliseconds between probes, from the configuration */
+uint64_t tui_watch_interval_ms(TuiState *state) {
+  Config *config = state->app ? state->app->config : NULL;
+  int sec = config ? config->general.watch_interval_sec : 0;
+  if (sec < CONFIG_WATCH_INTERVAL_SEC_MIN)
+    sec = CONFIG_WATCH_INTERVAL_SEC_DEFAULT;
+  return (uint64_t)sec * 1000;
+}
+
+static const char *kind_name(DbRowVersion kind) {
+  switch (kind) {
+  case DB_ROW_VERSION_XMIN:
+    return "xmin";
+  case DB_ROW_VERSION_COLUMN:
+    return "update column";
+  case DB_ROW_VERSION_HASH:
+    return "row hash";
+  }
+  return "?";
+}
+
+void tui_toggle_watch(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !tab->schema || !conn)
+    return;
+
+  RowWatch *w = &tab->watch;
+  if (w->enabled) {
+    row_watch_stop(w);
+    tui_set_status(state, "Watch off");
+  } else if (!row_watch_start(w, tab->schema, conn->driver->name)) {
+    tui_set_error(state, "Watch needs a primary key");
+    return;
+  } else {
+    tui_set_status(state, "Watching rows in view every %llus (%s)",
+                   (unsigned long long)(tui_watch_interval_ms(state) / 1000),
+                   kind_name(w->kind));
+  }
+  tui_mark_damage(state, TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS);
+}
+
+/* Whether two cells show the same value */
+static bool cells_equal(const DbValue *a, const DbValue *b) {
+  if (a->is_null || b->is_null)
+    return a->is_null == b->is_null;
+  char *sa = db_value_to_string(a);
+  char *sb = db_value_to_string(b);
+  bool same = sa && sb && strcmp(sa, sb) == 0;
+  free(sa);
+  free(sb);
+  return same;
+}
+
+/* Move src's cells into dst (freeing dst's), flagging the cells that differ
+ * at abs_row. flag_all flags every cell (a row new to this position).
+ * Returns whether any cell was flagged. */
+static bool patch_row(RowWatch *w, Row *dst, Row *src, size_t abs_row,
+                      bool flag_all) {
+  bool changed = false;
+  for (size_t c = 0; c < src->num_cells; c++) {
+    if (flag_all || c >= dst->num_cells ||
+        !cells_equal(&dst->cells[c], &src->cells[c])) {
+      row_watch_flag(w, abs_row, c);
+      changed = true;
+    }
+  }
+  db_row_free(dst);
+  *dst = *src;
+  src->cells = NULL;
+  src->num_cells = 0;
+  return changed;
+}
+
+/* Index of the row with key among keys[0..count), SIZE_MAX if none */
+static size_t find_key(char **keys, size_t count, const char *key) {
+  for (size_t i = 0; key && i < count; i++) {
+    if (keys[i] && str_eq(keys[i], key))
+      return i;
+  }
+  return SIZE_MAX;
+}
+
+/* Recount the table after rows came or went */
+static void recount_rows(TuiState *state, Tab *tab, DbConnection *conn) {
+  char *where = tui_build_filter_where(state);
+  char *err = NULL;
+  bool approx = false;
+  int64_t count =
+      where ? db_count_rows_where(conn, tab->table_name, where, &err)
+            : db_count_rows_fast(conn, tab->table_name, true, &approx, &err);
+  free(where);
+  free(err);
+  if (count < 0)
+    return;
+  tab->total_rows = (size_t)count;
+  tab->row_count_approximate = approx;
+  if (!tab->filters.num_filters)
+    tab->unfiltered_total_rows = tab->total_rows;
+}
+
+/* Replace the loaded window with rows (m of them, moved out) at abs; the
+ * cursor keeps its absolute row. The old rows must be out of the column
+ * statistics already. */
+static void replace_window(Tab *tab, Row *rows, size_t m, size_t abs) {
+  size_t abs_cursor = tab->loaded_offset + tab->cursor_row;
+
+  db_result_clear_rows(tab->data);
+  ResultSet window = {.rows = rows, .num_rows = m};
+  db_result_append_rows(tab->data, &window);
+  tui_column_stats_add(tab, 0, m);
+
+  tab->loaded_offset = abs;
+  tab->loaded_count = m;
+  tab->scroll_row = 0;
+  tab->cursor_row = abs_cursor > abs ? abs_cursor - abs : 0;
+  if (tab->cursor_row >= m)
+    tab->cursor_row = m - 1;
+}
+
+/* Push the patched data, widths and cursor to the view model and widget */
+static void sync_views(TuiState *state, Tab *tab) {
+  VmTable *vm = tui_vm_table(state);
+  if (vm && vm->tab == tab) {
+    vm_table_sync_from_tab(vm);
+    vm_table_set_cursor(vm, tab->cursor_row, tab->cursor_col);
+    vm_table_set_scroll(vm, tab->scroll_row, tab->scroll_col);
+  }
+  UITabState *ui = TUI_TAB_UI(state);
+  if (ui && ui->table_widget)
+    table_widget_sync_from_tab(ui->table_widget);
+}
+
+/* Fetch the rows with the keys of probe rows need[0..count) */
+static ResultSet *fetch_rows(DbConnection *conn, Tab *tab, const char **names,
+                             size_t nk, ResultSet *probe, const size_t *need,
+                             size_t count, char **err) {
+  DbValue *vals = safe_calloc(count * nk, sizeof(DbValue));
+  for (size_t i = 0; i < count; i++) {
+    /* Shallow copies: the probe keeps ownership */
+    for (size_t k = 0; k < nk; k++)
+      vals[i * nk + k] = probe->rows[need[i]].cells[k];
+  }
+  char *where = db_build_keys_where(conn, names, nk, vals, count, err);
+  free(vals);
+  if (!where)
+    return NULL;
+  ResultSet *rs = db_query_page_where(conn, tab->table_name, 0, count, where,
+                                      NULL, false, err);
+  free(where);
+  return rs;
+}
+
+/* One probe of the rows in view and the patch that follows, reported as
+ * label. Returns false with *err set if the probe or fetch failed. */
+static bool watch_tick(TuiState *state, Tab *tab, DbConnection *conn,
+                       const char *label, char **err) {
+  RowWatch *w = &tab->watch;
+  ResultSet *data = tab->data;
+  TableSchema *schema = tab->schema;
+
+  size_t key_cols[MAX_PK_COLUMNS];
+  const char *names[MAX_PK_COLUMNS];
+  size_t nk = row_watch_key_columns(schema, key_cols);
+  for (size_t k = 0; k < nk; k++)
+    names[k] = schema->columns[key_cols[k]].name;
+
+  const char **version_cols = safe_calloc(schema->num_columns, sizeof(char *));
+  size_t num_version_cols = 0;
+  if (w->kind == DB_ROW_VERSION_COLUMN) {
+    version_cols[num_version_cols++] = schema->columns[w->version_col].name;
+  } else {
+    for (size_t c = 0; c < schema->num_columns; c++)
+      version_cols[num_version_cols++] = schema->columns[c].name;
+  }
+
+  /* The rows on screen, as the grid pages them */
+  size_t first = tab->scroll_row < data->num_rows ? tab->scroll_row : 0;
+  size_t limit = state->content_rows > 0 ? (size_t)state->content_rows : 1;
+  size_t have = data->num_rows - first < limit ? data->num_rows - first : limit;
+  size_t abs = tab->loaded_offset + first;
+
+  size_t offset = abs;
+  char *where = tui_build_page_where(state, &offset);
+  char *order = tui_build_order_clause(state);
+  char *sql = db_build_row_version_sql(conn, tab->table_name, names, nk,
+                                       w->kind, version_cols, num_version_cols,
+                                       where, order, offset, limit, err);
+  free(version_cols);
+  free(where);
+  free(order);
+  ResultSet *probe = sql ? db_query(conn, sql, err) : NULL;
+  free(sql);
+  if (!probe)
+    return false;
+
+  size_t m = probe->num_rows;
+  bool shifted = m != have;
+  char **old_keys = safe_calloc(have + 1, sizeof(char *));
+  char **keys = safe_calloc(m + 1, sizeof(char *));
+  size_t *need = safe_calloc(m + 1, sizeof(size_t));
+  size_t *source = safe_calloc(m + 1, sizeof(size_t)); /* Old window row */
+  RowWatchEntry *seen = safe_calloc(m + 1, sizeof(RowWatchEntry));
+  size_t num_need = 0;
+
+  for (size_t j = 0; j < have; j++)
+    old_keys[j] = row_watch_key(data->rows[first + j].cells, key_cols, nk);
+
+  for (size_t i = 0; i < m; i++) {
+    Row *pr = &probe->rows[i];
+    keys[i] = row_watch_key(pr->cells, NULL, nk);
+    char *version = nk < pr->num_cells && !pr->cells[nk].is_null
+                        ? db_value_to_string(&pr->cells[nk])
+                        : NULL;
+    seen[i].key = str_dup(keys[i]);
+    seen[i].version = version;
+
+    bool same_pos = i < have && old_keys[i] && str_eq(old_keys[i], keys[i]);
+    source[i] = same_pos ? i : find_key(old_keys, have, keys[i]);
+    if (!same_pos)
+      shifted = true;
+
+    const char *was = row_watch_version(w, keys[i]);
+    bool current = source[i] != SIZE_MAX && was && version &&
+                   str_eq(was, version);
+    if (!current)
+      need[num_need++] = i;
+  }
+
+  ResultSet *fetched = NULL;
+  char **fetched_keys = NULL;
+  bool ok = true;
+  if (num_need > 0) {
+    fetched = fetch_rows(conn, tab, names, nk, probe, need, num_need, err);
+    ok = fetched != NULL;
+    if (ok) {
+      fetched_keys = safe_calloc(fetched->num_rows + 1, sizeof(char *));
+      for (size_t r = 0; r < fetched->num_rows; r++)
+        fetched_keys[r] =
+            row_watch_key(fetched->rows[r].cells, key_cols, nk);
+    }
+  }
+
+  size_t patched = 0;
+  if (ok && !shifted && num_need > 0) {
+    /* Same rows in the same places: patch the changed ones in place */
+    row_watch_reset_changes(w, abs, m, data->num_columns);
+    for (size_t n = 0; n < num_need; n++) {
+      size_t i = need[n];
+      size_t r = find_key(fetched_keys, fetched->num_rows, keys[i]);
+      if (r == SIZE_MAX) {
+        /* Deleted since the probe: look again next tick */
+        free(seen[i].version);
+        seen[i].version = NULL;
+        continue;
+      }
+      Row *dst = &data->rows[first + i];
+      tui_column_stats_remove(tab, first + i, 1);
+      if (patch_row(w, dst, &fetched->rows[r], abs + i, false))
+        patched++;
+      tui_column_stats_add(tab, first + i, 1);
+    }
+    if (patched > 0)
+      sync_views(state, tab);
+  } else if (ok && shifted) {
+    /* Rows came or went: the view becomes the loaded window */
+    row_watch_reset_changes(w, abs, m, data->num_columns);
+    tui_column_stats_remove(tab, 0, data->num_rows);
+    Row *rows = safe_calloc(m + 1, sizeof(Row));
+    size_t placed = 0;
+    for (size_t i = 0; i < m; i++) {
+      Row *old = source[i] != SIZE_MAX ? &data->rows[first + source[i]]
+                                       : NULL;
+      size_t r = fetched_keys ? find_key(fetched_keys, fetched->num_rows,
+                                         keys[i])
+                              : SIZE_MAX;
+      if (r != SIZE_MAX) {
+        Row empty = {0};
+        if (patch_row(w, old ? old : &empty, &fetched->rows[r], abs + i,
+                      !old))
+          patched++;
+        rows[placed] = old ? *old : empty;
+      } else if (old && old->cells) {
+        rows[placed] = *old; /* Moved, unchanged */
+      } else {
+        continue; /* Deleted since the probe */
+      }
+      if (old) {
+        old->cells = NULL;
+        old->num_cells = 0;
+      }
+      placed++;
+    }
+    if (placed > 0) {
+      replace_window(tab, rows, placed, abs);
+      sync_views(state, tab);
+      landmark_invalidate(&tab->landmarks);
+      recount_rows(state, tab, conn);
+    }
+    free(rows);
+    if (placed == 0) {
+      /* Nothing left in view: reload around the cursor */
+      row_watch_reset_changes(w, 0, 0, 0);
+      tui_refresh_table(state);
+    }
+    tui_mark_damage(state, TUI_DAMAGE_ALL);
+  } else if (ok) {
+    /* Nothing changed: drop the previous tick's highlights */
+    if (row_watch_reset_changes(w, abs, m, data->num_columns))
+      tui_mark_damage(state, TUI_DAMAGE_CONTENT);
+  }
+
+  if (ok) {
+    row_watch_set_seen(w, seen, m);
+    seen = NULL;
+    if (num_need > 0)
+      mem_budget_touch(state->app, tab);
+    if (patched > 0) {
+      tui_mark_damage(state, TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS);
+      tui_set_status(state, "%s: %zu row%s updated", label, patched,
+                     patched == 1 ? "" : "s");
+    }
+  }
+
+  for (size_t j = 0; j < have; j++)
+    free(old_keys[j]);
+  for (size_t i = 0; i < m; i++)
+    free(keys[i]);
+  for (size_t r = 0; fetched_keys && r < fetched->num_rows; r++)
+    free(fetched_keys[r]);
+  if (seen) {
+    for (size_t i = 0; i < m; i++) {
+      free(seen[i].key);
+      free(seen[i].version);
+    }
+    free(seen);
+  }
+  free(old_keys);
+  free(keys);
+  free(need);
+  free(source);
+  free(fetched_keys);
+  db_result_free(fetched);
+  db_result_free(probe);
+  return ok;
+}
+
+bool tui_watch_refresh(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || tab->type != TAB_TYPE_TABLE || !tab->table_name ||
+      !tab->schema || !tab->data || !conn)
+    return false;
+
+  /* A watched tab probes right away; otherwise one probe from scratch,
+   * which fetches the rows in view and patches what differs */
+  bool watching = tab->watch.enabled;
+  if (!watching && !row_watch_start(&tab->watch, tab->schema,
+                                    conn->driver->name))
+    return false;
+
+  void (*history_callback)(void *, const char *, int) = conn->history_callback;
+  conn->history_callback = NULL;
+  char *err = NULL;
+  bool ok = watch_tick(state, tab, conn, "Live update", &err);
+  conn->history_callback = history_callback;
+  free(err);
+
+  if (watching)
+    tab->watch.next_tick = lace_time_ms() + tui_watch_interval_ms(state);
+  else
+    row_watch_stop(&tab->watch);
+  return ok;
+}
+
+bool tui_poll_watch(TuiState *state) {
+  Tab *tab = TUI_TAB(state);
+  DbConnection *conn = TUI_CONN(state);
+  if (!tab || !tab->watch.enabled || !conn)
+    return false;
+  if (tab->type != TAB_TYPE_TABLE || !tab->table_name || !tab->schema ||
+      !tab->data) {
+    row_watch_stop(&tab->watch);
+    return false;
+  }
+
+  /* Never under an edit, a page load or a pending reload */
+  uint64_t now = lace_time_ms();
+  if (now < tab->watch.next_tick || state->editing || tab->bg_load_op ||
+      tab->needs_refresh || tab->rows_evicted)
+    return false;
+  tab->watch.next_tick = now + tui_watch_interval_ms(state);
+
+  /* Probes are polling, not something the user ran: keep them out of the
+   * query history */
+  void (*history_callback)(void *, const char *, int) = conn->history_callback;
+  conn->history_callback = NULL;
+  char *err = NULL;
+  bool ok = watch_tick(state, tab, conn, "Watch", &err);
+  conn->history_callback = history_callback;
+
+  if (!ok) {
+    RowWatch *w = &tab->watch;
+    if (row_watch_next_kind(w, tab->schema)) {
+      w->next_tick = 0; /* Retry with the fallback right away */
+    } else {
+      tui_set_error(state, "Watch stopped: %s", err ? err : "probe failed");
+      row_watch_stop(w);
+      tui_mark_damage(state, TUI_DAMAGE_CONTENT | TUI_DAMAGE_STATUS);
+    }
+  }
+  free(err);
+  return ok;
+}
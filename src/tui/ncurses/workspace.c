@@ -9,8 +9,10 @@
  * https://github.com/stychos/lace
  */
 
+#include "../../core/mem_budget.h"
 #include "../../core/workspace.h"
 #include "tui_internal.h"
+#include <stdio.h>
 #include <stdlib.h>
 #include <string.h>
 
@@ -27,6 +29,9 @@ void tab_save(TuiState *state) {
   if (ui && ui->table_widget && tab->type == TAB_TYPE_TABLE) {
     table_widget_sync_to_tab(ui->table_widget);
   }
+
+  /* Account the tab's rows as of leaving it, for the memory budget LRU */
+  mem_budget_touch(state->app, tab);
   /* TODO: Add query_widget_sync_to_tab when QueryWidget is migrated */
 
   /* Sync TUI-specific UI state to UITabState */
@@ -139,6 +144,10 @@ void tab_restore(TuiState *state) {
     tui_recreate_windows(state);
   }
 
+  /* Refetch rows dropped under memory pressure, then rebalance the budget */
+  tui_restore_evicted_rows(state);
+  tui_enforce_memory_budget(state);
+
   /* Check if tab needs refresh due to changes in another tab */
   if (tab->needs_refresh && tab->type == TAB_TYPE_TABLE && tab->table_name) {
     tab->needs_refresh = false;
@@ -307,6 +316,10 @@ bool workspace_create(TuiState *state, size_t table_index) {
   return tab_create(state, table_index);
 }
 
+/* Spinner frames for tabs running a query */
+static const char TAB_SPINNER[] = {'|', '/', '-', '\\'};
+#define TAB_SPINNER_COUNT 4
+
 /* Draw tab bar */
 void tui_draw_tabs(TuiState *state) {
   if (!state || !state->tab_win)
@@ -317,7 +330,7 @@ void tui_draw_tabs(TuiState *state) {
 
   Workspace *ws = TUI_WORKSPACE(state);
   if (!ws) {
-    wrefresh(state->tab_win);
+    wnoutrefresh(state->tab_win);
     return;
   }
 
@@ -331,6 +344,15 @@ void tui_draw_tabs(TuiState *state) {
     const char *name = tab->table_name ? tab->table_name : "?";
     int tab_width = (int)strlen(name) + 4; /* " name  " with padding */
 
+    /* A spinner in front of a tab running a background query */
+    char label[160];
+    if (tab->query_op) {
+      char spin = TAB_SPINNER[(lace_time_ms() / 100) % TAB_SPINNER_COUNT];
+      snprintf(label, sizeof(label), "%c %s", spin, name);
+      name = label;
+      tab_width += 2;
+    }
+
     if (x + tab_width > state->term_cols)
       break;
 
@@ -365,7 +387,7 @@ void tui_draw_tabs(TuiState *state) {
     }
   }
 
-  wrefresh(state->tab_win);
+  wnoutrefresh(state->tab_win);
 }
 
 /* Close current tab */
@@ -21,6 +21,7 @@
 #include <strings.h>
 #include <sys/stat.h>
 #include <unistd.h>
+#include <wchar.h>
 
 char *str_dup(const char *s) {
   if (!s)
@@ -90,6 +91,116 @@ char *str_lower(char *s) {
   return s;
 }
 
+/* ============================================================================
+ * Display width
+ * ============================================================================
+ */
+
+#define ASCII_HIGH_BITS 0x8080808080808080ULL
+
+/* Decode one UTF-8 sequence at s (len > 0). Returns bytes consumed and the
+ * display width in *width; invalid sequences consume one byte, width 1. */
+static size_t utf8_char_width(const unsigned char *s, size_t len, int *width) {
+  unsigned char c = s[0];
+  size_t need;
+  uint32_t cp;
+
+  if (c < 0x80) {
+    *width = 1;
+    return 1;
+  } else if ((c & 0xE0) == 0xC0) {
+    need = 2;
+    cp = c & 0x1F;
+  } else if ((c & 0xF0) == 0xE0) {
+    need = 3;
+    cp = c & 0x0F;
+  } else if ((c & 0xF8) == 0xF0) {
+    need = 4;
+    cp = c & 0x07;
+  } else {
+    *width = 1;
+    return 1;
+  }
+
+  if (need > len) {
+    *width = 1;
+    return 1;
+  }
+  for (size_t i = 1; i < need; i++) {
+    if ((s[i] & 0xC0) != 0x80) {
+      *width = 1;
+      return 1;
+    }
+    cp = (cp << 6) | (s[i] & 0x3F);
+  }
+
+  int w = wcwidth((wchar_t)cp);
+  *width = w < 0 ? 1 : w;
+  return need;
+}
+
+size_t str_display_width(const char *s, size_t len) {
+  if (!s)
+    return 0;
+
+  const unsigned char *p = (const unsigned char *)s;
+  size_t width = 0;
+  size_t i = 0;
+
+  while (i < len) {
+    /* Fast path: 8 ASCII bytes at a time are 8 columns */
+    while (i + sizeof(uint64_t) <= len) {
+      uint64_t word;
+      memcpy(&word, p + i, sizeof(word));
+      if (word & ASCII_HIGH_BITS)
+        break;
+      width += sizeof(word);
+      i += sizeof(word);
+    }
+    if (i >= len)
+      break;
+
+    int w;
+    i += utf8_char_width(p + i, len - i, &w);
+    width += (size_t)w;
+  }
+  return width;
+}
+
+size_t str_display_prefix(const char *s, size_t len, size_t max_cols,
+                          size_t *cols_out) {
+  const unsigned char *p = (const unsigned char *)s;
+  size_t cols = 0;
+  size_t i = 0;
+
+  while (s && i < len && cols < max_cols) {
+    if (p[i] < 0x80) {
+      i++;
+      cols++;
+      continue;
+    }
+    int w;
+    size_t n = utf8_char_width(p + i, len - i, &w);
+    if (cols + (size_t)w > max_cols)
+      break;
+    i += n;
+    cols += (size_t)w;
+  }
+
+  /* Swallow trailing zero-width characters (combining marks) */
+  while (s && i < len && p[i] >= 0x80) {
+    int w;
+    size_t n = utf8_char_width(p + i, len - i, &w);
+    if (w != 0)
+      break;
+    i += n;
+  }
+
+  if (cols_out)
+    *cols_out = cols;
+  return i;
+}
+
 char *str_url_encode(const char *s) {
   if (!s)
     return NULL;
@@ -184,6 +295,16 @@ bool str_to_double(const char *s, double *out) {
   return true;
 }
 
+char *str_from_double(double v) {
+  for (int digits = 15; digits < 17; digits++) {
+    char *s = str_printf("%.*g", digits, v);
+    if (!s || strtod(s, NULL) == v)
+      return s;
+    free(s);
+  }
+  return str_printf("%.17g", v);
+}
+
 /* Secure memory handling */
 
 void str_secure_free(char *s) {
@@ -31,6 +31,16 @@ bool str_eq_nocase(const char *a, const char *b);
 /* String manipulation */
 char *str_lower(char *s); /* In-place lowercase */
 
+/* Terminal display width (UTF-8 aware, via wcwidth).
+ * Control and undecodable bytes count as one column, matching how cells are
+ * sanitized for display. ASCII runs take a word-at-a-time fast path. */
+size_t str_display_width(const char *s, size_t len);
+
+/* Number of bytes of s (at most len) that fit in max_cols display columns
+ * without splitting a character. Columns used are stored in *cols_out. */
+size_t str_display_prefix(const char *s, size_t len, size_t max_cols,
+                          size_t *cols_out);
+
 /* URL encoding */
 char *str_url_encode(const char *s);
 char *str_url_decode(const char *s);
@@ -57,6 +67,8 @@ char *str_build_pk_where(const char **pk_cols, size_t num_pk_cols, bool use_doll
 bool str_to_int(const char *s, int *out);
 bool str_to_int64(const char *s, int64_t *out);
 bool str_to_double(const char *s, double *out);
+/* Shortest text (up to 17 digits) that reads back as v. Caller must free. */
+char *str_from_double(double v);
 
 /* Secure memory handling */
 void str_secure_free(char *s); /* Zero memory before freeing (for passwords) */
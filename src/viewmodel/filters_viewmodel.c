@@ -187,6 +187,8 @@ bool filters_vm_start_edit(FiltersViewModel *vm) {
     vm_notify(&vm->base, FILTERS_VM_CHANGE_EDIT_MODE);
     return true;
   }
+  /* A list too long for the buffer is replaced, not edited */
+  if (field == FILTER_FIELD_VALUE && f->long_value) return false;
   const char *current_value = "";
   if (field == FILTER_FIELD_VALUE) current_value = f->value;
   else if (field == FILTER_FIELD_VALUE2) current_value = f->value2;
@@ -249,8 +251,7 @@ bool filters_vm_commit_edit(FiltersViewModel *vm) {
   if (vm->edit.filter_index >= vm->filters->num_filters) return false;
   ColumnFilter *f = &vm->filters->filters[vm->edit.filter_index];
   if (vm->edit.field == FILTER_FIELD_VALUE) {
-    strncpy(f->value, vm->edit.buffer, sizeof(f->value) - 1);
-    f->value[sizeof(f->value) - 1] = '\0';
+    filter_set_value(f, vm->edit.buffer);
   } else if (vm->edit.field == FILTER_FIELD_VALUE2) {
     strncpy(f->value2, vm->edit.buffer, sizeof(f->value2) - 1);
     f->value2[sizeof(f->value2) - 1] = '\0';
@@ -7,6 +7,7 @@
  */
 
 #include "table_viewmodel.h"
+#include "../core/col_stats.h"
 #include "../core/constants.h"
 #include "../util/mem.h"
 #include "../util/str.h"
@@ -95,11 +96,8 @@ static void table_vm_validate_cursor_impl(ViewModel *vm) {
 static void table_vm_ops_destroy(ViewModel *vm) {
   TableViewModel *tvm = (TableViewModel *)vm;
 
-  /* Free selection array */
-  free(tvm->selection.rows);
-  tvm->selection.rows = NULL;
-  tvm->selection.count = 0;
-  tvm->selection.capacity = 0;
+  /* Free selection ranges */
+  row_set_free(&tvm->selection.rows);
 
   /* Free edit state */
   free(tvm->edit.buffer);
@@ -159,7 +157,7 @@ void table_vm_bind(TableViewModel *vm, Tab *tab) {
   }
 
   /* Clear selection */
-  vm->selection.count = 0;
+  row_set_clear(&vm->selection.rows);
   vm->selection.anchor_set = false;
 
   /* Bind to new tab */
@@ -394,46 +392,10 @@ void table_vm_update_pagination(TableViewModel *vm, size_t offset, size_t count,
  * ============================================================================
  */
 
-static bool selection_contains(const TableSelection *sel, size_t row) {
-  for (size_t i = 0; i < sel->count; i++) {
-    if (sel->rows[i] == row)
-      return true;
-  }
-  return false;
-}
-
-static bool selection_add(TableSelection *sel, size_t row) {
-  if (selection_contains(sel, row))
-    return false;
-
-  /* Grow if needed */
-  if (sel->count >= sel->capacity) {
-    size_t new_cap = sel->capacity == 0 ? 16 : sel->capacity * 2;
-    sel->rows = safe_reallocarray(sel->rows, new_cap, sizeof(size_t));
-    sel->capacity = new_cap;
-  }
-
-  sel->rows[sel->count++] = row;
-  return true;
-}
-
-static bool selection_remove(TableSelection *sel, size_t row) {
-  for (size_t i = 0; i < sel->count; i++) {
-    if (sel->rows[i] == row) {
-      /* Shift remaining elements */
-      memmove(&sel->rows[i], &sel->rows[i + 1],
-              (sel->count - i - 1) * sizeof(size_t));
-      sel->count--;
-      return true;
-    }
-  }
-  return false;
-}
-
 void table_vm_select_row(TableViewModel *vm, size_t row) {
   if (!vm)
     return;
-  if (selection_add(&vm->selection, row)) {
+  if (row_set_add(&vm->selection.rows, row)) {
     vm_notify(&vm->base, VM_CHANGE_SELECTION);
   }
 }
@@ -441,7 +403,7 @@ void table_vm_select_row(TableViewModel *vm, size_t row) {
 void table_vm_deselect_row(TableViewModel *vm, size_t row) {
   if (!vm)
     return;
-  if (selection_remove(&vm->selection, row)) {
+  if (row_set_remove(&vm->selection.rows, row)) {
     vm_notify(&vm->base, VM_CHANGE_SELECTION);
   }
 }
@@ -449,31 +411,21 @@ void table_vm_deselect_row(TableViewModel *vm, size_t row) {
 void table_vm_toggle_row_selection(TableViewModel *vm, size_t row) {
   if (!vm)
     return;
-  if (selection_contains(&vm->selection, row)) {
-    selection_remove(&vm->selection, row);
-  } else {
-    selection_add(&vm->selection, row);
-  }
+  row_set_toggle(&vm->selection.rows, row);
   vm_notify(&vm->base, VM_CHANGE_SELECTION);
 }
 
 bool table_vm_row_selected(const TableViewModel *vm, size_t row) {
   if (!vm)
     return false;
-  return selection_contains(&vm->selection, row);
+  return row_set_contains(&vm->selection.rows, row);
 }
 
 void table_vm_select_range(TableViewModel *vm, size_t from, size_t to) {
   if (!vm)
     return;
 
-  size_t start = (from < to) ? from : to;
-  size_t end = (from < to) ? to : from;
-
-  for (size_t i = start; i <= end; i++) {
-    selection_add(&vm->selection, i);
-  }
-
+  row_set_add_range(&vm->selection.rows, from, to);
   vm_notify(&vm->base, VM_CHANGE_SELECTION);
 }
 
@@ -486,7 +438,7 @@ void table_vm_extend_selection(TableViewModel *vm, size_t to_row) {
     vm->selection.anchor_set = true;
   }
 
-  table_vm_clear_selection(vm);
+  row_set_clear(&vm->selection.rows);
   table_vm_select_range(vm, vm->selection.anchor, to_row);
 }
 
@@ -494,11 +446,7 @@ void table_vm_select_all(TableViewModel *vm) {
   if (!vm)
     return;
 
-  size_t row_count = table_vm_row_count(vm);
-  for (size_t i = 0; i < row_count; i++) {
-    selection_add(&vm->selection, i);
-  }
-
+  row_set_select_all(&vm->selection.rows, table_vm_row_count(vm));
   vm_notify(&vm->base, VM_CHANGE_SELECTION);
 }
 
@@ -506,19 +454,19 @@ void table_vm_clear_selection(TableViewModel *vm) {
   if (!vm)
     return;
 
-  if (vm->selection.count > 0) {
-    vm->selection.count = 0;
+  if (row_set_count(&vm->selection.rows) > 0) {
+    row_set_clear(&vm->selection.rows);
     vm->selection.anchor_set = false;
     vm_notify(&vm->base, VM_CHANGE_SELECTION);
   }
 }
 
 size_t table_vm_selection_count(const TableViewModel *vm) {
-  return vm ? vm->selection.count : 0;
+  return vm ? row_set_count(&vm->selection.rows) : 0;
 }
 
-const size_t *table_vm_selected_rows(const TableViewModel *vm) {
-  return vm ? vm->selection.rows : NULL;
+const RowSet *table_vm_selected_rows(const TableViewModel *vm) {
+  return vm ? &vm->selection.rows : NULL;
 }
 
 /* ============================================================================
@@ -894,36 +842,29 @@ void table_vm_recalc_column_widths(TableViewModel *vm) {
     vm->num_col_widths = num_cols;
   }
 
-  /* Calculate width for each column */
-  for (size_t col = 0; col < num_cols; col++) {
-    int width = MIN_COL_WIDTH;
-
-    /* Consider header width */
-    if (vm->schema && col < vm->schema->num_columns &&
-        vm->schema->columns[col].name) {
-      int header_len = (int)strlen(vm->schema->columns[col].name);
-      if (header_len > width)
-        width = header_len;
-    }
-
-    /* Consider data width (sample first PAGE_SIZE rows) */
-    size_t sample_count =
-        vm->data->num_rows < PAGE_SIZE ? vm->data->num_rows : PAGE_SIZE;
-    for (size_t row = 0; row < sample_count; row++) {
-      const DbValue *val = table_vm_cell(vm, row, col);
-      if (val && !val->is_null && val->type == DB_TYPE_TEXT && val->text.data) {
-        int cell_len = (int)strlen(val->text.data);
-        if (cell_len > width)
-          width = cell_len;
-      }
-    }
+  /* Reuse the tab's incrementally maintained widths when they describe
+   * the same data */
+  Tab *tab = vm->tab;
+  if (tab && tab->data == vm->data && tab->col_widths &&
+      tab->num_col_widths == num_cols) {
+    memcpy(vm->col_widths, tab->col_widths, num_cols * sizeof(int));
+    vm_mark_dirty(&vm->base, TABLE_VM_CHANGE_COLUMN_WIDTHS);
+    return;
+  }
 
-    /* Clamp to max width */
-    if (width > MAX_COL_WIDTH)
-      width = MAX_COL_WIDTH;
+  /* Otherwise measure every loaded row by display width */
+  ColumnWidthStats *stats = safe_calloc(num_cols, sizeof(ColumnWidthStats));
+  col_stats_add_rows(stats, num_cols, vm->data->rows, vm->data->num_rows);
 
-    vm->col_widths[col] = width;
+  for (size_t col = 0; col < num_cols; col++) {
+    const char *header = NULL;
+    if (vm->schema && col < vm->schema->num_columns)
+      header = vm->schema->columns[col].name;
+    else if (vm->data->columns)
+      header = vm->data->columns[col].name;
+    vm->col_widths[col] = col_stats_width(&stats[col], header);
   }
+  free(stats);
 
   vm_mark_dirty(&vm->base, TABLE_VM_CHANGE_COLUMN_WIDTHS);
 }
@@ -975,7 +916,7 @@ char *table_vm_copy_cell(const TableViewModel *vm) {
 }
 
 char *table_vm_copy_selection(const TableViewModel *vm, bool include_headers) {
-  if (!vm || vm->selection.count == 0)
+  if (!vm || row_set_count(&vm->selection.rows) == 0)
     return table_vm_copy_cell(vm);
 
   /* Build tab-separated output */
@@ -1005,9 +946,10 @@ char *table_vm_copy_selection(const TableViewModel *vm, bool include_headers) {
     buf[buf_len++] = '\n';
   }
 
-  /* Add selected rows */
-  for (size_t i = 0; i < vm->selection.count; i++) {
-    size_t row = vm->selection.rows[i];
+  /* Add selected rows (in row order) */
+  size_t row_count = table_vm_row_count(vm);
+  size_t row = 0;
+  while (row_set_next(&vm->selection.rows, row, &row) && row < row_count) {
     size_t num_cols = table_vm_col_count(vm);
 
     for (size_t col = 0; col < num_cols; col++) {
@@ -1029,6 +971,7 @@ char *table_vm_copy_selection(const TableViewModel *vm, bool include_headers) {
       }
     }
     buf[buf_len++] = '\n';
+    row++;
   }
 
   buf[buf_len] = '\0';
@@ -1291,7 +1234,7 @@ void table_vm_ensure_row_loaded(TableViewModel *vm, size_t row) {
  */
 
 bool table_vm_delete_selected(TableViewModel *vm, char **error) {
-  if (!vm || vm->selection.count == 0) {
+  if (!vm || row_set_count(&vm->selection.rows) == 0) {
     if (error)
       *error = str_dup("No rows selected");
     return false;
@@ -42,9 +42,7 @@ typedef struct TableViewModel TableViewModel;
  */
 
 typedef struct TableSelection {
-  size_t *rows;    /* Array of selected row indices */
-  size_t count;    /* Number of selected rows */
-  size_t capacity; /* Allocated capacity */
+  RowSet rows;     /* Selected row indices (range-compressed) */
   size_t anchor;   /* Anchor row for shift-select */
   bool anchor_set; /* Whether anchor is valid */
 } TableSelection;
@@ -239,7 +237,7 @@ void table_vm_clear_selection(TableViewModel *vm);
 
 /* Get selected rows */
 size_t table_vm_selection_count(const TableViewModel *vm);
-const size_t *table_vm_selected_rows(const TableViewModel *vm);
+const RowSet *table_vm_selected_rows(const TableViewModel *vm);
 
 /* ============================================================================
  * Editing
@@ -592,6 +590,7 @@ typedef TableViewModelCallbacks VmTableCallbacks;
 #define vm_table_loaded_count            table_vm_loaded_count
 #define vm_table_delete_selected         table_vm_delete_selected
 #define vm_table_refresh                 table_vm_refresh
+#define vm_table_sync_from_tab           table_vm_sync_from_tab
 #define vm_table_copy_cell               table_vm_copy_cell
 #define vm_table_copy_selection          table_vm_copy_selection
 #define vm_table_recalc_column_widths    table_vm_recalc_column_widths